@@ -0,0 +1,174 @@
+/*
+  Framebuffer kernel micro benchmark
+
+  Compare the shared RGB565 fill/copy kernels (gfx_fill_16bit, gfx_fill_rect_16bit,
+  gfx_copy_rect_16bit) against the plain per-pixel loops they replaced.
+  No display required, results are printed to Serial in nano-seconds per pixel.
+*/
+#include <Arduino_GFX_Library.h>
+
+#define FB_W 320
+#define FB_H 240
+#define LOOP_COUNT 20
+
+uint16_t *fb;
+uint16_t *bitmap;
+
+// previous per-pixel implementations, for reference
+void ref_fill(uint16_t *dst, uint16_t color, uint32_t len)
+{
+  while (len--)
+  {
+    *(dst++) = color;
+  }
+}
+
+void ref_fill_rect(uint16_t *row, int16_t stride, int16_t w, int16_t h, uint16_t color)
+{
+  for (int j = 0; j < h; j++)
+  {
+    for (int i = 0; i < w; i++)
+    {
+      row[i] = color;
+    }
+    row += stride;
+  }
+}
+
+void ref_copy_rect(uint16_t *row, int16_t stride, uint16_t *from_bitmap, int16_t w, int16_t h)
+{
+  while (h--)
+  {
+    for (int i = 0; i < w; ++i)
+    {
+      row[i] = *from_bitmap++;
+    }
+    row += stride;
+  }
+}
+
+void printResult(const char *name, uint32_t ref_us, uint32_t kernel_us, uint32_t pixels)
+{
+  Serial.printf("%-22s ref: %7.3f ns/px  kernel: %7.3f ns/px  x%.2f\n",
+                name,
+                ref_us * 1000.0 / pixels,
+                kernel_us * 1000.0 / pixels,
+                (kernel_us > 0) ? ((float)ref_us / kernel_us) : 0);
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  // Serial.setDebugOutput(true);
+  // while(!Serial);
+  Serial.println("Arduino_GFX framebuffer kernel benchmark");
+
+#if defined(ESP32)
+  fb = (uint16_t *)aligned_alloc(16, FB_W * FB_H * 2);
+  bitmap = (uint16_t *)aligned_alloc(16, FB_W * FB_H * 2);
+#else
+  fb = (uint16_t *)malloc(FB_W * FB_H * 2);
+  bitmap = (uint16_t *)malloc(FB_W * FB_H * 2);
+#endif
+  if ((!fb) || (!bitmap))
+  {
+    Serial.println("framebuffer allocation failed!");
+    while (true)
+    {
+      delay(1000);
+    }
+  }
+  for (uint32_t i = 0; i < FB_W * FB_H; ++i)
+  {
+    bitmap[i] = i;
+  }
+}
+
+void loop()
+{
+  uint32_t start, ref_us, kernel_us;
+
+  // full screen fill
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    ref_fill(fb, i, FB_W * FB_H);
+  }
+  ref_us = micros() - start;
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    gfx_fill_16bit(fb, i, FB_W * FB_H);
+  }
+  kernel_us = micros() - start;
+  printResult("Screen fill", ref_us, kernel_us, LOOP_COUNT * FB_W * FB_H);
+
+  // odd aligned horizontal lines
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    for (int y = 0; y < FB_H; ++y)
+    {
+      ref_fill(fb + (y * FB_W) + 3, y, FB_W - 7);
+    }
+  }
+  ref_us = micros() - start;
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    for (int y = 0; y < FB_H; ++y)
+    {
+      gfx_fill_16bit(fb + (y * FB_W) + 3, y, FB_W - 7);
+    }
+  }
+  kernel_us = micros() - start;
+  printResult("Horiz lines", ref_us, kernel_us, LOOP_COUNT * FB_H * (FB_W - 7));
+
+  // small rects, typical text background / icon size
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT * 40; ++i)
+  {
+    ref_fill_rect(fb + ((i % 200) * FB_W) + (i % 280), FB_W, 33, 17, i);
+  }
+  ref_us = micros() - start;
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT * 40; ++i)
+  {
+    gfx_fill_rect_16bit(fb + ((i % 200) * FB_W) + (i % 280), FB_W, 33, 17, i);
+  }
+  kernel_us = micros() - start;
+  printResult("Small rects (33x17)", ref_us, kernel_us, LOOP_COUNT * 40 * 33 * 17);
+
+  // bitmap blit, sub rectangle
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    ref_copy_rect(fb + (10 * FB_W) + 11, FB_W, bitmap, 199, 201);
+  }
+  ref_us = micros() - start;
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    gfx_copy_rect_16bit(fb + (10 * FB_W) + 11, FB_W, bitmap, 199, 199, 201);
+  }
+  kernel_us = micros() - start;
+  printResult("Bitmap blit (199x201)", ref_us, kernel_us, LOOP_COUNT * 199 * 201);
+
+  // bitmap blit, full screen
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    ref_copy_rect(fb, FB_W, bitmap, FB_W, FB_H);
+  }
+  ref_us = micros() - start;
+  start = micros();
+  for (int i = 0; i < LOOP_COUNT; ++i)
+  {
+    gfx_copy_rect_16bit(fb, FB_W, bitmap, FB_W, FB_W, FB_H);
+  }
+  kernel_us = micros() - start;
+  printResult("Bitmap blit (full)", ref_us, kernel_us, LOOP_COUNT * FB_W * FB_H);
+
+  Serial.println();
+  delay(5000);
+}
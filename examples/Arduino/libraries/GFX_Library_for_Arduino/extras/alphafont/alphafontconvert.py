@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""Convert a BDF, TTF or OTF font to a GFXalphaFont header for Arduino_GFX::setFont().
+
+BDF bitmaps are box filtered, draw the font oversample times the wanted size.
+TTF and OTF need freetype-py (pip install freetype-py) and use FreeType anti-aliasing.
+
+  alphafontconvert.py font.bdf --oversample 2 --name MyFont16 > MyFont16.h
+  alphafontconvert.py font.ttf --size 16 --bpp 8 > MyFont16.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+class Glyph:
+    def __init__(self, code, width, height, x_offset, y_offset, x_advance, coverage):
+        self.code = code
+        self.width = width
+        self.height = height
+        self.x_offset = x_offset  # from cursor to glyph left
+        self.y_offset = y_offset  # from baseline to glyph top, negative is above
+        self.x_advance = x_advance
+        self.coverage = coverage  # rows of 0.0 to 1.0
+
+
+def load_bdf(path, first, last, oversample):
+    glyphs = {}
+    line_height = 0
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        if line.startswith("FONTBOUNDINGBOX "):
+            line_height = int(line.split()[2])
+        elif line.startswith("STARTCHAR"):
+            code = -1
+            x_advance = 0
+            bbx = (0, 0, 0, 0)
+            for line in lines:
+                if line.startswith("ENCODING "):
+                    code = int(line.split()[1])
+                elif line.startswith("DWIDTH "):
+                    x_advance = int(line.split()[1])
+                elif line.startswith("BBX "):
+                    bbx = tuple(int(v) for v in line.split()[1:5])
+                elif line.startswith("BITMAP"):
+                    break
+            w, h, bx, by = bbx
+            rows = []
+            for line in lines:
+                if line.startswith("ENDCHAR"):
+                    break
+                bits = int(line, 16) if line else 0
+                nbits = len(line) * 4
+                rows.append([(bits >> (nbits - 1 - i)) & 1 for i in range(w)])
+            if first <= code <= last:
+                # BBX y offset is from baseline to glyph bottom
+                glyphs[code] = downsample(code, rows, w, h, bx, -(by + h), x_advance, oversample)
+    return glyphs, round(line_height / oversample)
+
+
+def downsample(code, rows, w, h, x_offset, y_offset, x_advance, s):
+    x0 = x_offset // s
+    y0 = y_offset // s
+    dw = -((-(x_offset + w)) // s) - x0 if w else 0
+    dh = -((-(y_offset + h)) // s) - y0 if h else 0
+    coverage = []
+    for j in range(dh):
+        row = []
+        for i in range(dw):
+            cnt = 0
+            for sy in range((y0 + j) * s - y_offset, (y0 + j + 1) * s - y_offset):
+                for sx in range((x0 + i) * s - x_offset, (x0 + i + 1) * s - x_offset):
+                    if 0 <= sy < h and 0 <= sx < w and rows[sy][sx]:
+                        cnt += 1
+            row.append(cnt / (s * s))
+        coverage.append(row)
+    return Glyph(code, dw, dh, x0, y0, round(x_advance / s), coverage)
+
+
+def load_freetype(path, first, last, size):
+    try:
+        import freetype
+    except ImportError:
+        sys.exit("TTF/OTF input needs freetype-py: pip install freetype-py")
+    face = freetype.Face(path)
+    face.set_pixel_sizes(0, size)
+    glyphs = {}
+    for code in range(first, last + 1):
+        if face.get_char_index(code) == 0:
+            continue
+        face.load_char(code, freetype.FT_LOAD_RENDER | freetype.FT_LOAD_TARGET_NORMAL)
+        g = face.glyph
+        bm = g.bitmap
+        coverage = [[bm.buffer[j * bm.pitch + i] / 255 for i in range(bm.width)] for j in range(bm.rows)]
+        glyphs[code] = Glyph(code, bm.width, bm.rows, g.bitmap_left, -g.bitmap_top, (g.advance.x + 32) >> 6, coverage)
+    return glyphs, (face.size.height + 32) >> 6
+
+
+def pack(glyph, bpp):
+    max_alpha = (1 << bpp) - 1
+    data = []
+    for row in glyph.coverage:
+        alpha = [int(c * max_alpha + 0.5) for c in row]
+        if bpp == 4:
+            alpha.append(0)
+            data.extend((alpha[i] << 4) | alpha[i + 1] for i in range(0, len(row), 2))
+        else:
+            data.extend(alpha)
+    return data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("font", help="BDF, TTF or OTF font file")
+    parser.add_argument("--first", type=lambda v: int(v, 0), default=0x20, help="first character code (default 0x20)")
+    parser.add_argument("--last", type=lambda v: int(v, 0), default=0x7E, help="last character code (default 0x7E)")
+    parser.add_argument("--bpp", type=int, choices=(4, 8), default=4, help="alpha bits per pixel (default 4)")
+    parser.add_argument("--oversample", type=int, default=2, help="BDF pixels per alpha pixel (default 2)")
+    parser.add_argument("--size", type=int, default=16, help="TTF/OTF pixel size (default 16)")
+    parser.add_argument("--name", help="font variable name (default from file name)")
+    args = parser.parse_args()
+
+    name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.font))[0])
+    if args.font.lower().endswith(".bdf"):
+        if not 1 <= args.oversample <= 8:
+            sys.exit("oversample should be 1 to 8")
+        glyphs, y_advance = load_bdf(args.font, args.first, args.last, args.oversample)
+    else:
+        glyphs, y_advance = load_freetype(args.font, args.first, args.last, args.size)
+
+    out = ["// Generated by alphafontconvert.py from %s, %d-bit alpha" % (os.path.basename(args.font), args.bpp), ""]
+    out.append("const uint8_t %sBitmaps[] PROGMEM = {" % name)
+    bitmap = []
+    table = []
+    for code in range(args.first, args.last + 1):
+        g = glyphs.get(code)
+        if g is None or g.width == 0:
+            table.append((len(bitmap), 0, 0, g.x_advance if g else 0, 0, 0, code))
+            continue
+        if g.width > 255 or g.height > 255:
+            sys.exit("glyph 0x%02X is larger than 255 pixels" % code)
+        table.append((len(bitmap), g.width, g.height, g.x_advance, g.x_offset, g.y_offset, code))
+        bitmap.extend(pack(g, args.bpp))
+    if len(bitmap) > 0xFFFF:
+        sys.exit("bitmap is %d bytes, more than 65535" % len(bitmap))
+    for i in range(0, len(bitmap), 16):
+        out.append("    " + ", ".join("0x%02X" % b for b in bitmap[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("const GFXglyph %sGlyphs[] PROGMEM = {" % name)
+    for offset, w, h, adv, xo, yo, code in table:
+        ch = chr(code) if 0x20 <= code < 0x7F and chr(code) not in "\\'" else ""
+        out.append(("    {%d, %d, %d, %d, %d, %d}, // 0x%02X %s" % (offset, w, h, adv, xo, yo, code, ch)).rstrip())
+    out.append("};")
+    out.append("")
+    out.append("const GFXalphaFont %s PROGMEM = {(uint8_t *)%sBitmaps, (GFXglyph *)%sGlyphs, 0x%02X, 0x%02X, %d, %d};"
+               % (name, name, name, args.first, args.last, y_advance, args.bpp))
+    out.append("")
+    out.append("// Approx. %d bytes" % (len(bitmap) + len(table) * 7 + 12))
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,78 @@
+#include "Arduino_Accel_Stub.h"
+
+Arduino_Accel_Stub::Arduino_Accel_Stub(uint32_t min_pixels)
+    : Arduino_Accel(min_pixels)
+{
+}
+
+void Arduino_Accel_Stub::setAvailable(bool available)
+{
+  _available = available;
+}
+
+bool Arduino_Accel_Stub::hwFill(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h,
+                                int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  // the engine rejects blocks outside the picture
+  if ((!_available) || (x < 0) || (y < 0) || ((x + w) > framebuffer_w) || ((y + h) > framebuffer_h))
+  {
+    return false;
+  }
+  for (int16_t j = 0; j < h; ++j)
+  {
+    uint16_t *row = framebuffer + ((int32_t)(y + j) * framebuffer_w) + x;
+    for (int16_t i = 0; i < w; ++i)
+    {
+      row[i] = color;
+    }
+  }
+  return true;
+}
+
+bool Arduino_Accel_Stub::hwBlit(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h, int16_t src_x, int16_t src_y, int16_t w, int16_t h,
+                                uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y,
+                                uint8_t quarter_turns, uint8_t scale_x16, uint8_t scale_y16)
+{
+  bool odd = quarter_turns & 1;
+  int16_t turned_w = odd ? h : w;
+  int16_t turned_h = odd ? w : h;
+  int16_t out_w = (int32_t)turned_w * scale_x16 / 16;
+  int16_t out_h = (int32_t)turned_h * scale_y16 / 16;
+  if ((!_available) || (src_x < 0) || (src_y < 0) || ((src_x + w) > bitmap_w) || ((src_y + h) > bitmap_h) ||
+      (x < 0) || (y < 0) || ((x + out_w) > framebuffer_w) || ((y + out_h) > framebuffer_h))
+  {
+    return false;
+  }
+
+  // nearest neighbour at the pixel center, like the CPU kernel: output pixel (u, v) of the turned block back to the source block (i, j)
+  for (int16_t v = 0; v < out_h; ++v)
+  {
+    int16_t tv = ((int32_t)v * 2 + 1) * 16 / (scale_y16 * 2);
+    uint16_t *row = framebuffer + ((int32_t)(y + v) * framebuffer_w) + x;
+    for (int16_t u = 0; u < out_w; ++u)
+    {
+      int16_t tu = ((int32_t)u * 2 + 1) * 16 / (scale_x16 * 2);
+      int16_t i, j;
+      switch (quarter_turns & 3)
+      {
+      case 1: // counterclockwise, source column i ends up in row w - 1 - i
+        i = w - 1 - tv;
+        j = tu;
+        break;
+      case 2:
+        i = w - 1 - tu;
+        j = h - 1 - tv;
+        break;
+      case 3:
+        i = tv;
+        j = h - 1 - tu;
+        break;
+      default: // case 0:
+        i = tu;
+        j = tv;
+      }
+      row[u] = bitmap[((int32_t)(src_y + j) * bitmap_w) + src_x + i];
+    }
+  }
+  return true;
+}
@@ -0,0 +1,25 @@
+#ifndef _ARDUINO_ACCEL_STUB_H_
+#define _ARDUINO_ACCEL_STUB_H_
+
+#include "Arduino_Accel.h"
+
+/// Arduino_Accel with the engine emulated on the CPU, for host builds: exercises the dispatch, clipping and
+/// rotation mapping that the ESP32-P4 PPA backend shares, with the engine switched off by setAvailable(false).
+class Arduino_Accel_Stub : public Arduino_Accel
+{
+public:
+  Arduino_Accel_Stub(uint32_t min_pixels = ACCEL_MIN_PIXELS);
+
+  void setAvailable(bool available);
+
+protected:
+  bool hwFill(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h,
+              int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  bool hwBlit(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h, int16_t src_x, int16_t src_y, int16_t w, int16_t h,
+              uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y,
+              uint8_t quarter_turns, uint8_t scale_x16, uint8_t scale_y16) override;
+
+  bool _available = true;
+};
+
+#endif // _ARDUINO_ACCEL_STUB_H_
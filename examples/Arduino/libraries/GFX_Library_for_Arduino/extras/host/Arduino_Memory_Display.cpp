@@ -0,0 +1,192 @@
+#include "Arduino_Memory_Display.h"
+
+Arduino_Memory_Display::Arduino_Memory_Display(int16_t w, int16_t h)
+    : Arduino_G(w, h)
+{
+}
+
+Arduino_Memory_Display::~Arduino_Memory_Display()
+{
+  if (_framebuffer)
+  {
+    free(_framebuffer);
+  }
+}
+
+bool Arduino_Memory_Display::begin(int32_t speed)
+{
+  UNUSED(speed);
+
+  if (!_framebuffer)
+  {
+    _framebuffer = (uint16_t *)calloc(WIDTH * HEIGHT, 2);
+    if (!_framebuffer)
+    {
+      return false;
+    }
+  }
+  resetCounters();
+
+  return true;
+}
+
+void Arduino_Memory_Display::setPixel(int16_t x, int16_t y, uint16_t color)
+{
+  if ((x >= 0) && (y >= 0) && (x < WIDTH) && (y < HEIGHT))
+  {
+    _framebuffer[(int32_t)y * WIDTH + x] = color;
+  }
+}
+
+void Arduino_Memory_Display::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+  int16_t byteWidth = (w + 7) / 8;
+  uint8_t b = 0;
+  ++_call_count;
+  _pixel_count += w * h;
+  for (int16_t j = 0; j < h; j++)
+  {
+    for (int16_t i = 0; i < w; i++)
+    {
+      if (i & 7)
+      {
+        b <<= 1;
+      }
+      else
+      {
+        b = bitmap[j * byteWidth + i / 8];
+      }
+      setPixel(x + i, y + j, (b & 0x80) ? color : bg);
+    }
+  }
+}
+
+void Arduino_Memory_Display::drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip)
+{
+  ++_call_count;
+  _pixel_count += w * h;
+  for (int16_t j = 0; j < h; j++)
+  {
+    for (int16_t i = 0; i < w; i++)
+    {
+      setPixel(x + i, y + j, color_index[*bitmap++]);
+    }
+    bitmap += x_skip;
+  }
+}
+
+void Arduino_Memory_Display::draw3bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h)
+{
+  int32_t offset = 0;
+  uint8_t c = 0;
+  ++_call_count;
+  _pixel_count += w * h;
+  for (int16_t j = 0; j < h; j++)
+  {
+    for (int16_t i = 0; i < w; i++)
+    {
+      if (offset & 1)
+      {
+        c <<= 3;
+      }
+      else
+      {
+        c = bitmap[offset >> 1];
+      }
+      setPixel(x + i, y + j,
+               ((c & 0b100000) ? 0xF800 : 0) |
+                   ((c & 0b010000) ? 0x07E0 : 0) |
+                   ((c & 0b001000) ? 0x001F : 0));
+      offset++;
+    }
+  }
+}
+
+void Arduino_Memory_Display::draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+  ++_call_count;
+  _pixel_count += w * h;
+  if ((x == 0) && (w == WIDTH) && (y >= 0) && ((y + h) <= HEIGHT))
+  {
+    memcpy(_framebuffer + ((int32_t)y * WIDTH), bitmap, (size_t)w * h * 2);
+  }
+  else
+  {
+    for (int16_t j = 0; j < h; j++)
+    {
+      for (int16_t i = 0; i < w; i++)
+      {
+        setPixel(x + i, y + j, *bitmap++);
+      }
+    }
+  }
+}
+
+void Arduino_Memory_Display::draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h)
+{
+  ++_call_count;
+  _pixel_count += w * h;
+  for (int16_t j = 0; j < h; j++)
+  {
+    for (int16_t i = 0; i < w; i++)
+    {
+      setPixel(x + i, y + j, ((bitmap[0] & 0xF8) << 8) | ((bitmap[1] & 0xFC) << 3) | (bitmap[2] >> 3));
+      bitmap += 3;
+    }
+  }
+}
+
+uint16_t *Arduino_Memory_Display::getFramebuffer()
+{
+  return _framebuffer;
+}
+
+int16_t Arduino_Memory_Display::width()
+{
+  return WIDTH;
+}
+
+int16_t Arduino_Memory_Display::height()
+{
+  return HEIGHT;
+}
+
+bool Arduino_Memory_Display::savePPM(const char *filename)
+{
+  FILE *f = fopen(filename, "wb");
+  if (!f)
+  {
+    return false;
+  }
+
+  fprintf(f, "P6\n%d %d\n255\n", WIDTH, HEIGHT);
+  uint8_t rgb[3];
+  uint16_t *p = _framebuffer;
+  for (int32_t i = (int32_t)WIDTH * HEIGHT; i > 0; --i)
+  {
+    uint16_t c = *p++;
+    // expand 5/6/5 to 8 bits, replicate high bits into low bits
+    rgb[0] = ((c >> 8) & 0xF8) | (c >> 13);
+    rgb[1] = ((c >> 3) & 0xFC) | ((c >> 9) & 0x03);
+    rgb[2] = ((c << 3) & 0xF8) | ((c >> 2) & 0x07);
+    fwrite(rgb, 1, 3, f);
+  }
+
+  return fclose(f) == 0;
+}
+
+uint32_t Arduino_Memory_Display::getPixelCount()
+{
+  return _pixel_count;
+}
+
+uint32_t Arduino_Memory_Display::getCallCount()
+{
+  return _call_count;
+}
+
+void Arduino_Memory_Display::resetCounters()
+{
+  _pixel_count = 0;
+  _call_count = 0;
+}
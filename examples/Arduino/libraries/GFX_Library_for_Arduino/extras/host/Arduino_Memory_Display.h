@@ -0,0 +1,38 @@
+#ifndef _ARDUINO_MEMORY_DISPLAY_H_
+#define _ARDUINO_MEMORY_DISPLAY_H_
+
+#include "Arduino_G.h"
+
+/// Arduino_G output backed by an in-memory RGB565 surface, for host builds and benchmarks.
+class Arduino_Memory_Display : public Arduino_G
+{
+public:
+  Arduino_Memory_Display(int16_t w, int16_t h);
+  ~Arduino_Memory_Display();
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg) override;
+  void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip = 0) override;
+  void draw3bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) override;
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) override;
+
+  uint16_t *getFramebuffer();
+  int16_t width();
+  int16_t height();
+  bool savePPM(const char *filename);
+
+  // pixels and draw calls received since begin() or resetCounters()
+  uint32_t getPixelCount();
+  uint32_t getCallCount();
+  void resetCounters();
+
+protected:
+  void setPixel(int16_t x, int16_t y, uint16_t color);
+
+  uint16_t *_framebuffer = nullptr;
+  uint32_t _pixel_count = 0;
+  uint32_t _call_count = 0;
+};
+
+#endif // _ARDUINO_MEMORY_DISPLAY_H_
@@ -0,0 +1,86 @@
+/*
+ * Host check of Arduino_Canvas_DisplayList rotated after begin().
+ *
+ * setRotation() swaps the width and height, the bands and tiles must be sized again:
+ * a tall canvas turned wide has more tiles per band and rows of a different length.
+ * Each rotation draws the same scene on the display list and on an Arduino_Canvas of the rotated size,
+ * the flushed images must be equal, and a flush() right after a rotation must send the whole screen.
+ *
+ * usage: display_list_check, exits with 1 on any error
+ */
+#include "Arduino_GFX.h"
+#include "canvas/Arduino_Canvas.h"
+#include "canvas/Arduino_Canvas_DisplayList.h"
+#include "Arduino_Memory_Display.h"
+
+#define CHECK_W 40
+#define CHECK_H 600
+
+static int errors = 0;
+
+static void check(bool ok, const char *what, uint8_t r)
+{
+  if (!ok)
+  {
+    printf("%s failed, rotation %u\n", what, r);
+    ++errors;
+  }
+}
+
+static void drawScene(Arduino_GFX *gfx, uint8_t r)
+{
+  int16_t w = gfx->width();
+  int16_t h = gfx->height();
+  gfx->fillScreen(RGB565_NAVY);
+  gfx->fillRect(0, 0, 8, 8, RGB565_RED);
+  gfx->fillRect(w - 8, h - 8, 8, 8, RGB565_GREEN);
+  gfx->drawLine(0, 0, w - 1, h - 1, RGB565_WHITE);
+  gfx->drawFastHLine(0, h / 2, w, RGB565_YELLOW);
+  gfx->setCursor(2, 12);
+  gfx->setTextColor(RGB565_WHITE);
+  gfx->print("rotation ");
+  gfx->print(r);
+}
+
+int main()
+{
+  Arduino_Memory_Display *out = new Arduino_Memory_Display(CHECK_H, CHECK_H);
+  Arduino_Memory_Display *ref_out = new Arduino_Memory_Display(CHECK_H, CHECK_H);
+  Arduino_Canvas_DisplayList *display_list = new Arduino_Canvas_DisplayList(CHECK_W, CHECK_H, out);
+  Arduino_Canvas *portrait = new Arduino_Canvas(CHECK_W, CHECK_H, ref_out);
+  Arduino_Canvas *landscape = new Arduino_Canvas(CHECK_H, CHECK_W, ref_out);
+  if ((!display_list->begin()) || (!ref_out->begin()) || (!portrait->begin(GFX_SKIP_OUTPUT_BEGIN)) || (!landscape->begin(GFX_SKIP_OUTPUT_BEGIN)))
+  {
+    printf("begin failed\n");
+    return 1;
+  }
+  display_list->flush();
+
+  static const uint8_t rotations[] = {1, 0, 3, 2, 1};
+  for (uint8_t r : rotations)
+  {
+    display_list->setRotation(r);
+    Arduino_Canvas *ref = (r & 1) ? landscape : portrait;
+    check((display_list->width() == ref->width()) && (display_list->height() == ref->height()), "size", r);
+
+    // nothing drawn since the rotation, the whole screen is sent
+    out->resetCounters();
+    display_list->flush();
+    check(out->getPixelCount() == (uint32_t)display_list->width() * display_list->height(), "flush after setRotation", r);
+
+    drawScene(display_list, r);
+    display_list->flush();
+    drawScene(ref, r);
+    ref->flush();
+    check(!memcmp(out->getFramebuffer(), ref_out->getFramebuffer(), (size_t)CHECK_H * CHECK_H * 2), "image", r);
+  }
+
+  delete landscape;
+  delete portrait;
+  delete display_list;
+  delete ref_out;
+  delete out;
+
+  printf("display_list_check: %d errors\n", errors);
+  return errors ? 1 : 0;
+}
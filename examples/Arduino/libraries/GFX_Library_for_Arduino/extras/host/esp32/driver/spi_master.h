@@ -0,0 +1,104 @@
+/*
+ * The part of the ESP-IDF SPI master driver API used by Arduino_ESP32SPIDMA and Arduino_ESP32QSPI,
+ * implemented by spi_master_mock.cpp.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_ERROR_CHECK(x) (void)(x)
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY 0xffffffff
+
+#define MALLOC_CAP_DMA (1 << 3)
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps);
+
+int spiFrequencyToClockDiv(int freq);
+
+typedef int spi_host_device_t;
+#define SPI2_HOST 1
+
+#define SPI_DMA_CH_AUTO 3
+#define SPICOMMON_BUSFLAG_MASTER (1 << 0)
+#define SPICOMMON_BUSFLAG_GPIO_PINS (1 << 1)
+#define ESP_INTR_CPU_AFFINITY_AUTO 0
+#define SPI_CLK_SRC_DEFAULT 0
+
+#define SPI_DEVICE_NO_DUMMY (1 << 2)
+#define SPI_DEVICE_HALFDUPLEX (1 << 4)
+
+#define SPI_TRANS_USE_TXDATA (1 << 3)
+#define SPI_TRANS_MODE_QIO (1 << 4)
+#define SPI_TRANS_MULTILINE_CMD (1 << 5)
+#define SPI_TRANS_MULTILINE_ADDR (1 << 6)
+#define SPI_TRANS_VARIABLE_CMD (1 << 7)
+#define SPI_TRANS_VARIABLE_ADDR (1 << 8)
+#define SPI_TRANS_VARIABLE_DUMMY (1 << 9)
+
+typedef struct
+{
+  int mosi_io_num, miso_io_num, sclk_io_num, quadwp_io_num, quadhd_io_num;
+  int data4_io_num, data5_io_num, data6_io_num, data7_io_num;
+  int max_transfer_sz;
+  uint32_t flags;
+  int isr_cpu_id;
+  int intr_flags;
+} spi_bus_config_t;
+
+typedef struct spi_transaction_t
+{
+  uint32_t flags;
+  uint16_t cmd;
+  uint64_t addr;
+  size_t length;
+  size_t rxlength;
+  void *user;
+  union
+  {
+    const void *tx_buffer;
+    uint8_t tx_data[4];
+  };
+  union
+  {
+    void *rx_buffer;
+    uint8_t rx_data[4];
+  };
+} spi_transaction_t;
+
+typedef struct
+{
+  spi_transaction_t base;
+  uint8_t command_bits, address_bits, dummy_bits;
+} spi_transaction_ext_t;
+
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+
+typedef struct
+{
+  uint8_t command_bits, address_bits, dummy_bits, mode;
+  int clock_source;
+  uint16_t duty_cycle_pos, cs_ena_pretrans;
+  uint8_t cs_ena_posttrans;
+  int clock_speed_hz;
+  int input_delay_ns;
+  int spics_io_num;
+  uint32_t flags;
+  int queue_size;
+  transaction_cb_t pre_cb;
+  transaction_cb_t post_cb;
+} spi_device_interface_config_t;
+
+typedef struct spi_device_t *spi_device_handle_t;
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config, spi_device_handle_t *handle);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t handle, TickType_t wait);
+void spi_device_release_bus(spi_device_handle_t handle);
+esp_err_t spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait);
+esp_err_t spi_device_polling_end(spi_device_handle_t handle, TickType_t wait);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t wait);
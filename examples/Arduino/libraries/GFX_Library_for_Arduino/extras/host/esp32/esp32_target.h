@@ -0,0 +1,27 @@
+/*
+ * Forced include of the ESP32 databus checks: an ESP32-C3 with Arduino-ESP32 3.x,
+ * built against the host Arduino shim and the mock ESP-IDF drivers of this directory.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define ESP_ARDUINO_VERSION_MAJOR 3
+#define CONFIG_IDF_TARGET_ESP32C3 1
+
+#define FSPI 0
+#define SCK 1
+#define MISO 2
+#define MOSI 3
+#define SS 4
+#define SPI_MSBFIRST 0
+
+// DC and CS writes land in plain variables
+extern uint32_t esp32_mock_gpio_set, esp32_mock_gpio_clr;
+#define GPIO_OUT_W1TS_REG (&esp32_mock_gpio_set)
+#define GPIO_OUT_W1TC_REG (&esp32_mock_gpio_clr)
+#define digitalPinToBitMask(p) (1u << (p))
+
+#define IRAM_ATTR
+#define log_e(...) printf(__VA_ARGS__)
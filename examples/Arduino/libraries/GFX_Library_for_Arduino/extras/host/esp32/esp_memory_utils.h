@@ -0,0 +1,5 @@
+#pragma once
+
+extern bool spi_mock_dma_capable;
+
+inline bool esp_ptr_dma_capable(const void *) { return spi_mock_dma_capable; }
@@ -0,0 +1,152 @@
+#include "spi_master_mock.h"
+
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+uint32_t esp32_mock_gpio_set, esp32_mock_gpio_clr;
+
+std::vector<uint8_t> spi_mock_wire;
+uint64_t spi_mock_wire_bits = 0;
+int spi_mock_errors = 0;
+bool spi_mock_dma_capable = false;
+
+struct spi_device_t
+{
+  int queue_size;
+  transaction_cb_t post_cb;
+};
+
+typedef struct
+{
+  spi_device_handle_t device;
+  spi_transaction_t *t;
+  std::vector<uint8_t> data; // tx data when the transaction was started
+} mock_trans_t;
+
+static std::deque<mock_trans_t> queued;
+static bool polling = false;
+static mock_trans_t polled;
+
+static void error(const char *msg)
+{
+  printf("spi mock: %s\n", msg);
+  ++spi_mock_errors;
+}
+
+static const uint8_t *tx_data(const spi_transaction_t *t)
+{
+  return (t->flags & SPI_TRANS_USE_TXDATA) ? t->tx_data : (const uint8_t *)t->tx_buffer;
+}
+
+static mock_trans_t start(spi_device_handle_t device, spi_transaction_t *t)
+{
+  mock_trans_t m;
+  m.device = device;
+  m.t = t;
+  m.data.assign(tx_data(t), tx_data(t) + ((t->length + 7) / 8));
+  return m;
+}
+
+static void send(const mock_trans_t &m)
+{
+  if (m.data.size() && memcmp(tx_data(m.t), m.data.data(), m.data.size())) // command only transactions have no buffer
+  {
+    error("buffer changed in flight");
+  }
+  spi_mock_wire.insert(spi_mock_wire.end(), m.data.begin(), m.data.end());
+  spi_mock_wire_bits += m.t->length;
+  if (m.device->post_cb)
+  {
+    m.device->post_cb(m.t);
+  }
+}
+
+size_t spi_mock_queued()
+{
+  return queued.size();
+}
+
+void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t)
+{
+  return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+int spiFrequencyToClockDiv(int)
+{
+  return 1;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t, const spi_bus_config_t *, int)
+{
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t, const spi_device_interface_config_t *config, spi_device_handle_t *handle)
+{
+  *handle = new spi_device_t{config->queue_size, config->post_cb}; // lives as long as the check
+  return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t, TickType_t)
+{
+  return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t)
+{
+}
+
+esp_err_t spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t)
+{
+  if (polling || (!queued.empty()))
+  {
+    error("polling while a transaction is pending");
+  }
+  polling = true;
+  polled = start(handle, trans);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_polling_end(spi_device_handle_t, TickType_t)
+{
+  if (!polling)
+  {
+    error("polling_end without polling_start");
+    return 1;
+  }
+  send(polled);
+  polling = false;
+  return ESP_OK;
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t)
+{
+  if (polling || ((int)queued.size() >= handle->queue_size))
+  {
+    error("queue_trans while polling or with a full queue");
+  }
+  for (const mock_trans_t &m : queued)
+  {
+    if (m.t == trans)
+    {
+      error("queued transaction reused");
+    }
+  }
+  queued.push_back(start(handle, trans));
+  return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t, spi_transaction_t **trans, TickType_t)
+{
+  if (queued.empty())
+  {
+    error("get_trans_result with nothing queued"); // blocks forever on a real driver
+    return 1;
+  }
+  send(queued.front());
+  *trans = queued.front().t;
+  queued.pop_front();
+  return ESP_OK;
+}
@@ -0,0 +1,19 @@
+/*
+ * Mock of the ESP-IDF SPI master driver for host checks of the ESP32 SPI databuses.
+ * A queued transaction is sent when its result is fetched, a polling one at spi_device_polling_end(),
+ * the device post_cb is called after each. What a real driver would silently get wrong is counted in spi_mock_errors:
+ * polling while transactions are queued, queueing more than queue_size or while polling,
+ * reusing a queued transaction and changing a buffer while its transaction is in flight.
+ */
+#pragma once
+
+#include "driver/spi_master.h"
+
+#include <vector>
+
+extern std::vector<uint8_t> spi_mock_wire; // bytes sent, in order
+extern uint64_t spi_mock_wire_bits;
+extern int spi_mock_errors;
+extern bool spi_mock_dma_capable; // esp_ptr_dma_capable() result
+
+size_t spi_mock_queued();
@@ -0,0 +1,278 @@
+/*
+ * Host check of the ESP32 SPI databuses over the mock SPI master driver in esp32/.
+ *
+ * Compares the bytes on the wire with what was written, and relies on the mock to catch
+ * queued transactions out of order: polling before the queue is drained (QUEUE_END),
+ * more transactions in flight than the queue holds (QUEUE_WAIT), a transaction or its buffer
+ * reused while still queued (QUEUE_START) and transactions left queued after endWrite().
+ * Async writes must call back once, after the last byte, and a later command must wait for them.
+ *
+ * usage: esp32_spi_check, exits with 1 on any error
+ */
+#include "databus/Arduino_ESP32QSPI.h"
+#include "databus/Arduino_ESP32SPIDMA.h"
+#include "spi_master_mock.h"
+
+static int errors = 0;
+static int cb_count;
+static size_t cb_wire_size; // bytes on the wire when the callback ran
+static uint32_t cb_cs_set;  // CS mask raised before the callback ran
+
+static void count_cb(void *)
+{
+  ++cb_count;
+  cb_wire_size = spi_mock_wire.size();
+  cb_cs_set = esp32_mock_gpio_set;
+}
+
+static void check(bool ok, const char *what, uint32_t len)
+{
+  if (!ok)
+  {
+    printf("%s failed, len %u\n", what, len);
+    ++errors;
+  }
+}
+
+static void push16(std::vector<uint8_t> &v, uint16_t p)
+{
+  v.push_back(p >> 8);
+  v.push_back(p & 0xff);
+}
+
+// the wire holds exactly the expected bytes and nothing is left queued
+static void checkWire(const std::vector<uint8_t> &expected, const char *what, uint32_t len)
+{
+  check((spi_mock_wire == expected) && (spi_mock_queued() == 0), what, len);
+  spi_mock_wire.clear();
+  spi_mock_wire_bits = 0;
+}
+
+// pixel writes split into ping-pong chunks of ESP32SPIDMA_MAX_PIXELS_AT_ONCE, lengths around the chunk size
+static void checkPixelWrites(Arduino_ESP32SPIDMA *bus)
+{
+  static const uint32_t lens[] = {1, 2, 3, 1023, 1024, 1025, 2048, 3001, 20000};
+  uint16_t palette[256];
+  for (int i = 0; i < 256; ++i)
+  {
+    palette[i] = i * 257 + 3;
+  }
+
+  for (uint32_t len : lens)
+  {
+    std::vector<uint16_t> px(len);
+    std::vector<uint8_t> idx(len);
+    std::vector<uint8_t> e, e_repeat, e_indexed, e_double;
+    for (uint32_t i = 0; i < len; ++i)
+    {
+      px[i] = (uint16_t)((i * 2654435761u) >> 7);
+      idx[i] = i * 7;
+      push16(e, px[i]);
+      push16(e_repeat, 0x1234);
+      push16(e_indexed, palette[idx[i]]);
+      push16(e_double, palette[idx[i]]);
+      push16(e_double, palette[idx[i]]);
+    }
+    std::vector<uint16_t> src = px;
+
+    bus->beginWrite();
+    bus->writePixels(src.data(), len);
+    bus->endWrite();
+    checkWire(e, "writePixels", len);
+
+    bus->beginWrite();
+    bus->writeRepeat(0x1234, len);
+    bus->endWrite();
+    checkWire(e_repeat, "writeRepeat", len);
+
+    bus->beginWrite();
+    bus->writeIndexedPixels(idx.data(), palette, len);
+    bus->endWrite();
+    checkWire(e_indexed, "writeIndexedPixels", len);
+
+    bus->beginWrite();
+    bus->writeIndexedPixelsDouble(idx.data(), palette, len);
+    bus->endWrite();
+    checkWire(e_double, "writeIndexedPixelsDouble", len);
+
+    // polling commands between queued pixel chunks
+    std::vector<uint8_t> e_mixed = {0x2a, 0x00, 0x01, 0x00, 0x02};
+    e_mixed.insert(e_mixed.end(), e.begin(), e.end());
+    e_mixed.push_back(0x2c);
+    e_mixed.insert(e_mixed.end(), e_repeat.begin(), e_repeat.end());
+    bus->beginWrite();
+    bus->writeC8D16D16(0x2a, 1, 2);
+    bus->writePixels(src.data(), len);
+    bus->writeCommand(0x2c);
+    bus->writeRepeat(0x1234, len);
+    bus->endWrite();
+    checkWire(e_mixed, "commands between pixel writes", len);
+  }
+}
+
+static std::vector<uint8_t> makeBytes(uint32_t len)
+{
+  std::vector<uint8_t> b(len);
+  for (uint32_t i = 0; i < len; ++i)
+  {
+    b[i] = i * 31 + (i >> 8);
+  }
+  return b;
+}
+
+// DMA-capable writeBytes() data is queued in place in ESP32SPIDMA_MAX_DMA_BYTES chunks, other data is copied through the ping-pong buffers
+static void checkByteWrites(Arduino_ESP32SPIDMA *bus)
+{
+  static const uint32_t lens[] = {1, 3, 2047, 2048, 2049, 32768, 40000, 70001};
+  for (uint32_t len : lens)
+  {
+    std::vector<uint8_t> b = makeBytes(len);
+    for (int dma = 0; dma < 2; ++dma)
+    {
+      spi_mock_dma_capable = dma;
+
+      bus->beginWrite();
+      bus->writeBytes(b.data(), len);
+      bus->endWrite();
+      checkWire(b, "writeBytes", len);
+
+      // the callback runs once the last byte is sent, a command after the async write waits for it
+      std::vector<uint8_t> e = {0x2a, 0x00, 0x01, 0x00, 0x02};
+      size_t header = e.size();
+      e.insert(e.end(), b.begin(), b.end());
+      e.push_back(0x2c);
+      cb_count = 0;
+      bus->beginWrite();
+      bus->writeC8D16D16(0x2a, 1, 2);
+      bus->writeBytesAsync(b.data(), len, count_cb, nullptr);
+      if (dma && (len > 2 * ESP32SPIDMA_MAX_DMA_BYTES))
+      {
+        check(cb_count == 0, "writeBytesAsync returns before the end", len);
+      }
+      bus->writeCommand(0x2c);
+      bus->endWrite();
+      check((cb_count == 1) && (cb_wire_size == header + len), "writeBytesAsync callback", len);
+      checkWire(e, "writeBytesAsync", len);
+
+      cb_count = 0;
+      bus->beginWrite();
+      bus->writeBytesAsync(b.data(), len, count_cb, nullptr);
+      bus->waitWriteDone();
+      check((cb_count == 1) && (spi_mock_queued() == 0), "waitWriteDone", len);
+      bus->endWrite();
+      checkWire(b, "writeBytesAsync then waitWriteDone", len);
+    }
+  }
+  spi_mock_dma_capable = false;
+}
+
+// pixel async writes copy the pixels before returning and finish in sending order
+static void checkPixelAsync(Arduino_DataBus *bus, uint32_t chunk_pixels, const char *what)
+{
+  static const uint32_t lens[] = {1, 3, 1024, 1025, 5000};
+  for (uint32_t len : lens)
+  {
+    std::vector<uint16_t> px(len);
+    std::vector<uint8_t> e;
+    for (uint32_t i = 0; i < len; ++i)
+    {
+      px[i] = (uint16_t)(i * 40503u + 11);
+      push16(e, px[i]);
+    }
+    for (uint32_t i = 0; i < len; ++i)
+    {
+      push16(e, 0x5a5a);
+    }
+    std::vector<uint16_t> src = px;
+
+    cb_count = 0;
+    bus->beginWrite();
+    gfx_transfer_t t1 = bus->writePixelsAsync(src.data(), len, count_cb, nullptr);
+    std::fill(src.begin(), src.end(), 0); // the caller buffer is free on return
+    gfx_transfer_t t2 = bus->writeRepeatAsync(0x5a5a, len, count_cb, nullptr);
+    check((t1 != 0) && (t2 > t1), what, len);
+    if (len > 2 * chunk_pixels)
+    {
+      check(!bus->isTransferDone(t2), what, len);
+    }
+    bus->waitTransfer(t2);
+    check(bus->isTransferDone(t1) && bus->isTransferDone(t2) && (cb_count == 2), what, len);
+    bus->endWrite();
+    checkWire(e, what, len);
+
+    // nothing to send is done at once
+    gfx_transfer_t t0 = bus->writePixelsAsync(src.data(), 0, count_cb, nullptr);
+    check(bus->isTransferDone(t0) && (cb_count == 3), what, 0);
+  }
+}
+
+// 9-bit SPI sends a DC bit before each byte
+static void check9Bit()
+{
+  Arduino_ESP32SPIDMA bus(GFX_NOT_DEFINED, 11, 12, 13, -1);
+  bus.begin();
+  spi_mock_wire.clear();
+  spi_mock_wire_bits = 0;
+
+  bus.beginWrite();
+  bus.writeRepeat(0xabcd, 100);
+  bus.endWrite();
+  check((spi_mock_wire_bits == 100 * 18) && (spi_mock_queued() == 0), "9-bit writeRepeat", 100);
+}
+
+// QSPI sends the data after the command and address phases, writeBytesAsync() raises CS from post_cb of the last chunk
+static void checkQSPI()
+{
+  const int8_t cs = 5;
+  Arduino_ESP32QSPI bus(cs, 1, 2, 3, 4, 6);
+  bus.begin();
+  spi_mock_wire.clear();
+
+  static const uint32_t lens[] = {1, 100, 32768, 32769, 100000};
+  for (uint32_t len : lens)
+  {
+    std::vector<uint8_t> b = makeBytes(len);
+    for (int dma = 0; dma < 2; ++dma)
+    {
+      spi_mock_dma_capable = dma;
+
+      bus.beginWrite();
+      bus.writeBytes(b.data(), len);
+      bus.endWrite();
+      checkWire(b, "QSPI writeBytes", len);
+
+      cb_count = 0;
+      esp32_mock_gpio_set = 0;
+      bus.beginWrite();
+      bus.writeBytesAsync(b.data(), len, count_cb, nullptr);
+      if (dma && (len > 2 * ESP32QSPI_MAX_DMA_BYTES))
+      {
+        check(cb_count == 0, "QSPI writeBytesAsync returns before the end", len);
+      }
+      bus.writeCommand(0x2c);
+      bus.endWrite();
+      check((cb_count == 1) && (cb_wire_size == len) && (cb_cs_set == (1u << cs)), "QSPI writeBytesAsync callback after CS high", len);
+      checkWire(b, "QSPI writeBytesAsync", len);
+    }
+  }
+  spi_mock_dma_capable = false;
+
+  checkPixelAsync(&bus, ESP32QSPI_MAX_PIXELS_AT_ONCE, "QSPI pixel async");
+}
+
+int main()
+{
+  Arduino_ESP32SPIDMA bus(10, 11, 12, 13, -1);
+  bus.begin();
+  spi_mock_wire.clear();
+
+  checkPixelWrites(&bus);
+  checkByteWrites(&bus);
+  checkPixelAsync(&bus, ESP32SPIDMA_MAX_PIXELS_AT_ONCE, "pixel async");
+  check9Bit();
+  checkQSPI();
+
+  errors += spi_mock_errors;
+  printf("esp32_spi_check: %d errors\n", errors);
+  return errors ? 1 : 0;
+}
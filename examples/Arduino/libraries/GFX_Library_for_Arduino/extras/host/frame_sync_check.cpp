@@ -0,0 +1,129 @@
+/*
+ * Host check of Arduino_FrameSync with a thread calling notifyVSync() at a fixed period, like the TE pin of a panel.
+ *
+ * waitForVSync() must give up without a sync signal and count a timeout, return once per refresh,
+ * and with setFrameInterval(2) present every second refresh. Frames drawn for longer than a refresh
+ * are counted as missed refreshes and fps follows the presented frames.
+ * The checks hold on a busy host, where either thread may run late. Built with FRAME_SYNC_FPS_WINDOW_MS 200.
+ *
+ * usage: frame_sync_check, exits with 1 on any error
+ */
+#include "Arduino_FrameSync.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define VSYNC_PERIOD_US 5000 // 200 Hz
+#define CHECK_FRAMES 100
+
+static int errors = 0;
+static std::atomic<bool> vsync_running;
+
+static void check(bool ok, const char *phase, const char *what, uint32_t value)
+{
+  if (!ok)
+  {
+    printf("%s: %s failed, %u\n", phase, what, value);
+    ++errors;
+  }
+}
+
+static void vsyncThread(Arduino_FrameSync *frame_sync)
+{
+  auto next = std::chrono::steady_clock::now();
+  while (vsync_running)
+  {
+    next += std::chrono::microseconds(VSYNC_PERIOD_US);
+    std::this_thread::sleep_until(next);
+    frame_sync->notifyVSync();
+  }
+}
+
+/*
+ * Wait and present CHECK_FRAMES frames, each drawn for draw_us, from a reset, and check the stats.
+ * The refresh a frame is presented at is between the refresh count before waitForVSync() (exclusive) and the one
+ * after framePresented(), which bounds missed and the refreshes between frames however late the threads run.
+ * fps must equal the frames over the last full window of the present times.
+ */
+static void presentFrames(Arduino_FrameSync *frame_sync, uint8_t interval, uint32_t draw_us, const char *phase)
+{
+  uint32_t before[CHECK_FRAMES], after[CHECK_FRAMES], present_us[CHECK_FRAMES];
+  frame_sync->resetStats();
+  frame_sync->setFrameInterval(interval);
+  for (int i = 0; i < CHECK_FRAMES; ++i)
+  {
+    before[i] = frame_sync->getVSyncCount();
+    bool ok = frame_sync->waitForVSync();
+    check(ok && (frame_sync->getVSyncCount() != before[i]), phase, "waitForVSync returns at a new refresh", i);
+    if (draw_us)
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(draw_us));
+    }
+    frame_sync->framePresented();
+    after[i] = frame_sync->getVSyncCount();
+    present_us[i] = micros();
+  }
+
+  const frame_sync_stats_t *stats = frame_sync->getStats();
+  check(stats->frames == CHECK_FRAMES, phase, "frames", stats->frames);
+  check(stats->timeouts == 0, phase, "timeouts", stats->timeouts);
+
+  // presented at refreshes p[i] with before[i] < p[i] <= after[i], p[i + 1] - p[i] >= interval
+  int32_t span_min = (int32_t)(before[CHECK_FRAMES - 1] + 1 - after[0]);
+  int32_t span_max = (int32_t)(after[CHECK_FRAMES - 1] - before[0] - 1);
+  int32_t paced = (CHECK_FRAMES - 1) * interval;
+  check(((int32_t)stats->missed >= (span_min - paced)) && ((int32_t)stats->missed <= (span_max - paced)), phase, "missed", stats->missed);
+  for (int i = 0; i + 1 < CHECK_FRAMES; ++i)
+  {
+    check((after[i + 1] - before[i] - 1) >= interval, phase, "refreshes between frames", i);
+  }
+
+  uint32_t window_start = present_us[0], window_frames = 0;
+  float fps = 0;
+  for (int i = 1; i < CHECK_FRAMES; ++i)
+  {
+    ++window_frames;
+    if ((present_us[i] - window_start) >= (FRAME_SYNC_FPS_WINDOW_MS * 1000UL))
+    {
+      fps = (float)window_frames * 1000000 / (present_us[i] - window_start);
+      window_start = present_us[i];
+      window_frames = 0;
+    }
+  }
+  check((fps > 0) && (stats->fps > (fps * 0.95f)) && (stats->fps < (fps * 1.05f)), phase, "fps", stats->fps);
+}
+
+int main()
+{
+  Arduino_FrameSync frame_sync;
+  if (!frame_sync.begin())
+  {
+    printf("begin failed\n");
+    return 1;
+  }
+
+  // no sync signal
+  uint32_t start_ms = millis();
+  check(!frame_sync.waitForVSync(20), "no sync signal", "waitForVSync", 0);
+  check((millis() - start_ms) >= 20, "no sync signal", "timeout", millis() - start_ms);
+  check(frame_sync.getStats()->timeouts == 1, "no sync signal", "timeouts", frame_sync.getStats()->timeouts);
+
+  vsync_running = true;
+  std::thread vsync(vsyncThread, &frame_sync);
+
+  // a frame every refresh
+  presentFrames(&frame_sync, 1, 0, "interval 1");
+  check(frame_sync.getRefreshRate() > 0, "interval 1", "refresh rate", 0);
+  // frames drawn for 1.5 refreshes miss a refresh each
+  presentFrames(&frame_sync, 1, VSYNC_PERIOD_US * 3 / 2, "late frames");
+  check(frame_sync.getStats()->missed > 0, "late frames", "missed refreshes", 0);
+  // every second refresh
+  presentFrames(&frame_sync, 2, 0, "interval 2");
+
+  vsync_running = false;
+  vsync.join();
+
+  printf("frame_sync_check: %d errors\n", errors);
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,1385 @@
+/*
+ * Host benchmark for Arduino_GFX rendering paths.
+ *
+ * Replays the PDQgraphicstest sequence (plus gauges, polygons, bitmaps, U8g2 and anti-aliased text, a dashboard, layers and flush) on an
+ * Arduino_Canvas backed by Arduino_Memory_Display and reports ns/pixel and Mpixel/s per primitive.
+ *
+ * With -b the same sequence is drawn on an Arduino_GC9A01 over Arduino_RecordBus instead,
+ * and the bus traffic (transactions, bytes, address windows) per primitive is reported.
+ *
+ * With -r the results are compared with a baseline CSV written by -c in the same mode,
+ * every ns/pixel (or every bus traffic count with -b) above the baseline by more than the tolerance is reported
+ * and the exit code is 2. -r can be repeated, the lowest value of each test is the baseline.
+ * Bus traffic is exact and can be compared with a stored baseline, timing only with runs on the same machine.
+ *
+ * With -o the image each test leaves is saved, tests drawing on the display save it after a full flush of their renderer.
+ * An image equal to the one of another test is an error (exit code 1), unless the test names that one as same_image_as.
+ *
+ * usage: gfx_benchmark [-w width] [-h height] [-n repeat] [-o ppm_output_dir] [-c] [-b] [-a] [-r baseline.csv] [-t percent]
+ *   -c  print CSV instead of a table
+ *   -b  report bus traffic instead of timing
+ *   -a  offload canvas fills and blits to Arduino_Accel_Stub and report how many were offloaded
+ *   -r  compare with a baseline CSV
+ *   -t  tolerance of -r in percent, default 0
+ */
+#define U8G2_USE_LARGE_FONTS // only this translation unit needs the font data
+#include "Arduino_GFX.h"
+#include "canvas/Arduino_Canvas.h"
+#include "canvas/Arduino_Canvas_DisplayList.h"
+#include "canvas/Arduino_Compositor.h"
+#include "canvas/Arduino_SpriteEngine.h"
+#include "databus/Arduino_RecordBus.h"
+#include "display/Arduino_GC9A01.h"
+#include "Arduino_Accel_Stub.h"
+#include "Arduino_Memory_Display.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+static int32_t clipped_area(int32_t x, int32_t y, int32_t w, int32_t h, int32_t max_w, int32_t max_h)
+{
+  if (w < 0)
+  {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0)
+  {
+    y += h + 1;
+    h = -h;
+  }
+  int32_t x2 = min(x + w, max_w);
+  int32_t y2 = min(y + h, max_h);
+  x = max(x, (int32_t)0);
+  y = max(y, (int32_t)0);
+  return ((x2 > x) && (y2 > y)) ? ((x2 - x) * (y2 - y)) : 0;
+}
+
+// Canvas that counts pixels written to the framebuffer, used for a separate untimed pass
+class PixelCountCanvas : public Arduino_Canvas
+{
+public:
+  PixelCountCanvas(int16_t w, int16_t h, Arduino_G *output) : Arduino_Canvas(w, h, output) {}
+
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override
+  {
+    ++pixels;
+    Arduino_Canvas::writePixelPreclipped(x, y, color);
+  }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override
+  {
+    pixels += clipped_area(x, y, 1, h, _width, _height);
+    Arduino_Canvas::writeFastVLine(x, y, h, color);
+  }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override
+  {
+    pixels += clipped_area(x, y, w, 1, _width, _height);
+    Arduino_Canvas::writeFastHLine(x, y, w, color);
+  }
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override
+  {
+    pixels += (int32_t)w * h;
+    Arduino_Canvas::writeFillRectPreclipped(x, y, w, h, color);
+  }
+  void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip = 0) override
+  {
+    pixels += clipped_area(x, y, w, h, _width, _height);
+    Arduino_Canvas::drawIndexedBitmap(x, y, bitmap, color_index, w, h, x_skip);
+  }
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override
+  {
+    pixels += clipped_area(x, y, w, h, _width, _height);
+    Arduino_Canvas::draw16bitRGBBitmap(x, y, bitmap, w, h);
+  }
+  void drawAlphaBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg) override
+  {
+    pixels += clipped_area(x, y, w, h, _width, _height);
+    Arduino_Canvas::drawAlphaBitmap(x, y, bitmap, bpp, w, h, color, bg);
+  }
+  void draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h) override
+  {
+    pixels += clipped_area(x, y, w, h, _width, _height);
+    Arduino_Canvas::draw16bitRGBBitmapWithAlpha(x, y, bitmap, alpha, w, h);
+  }
+  void draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h) override
+  {
+    pixels += clipped_area(x, y, w, h, _width, _height);
+    Arduino_Canvas::draw32bitARGBBitmap(x, y, bitmap, w, h);
+  }
+  void drawAffineBitmap(const gfx_affine_t *affine) override
+  {
+    for (int16_t j = affine->y1; j <= affine->y2; ++j)
+    {
+      int16_t i;
+      pixels += gfx_affine_span(affine, j, &i);
+    }
+    Arduino_Canvas::drawAffineBitmap(affine);
+  }
+
+  uint64_t pixels = 0;
+};
+
+static int32_t w, h, n, n1, cx, cy, cx1, cy1, cn, cn1;
+static uint8_t tsa, tsb, tsc;
+static std::vector<uint16_t> test_bitmap;
+static std::vector<uint8_t> test_indexed_bitmap;
+static std::vector<uint8_t> test_alpha;
+static std::vector<uint32_t> test_argb_bitmap;
+static std::vector<uint16_t> test_sprite_frames;
+static std::vector<uint16_t> test_sprite_background;
+static uint16_t test_palette[256];
+static Arduino_Memory_Display *display;
+
+static void testFillScreen(Arduino_GFX *gfx)
+{
+  gfx->fillScreen(RGB565_WHITE);
+  gfx->fillScreen(RGB565_RED);
+  gfx->fillScreen(RGB565_GREEN);
+  gfx->fillScreen(RGB565_BLUE);
+  gfx->fillScreen(RGB565_BLACK);
+}
+
+static void testText(Arduino_GFX *gfx)
+{
+  gfx->setFont((const GFXfont *)NULL);
+  gfx->setCursor(0, 0);
+
+  gfx->setTextSize(1);
+  gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
+  gfx->println(F("Hello World!"));
+
+  gfx->setTextSize(2);
+  gfx->setTextColor(gfx->color565(0xff, 0x00, 0x00));
+  gfx->print(F("RED "));
+  gfx->setTextColor(gfx->color565(0x00, 0xff, 0x00));
+  gfx->print(F("GREEN "));
+  gfx->setTextColor(gfx->color565(0x00, 0x00, 0xff));
+  gfx->println(F("BLUE"));
+
+  gfx->setTextSize(tsa);
+  gfx->setTextColor(RGB565_YELLOW);
+  gfx->println(1234.56);
+
+  gfx->setTextColor(RGB565_WHITE);
+  gfx->println((w > 128) ? 0xDEADBEEF : 0xDEADBEE, HEX);
+
+  gfx->setTextColor(RGB565_CYAN, RGB565_WHITE);
+  gfx->println(F("Groop,"));
+
+  gfx->setTextSize(tsc);
+  gfx->setTextColor(RGB565_MAGENTA, RGB565_WHITE);
+  gfx->println(F("I implore thee,"));
+
+  gfx->setTextSize(1);
+  gfx->setTextColor(RGB565_NAVY, RGB565_WHITE);
+  gfx->println(F("my foonting turlingdromes."));
+
+  gfx->setTextColor(RGB565_DARKGREEN, RGB565_WHITE);
+  gfx->println(F("And hooptiously drangle me"));
+
+  gfx->setTextColor(RGB565_DARKCYAN, RGB565_WHITE);
+  gfx->println(F("with crinkly bindlewurdles,"));
+
+  gfx->setTextColor(RGB565_MAROON, RGB565_WHITE);
+  gfx->println(F("Or I will rend thee"));
+
+  gfx->setTextColor(RGB565_PURPLE, RGB565_WHITE);
+  gfx->println(F("in the gobberwartsb"));
+
+  gfx->setTextColor(RGB565_OLIVE, RGB565_WHITE);
+  gfx->println(F("with my blurglecruncheon,"));
+
+  gfx->setTextColor(RGB565_DARKGREY, RGB565_WHITE);
+  gfx->println(F("see if I don't!"));
+
+  for (uint8_t s = 2; s <= 9; ++s)
+  {
+    gfx->setTextSize(s);
+    gfx->setTextColor(RGB565_RED + s);
+    gfx->print(F("Size "));
+    gfx->println(s);
+  }
+  gfx->setTextSize(1);
+}
+
+static void testPixels(Arduino_GFX *gfx)
+{
+  for (int16_t y = 0; y < h; y++)
+  {
+    for (int16_t x = 0; x < w; x++)
+    {
+      gfx->drawPixel(x, y, gfx->color565(x << 3, y << 3, x * y));
+    }
+  }
+}
+
+static void testLines(Arduino_GFX *gfx)
+{
+  int32_t x1, y1, x2, y2;
+
+  x1 = y1 = 0;
+  y2 = h - 1;
+  for (x2 = 0; x2 < w; x2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+  x2 = w - 1;
+  for (y2 = 0; y2 < h; y2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+
+  x1 = w - 1;
+  y1 = 0;
+  y2 = h - 1;
+  for (x2 = 0; x2 < w; x2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+  x2 = 0;
+  for (y2 = 0; y2 < h; y2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+
+  x1 = 0;
+  y1 = h - 1;
+  y2 = 0;
+  for (x2 = 0; x2 < w; x2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+  x2 = w - 1;
+  for (y2 = 0; y2 < h; y2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+
+  x1 = w - 1;
+  y1 = h - 1;
+  y2 = 0;
+  for (x2 = 0; x2 < w; x2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+  x2 = 0;
+  for (y2 = 0; y2 < h; y2 += 6)
+  {
+    gfx->drawLine(x1, y1, x2, y2, RGB565_BLUE);
+  }
+}
+
+static void testFastLines(Arduino_GFX *gfx)
+{
+  for (int32_t y = 0; y < h; y += 5)
+  {
+    gfx->drawFastHLine(0, y, w, RGB565_RED);
+  }
+  for (int32_t x = 0; x < w; x += 5)
+  {
+    gfx->drawFastVLine(x, 0, h, RGB565_BLUE);
+  }
+}
+
+static void testFilledRects(Arduino_GFX *gfx)
+{
+  for (int32_t i = n; i > 0; i -= 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->fillRect(cx - i2, cy - i2, i, i, gfx->color565(i, i, 0));
+  }
+}
+
+static void testRects(Arduino_GFX *gfx)
+{
+  for (int32_t i = 2; i < n; i += 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->drawRect(cx - i2, cy - i2, i, i, RGB565_GREEN);
+  }
+}
+
+static void testFilledTriangles(Arduino_GFX *gfx)
+{
+  for (int32_t i = cn1; i > 10; i -= 5)
+  {
+    gfx->fillTriangle(cx1, cy1 - i, cx1 - i, cy1 + i, cx1 + i, cy1 + i, gfx->color565(0, i, i));
+  }
+}
+
+static void testTriangles(Arduino_GFX *gfx)
+{
+  for (int32_t i = 0; i < cn; i += 5)
+  {
+    gfx->drawTriangle(cx1, cy1 - i, cx1 - i, cy1 + i, cx1 + i, cy1 + i, gfx->color565(0, 0, i));
+  }
+}
+
+static void testFilledCircles(Arduino_GFX *gfx)
+{
+  const int32_t radius = 10, r2 = radius * 2;
+  for (int32_t x = radius; x < w; x += r2)
+  {
+    for (int32_t y = radius; y < h; y += r2)
+    {
+      gfx->fillCircle(x, y, radius, RGB565_MAGENTA);
+    }
+  }
+}
+
+static void testCircles(Arduino_GFX *gfx)
+{
+  const int32_t radius = 10, r2 = radius * 2;
+  for (int32_t x = 0; x < w + radius; x += r2)
+  {
+    for (int32_t y = 0; y < h + radius; y += r2)
+    {
+      gfx->drawCircle(x, y, radius, RGB565_WHITE);
+    }
+  }
+}
+
+static void testFillArcs(Arduino_GFX *gfx)
+{
+  int16_t r = (360 > cn) ? (360 / cn) : 1;
+  for (int16_t i = 6; i < cn; i += 6)
+  {
+    gfx->fillArc(cx1, cy1, i, i - 3, 0, i * r, RGB565_RED);
+  }
+}
+
+static void testArcs(Arduino_GFX *gfx)
+{
+  int16_t r = (360 > cn) ? (360 / cn) : 1;
+  for (int16_t i = 6; i < cn; i += 6)
+  {
+    gfx->drawArc(cx1, cy1, i, i - 3, 0, i * r, RGB565_WHITE);
+  }
+}
+
+// same arcs as testFillArcs() drawn by the per pixel writeFillArcHelper()
+static void testFillArcsLegacy(Arduino_GFX *gfx)
+{
+  int16_t r = (360 > cn) ? (360 / cn) : 1;
+  gfx->startWrite();
+  for (int16_t i = 6; i < cn; i += 6)
+  {
+    float end = fmodf(i * r, 360);
+    gfx->writeFillArcHelper(cx1, cy1, i, i - 3, 0, (end == 0) ? 360.0 : end, RGB565_RED);
+  }
+  gfx->endWrite();
+}
+
+// 4 ring gauges following a value sweep, either fully redrawn or updated by the changed angle range
+static void drawGauges(Arduino_GFX *gfx, bool update)
+{
+  int16_t r = ((w < h) ? w : h) / 4 - 4;
+  float value[4] = {0, 0, 0, 0};
+  for (int16_t g = 0; g < 4; ++g)
+  {
+    gfx->fillArc((g & 1) ? (w * 3 / 4) : (w / 4), (g & 2) ? (h * 3 / 4) : (h / 4), r, r * 3 / 4, 135, 405, RGB565_DARKGREY);
+  }
+  for (int16_t frame = 0; frame < 30; ++frame)
+  {
+    for (int16_t g = 0; g < 4; ++g)
+    {
+      int16_t x = (g & 1) ? (w * 3 / 4) : (w / 4);
+      int16_t y = (g & 2) ? (h * 3 / 4) : (h / 4);
+      float v = (float)(((frame + 1) * (g + 3) * 37) % 270);
+      if (update)
+      {
+        gfx->updateArc(x, y, r, r * 3 / 4, 135, 135 + value[g], 135 + v, RGB565_GREEN, RGB565_DARKGREY);
+      }
+      else
+      {
+        gfx->fillArc(x, y, r, r * 3 / 4, 135, 405, RGB565_DARKGREY);
+        if (v > 0)
+        {
+          gfx->fillArc(x, y, r, r * 3 / 4, 135, 135 + v, RGB565_GREEN);
+        }
+      }
+      value[g] = v;
+    }
+  }
+}
+
+static void testGauges(Arduino_GFX *gfx)
+{
+  drawGauges(gfx, false);
+}
+
+static void testGaugesUpdate(Arduino_GFX *gfx)
+{
+  drawGauges(gfx, true);
+}
+
+// 12-point stars on a grid, outer radius 28, inner radius 14
+static void starPoints(int16_t *points, int16_t x, int16_t y)
+{
+  for (int16_t i = 0; i < 24; ++i)
+  {
+    float a = i * (float)PI / 12;
+    int16_t r = (i & 1) ? 14 : 28;
+    points[i * 2] = x + (int16_t)lroundf(r * cosf(a));
+    points[i * 2 + 1] = y + (int16_t)lroundf(r * sinf(a));
+  }
+}
+
+// same stars as testPolygons() tessellated into a triangle fan from the center
+static void testPolygonsFan(Arduino_GFX *gfx)
+{
+  int16_t points[48];
+  for (int16_t y = 20; y < h; y += 50)
+  {
+    for (int16_t x = 20; x < w; x += 50)
+    {
+      starPoints(points, x, y);
+      for (int16_t i = 0; i < 24; ++i)
+      {
+        int16_t j = (i + 1) % 24;
+        gfx->fillTriangle(x, y, points[i * 2], points[i * 2 + 1], points[j * 2], points[j * 2 + 1], RGB565_YELLOW);
+      }
+    }
+  }
+}
+
+static void testPolygons(Arduino_GFX *gfx)
+{
+  int16_t points[48];
+  for (int16_t y = 20; y < h; y += 50)
+  {
+    for (int16_t x = 20; x < w; x += 50)
+    {
+      starPoints(points, x, y);
+      gfx->fillPolygon(points, 24, RGB565_YELLOW);
+    }
+  }
+}
+
+static void testPolygonsAA(Arduino_GFX *gfx)
+{
+  int16_t points[48];
+  for (int16_t y = 20; y < h; y += 50)
+  {
+    for (int16_t x = 20; x < w; x += 50)
+    {
+      starPoints(points, x, y);
+      gfx->fillPolygonAA(points, 24, RGB565_YELLOW, RGB565_YELLOW);
+    }
+  }
+}
+
+static void testFilledRoundRects(Arduino_GFX *gfx)
+{
+  for (int32_t i = n1; i > 20; i -= 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->fillRoundRect(cx - i2, cy - i2, i, i, i / 8, gfx->color565(0, i, 0));
+  }
+}
+
+static void testRoundRects(Arduino_GFX *gfx)
+{
+  for (int32_t i = 20; i < n1; i += 6)
+  {
+    int32_t i2 = i / 2;
+    gfx->drawRoundRect(cx - i2, cy - i2, i, i, i / 8, gfx->color565(i, 0, 0));
+  }
+}
+
+static void test16bitBitmaps(Arduino_GFX *gfx)
+{
+  for (int32_t y = -32; y < h; y += 48)
+  {
+    for (int32_t x = -32; x < w; x += 48)
+    {
+      gfx->draw16bitRGBBitmap(x, y, test_bitmap.data(), 64, 64);
+    }
+  }
+}
+
+static void testScaledBitmaps(Arduino_GFX *gfx, bool bilinear)
+{
+  // odd sizes, as when fitting video frames to a panel
+  for (int32_t i = 0; i < 8; ++i)
+  {
+    int32_t dw = w * (3 + i) / 10;
+    int32_t dh = h * (3 + i) / 10;
+    gfx->draw16bitRGBBitmapScaled(cx - dw / 2, cy - dh / 2, test_bitmap.data(), 64, 64, dw, dh, bilinear);
+  }
+  // a whole number factor, as for pixel art
+  gfx->draw16bitRGBBitmapScaled(cx - 64, cy - 64, test_bitmap.data(), 64, 64, 128, 128, bilinear);
+}
+
+static void testScaledBitmapsNearest(Arduino_GFX *gfx)
+{
+  testScaledBitmaps(gfx, false);
+}
+
+static void testScaledBitmapsBilinear(Arduino_GFX *gfx)
+{
+  testScaledBitmaps(gfx, true);
+}
+
+static void testRotatedBitmaps(Arduino_GFX *gfx)
+{
+  for (int32_t i = 0; i < 12; ++i)
+  {
+    gfx->draw16bitRGBBitmapRotated(cx, cy, test_bitmap.data(), 64, 64, i * 30 + 7, n / 128.0f, i & 1);
+  }
+}
+
+static void testAlphaBitmaps(Arduino_GFX *gfx)
+{
+  for (int32_t y = -32; y < h; y += 48)
+  {
+    for (int32_t x = -32; x < w; x += 48)
+    {
+      gfx->draw16bitRGBBitmapWithAlpha(x, y, test_bitmap.data(), test_alpha.data(), 64, 64);
+    }
+  }
+}
+
+static void testARGBBitmaps(Arduino_GFX *gfx)
+{
+  for (int32_t y = -32; y < h; y += 48)
+  {
+    for (int32_t x = -32; x < w; x += 48)
+    {
+      gfx->draw32bitARGBBitmap(x, y, test_argb_bitmap.data(), 64, 64);
+    }
+  }
+}
+
+static void testIndexedBitmaps(Arduino_GFX *gfx)
+{
+  for (int32_t y = -32; y < h; y += 48)
+  {
+    for (int32_t x = -32; x < w; x += 48)
+    {
+      gfx->drawIndexedBitmap(x, y, test_indexed_bitmap.data(), test_palette, 64, 64);
+    }
+  }
+}
+
+static void testU8g2Text(Arduino_GFX *gfx)
+{
+  gfx->setFont(u8g2_font_quan7_h_cjk);
+  gfx->setUTF8Print(true);
+  gfx->setTextSize(1);
+  gfx->setCursor(0, 10);
+  for (int i = 0; i < 6; ++i)
+  {
+    gfx->setTextColor(RGB565_WHITE, RGB565_BLACK);
+    gfx->println(F("The quick brown fox jumps over the lazy dog 0123456789"));
+    gfx->setTextColor(RGB565_YELLOW);
+    gfx->println(F("Arduino_GFX 你好世界 こんにちは 안녕하세요"));
+  }
+  gfx->setTextSize(3);
+  gfx->setTextColor(RGB565_CYAN);
+  gfx->println(F("Size 3 文字"));
+  gfx->setTextSize(1);
+  gfx->setUTF8Print(false);
+  gfx->setFont((const GFXfont *)NULL);
+}
+
+static void testU8g2TextCached(Arduino_GFX *gfx)
+{
+  gfx->setGlyphCacheSize(16 * 1024);
+  testU8g2Text(gfx);
+  gfx->setGlyphCacheSize(0);
+}
+
+static void drawStatusLines(Arduino_GFX *gfx, bool run)
+{
+  static const char *lines[] = {"Temp 23.5C  Hum 41%  Batt 3.97V", "Net OK  RSSI -61dBm  12:34:56"};
+  for (int16_t i = 0, y = 0; y < (h - 16); ++i, y += 16)
+  {
+    const char *str = lines[i & 1];
+    uint16_t color = (i & 2) ? RGB565_YELLOW : RGB565_WHITE;
+    if (i & 1)
+    {
+      gfx->setFont(u8g2_font_quan7_h_cjk);
+      y += 4; // u8g2 cursor is at baseline
+    }
+    else
+    {
+      gfx->setFont((const GFXfont *)NULL);
+    }
+    if (run)
+    {
+      gfx->drawTextRun(0, y, str, color, RGB565_BLACK);
+    }
+    else
+    {
+      gfx->setCursor(0, y);
+      gfx->setTextColor(color, RGB565_BLACK);
+      gfx->print(str);
+    }
+  }
+  gfx->setFont((const GFXfont *)NULL);
+}
+
+static void testStatusLines(Arduino_GFX *gfx)
+{
+  drawStatusLines(gfx, false);
+}
+
+static void testStatusLinesRun(Arduino_GFX *gfx)
+{
+  drawStatusLines(gfx, true);
+}
+
+// 8 pixels high anti-aliased font, box filtered from 16 pixels high unifont
+static GFXalphaFont *alphaFont(Arduino_GFX *gfx)
+{
+  static GFXalphaFont *font = NULL;
+  if (!font)
+  {
+    gfx->setFont(u8g2_font_unifont_t_chinese);
+    font = gfx->createAlphaFont(32, 126, 2, 4);
+  }
+  return font;
+}
+
+static void drawAlphaText(Arduino_GFX *gfx, bool transparent)
+{
+  gfx->setFont(alphaFont(gfx));
+  gfx->setCursor(0, 8);
+  for (int i = 0; i < 10; ++i)
+  {
+    uint16_t color = (i & 1) ? RGB565_YELLOW : RGB565_WHITE;
+    if (transparent)
+    {
+      gfx->setTextColor(color); // blend with the framebuffer pixels
+    }
+    else
+    {
+      gfx->setTextColor(color, RGB565_NAVY);
+    }
+    gfx->println(F("The quick brown fox jumps over the lazy dog 0123456789"));
+  }
+  gfx->setFont((const GFXfont *)NULL);
+}
+
+static void testAlphaText(Arduino_GFX *gfx)
+{
+  drawAlphaText(gfx, false);
+}
+
+static void testAlphaTextBlended(Arduino_GFX *gfx)
+{
+  drawAlphaText(gfx, true);
+}
+
+// display list drawing to the same output as the direct tests, flushed after each dashboard frame
+static Arduino_Canvas_DisplayList *display_list;
+
+// 4 panels with a bar and a value, fully drawn once and then updated for 10 frames
+static void drawDashboard(Arduino_GFX *gfx, bool flush)
+{
+  int16_t pw = w / 2 - 6, ph = (h - 28) / 2 - 6;
+  for (int16_t frame = 0; frame < 10; ++frame)
+  {
+    if (frame == 0)
+    {
+      gfx->fillScreen(RGB565_BLACK);
+      gfx->fillRect(0, 0, w, 24, RGB565_DARKCYAN);
+      gfx->setTextSize(2);
+      gfx->setTextColor(RGB565_WHITE);
+      gfx->setCursor(4, 4);
+      gfx->print("Dashboard");
+    }
+    for (int16_t p = 0; p < 4; ++p)
+    {
+      int16_t x = 4 + (p & 1) * (pw + 8);
+      int16_t y = 28 + (p >> 1) * (ph + 8);
+      int16_t v = ((frame + 1) * (p + 5) * 13) % 100;
+      if (frame == 0)
+      {
+        gfx->fillRoundRect(x, y, pw, ph, 6, RGB565_NAVY);
+        gfx->setTextColor(RGB565_LIGHTGREY);
+        gfx->setCursor(x + 6, y + 6);
+        gfx->print("Sensor ");
+        gfx->print(p);
+      }
+      gfx->fillRect(x + 6, y + ph - 18, pw - 12, 12, RGB565_DARKGREY);
+      gfx->fillRect(x + 6, y + ph - 18, (pw - 12) * v / 100, 12, RGB565_GREEN);
+      gfx->setTextColor(RGB565_WHITE, RGB565_NAVY);
+      gfx->setCursor(x + 6, y + 26);
+      gfx->printf("%3d%%", v);
+    }
+    if (flush)
+    {
+      gfx->flush();
+    }
+  }
+}
+
+static void testDashboard(Arduino_GFX *gfx)
+{
+  drawDashboard(gfx, false);
+}
+
+static void testDashboardList(Arduino_GFX *gfx)
+{
+  drawDashboard(display_list, true);
+}
+
+// background, a moving content panel and a status bar
+static Arduino_Compositor *compositor;
+static Arduino_Canvas *layer_content;
+static Arduino_Canvas_Mono *layer_status;
+
+static void drawLayerBackground(Arduino_GFX *gfx)
+{
+  for (int16_t y = 0; y < h; y += 8)
+  {
+    gfx->fillRect(0, y, w, 8, RGB565(0, y * 255 / h, 128));
+  }
+}
+
+static void drawLayerContent(Arduino_GFX *gfx, int16_t x, int16_t y)
+{
+  gfx->fillRoundRect(x, y, w / 2, h / 2, 8, RGB565_NAVY);
+  gfx->fillCircle(x + w / 4, y + h / 4, h / 6, RGB565_ORANGE);
+  gfx->setTextSize(1);
+  gfx->setTextColor(RGB565_WHITE);
+  gfx->setCursor(x + 6, y + 6);
+  gfx->print("Content");
+}
+
+static void drawLayerStatus(Arduino_GFX *gfx, int16_t y, int16_t frame)
+{
+  gfx->fillRect(0, y, w, 16, RGB565_BLACK);
+  gfx->setTextSize(1);
+  gfx->setTextColor(RGB565_WHITE);
+  gfx->setCursor(4, y + 4);
+  gfx->printf("Frame %d", frame);
+}
+
+static bool beginCompositor(Arduino_G *output)
+{
+  compositor = new Arduino_Compositor(w, h, output);
+  if (!compositor->begin(GFX_SKIP_OUTPUT_BEGIN))
+  {
+    return false;
+  }
+  Arduino_Canvas *background = compositor->addLayer(0, 0, w, h, 0);
+  layer_content = compositor->addLayer(0, 0, w / 2, h / 2, 1);
+  layer_status = compositor->addMonoLayer(0, h - 16, w, 16, RGB565_WHITE, RGB565_BLACK, 2);
+  if ((!background) || (!layer_content) || (!layer_status))
+  {
+    return false;
+  }
+  drawLayerBackground(background);
+  drawLayerContent(layer_content, 0, 0);
+  compositor->setLayerColorKey(layer_status, RGB565_BLACK);
+  compositor->setLayerAlpha(layer_status, 192);
+  compositor->flush();
+  return true;
+}
+
+// everything redrawn each of 10 frames while the panel moves and the status changes
+static void testLayers(Arduino_GFX *gfx)
+{
+  for (int16_t frame = 0; frame < 10; ++frame)
+  {
+    drawLayerBackground(gfx);
+    drawLayerContent(gfx, 20 + frame * 4, 40);
+    drawLayerStatus(gfx, h - 16, frame);
+  }
+}
+
+static void testLayersCompositor(Arduino_GFX *gfx)
+{
+  for (int16_t frame = 0; frame < 10; ++frame)
+  {
+    compositor->setLayerPosition(layer_content, 20 + frame * 4, 40);
+    drawLayerStatus(layer_status, 0, frame);
+    compositor->markLayerDirty(layer_status);
+    compositor->flush();
+  }
+}
+
+// a full height log view that gets 20 new lines
+#define LOG_LINE_H 10
+
+static void drawLogLine(Arduino_GFX *gfx, int16_t y, int16_t line)
+{
+  gfx->fillRect(0, y, w, LOG_LINE_H, RGB565_BLACK);
+  gfx->setTextSize(1);
+  gfx->setTextColor(RGB565_GREEN);
+  gfx->setCursor(2, y + 1);
+  gfx->printf("%05d log line", line);
+}
+
+static void testLogView(Arduino_GFX *gfx)
+{
+  int16_t rows = h / LOG_LINE_H;
+  for (int16_t line = 0; line < 20; ++line)
+  {
+    for (int16_t r = 0; r < rows; ++r)
+    {
+      drawLogLine(gfx, r * LOG_LINE_H, line - rows + 1 + r);
+    }
+  }
+}
+
+static void testLogViewScroll(Arduino_GFX *gfx)
+{
+  int16_t area_h = (h / LOG_LINE_H) * LOG_LINE_H;
+  if (!gfx->setScrollArea(0, area_h))
+  {
+    return;
+  }
+  for (int16_t line = 0; line < 20; ++line)
+  {
+    gfx->scrollTo(gfx->getScrollOffset() + LOG_LINE_H);
+    drawLogLine(gfx, gfx->getScrollDrawY(area_h - LOG_LINE_H), line);
+  }
+  gfx->setScrollArea(0, 0);
+}
+
+// 32 animated 16x16 balls moving over a background bitmap
+#define SPRITE_COUNT 32
+#define SPRITE_FRAMES 4
+#define SPRITE_KEY RGB565_MAGENTA
+static Arduino_SpriteEngine *sprite_engine;
+
+static int16_t spriteX(int16_t i, int16_t frame)
+{
+  return ((i * 37) + ((1 + (i % 3)) * frame * 2)) % (w - 16);
+}
+
+static int16_t spriteY(int16_t i, int16_t frame)
+{
+  return ((i * 53) + ((1 + (i % 4)) * frame * 2)) % (h - 16);
+}
+
+static bool beginSpriteEngine(Arduino_G *output)
+{
+  sprite_engine = new Arduino_SpriteEngine(w, h, output);
+  if (!sprite_engine->begin(GFX_SKIP_OUTPUT_BEGIN))
+  {
+    return false;
+  }
+  sprite_engine->setBackgroundBitmap(test_sprite_background.data(), w, h);
+  for (int16_t i = 0; i < SPRITE_COUNT; ++i)
+  {
+    int16_t id = sprite_engine->addSprite(test_sprite_frames.data(), 16, 16, spriteX(i, 0), spriteY(i, 0), i & 1, SPRITE_FRAMES);
+    if (id < 0)
+    {
+      return false;
+    }
+    sprite_engine->setSpriteColorKey(id, SPRITE_KEY);
+  }
+  sprite_engine->flush();
+  return true;
+}
+
+// background and every sprite redrawn each of 10 frames
+static void testSprites(Arduino_GFX *gfx)
+{
+  for (int16_t frame = 0; frame < 10; ++frame)
+  {
+    gfx->draw16bitRGBBitmap(0, 0, test_sprite_background.data(), w, h);
+    for (int16_t z = 0; z < 2; ++z)
+    {
+      for (int16_t i = z; i < SPRITE_COUNT; i += 2)
+      {
+        gfx->draw16bitRGBBitmapWithTranColor(spriteX(i, frame), spriteY(i, frame),
+                                             test_sprite_frames.data() + ((frame + i) % SPRITE_FRAMES) * 16 * 16, SPRITE_KEY, 16, 16);
+      }
+    }
+  }
+}
+
+static void testSpritesEngine(Arduino_GFX *gfx)
+{
+  for (int16_t frame = 0; frame < 10; ++frame)
+  {
+    for (int16_t i = 0; i < SPRITE_COUNT; ++i)
+    {
+      sprite_engine->setSpritePosition(i, spriteX(i, frame), spriteY(i, frame));
+      sprite_engine->setSpriteFrame(i, (frame + i) % SPRITE_FRAMES);
+    }
+    sprite_engine->flush();
+  }
+}
+
+static void testFlush(Arduino_GFX *gfx)
+{
+  gfx->flush();
+}
+
+// send the whole screen of a renderer that draws on the display directly, its last flush() sent only what changed
+static void flushDisplayList()
+{
+  display_list->flush(true);
+}
+
+static void flushCompositor()
+{
+  compositor->flush(true);
+}
+
+static void flushSpriteEngine()
+{
+  sprite_engine->flush(true);
+}
+
+typedef void (*test_func_t)(Arduino_GFX *gfx);
+
+typedef struct
+{
+  const char *name;
+  test_func_t func;
+  void (*flush_display)();  // the test draws on the display instead of the canvas, nullptr if it does not
+  const char *same_image_as; // -o: an earlier test expected to leave the same image, every other image must differ
+} benchmark_test_t;
+
+static const benchmark_test_t tests[] = {
+    {"Screen fill", testFillScreen},
+    {"Text", testText},
+    {"Pixels", testPixels},
+    {"Lines", testLines},
+    {"Horiz/Vert Lines", testFastLines},
+    {"Rectangles (filled)", testFilledRects},
+    {"Rectangles (outline)", testRects},
+    {"Triangles (filled)", testFilledTriangles},
+    {"Triangles (outline)", testTriangles},
+    {"Circles (filled)", testFilledCircles},
+    {"Circles (outline)", testCircles},
+    {"Arcs (filled)", testFillArcs},
+    {"Arcs (filled, legacy helper)", testFillArcsLegacy},
+    {"Arcs (outline)", testArcs},
+    {"Ring gauges (full redraw)", testGauges},
+    {"Ring gauges (update)", testGaugesUpdate, nullptr, "Ring gauges (full redraw)"},
+    {"Polygons (triangle fan)", testPolygonsFan},
+    {"Polygons (scanline)", testPolygons},
+    {"Polygons (anti-aliased)", testPolygonsAA},
+    {"Rounded rects (filled)", testFilledRoundRects},
+    {"Rounded rects (outline)", testRoundRects},
+    {"16-bit bitmaps", test16bitBitmaps},
+    {"Alpha bitmaps (RGB565+A8)", testAlphaBitmaps},
+    {"Alpha bitmaps (ARGB8888)", testARGBBitmaps},
+    {"Indexed bitmaps", testIndexedBitmaps},
+    {"Scaled bitmaps (nearest)", testScaledBitmapsNearest},
+    {"Scaled bitmaps (bilinear)", testScaledBitmapsBilinear},
+    {"Rotated bitmaps", testRotatedBitmaps},
+    {"U8g2 text", testU8g2Text},
+    {"U8g2 text (glyph cache)", testU8g2TextCached, nullptr, "U8g2 text"},
+    {"Status lines", testStatusLines},
+    {"Status lines (text run)", testStatusLinesRun, nullptr, "Status lines"},
+    {"Alpha text (opaque)", testAlphaText},
+    {"Alpha text (blended)", testAlphaTextBlended},
+    {"Dashboard (direct)", testDashboard},
+    {"Dashboard (display list)", testDashboardList, flushDisplayList, "Dashboard (direct)"},
+    {"Layers (full redraw)", testLayers},
+    {"Layers (compositor)", testLayersCompositor, flushCompositor},
+    {"Log view (redraw)", testLogView},
+    {"Log view (scroll)", testLogViewScroll},
+    {"Sprites (full redraw)", testSprites},
+    {"Sprites (engine)", testSpritesEngine, flushSpriteEngine, "Sprites (full redraw)"},
+    {"flush", testFlush, nullptr, "Screen fill"}, // the black canvas
+};
+
+// -r: CSV values of each test without the name, the lowest of all baseline files
+static std::map<std::string, std::vector<double>> baseline;
+static double tolerance = 0; // percent
+static int regressions = 0;
+
+static bool loadBaseline(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  if (!f)
+  {
+    return false;
+  }
+  char line[256];
+  while (fgets(line, sizeof(line), f))
+  {
+    // values are the numeric fields at the end, a test name may contain commas
+    std::vector<double> values;
+    char *end = line + strcspn(line, "\r\n");
+    char *comma;
+    *end = '\0';
+    while ((comma = strrchr(line, ',')))
+    {
+      char *p;
+      double v = strtod(comma + 1, &p);
+      if ((p == comma + 1) || (*p != '\0'))
+      {
+        break;
+      }
+      values.insert(values.begin(), v);
+      *comma = '\0';
+    }
+    if ((!values.empty()) && strcmp(line, "test"))
+    {
+      auto b = baseline.find(line);
+      if (b == baseline.end())
+      {
+        baseline[line] = values;
+      }
+      else
+      {
+        for (size_t i = 0; (i < values.size()) && (i < b->second.size()); ++i)
+        {
+          b->second[i] = min(b->second[i], values[i]);
+        }
+      }
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+static bool overBaseline(const char *name, int column, double value)
+{
+  auto b = baseline.find(name);
+  return (b != baseline.end()) && (column < (int)b->second.size()) && (value > b->second[column] * (1 + (tolerance / 100)));
+}
+
+// report the columns [first, last] of a test that are higher than the baseline by more than the tolerance
+static void compareBaseline(const char *name, const double *values, const char *const *columns, int first, int last)
+{
+  if (baseline.empty())
+  {
+    return;
+  }
+  auto b = baseline.find(name);
+  if (b == baseline.end())
+  {
+    fprintf(stderr, "%s: not in the baseline\n", name);
+    return;
+  }
+  for (int i = first; i <= last; ++i)
+  {
+    if (overBaseline(name, i, values[i]))
+    {
+      fprintf(stderr, "%s: %s %.4f, baseline %.4f (+%.1f%%)\n", name, columns[i], values[i], b->second[i],
+              b->second[i] ? ((values[i] / b->second[i] - 1) * 100) : 100);
+      ++regressions;
+    }
+  }
+}
+
+// -o: FNV-1a hash of the display image of each test so far
+static std::map<std::string, uint64_t> image_hashes;
+static int image_errors = 0;
+
+// the image must equal the one of same_as and differ from every other, a test whose drawing is lost leaves a repeated image
+static void checkImage(const char *name, const char *same_as)
+{
+  const uint8_t *p = (const uint8_t *)display->getFramebuffer();
+  uint64_t hash = 14695981039346656037ULL;
+  for (uint32_t i = 0; i < (uint32_t)w * h * 2; ++i)
+  {
+    hash = (hash ^ p[i]) * 1099511628211ULL;
+  }
+
+  for (const auto &i : image_hashes)
+  {
+    bool same = (i.second == hash);
+    if (same_as && (i.first == same_as))
+    {
+      if (!same)
+      {
+        fprintf(stderr, "%s: image differs from %s\n", name, same_as);
+        ++image_errors;
+      }
+    }
+    else if (same)
+    {
+      fprintf(stderr, "%s: same image as %s\n", name, i.first.c_str());
+      ++image_errors;
+    }
+  }
+  image_hashes[name] = hash;
+}
+
+static int busTraffic(bool csv)
+{
+  Arduino_RecordBus *bus = new Arduino_RecordBus();
+  Arduino_GC9A01 *tft = new Arduino_GC9A01(bus, GFX_NOT_DEFINED, 0 /* rotation */, false /* IPS */, w, h);
+  Arduino_Canvas *canvas = new Arduino_Canvas(w, h, tft);
+  display_list = new Arduino_Canvas_DisplayList(w, h, tft);
+  if ((!canvas->begin()) || (!display_list->begin(GFX_SKIP_OUTPUT_BEGIN)) || (!beginCompositor(tft)) || (!beginSpriteEngine(tft)))
+  {
+    fprintf(stderr, "GC9A01 begin failed\n");
+    return 1;
+  }
+  bus->setRecordPayload(false);
+
+  if (csv)
+  {
+    printf("test,transactions,commands,command_bytes,data_bytes,pixel_bytes,addr_windows,redundant_addr\n");
+  }
+  else
+  {
+    printf("Arduino_GFX bus traffic, Arduino_GC9A01 %dx%d\n", w, h);
+    printf("%-24s %8s %8s %10s %10s %10s %8s %9s\n", "Benchmark", "trans", "cmds", "cmd bytes", "data bytes", "overhead", "addr", "redundant");
+  }
+
+  for (const benchmark_test_t &t : tests)
+  {
+    // flush sends the canvas, every other test draws on the display directly
+    Arduino_GFX *gfx = (t.func == testFlush) ? (Arduino_GFX *)canvas : (Arduino_GFX *)tft;
+    gfx->fillScreen(RGB565_BLACK);
+    bus->clearTrace();
+    bus->resetStats();
+    t.func(gfx);
+
+    const record_bus_stats_t *stats = bus->getStats();
+    uint32_t overhead = stats->command_bytes + stats->data_bytes - stats->pixel_bytes;
+    if (csv)
+    {
+      printf("%s,%u,%u,%u,%u,%u,%u,%u\n", t.name, stats->transactions, stats->commands, stats->command_bytes,
+             stats->data_bytes, stats->pixel_bytes, stats->addr_windows, stats->redundant_addr);
+    }
+    else
+    {
+      printf("%-24s %8u %8u %10u %10u %10u %8u %9u\n", t.name, stats->transactions, stats->commands,
+             stats->command_bytes, stats->data_bytes, overhead, stats->addr_windows, stats->redundant_addr);
+    }
+
+    static const char *const columns[] = {"transactions", "commands", "command_bytes", "data_bytes", "pixel_bytes", "addr_windows", "redundant_addr"};
+    const double values[] = {(double)stats->transactions, (double)stats->commands, (double)stats->command_bytes,
+                             (double)stats->data_bytes, (double)stats->pixel_bytes, (double)stats->addr_windows, (double)stats->redundant_addr};
+    compareBaseline(t.name, values, columns, 0, 6);
+  }
+
+  delete sprite_engine;
+  delete compositor;
+  delete display_list;
+  delete canvas;
+  delete tft;
+  delete bus;
+  return regressions ? 2 : 0;
+}
+
+int main(int argc, char **argv)
+{
+  int repeat = 20;
+  const char *ppm_dir = nullptr;
+  bool csv = false;
+  bool bus_traffic = false;
+  bool accel = false;
+  w = 320;
+  h = 240;
+  for (int i = 1; i < argc; ++i)
+  {
+    if ((strcmp(argv[i], "-w") == 0) && (i + 1 < argc))
+    {
+      w = atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "-h") == 0) && (i + 1 < argc))
+    {
+      h = atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+    {
+      repeat = max(1, atoi(argv[++i]));
+    }
+    else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+    {
+      ppm_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "-c") == 0)
+    {
+      csv = true;
+    }
+    else if (strcmp(argv[i], "-b") == 0)
+    {
+      bus_traffic = true;
+    }
+    else if (strcmp(argv[i], "-a") == 0)
+    {
+      accel = true;
+    }
+    else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))
+    {
+      if (!loadBaseline(argv[++i]))
+      {
+        fprintf(stderr, "cannot read %s\n", argv[i]);
+        return 1;
+      }
+    }
+    else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+    {
+      tolerance = atof(argv[++i]);
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [-w width] [-h height] [-n repeat] [-o ppm_output_dir] [-c] [-b] [-a] [-r baseline.csv] [-t percent]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  n = min(w, h);
+  n1 = n - 1;
+  cx = w / 2;
+  cy = h / 2;
+  cx1 = cx - 1;
+  cy1 = cy - 1;
+  cn = min(cx1, cy1);
+  cn1 = cn - 1;
+  tsa = ((w <= 176) || (h <= 160)) ? 1 : (((w <= 240) || (h <= 240)) ? 2 : 3);
+  tsb = ((w <= 272) || (h <= 220)) ? 1 : 2;
+  tsc = ((w <= 220) || (h <= 220)) ? 1 : 2;
+
+  test_bitmap.resize(64 * 64);
+  test_indexed_bitmap.resize(64 * 64);
+  for (int i = 0; i < 64 * 64; ++i)
+  {
+    test_bitmap[i] = RGB565((i & 63) << 2, (i >> 6) << 2, i);
+    test_indexed_bitmap[i] = i ^ (i >> 6);
+  }
+  for (int i = 0; i < 256; ++i)
+  {
+    test_palette[i] = RGB565(i, 255 - i, i << 1);
+  }
+  // soft edged disc: opaque inside, a few pixels of partial alpha, transparent corners
+  test_alpha.resize(64 * 64);
+  test_argb_bitmap.resize(64 * 64);
+  for (int i = 0; i < 64 * 64; ++i)
+  {
+    float dx = (i & 63) - 31.5f;
+    float dy = (i >> 6) - 31.5f;
+    float a = (30.0f - sqrtf(dx * dx + dy * dy)) * 64.0f;
+    test_alpha[i] = (a <= 0) ? 0 : ((a >= 255) ? 255 : (uint8_t)a);
+    test_argb_bitmap[i] = ((uint32_t)test_alpha[i] << 24) | ((uint32_t)((i & 63) << 2) << 16) | ((uint32_t)((i >> 6) << 2) << 8) | (i & 0xFF);
+  }
+
+  // ball frames with a keyed border, a gradient background
+  test_sprite_frames.resize(SPRITE_FRAMES * 16 * 16);
+  for (int i = 0; i < SPRITE_FRAMES * 16 * 16; ++i)
+  {
+    int f = i >> 8;
+    float dx = (i & 15) - 7.5f;
+    float dy = ((i >> 4) & 15) - 7.5f;
+    test_sprite_frames[i] = ((dx * dx + dy * dy) < 56) ? RGB565(255 - f * 48, 64 + f * 48, (i & 15) << 4) : SPRITE_KEY;
+  }
+  test_sprite_background.resize((size_t)w * h);
+  for (int i = 0; i < w * h; ++i)
+  {
+    test_sprite_background[i] = RGB565(0, (i / w) * 255 / h, ((i % w) * 255 / w) >> 1);
+  }
+
+  if (bus_traffic)
+  {
+    return busTraffic(csv);
+  }
+
+  display = new Arduino_Memory_Display(w, h);
+  Arduino_Canvas *canvas = new Arduino_Canvas(w, h, display);
+  PixelCountCanvas *counter = new PixelCountCanvas(w, h, display);
+  display_list = new Arduino_Canvas_DisplayList(w, h, display);
+  if ((!canvas->begin()) || (!counter->begin()) || (!display_list->begin()) || (!beginCompositor(display)) || (!beginSpriteEngine(display)))
+  {
+    fprintf(stderr, "canvas begin failed\n");
+    return 1;
+  }
+  Arduino_Accel_Stub *accel_stub = nullptr;
+  if (accel)
+  {
+    accel_stub = new Arduino_Accel_Stub();
+    canvas->setAccel(accel_stub);
+  }
+
+  if (csv)
+  {
+    printf("test,pixels,ns,ns_per_pixel,mpixel_per_s\n");
+  }
+  else
+  {
+    printf("Arduino_GFX host benchmark %dx%d, best of %d runs\n", w, h, repeat);
+    printf("%-24s %12s %14s %10s %10s\n", "Benchmark", "pixels", "ns", "ns/pixel", "Mpixel/s");
+  }
+
+  for (const benchmark_test_t &t : tests)
+  {
+    // untimed pass to count pixels
+    counter->fillScreen(RGB565_BLACK);
+    counter->pixels = 0;
+    display->resetCounters();
+    t.func(counter);
+    // flush and the tests drawing on the display count the pixels sent to the display
+    uint64_t pixels = ((t.func == testFlush) || t.flush_display) ? display->getPixelCount() : counter->pixels;
+
+    uint64_t best_ns = UINT64_MAX;
+    for (int r = 0; r < repeat; ++r)
+    {
+      canvas->fillScreen(RGB565_BLACK);
+      auto start = std::chrono::steady_clock::now();
+      t.func(canvas);
+      auto end = std::chrono::steady_clock::now();
+      uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+      best_ns = min(best_ns, ns);
+    }
+
+    double ns_per_pixel = pixels ? ((double)best_ns / pixels) : 0;
+    double mpixel_per_s = best_ns ? ((double)pixels * 1000 / best_ns) : 0;
+    if (csv)
+    {
+      printf("%s,%llu,%llu,%.4f,%.1f\n", t.name, (unsigned long long)pixels, (unsigned long long)best_ns, ns_per_pixel, mpixel_per_s);
+    }
+    else
+    {
+      printf("%-24s %12llu %14llu %10.4f %10.1f\n", t.name, (unsigned long long)pixels, (unsigned long long)best_ns, ns_per_pixel, mpixel_per_s);
+    }
+
+    static const char *const columns[] = {"pixels", "ns", "ns_per_pixel", "mpixel_per_s"};
+    const double values[] = {(double)pixels, (double)best_ns, ns_per_pixel, mpixel_per_s};
+    compareBaseline(t.name, values, columns, 2, 2);
+
+    if (ppm_dir)
+    {
+      char filename[256];
+      char *p;
+      snprintf(filename, sizeof(filename), "%s/%s.ppm", ppm_dir, t.name);
+      for (p = filename + strlen(ppm_dir) + 1; *p; ++p)
+      {
+        if ((*p == ' ') || (*p == '/') || (*p == '(') || (*p == ')'))
+        {
+          *p = '_';
+        }
+      }
+      if (t.flush_display)
+      {
+        // the display holds the image of the previous test, a renderer sending nothing must not pass
+        memset(display->getFramebuffer(), 0, (size_t)w * h * 2);
+        t.flush_display();
+      }
+      else
+      {
+        canvas->flush();
+      }
+      display->savePPM(filename);
+      checkImage(t.name, t.same_image_as);
+    }
+  }
+
+  if (accel_stub)
+  {
+    const accel_stats_t *stats = accel_stub->getStats();
+    printf("offloaded %u ops, %u pixels; CPU %u ops, %u pixels\n", stats->hw_ops, stats->hw_pixels, stats->cpu_ops, stats->cpu_pixels);
+  }
+
+  delete sprite_engine;
+  delete compositor;
+  delete display_list;
+  delete counter;
+  delete canvas;
+  delete accel_stub;
+  delete display;
+  if (image_errors)
+  {
+    return 1;
+  }
+  return regressions ? 2 : 0;
+}
@@ -0,0 +1,331 @@
+/*
+ * Host check of the async transfers of Arduino_RecordBus.
+ *
+ * With setAsyncDepth(n) the bus leaves up to n transfers pending, like a DMA bus with a queue.
+ * Transfers must finish in sending order: isTransferDone() of a transfer implies every earlier one is done,
+ * callbacks fire once each and in order, and waitTransfer(), waitWriteDone() and endWrite() drain what they should.
+ * The trace of async writes must equal the trace of the same synchronous writes.
+ *
+ * Arduino_SharedBus is checked on the trace of two Arduino_GC9A01 panels and a mirror device over one
+ * Arduino_RecordBus, with the chip select edges put in between: chip select order, windows not resent
+ * while unchanged, windows restored before RAMWR after another device changed them, mirror writes with both
+ * panels selected and an async write left open closed before the other panel is selected.
+ *
+ * usage: record_bus_check, exits with 1 on any error
+ */
+#include "databus/Arduino_RecordBus.h"
+#include "databus/Arduino_SharedBus.h"
+#include "display/Arduino_GC9A01.h"
+
+#include <string>
+
+#include <vector>
+
+static int errors = 0;
+static std::vector<intptr_t> done_order; // user_ctx of each callback, in call order
+
+static void done_cb(void *user_ctx)
+{
+  done_order.push_back((intptr_t)user_ctx);
+}
+
+static void check(bool ok, const char *what, int depth)
+{
+  if (!ok)
+  {
+    printf("%s failed, depth %d\n", what, depth);
+    ++errors;
+  }
+}
+
+// transfers [0, done) are done and [done, count) are not, callbacks fired for [0, done) in order
+static void checkDone(Arduino_DataBus *bus, const gfx_transfer_t *t, int count, int done, const char *what, int depth)
+{
+  bool ok = ((int)done_order.size() == done);
+  for (int i = 0; i < count; ++i)
+  {
+    ok = ok && (bus->isTransferDone(t[i]) == (i < done));
+    if (i < done)
+    {
+      ok = ok && (done_order[i] == i);
+    }
+  }
+  check(ok, what, depth);
+}
+
+static gfx_transfer_t writeAsync(Arduino_RecordBus *bus, int i, uint16_t *px, uint32_t len)
+{
+  switch (i % 3)
+  {
+  case 0:
+    return bus->writePixelsAsync(px, len, done_cb, (void *)(intptr_t)i);
+  case 1:
+    return bus->writeRepeatAsync(0x1234 + i, len, done_cb, (void *)(intptr_t)i);
+  default:
+    return bus->writeBytesAsync((uint8_t *)px, len * 2, done_cb, (void *)(intptr_t)i);
+  }
+}
+
+static void writeSync(Arduino_RecordBus *bus, int i, uint16_t *px, uint32_t len)
+{
+  switch (i % 3)
+  {
+  case 0:
+    bus->writePixels(px, len);
+    break;
+  case 1:
+    bus->writeRepeat(0x1234 + i, len);
+    break;
+  default:
+    bus->writeBytes((uint8_t *)px, len * 2);
+  }
+}
+
+static void checkDepth(int depth)
+{
+  const int count = 12;
+  uint16_t px[5] = {1, 2, 3, 4, 5};
+  gfx_transfer_t t[count];
+  Arduino_RecordBus bus;
+  bus.begin();
+  bus.setAsyncDepth(depth);
+
+  // each call leaves the last depth transfers pending, handles grow in sending order
+  done_order.clear();
+  bus.beginWrite();
+  for (int i = 0; i < count; ++i)
+  {
+    t[i] = writeAsync(&bus, i, px, 5);
+    check((t[i] != 0) && ((i == 0) || (t[i] > t[i - 1])), "handles in sending order", depth);
+    checkDone(&bus, t, i + 1, max(i + 1 - depth, 0), "transfers left pending", depth);
+  }
+
+  // finishing one transfer finishes every earlier one
+  if (depth)
+  {
+    bus.completeTransfer();
+    checkDone(&bus, t, count, count - depth + 1, "completeTransfer", depth);
+    bus.waitTransfer(t[count - 1]);
+    checkDone(&bus, t, count, count, "waitTransfer", depth);
+  }
+
+  // waitWriteDone() drains the queue
+  done_order.clear();
+  for (int i = 0; i < count; ++i)
+  {
+    t[i] = writeAsync(&bus, i, px, 5);
+  }
+  bus.waitWriteDone();
+  checkDone(&bus, t, count, count, "waitWriteDone", depth);
+
+  // endWrite() drains the queue
+  done_order.clear();
+  for (int i = 0; i < count; ++i)
+  {
+    t[i] = writeAsync(&bus, i, px, 5);
+  }
+  bus.endWrite();
+  checkDone(&bus, t, count, count, "endWrite", depth);
+
+  // the same writes, synchronous
+  Arduino_RecordBus sync;
+  sync.begin();
+  sync.beginWrite();
+  for (int i = 0; i < count; ++i)
+  {
+    writeSync(&sync, i, px, 5);
+  }
+  for (int j = 0; j < 2; ++j)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      writeSync(&sync, i, px, 5);
+    }
+  }
+  sync.endWrite();
+  check((sync.getTraceLength() == bus.getTraceLength()) && (!memcmp(sync.getTrace(), bus.getTrace(), bus.getTraceLength())), "async trace equals sync trace", depth);
+}
+
+// in front of another bus, async transfers are forwarded and finish with the output bus
+static void checkForward(int depth)
+{
+  uint16_t px[5] = {1, 2, 3, 4, 5};
+  gfx_transfer_t t[2];
+  Arduino_RecordBus out;
+  out.begin();
+  out.setAsyncDepth(depth);
+  Arduino_RecordBus front(&out);
+  front.begin();
+
+  done_order.clear();
+  front.beginWrite();
+  t[0] = front.writePixelsAsync(px, 5, done_cb, (void *)0);
+  t[1] = front.writeRepeatAsync(7, 5, done_cb, (void *)1);
+  checkDone(&front, t, 2, max(2 - depth, 0), "forwarded transfers left pending", depth);
+  front.waitWriteDone();
+  checkDone(&front, t, 2, 2, "forwarded waitWriteDone", depth);
+  front.endWrite();
+}
+
+// chip select edges and the trace length when they happened
+typedef struct
+{
+  size_t pos;
+  int pin;
+  int val;
+  size_t done; // callbacks fired before the edge
+} cs_edge_t;
+
+static Arduino_RecordBus *cs_bus;
+static std::vector<cs_edge_t> cs_edges;
+
+static void cs_hook(int pin, int val)
+{
+  cs_edges.push_back({cs_bus->getTraceLength(), pin, val, done_order.size()});
+}
+
+// the trace and the chip select edges since the previous call as text, e.g. "cs6=1 [ caset 0-9 raset 0-9 ramwr repeat 100 ]"
+static std::string sharedTrace(Arduino_RecordBus *bus)
+{
+  const uint8_t *t = bus->getTrace();
+  size_t len = bus->getTraceLength();
+  std::string s;
+  char tok[32];
+  size_t e = 0;
+  uint16_t d1, d2;
+  uint32_t n;
+  for (size_t i = 0;;)
+  {
+    while ((e < cs_edges.size()) && (cs_edges[e].pos <= i))
+    {
+      snprintf(tok, sizeof(tok), " cs%d=%d", cs_edges[e].pin, cs_edges[e].val);
+      s += tok;
+      ++e;
+    }
+    if (i >= len)
+    {
+      break;
+    }
+    uint8_t op = t[i++];
+    switch (op)
+    {
+    case RECORD_BEGIN_WRITE:
+      s += " [";
+      break;
+    case RECORD_END_WRITE:
+      s += " ]";
+      break;
+    case RECORD_COMMAND_8:
+      snprintf(tok, sizeof(tok), (t[i] == SHAREDBUS_RAMWR) ? " ramwr" : " c%02x", t[i]);
+      s += tok;
+      i += 1;
+      break;
+    case RECORD_C8_D16_D16:
+    case RECORD_C8_D16_D16_SPLIT:
+      memcpy(&d1, t + i + 1, 2);
+      memcpy(&d2, t + i + 3, 2);
+      snprintf(tok, sizeof(tok), " %s %u-%u", (t[i] == SHAREDBUS_CASET) ? "caset" : ((t[i] == SHAREDBUS_RASET) ? "raset" : "c8d16d16"), d1, d2);
+      s += tok;
+      i += 5;
+      break;
+    case RECORD_REPEAT:
+      memcpy(&n, t + i + 2, 4);
+      snprintf(tok, sizeof(tok), " repeat %u", n);
+      s += tok;
+      i += 6;
+      break;
+    case RECORD_PIXELS:
+      memcpy(&n, t + i, 4);
+      snprintf(tok, sizeof(tok), " pixels %u", n);
+      s += tok;
+      i += 4 + (n * 2);
+      break;
+    default: // not sent by the checked drawing
+      snprintf(tok, sizeof(tok), " op%u", op);
+      s += tok;
+      i = len;
+    }
+  }
+  bus->clearTrace();
+  cs_edges.clear();
+  return s.empty() ? s : s.substr(1);
+}
+
+static void checkShared(Arduino_RecordBus *bus, const char *expected, const char *what)
+{
+  std::string s = sharedTrace(bus);
+  if (s != expected)
+  {
+    printf("%s failed\n  trace:    %s\n  expected: %s\n", what, s.c_str(), expected);
+    ++errors;
+  }
+}
+
+static void checkSharedBus()
+{
+  const int8_t cs_a = 5, cs_b = 6;
+  uint16_t px[100] = {};
+  Arduino_RecordBus bus;
+  Arduino_SharedBus bus_a(&bus, cs_a);
+  Arduino_SharedBus bus_b(&bus_a, cs_b);
+  Arduino_SharedBus bus_mirror(&bus_a, &bus_b);
+  Arduino_GC9A01 tft_a(&bus_a);
+  Arduino_GC9A01 tft_b(&bus_b);
+  Arduino_GC9A01 tft_mirror(&bus_mirror);
+  if ((!tft_a.begin()) || (!tft_b.begin()) || (!tft_mirror.begin()))
+  {
+    printf("SharedBus begin failed\n");
+    ++errors;
+    return;
+  }
+  cs_bus = &bus;
+  host_digital_write_hook = cs_hook;
+  bus.clearTrace();
+  done_order.clear();
+
+  // the mirror had the bus, panel B is deselected
+  tft_a.fillRect(0, 0, 10, 10, RGB565_RED);
+  checkShared(&bus, "cs6=1 [ caset 0-9 raset 0-9 ramwr repeat 100 ]", "panel A");
+  // the previous panel is deselected before the next one is selected
+  tft_b.fillRect(20, 20, 10, 10, RGB565_RED);
+  checkShared(&bus, "cs5=1 cs6=0 [ caset 20-29 raset 20-29 ramwr repeat 100 ]", "panel B");
+  // panel B did not change the window of panel A
+  tft_a.fillRect(0, 0, 10, 10, RGB565_RED);
+  checkShared(&bus, "cs6=1 cs5=0 [ ramwr repeat 100 ]", "unchanged window of panel A");
+  // both panels selected, the window is sent to both
+  tft_mirror.fillRect(40, 40, 10, 10, RGB565_RED);
+  checkShared(&bus, "cs6=0 [ caset 40-49 raset 40-49 ramwr repeat 100 ]", "mirror");
+  // Arduino_GC9A01 skips its unchanged window, the window the mirror set is restored before RAMWR
+  tft_a.fillRect(0, 0, 10, 10, RGB565_RED);
+  checkShared(&bus, "cs6=1 [ caset 0-9 raset 0-9 ramwr repeat 100 ]", "window restored");
+  // panel B already has the window of the mirror
+  tft_b.fillRect(40, 40, 10, 10, RGB565_RED);
+  checkShared(&bus, "cs5=1 cs6=0 [ ramwr repeat 100 ]", "window set by the mirror not resent");
+
+  // an async write leaves the bus open after endWrite(), selecting panel B finishes it first
+  bus.setAsyncDepth(1);
+  tft_a.startWrite();
+  tft_a.writeAddrWindow(0, 0, 10, 10);
+  gfx_transfer_t t = bus_a.writePixelsAsync(px, 100, done_cb, (void *)0);
+  tft_a.endWrite();
+  check(!bus_a.isTransferDone(t), "SharedBus async write pending after endWrite", 1);
+  tft_b.fillRect(40, 40, 10, 10, RGB565_RED);
+  check((cs_edges.size() == 4) && (cs_edges[2].done == 1) && (cs_edges[3].done == 1), "SharedBus async write done before the chip select switch", 1);
+  checkShared(&bus, "cs6=1 cs5=0 [ ramwr pixels 100 ] cs5=1 cs6=0 [ ramwr repeat 100 ]", "async write closed before panel B");
+
+  host_digital_write_hook = nullptr;
+}
+
+int main()
+{
+  for (int depth = 0; depth < RECORDBUS_ASYNC_QUEUE_SIZE; ++depth) // the deepest queue leaves one slot for the next transfer
+  {
+    checkDepth(depth);
+  }
+  checkForward(1);
+  checkForward(2);
+  checkSharedBus();
+
+  printf("record_bus_check: %d errors\n", errors);
+  return errors ? 1 : 0;
+}
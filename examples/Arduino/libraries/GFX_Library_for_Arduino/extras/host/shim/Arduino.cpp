@@ -0,0 +1,105 @@
+#include "Arduino.h"
+
+#include <stdarg.h>
+#include <chrono>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial;
+void (*host_digital_write_hook)(int pin, int val) = nullptr;
+
+static const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+static std::mt19937 rng;
+
+unsigned long millis()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+unsigned long micros()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+void delay(unsigned long ms)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+long random(long howbig)
+{
+  return (howbig <= 0) ? 0 : (long)(rng() % howbig);
+}
+
+long random(long howsmall, long howbig)
+{
+  return (howsmall >= howbig) ? howsmall : (howsmall + random(howbig - howsmall));
+}
+
+void randomSeed(unsigned long seed)
+{
+  rng.seed(seed);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0)
+  {
+    return 0;
+  }
+  return write(buf, ((size_t)len < sizeof(buf)) ? len : (sizeof(buf) - 1));
+}
+
+size_t Print::printSigned(long n, int base)
+{
+  if ((base == DEC) && (n < 0))
+  {
+    return print('-') + printNumber(-(unsigned long)n, base);
+  }
+  return printNumber((unsigned long)n, base);
+}
+
+size_t Print::printNumber(unsigned long n, int base)
+{
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2)
+  {
+    base = 10;
+  }
+  do
+  {
+    char c = n % base;
+    n /= base;
+    *--str = (c < 10) ? (c + '0') : (c + 'A' - 10);
+  } while (n);
+  return write(str);
+}
+
+size_t Print::print(double n, int digits)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  return fwrite(&c, 1, 1, stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+  return fwrite(buffer, 1, size, stdout);
+}
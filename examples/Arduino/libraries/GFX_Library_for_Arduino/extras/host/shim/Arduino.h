@@ -0,0 +1,119 @@
+/*
+ * Minimal Arduino core shim for building Arduino_GFX on a Linux host.
+ * Only what the library, the host display and the benchmarks need.
+ */
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <algorithm>
+#include <string>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+using std::max;
+using std::min;
+
+template <typename T, typename L, typename H>
+inline T constrain(T amt, L low, H high)
+{
+  return (amt < low) ? low : ((amt > high) ? high : amt);
+}
+
+// Pins do nothing on host, a check can watch the outputs with host_digital_write_hook
+extern void (*host_digital_write_hook)(int pin, int val);
+inline void pinMode(int, int) {}
+inline void digitalWrite(int pin, int val)
+{
+  if (host_digital_write_hook)
+  {
+    host_digital_write_hook(pin, val);
+  }
+}
+inline int digitalRead(int) { return LOW; }
+inline void analogWrite(int, int) {}
+
+// Interrupts never fire on host
+#define CHANGE 0x1
+#define FALLING 0x2
+#define RISING 0x3
+#define digitalPinToInterrupt(p) (p)
+inline void attachInterrupt(int, void (*)(void), int) {}
+inline void detachInterrupt(int) {}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+inline void yield() {}
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+class String : public std::string
+{
+public:
+  String() {}
+  String(const char *s) : std::string(s ? s : "") {}
+  String(const std::string &s) : std::string(s) {}
+  String(int v) : std::string(std::to_string(v)) {}
+  String(long v) : std::string(std::to_string(v)) {}
+  String(unsigned int v) : std::string(std::to_string(v)) {}
+  String(unsigned long v) : std::string(std::to_string(v)) {}
+};
+
+#include "Print.h"
+
+class HardwareSerial : public Print
+{
+public:
+  void begin(unsigned long) {}
+  void setDebugOutput(bool) {}
+  operator bool() { return true; }
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+};
+
+extern HardwareSerial Serial;
+
+#endif // _HOST_ARDUINO_H_
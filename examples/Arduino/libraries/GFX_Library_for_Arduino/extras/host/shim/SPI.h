@@ -0,0 +1,9 @@
+/*
+ * Host stand-in for SPI.h, several display drivers include it without using it.
+ */
+#ifndef _HOST_SPI_H_
+#define _HOST_SPI_H_
+
+#include "Arduino.h"
+
+#endif // _HOST_SPI_H_
@@ -0,0 +1,13 @@
+/*
+ * Host stand-in for U8g2lib.h, Arduino_GFX only needs the font data format.
+ * Its presence enables U8G2_FONT_SUPPORT in Arduino_GFX.h.
+ */
+#ifndef _HOST_U8G2LIB_H_
+#define _HOST_U8G2LIB_H_
+
+#include "Arduino.h"
+
+#define U8G2_WITH_UNICODE
+#define U8G2_FONT_SECTION(name)
+
+#endif // _HOST_U8G2LIB_H_
@@ -0,0 +1 @@
+// u8g2_font_unifont_h_utf8 is not shipped with this copy of the library, placeholder for host build
@@ -0,0 +1 @@
+// u8g2_font_unifont_t_cjk is not shipped with this copy of the library, placeholder for host build
@@ -0,0 +1,243 @@
+#include "Arduino_Accel.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+// true if a nearest scale of src pixels to dst picks the same pixels as draw16bitRGBBitmapScaled() on the CPU:
+// a whole number factor k, the engine takes pixel u / k whatever its sample phase, and the truncated 16.16 step
+// of the CPU kernel does not drift past a pixel boundary over the row
+static bool scale_matches_cpu(int32_t src, int32_t dst)
+{
+  if ((dst % src) != 0)
+  {
+    return false;
+  }
+  int32_t k = dst / src;
+  int32_t step = (src << 16) / dst;
+  return ((src - 1) * (65536 % k)) <= (step >> 1);
+}
+
+Arduino_Accel::Arduino_Accel(uint32_t min_pixels)
+    : _min_pixels(min_pixels)
+{
+  resetStats();
+}
+
+Arduino_Accel::~Arduino_Accel()
+{
+}
+
+bool Arduino_Accel::begin()
+{
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill a rectangle of the framebuffer
+   @param    framebuffer    Framebuffer, rotation 0
+   @param    framebuffer_w  Framebuffer width
+   @param    framebuffer_h  Framebuffer height
+   @param    x              Left x coordinate, preclipped
+   @param    y              Top y coordinate, preclipped
+   @param    w              Width in pixels
+   @param    h              Height in pixels
+   @param    color          16-bit 5-6-5 Color
+   @return   true if filled, false if the caller must fill on the CPU
+*/
+/**************************************************************************/
+bool Arduino_Accel::fillRect(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  uint32_t pixels = (uint32_t)w * h;
+  if ((pixels < _min_pixels) || (!hwFill(framebuffer, framebuffer_w, framebuffer_h, x, y, w, h, color)))
+  {
+    return decline(pixels);
+  }
+  ++_stats.hw_ops;
+  _stats.hw_pixels += pixels;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy a bitmap to the framebuffer, turned by the display rotation
+   @param    bitmap         16-bit 5-6-5 bitmap
+   @param    bitmap_w       Bitmap width
+   @param    bitmap_h       Bitmap height
+   @param    framebuffer    Framebuffer
+   @param    x              Left x coordinate in rotated coordinates
+   @param    y              Top y coordinate in rotated coordinates
+   @param    framebuffer_w  Framebuffer width in rotated coordinates
+   @param    framebuffer_h  Framebuffer height in rotated coordinates
+   @param    rotation       0 to 3, as gfx_draw_bitmap_to_framebuffer() and gfx_draw_bitmap_to_framebuffer_rotate_1..3()
+   @return   true if drawn, false if the caller must draw on the CPU (also if clipped out entirely)
+*/
+/**************************************************************************/
+bool Arduino_Accel::drawBitmap(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h,
+                               uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation)
+{
+  // clip like the CPU functions
+  int16_t src_x = 0, src_y = 0;
+  int16_t w = bitmap_w, h = bitmap_h;
+  if (x < 0)
+  {
+    src_x = -x;
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    src_y = -y;
+    h += y;
+    y = 0;
+  }
+  if ((x + w) > framebuffer_w)
+  {
+    w = framebuffer_w - x;
+  }
+  if ((y + h) > framebuffer_h)
+  {
+    h = framebuffer_h - y;
+  }
+  if ((w <= 0) || (h <= 0))
+  {
+    return false;
+  }
+
+  uint32_t pixels = (uint32_t)w * h;
+  if (pixels < _min_pixels)
+  {
+    return decline(pixels);
+  }
+
+  // the CPU functions turn clockwise, the engine counterclockwise
+  bool result;
+  switch (rotation)
+  {
+  case 1:
+    result = hwBlit(bitmap, bitmap_w, bitmap_h, src_x, src_y, w, h, framebuffer, framebuffer_h, framebuffer_w, framebuffer_h - y - h, x, 3, 16, 16);
+    break;
+  case 2:
+    result = hwBlit(bitmap, bitmap_w, bitmap_h, src_x, src_y, w, h, framebuffer, framebuffer_w, framebuffer_h, framebuffer_w - x - w, framebuffer_h - y - h, 2, 16, 16);
+    break;
+  case 3:
+    result = hwBlit(bitmap, bitmap_w, bitmap_h, src_x, src_y, w, h, framebuffer, framebuffer_h, framebuffer_w, y, framebuffer_w - x - w, 1, 16, 16);
+    break;
+  default: // case 0:
+    result = hwBlit(bitmap, bitmap_w, bitmap_h, src_x, src_y, w, h, framebuffer, framebuffer_w, framebuffer_h, x, y, 0, 16, 16);
+  }
+  if (!result)
+  {
+    return decline(pixels);
+  }
+  ++_stats.hw_ops;
+  _stats.hw_pixels += pixels;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw a bitmap scaled to dst_w x dst_h, rotation 0
+   @param    bitmap         16-bit 5-6-5 bitmap
+   @param    bitmap_w       Bitmap width
+   @param    bitmap_h       Bitmap height
+   @param    framebuffer    Framebuffer
+   @param    x              Left x coordinate
+   @param    y              Top y coordinate
+   @param    framebuffer_w  Framebuffer width
+   @param    framebuffer_h  Framebuffer height
+   @param    dst_w          Scaled width
+   @param    dst_h          Scaled height
+   @return   true if drawn, false if the caller must draw on the CPU: the scale is not a whole number the engine
+             samples like the CPU kernel, the result is clipped or below the threshold
+*/
+/**************************************************************************/
+bool Arduino_Accel::drawScaledBitmap(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h,
+                                     uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, int16_t dst_w, int16_t dst_h)
+{
+  if ((bitmap_w <= 0) || (bitmap_h <= 0) || (dst_w <= 0) || (dst_h <= 0))
+  {
+    return false;
+  }
+  uint32_t pixels = (uint32_t)dst_w * dst_h;
+  int32_t scale_x16 = (int32_t)dst_w * 16 / bitmap_w;
+  int32_t scale_y16 = (int32_t)dst_h * 16 / bitmap_h;
+  if ((pixels < _min_pixels) ||
+      (!scale_matches_cpu(bitmap_w, dst_w)) || (!scale_matches_cpu(bitmap_h, dst_h)) ||
+      (scale_x16 > 255) || (scale_y16 > 255) ||
+      (x < 0) || (y < 0) || ((x + dst_w) > framebuffer_w) || ((y + dst_h) > framebuffer_h) ||
+      (!hwBlit(bitmap, bitmap_w, bitmap_h, 0, 0, bitmap_w, bitmap_h, framebuffer, framebuffer_w, framebuffer_h, x, y, 0, scale_x16, scale_y16)))
+  {
+    return decline(pixels);
+  }
+  ++_stats.hw_ops;
+  _stats.hw_pixels += pixels;
+  return true;
+}
+
+void Arduino_Accel::setMinPixels(uint32_t min_pixels)
+{
+  _min_pixels = min_pixels;
+}
+
+uint32_t Arduino_Accel::getMinPixels()
+{
+  return _min_pixels;
+}
+
+const accel_stats_t *Arduino_Accel::getStats()
+{
+  return &_stats;
+}
+
+void Arduino_Accel::resetStats()
+{
+  _stats.hw_ops = 0;
+  _stats.hw_pixels = 0;
+  _stats.cpu_ops = 0;
+  _stats.cpu_pixels = 0;
+}
+
+bool Arduino_Accel::decline(uint32_t pixels)
+{
+  ++_stats.cpu_ops;
+  _stats.cpu_pixels += pixels;
+  return false;
+}
+
+bool Arduino_Accel::hwFill(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h,
+                           int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  UNUSED(framebuffer);
+  UNUSED(framebuffer_w);
+  UNUSED(framebuffer_h);
+  UNUSED(x);
+  UNUSED(y);
+  UNUSED(w);
+  UNUSED(h);
+  UNUSED(color);
+  return false;
+}
+
+bool Arduino_Accel::hwBlit(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h, int16_t src_x, int16_t src_y, int16_t w, int16_t h,
+                           uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y,
+                           uint8_t quarter_turns, uint8_t scale_x16, uint8_t scale_y16)
+{
+  UNUSED(bitmap);
+  UNUSED(bitmap_w);
+  UNUSED(bitmap_h);
+  UNUSED(src_x);
+  UNUSED(src_y);
+  UNUSED(w);
+  UNUSED(h);
+  UNUSED(framebuffer);
+  UNUSED(framebuffer_w);
+  UNUSED(framebuffer_h);
+  UNUSED(x);
+  UNUSED(y);
+  UNUSED(quarter_turns);
+  UNUSED(scale_x16);
+  UNUSED(scale_y16);
+  return false;
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,62 @@
+#ifndef _ARDUINO_ACCEL_H_
+#define _ARDUINO_ACCEL_H_
+
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef ACCEL_MIN_PIXELS
+#define ACCEL_MIN_PIXELS 4096 // smaller areas are drawn by the CPU, setup and cache sync cost more than they save
+#endif
+
+typedef struct
+{
+  uint32_t hw_ops;
+  uint32_t hw_pixels;
+  uint32_t cpu_ops; // declined, the caller draws them on the CPU
+  uint32_t cpu_pixels;
+} accel_stats_t;
+
+/**
+ * Offloads framebuffer fills and blits to a 2D engine, e.g. the ESP32-P4 PPA.
+ * Each function returns false if the caller must draw on the CPU instead: the area is below the threshold,
+ * the engine cannot do it or is not available. This base class has no engine and declines everything.
+ * Coordinates and framebuffer sizes are the same as gfx_draw_bitmap_to_framebuffer_rotate_1..3().
+ */
+class Arduino_Accel
+{
+public:
+  Arduino_Accel(uint32_t min_pixels = ACCEL_MIN_PIXELS);
+  virtual ~Arduino_Accel();
+
+  virtual bool begin();
+
+  bool fillRect(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  bool drawBitmap(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h,
+                  uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation);
+  bool drawScaledBitmap(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h,
+                        uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, int16_t dst_w, int16_t dst_h);
+
+  void setMinPixels(uint32_t min_pixels);
+  uint32_t getMinPixels();
+  const accel_stats_t *getStats();
+  void resetStats();
+
+protected:
+  bool decline(uint32_t pixels);
+
+  // engine operations in framebuffer (rotation 0) coordinates, preclipped, false if not done
+  virtual bool hwFill(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h,
+                      int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+  // copy the block (src_x, src_y, w, h) of the bitmap turned counterclockwise by quarter_turns and scaled to (x, y)
+  virtual bool hwBlit(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h, int16_t src_x, int16_t src_y, int16_t w, int16_t h,
+                      uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y,
+                      uint8_t quarter_turns, uint8_t scale_x16, uint8_t scale_y16);
+
+  uint32_t _min_pixels;
+  accel_stats_t _stats;
+};
+
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+#endif // _ARDUINO_ACCEL_H_
@@ -215,4 +215,116 @@ void Arduino_DataBus::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_t
   }
 }
 
+/**
+ * @brief writeBytesAsync, send bytes without copying them, the buffer must stay unchanged until the transfer is done.
+ *   Buses with DMA send in the background and call cb from an interrupt, this one sends at once and calls cb before return.
+ *   A few transfers can be in flight, the next async call waits for a free slot.
+ *   Commands, address windows and other bus calls wait for the transfers first, so the order on the wire is kept.
+ *
+ * @param data DMA-capable memory for background transfers
+ * @param len
+ * @param cb nullptr if not needed
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_DataBus::writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  writeBytes(data, len);
+  return syncTransferDone(cb, user_ctx);
+}
+
+/**
+ * @brief writePixelsAsync, send 16-bit pixels in the background, the data must stay unchanged until the transfer is done
+ *
+ * @param data
+ * @param len
+ * @param cb nullptr if not needed
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_DataBus::writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  writePixels(data, len);
+  return syncTransferDone(cb, user_ctx);
+}
+
+/**
+ * @brief writeRepeatAsync, send a color len times in the background
+ *
+ * @param p
+ * @param len
+ * @param cb nullptr if not needed
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_DataBus::writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  writeRepeat(p, len);
+  return syncTransferDone(cb, user_ctx);
+}
+
+/**
+ * @brief isTransferDone, transfers finish in the order they were started
+ *
+ * @param transfer
+ * @return true if the transfer is sent and its buffer can be reused
+ */
+bool Arduino_DataBus::isTransferDone(gfx_transfer_t transfer)
+{
+  return (!transfer) || ((int32_t)(_transfer_done - transfer) >= 0);
+}
+
+/**
+ * @brief waitTransfer, wait until the transfer is sent, and the ones started before it
+ *
+ * @param transfer
+ */
+void Arduino_DataBus::waitTransfer(gfx_transfer_t transfer)
+{
+  if (!isTransferDone(transfer))
+  {
+    waitWriteDone();
+  }
+}
+
+/**
+ * @brief waitWriteDone, wait until every background transfer is sent
+ */
+void Arduino_DataBus::waitWriteDone()
+{
+}
+
+/**
+ * @brief nextTransfer, handle of a new async transfer
+ *
+ * @return never 0
+ */
+gfx_transfer_t Arduino_DataBus::nextTransfer()
+{
+  if (!++_transfer_started)
+  {
+    ++_transfer_started;
+  }
+  return _transfer_started;
+}
+
+/**
+ * @brief syncTransferDone, finish an async call that was sent at once
+ *
+ * @param cb
+ * @param user_ctx
+ * @return handle, already done
+ */
+gfx_transfer_t Arduino_DataBus::syncTransferDone(gfx_write_done_cb_t cb, void *user_ctx)
+{
+  waitWriteDone();
+  gfx_transfer_t transfer = nextTransfer();
+  _transfer_done = transfer;
+  if (cb)
+  {
+    cb(user_ctx);
+  }
+  return transfer;
+}
+
 #endif // !defined(LITTLE_FOOT_PRINT)
@@ -259,6 +259,13 @@ union
   };
 } _data16;
 
+#if !defined(LITTLE_FOOT_PRINT)
+// called when an async transfer is done, from an interrupt on buses that send in the background
+typedef void (*gfx_write_done_cb_t)(void *user_ctx);
+// handle of an async transfer, numbered in sending order, 0 for none
+typedef uint32_t gfx_transfer_t;
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 class Arduino_DataBus
 {
 public:
@@ -295,11 +302,25 @@ public:
   virtual void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len);
   virtual void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len);
   virtual void writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_t *crData, uint16_t w, uint16_t h);
+  virtual gfx_transfer_t writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr);
+  virtual gfx_transfer_t writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr);
+  virtual gfx_transfer_t writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr);
+  virtual bool isTransferDone(gfx_transfer_t transfer);
+  void waitTransfer(gfx_transfer_t transfer);
+  virtual void waitWriteDone();
 #else
   void batchOperation(const uint8_t *operations, size_t len);
 #endif // !defined(LITTLE_FOOT_PRINT)
 
 protected:
+#if !defined(LITTLE_FOOT_PRINT)
+  gfx_transfer_t nextTransfer();
+  gfx_transfer_t syncTransferDone(gfx_write_done_cb_t cb, void *user_ctx);
+
+  gfx_transfer_t _transfer_started = 0;       // last handle given out
+  volatile gfx_transfer_t _transfer_done = 0; // last handle sent out, set from the completion interrupt
+#endif // !defined(LITTLE_FOOT_PRINT)
+
   int32_t _speed;
   int8_t _dataMode;
 };
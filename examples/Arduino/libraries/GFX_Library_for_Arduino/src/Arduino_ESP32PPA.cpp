@@ -0,0 +1,114 @@
+#include "Arduino_ESP32PPA.h"
+
+#if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
+
+Arduino_ESP32PPA::Arduino_ESP32PPA(uint32_t min_pixels)
+    : Arduino_Accel(min_pixels)
+{
+}
+
+Arduino_ESP32PPA::~Arduino_ESP32PPA()
+{
+  if (_fill_client)
+  {
+    ppa_unregister_client(_fill_client);
+  }
+  if (_srm_client)
+  {
+    ppa_unregister_client(_srm_client);
+  }
+}
+
+bool Arduino_ESP32PPA::begin()
+{
+  if (!_fill_client)
+  {
+    ppa_client_config_t fill_config = {};
+    fill_config.oper_type = PPA_OPERATION_FILL;
+    fill_config.max_pending_trans_num = 1;
+    if (ppa_register_client(&fill_config, &_fill_client) != ESP_OK)
+    {
+      _fill_client = nullptr;
+      return false;
+    }
+  }
+  if (!_srm_client)
+  {
+    ppa_client_config_t srm_config = {};
+    srm_config.oper_type = PPA_OPERATION_SRM;
+    srm_config.max_pending_trans_num = 1;
+    if (ppa_register_client(&srm_config, &_srm_client) != ESP_OK)
+    {
+      _srm_client = nullptr;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Arduino_ESP32PPA::hwFill(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h,
+                              int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  if (!_fill_client)
+  {
+    return false;
+  }
+
+  // dirty cache lines written back later would overwrite the engine output
+  esp_cache_msync(framebuffer + ((int32_t)y * framebuffer_w), (int32_t)framebuffer_w * h * 2, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+
+  ppa_fill_oper_config_t config = {};
+  config.out.buffer = framebuffer;
+  config.out.buffer_size = (uint32_t)framebuffer_w * framebuffer_h * 2;
+  config.out.pic_w = framebuffer_w;
+  config.out.pic_h = framebuffer_h;
+  config.out.block_offset_x = x;
+  config.out.block_offset_y = y;
+  config.out.fill_cm = PPA_FILL_COLOR_MODE_RGB565;
+  config.fill_block_w = w;
+  config.fill_block_h = h;
+  // RGB565 to ARGB8888, the engine converts back without loss
+  config.fill_argb_color.val = 0xFF000000 | ((uint32_t)(color & 0xF800) << 8) | ((uint32_t)(color & 0x07E0) << 5) | ((uint32_t)(color & 0x001F) << 3);
+  config.mode = PPA_TRANS_MODE_BLOCKING;
+  return ppa_do_fill(_fill_client, &config) == ESP_OK;
+}
+
+bool Arduino_ESP32PPA::hwBlit(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h, int16_t src_x, int16_t src_y, int16_t w, int16_t h,
+                              uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y,
+                              uint8_t quarter_turns, uint8_t scale_x16, uint8_t scale_y16)
+{
+  static const ppa_srm_rotation_angle_t angles[4] = {
+      PPA_SRM_ROTATION_ANGLE_0, PPA_SRM_ROTATION_ANGLE_90, PPA_SRM_ROTATION_ANGLE_180, PPA_SRM_ROTATION_ANGLE_270};
+
+  if (!_srm_client)
+  {
+    return false;
+  }
+
+  int32_t out_h = ((quarter_turns & 1) ? w : h) * scale_y16 / 16;
+  esp_cache_msync(framebuffer + ((int32_t)y * framebuffer_w), framebuffer_w * out_h * 2, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+
+  ppa_srm_oper_config_t config = {};
+  config.in.buffer = bitmap;
+  config.in.pic_w = bitmap_w;
+  config.in.pic_h = bitmap_h;
+  config.in.block_w = w;
+  config.in.block_h = h;
+  config.in.block_offset_x = src_x;
+  config.in.block_offset_y = src_y;
+  config.in.srm_cm = PPA_SRM_COLOR_MODE_RGB565;
+  config.out.buffer = framebuffer;
+  config.out.buffer_size = (uint32_t)framebuffer_w * framebuffer_h * 2;
+  config.out.pic_w = framebuffer_w;
+  config.out.pic_h = framebuffer_h;
+  config.out.block_offset_x = x;
+  config.out.block_offset_y = y;
+  config.out.srm_cm = PPA_SRM_COLOR_MODE_RGB565;
+  config.rotation_angle = angles[quarter_turns & 3];
+  config.scale_x = scale_x16 / 16.0f;
+  config.scale_y = scale_y16 / 16.0f;
+  config.mode = PPA_TRANS_MODE_BLOCKING;
+  return ppa_do_scale_rotate_mirror(_srm_client, &config) == ESP_OK;
+}
+
+#endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
@@ -0,0 +1,40 @@
+#ifndef _ARDUINO_ESP32PPA_H_
+#define _ARDUINO_ESP32PPA_H_
+
+#include "Arduino_DataBus.h"
+
+#if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
+
+#include "Arduino_Accel.h"
+
+#include <esp_cache.h>
+#include <driver/ppa.h>
+
+/**
+ * Fills and blits on the ESP32-P4 pixel processing accelerator.
+ * Operations are blocking. The destination rows are written back from the CPU cache first,
+ * the PPA driver writes back the source and invalidates the destination.
+ * Destination framebuffers must be cache line aligned, e.g. the DSI framebuffer, otherwise the CPU draws.
+ */
+class Arduino_ESP32PPA : public Arduino_Accel
+{
+public:
+  Arduino_ESP32PPA(uint32_t min_pixels = ACCEL_MIN_PIXELS);
+  ~Arduino_ESP32PPA();
+
+  bool begin() override;
+
+protected:
+  bool hwFill(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h,
+              int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  bool hwBlit(const uint16_t *bitmap, int16_t bitmap_w, int16_t bitmap_h, int16_t src_x, int16_t src_y, int16_t w, int16_t h,
+              uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, int16_t x, int16_t y,
+              uint8_t quarter_turns, uint8_t scale_x16, uint8_t scale_y16) override;
+
+  ppa_client_handle_t _fill_client = nullptr;
+  ppa_client_handle_t _srm_client = nullptr;
+};
+
+#endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
+
+#endif // _ARDUINO_ESP32PPA_H_
@@ -0,0 +1,190 @@
+#include "Arduino_FrameSync.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+Arduino_FrameSync::Arduino_FrameSync()
+{
+  resetStats();
+}
+
+Arduino_FrameSync::~Arduino_FrameSync()
+{
+#if defined(ESP32)
+  if (_vsync_sem)
+  {
+    vSemaphoreDelete(_vsync_sem);
+  }
+#endif // defined(ESP32)
+}
+
+bool Arduino_FrameSync::begin()
+{
+#if defined(ESP32)
+  if (!_vsync_sem)
+  {
+    _vsync_sem = xSemaphoreCreateBinary();
+  }
+  return _vsync_sem != nullptr;
+#else
+  return true;
+#endif // defined(ESP32)
+}
+
+/**************************************************************************/
+/*!
+   @brief    Count a panel refresh, called from the interrupt of the sync source
+   @return   true if a higher priority task was woken, the ISR should yield
+*/
+/**************************************************************************/
+bool FRAME_SYNC_ISR_ATTR Arduino_FrameSync::notifyVSync()
+{
+  uint32_t now = micros();
+  if (_vsyncs)
+  {
+    _period_us = now - _last_vsync_us;
+  }
+  _last_vsync_us = now;
+  _vsyncs = _vsyncs + 1;
+
+#if defined(ESP32)
+  BaseType_t high_task_woken = pdFALSE;
+  if (_vsync_sem)
+  {
+    xSemaphoreGiveFromISR(_vsync_sem, &high_task_woken);
+  }
+  return high_task_woken == pdTRUE;
+#else
+  return false;
+#endif // defined(ESP32)
+}
+
+// gfx_vsync_cb_t of a panel, user_ctx is the Arduino_FrameSync
+bool FRAME_SYNC_ISR_ATTR Arduino_FrameSync::vsyncCallback(void *frame_sync)
+{
+  return ((Arduino_FrameSync *)frame_sync)->notifyVSync();
+}
+
+/**************************************************************************/
+/*!
+   @brief    Wait until the panel has just started a new refresh, the next frame can be sent without tearing.
+    A frame that was late waits for the next refresh only. With a frame interval of n,
+    it also waits until n refreshes have passed since the previous framePresented().
+   @param    timeout_ms  Give up after this time, e.g. if the sync signal is not connected
+   @return   false on timeout
+*/
+/**************************************************************************/
+bool Arduino_FrameSync::waitForVSync(uint32_t timeout_ms)
+{
+  uint32_t start = _vsyncs;
+  uint32_t start_ms = millis();
+  while (true)
+  {
+    uint32_t vsyncs = _vsyncs;
+    if ((vsyncs != start) && ((!_presented) || ((vsyncs - _present_vsync) >= _interval)))
+    {
+      _wait_vsync = vsyncs;
+      _waited = true;
+      return true;
+    }
+
+    uint32_t elapsed = millis() - start_ms;
+    if (elapsed >= timeout_ms)
+    {
+      ++_stats.timeouts;
+      return false;
+    }
+#if defined(ESP32)
+    if (_vsync_sem)
+    {
+      xSemaphoreTake(_vsync_sem, pdMS_TO_TICKS(timeout_ms - elapsed) + 1);
+      continue;
+    }
+#endif // defined(ESP32)
+    yield();
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Count a frame sent out, after waitForVSync() and drawing
+*/
+/**************************************************************************/
+void Arduino_FrameSync::framePresented()
+{
+  uint32_t now = micros();
+  uint32_t vsync = _waited ? _wait_vsync : _vsyncs;
+  if (_presented)
+  {
+    uint32_t refreshes = vsync - _present_vsync;
+    if (refreshes > _interval)
+    {
+      _stats.missed += refreshes - _interval;
+    }
+    ++_window_frames;
+    uint32_t window_us = now - _window_start_us;
+    if (window_us >= (FRAME_SYNC_FPS_WINDOW_MS * 1000UL))
+    {
+      _stats.fps = (float)_window_frames * 1000000 / window_us;
+      _window_start_us = now;
+      _window_frames = 0;
+    }
+  }
+  else
+  {
+    _window_start_us = now;
+    _window_frames = 0;
+  }
+  _present_vsync = vsync;
+  _presented = true;
+  _waited = false;
+  ++_stats.frames;
+}
+
+// present every n-th refresh, e.g. 2 for 30 fps on a 60 Hz panel
+void Arduino_FrameSync::setFrameInterval(uint8_t interval)
+{
+  _interval = (interval < 1) ? 1 : interval;
+}
+
+uint8_t Arduino_FrameSync::getFrameInterval()
+{
+  return _interval;
+}
+
+uint32_t Arduino_FrameSync::getVSyncCount()
+{
+  return _vsyncs;
+}
+
+float Arduino_FrameSync::getRefreshRate()
+{
+  uint32_t period_us = _period_us;
+  return period_us ? (1000000.0f / period_us) : 0;
+}
+
+float Arduino_FrameSync::getFPS()
+{
+  return _stats.fps;
+}
+
+const frame_sync_stats_t *Arduino_FrameSync::getStats()
+{
+  _stats.vsyncs = _vsyncs;
+  _stats.period_us = _period_us;
+  return &_stats;
+}
+
+void Arduino_FrameSync::resetStats()
+{
+  _vsyncs = 0;
+  _presented = false;
+  _waited = false;
+  _stats.vsyncs = 0;
+  _stats.frames = 0;
+  _stats.missed = 0;
+  _stats.timeouts = 0;
+  _stats.period_us = 0;
+  _stats.fps = 0;
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
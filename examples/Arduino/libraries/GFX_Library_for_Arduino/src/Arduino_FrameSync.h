@@ -0,0 +1,87 @@
+#ifndef _ARDUINO_FRAMESYNC_H_
+#define _ARDUINO_FRAMESYNC_H_
+
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif // defined(ESP32)
+
+#if defined(ESP32) || defined(ESP8266)
+#define FRAME_SYNC_ISR_ATTR IRAM_ATTR
+#else
+#define FRAME_SYNC_ISR_ATTR
+#endif
+
+#ifndef FRAME_SYNC_TIMEOUT_MS
+#define FRAME_SYNC_TIMEOUT_MS 100 // longer than the slowest refresh, waitForVSync() gives up after it
+#endif
+#ifndef FRAME_SYNC_FPS_WINDOW_MS
+#define FRAME_SYNC_FPS_WINDOW_MS 1000
+#endif
+
+// called from the interrupt of a sync source, returns true if a higher priority task was woken
+typedef bool (*gfx_vsync_cb_t)(void *user_ctx);
+
+typedef struct
+{
+  uint32_t vsyncs;    // panel refreshes
+  uint32_t frames;    // frames presented
+  uint32_t missed;    // refreshes that showed the previous frame again because the next one was late
+  uint32_t timeouts;  // waitForVSync() gave up, the sync signal is missing
+  uint32_t period_us; // last refresh period
+  float fps;          // frames presented per second over the last window
+} frame_sync_stats_t;
+
+/**
+ * Counts the refreshes of a panel and lets drawing wait for the next one.
+ * The source calls notifyVSync() from its interrupt: the TE pin of a MIPI DCS controller,
+ * the VSYNC or bounce buffer done event of an RGB panel, the refresh done event of a MIPI DSI panel.
+ */
+class Arduino_FrameSync
+{
+public:
+  Arduino_FrameSync();
+  ~Arduino_FrameSync();
+
+  bool begin();
+
+  bool notifyVSync();
+  static bool vsyncCallback(void *frame_sync);
+  bool waitForVSync(uint32_t timeout_ms = FRAME_SYNC_TIMEOUT_MS);
+  void framePresented();
+
+  void setFrameInterval(uint8_t interval);
+  uint8_t getFrameInterval();
+  uint32_t getVSyncCount();
+  float getRefreshRate();
+  float getFPS();
+  const frame_sync_stats_t *getStats();
+  void resetStats();
+
+protected:
+  volatile uint32_t _vsyncs = 0;
+  volatile uint32_t _last_vsync_us = 0;
+  volatile uint32_t _period_us = 0;
+
+  uint8_t _interval = 1;
+  uint32_t _wait_vsync = 0;    // refresh that waitForVSync() returned at
+  uint32_t _present_vsync = 0; // refresh of the previous framePresented()
+  bool _waited = false;
+  bool _presented = false;
+
+  uint32_t _window_start_us = 0;
+  uint32_t _window_frames = 0;
+  frame_sync_stats_t _stats;
+
+#if defined(ESP32)
+  SemaphoreHandle_t _vsync_sem = nullptr;
+#endif // defined(ESP32)
+};
+
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+#endif // _ARDUINO_FRAMESYNC_H_
@@ -11,7 +11,214 @@ Arduino_G::Arduino_G(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h)
 {
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
+/**************************************************************************/
+/*!
+   @brief    Draw a 16-bit Big Endian (wire order) image, by default swapped in small chunks for draw16bitRGBBitmap()
+   @param    x       Top left corner x coordinate
+   @param    y       Top left corner y coordinate
+   @param    bitmap  Big Endian RGB565 pixels
+   @param    w       Width of bitmap in pixels
+   @param    h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Arduino_G::draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+  uint16_t buf[64];
+  for (int16_t j = 0; j < h; j++)
+  {
+    for (int16_t i = 0; i < w; i += 64)
+    {
+      int16_t len = ((w - i) < 64) ? (w - i) : 64;
+      for (int16_t k = 0; k < len; k++)
+      {
+        MSB_16_SET(buf[k], bitmap[i + k]);
+      }
+      draw16bitRGBBitmap(x + i, y + j, buf, len, 1);
+    }
+    bitmap += w;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Refresh counter of the panel, for waitForVSync()
+   @return   nullptr if the display has no sync signal
+*/
+/**************************************************************************/
+Arduino_FrameSync *Arduino_G::getFrameSync()
+{
+  return nullptr;
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+// ESP32-S3 PIE 128-bit store, disable by defining GFX_DISABLE_PIE
+#if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32S3) && !defined(GFX_DISABLE_PIE)
+#define GFX_USE_PIE
+#endif
+
 // utility functions
+
+/**************************************************************************/
+/*!
+   @brief    Fill 16-bit pixels, 32-bit stores with 128-bit unrolled main loop
+   @param    dst     Destination, must be 2-byte aligned
+   @param    color   16-bit color
+   @param    len     Number of pixels
+*/
+/**************************************************************************/
+void gfx_fill_16bit(uint16_t *dst, uint16_t color, uint32_t len)
+{
+  if (len < 8)
+  {
+    while (len--)
+    {
+      *dst++ = color;
+    }
+    return;
+  }
+
+  if ((uintptr_t)dst & 2)
+  {
+    *dst++ = color;
+    --len;
+  }
+  uint32_t c32 = color | ((uint32_t)color << 16);
+  uint32_t *d32 = (uint32_t *)dst;
+
+#if defined(GFX_USE_PIE)
+  while (((uintptr_t)d32 & 15) && (len >= 2))
+  {
+    *d32++ = c32;
+    len -= 2;
+  }
+  uint32_t n = len >> 3;
+  if (n)
+  {
+    __asm__ __volatile__(
+        "ee.vldbc.32 q0, %[c]\n"
+        "loopnez %[n], 1f\n"
+        "ee.vst.128.ip q0, %[d], 16\n"
+        "1:\n"
+        : [d] "+r"(d32)
+        : [c] "r"(&c32), [n] "r"(n)
+        : "memory");
+    len &= 7;
+  }
+#endif
+
+  uint32_t n4 = len >> 3;
+  while (n4--)
+  {
+    d32[0] = c32;
+    d32[1] = c32;
+    d32[2] = c32;
+    d32[3] = c32;
+    d32 += 4;
+  }
+  len &= 7;
+  while (len >= 2)
+  {
+    *d32++ = c32;
+    len -= 2;
+  }
+  if (len)
+  {
+    *((uint16_t *)d32) = color;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill a rectangle of 16-bit pixels
+   @param    dst         Top left pixel of the rectangle
+   @param    dst_stride  Destination row length in pixels
+   @param    w           Width in pixels
+   @param    h           Height in pixels
+   @param    color       16-bit color
+*/
+/**************************************************************************/
+void gfx_fill_rect_16bit(uint16_t *dst, int16_t dst_stride, int16_t w, int16_t h, uint16_t color)
+{
+  if (w == dst_stride)
+  {
+    gfx_fill_16bit(dst, color, (uint32_t)w * h);
+  }
+  else
+  {
+    while (h--)
+    {
+      gfx_fill_16bit(dst, color, w);
+      dst += dst_stride;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Copy a rectangle of 16-bit pixels, memcpy per row or once if both are contiguous
+   @param    dst         Top left pixel of destination
+   @param    dst_stride  Destination row length in pixels
+   @param    src         Top left pixel of source
+   @param    src_stride  Source row length in pixels
+   @param    w           Width in pixels
+   @param    h           Height in pixels
+*/
+/**************************************************************************/
+void gfx_copy_rect_16bit(uint16_t *dst, int16_t dst_stride, const uint16_t *src, int16_t src_stride, int16_t w, int16_t h)
+{
+  if ((w == dst_stride) && (w == src_stride))
+  {
+    memcpy(dst, src, (size_t)w * h * 2);
+  }
+  else
+  {
+    while (h--)
+    {
+      memcpy(dst, src, w * 2);
+      dst += dst_stride;
+      src += src_stride;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Swap the bytes of a rectangle of 16-bit pixels in place, between host and wire (Big Endian) order
+   @param    dst         Top left pixel
+   @param    dst_stride  Row length in pixels
+   @param    w           Width in pixels
+   @param    h           Height in pixels
+*/
+/**************************************************************************/
+void gfx_swap_rect_16bit(uint16_t *dst, int16_t dst_stride, int16_t w, int16_t h)
+{
+  while (h-- > 0)
+  {
+    uint16_t *p = dst;
+    int16_t len = w;
+    if (((uintptr_t)p & 2) && (len > 0))
+    {
+      MSB_16_SET(*p, *p);
+      ++p;
+      --len;
+    }
+    uint32_t *p32 = (uint32_t *)p;
+    while (len >= 2)
+    {
+      uint32_t v = *p32;
+      *p32++ = ((v & 0x00ff00ff) << 8) | ((v >> 8) & 0x00ff00ff);
+      len -= 2;
+    }
+    if (len > 0)
+    {
+      p = (uint16_t *)p32;
+      MSB_16_SET(*p, *p);
+    }
+    dst += dst_stride;
+  }
+}
+
 bool gfx_draw_bitmap_to_framebuffer(
     uint16_t *from_bitmap, int16_t bitmap_w, int16_t bitmap_h,
     uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h)
@@ -56,38 +263,7 @@ bool gfx_draw_bitmap_to_framebuffer(
     uint16_t *row = framebuffer;
     row += y * framebuffer_w; // shift framebuffer to y offset
     row += x;                 // shift framebuffer to x offset
-    if (((framebuffer_w & 1) == 0) && ((x_skip & 1) == 0) && ((bitmap_w & 1) == 0))
-    {
-      uint32_t *row2 = (uint32_t *)row;
-      uint32_t *from_bitmap2 = (uint32_t *)from_bitmap;
-      int16_t framebuffer_w2 = framebuffer_w >> 1;
-      int16_t xskip2 = x_skip >> 1;
-      int16_t w2 = bitmap_w >> 1;
-
-      int16_t j = bitmap_h;
-      while (j--)
-      {
-        for (int16_t i = 0; i < w2; ++i)
-        {
-          row2[i] = *from_bitmap2++;
-        }
-        from_bitmap2 += xskip2;
-        row2 += framebuffer_w2;
-      }
-    }
-    else
-    {
-      int16_t j = bitmap_h;
-      while (j--)
-      {
-        for (int i = 0; i < bitmap_w; ++i)
-        {
-          row[i] = *from_bitmap++;
-        }
-        from_bitmap += x_skip;
-        row += framebuffer_w;
-      }
-    }
+    gfx_copy_rect_16bit(row, framebuffer_w, from_bitmap, bitmap_w + x_skip, bitmap_w, bitmap_h);
     return true;
   }
 }
@@ -139,7 +315,7 @@ bool gfx_draw_bitmap_to_framebuffer_rotate_1(
     {
       p = framebuffer;
       p += (x * framebuffer_h);     // shift framebuffer to y offset
-      p += (framebuffer_h - y - j); // shift framebuffer to x offset
+      p += (max_Y - y - j);         // shift framebuffer to x offset
 
       i = bitmap_w;
       while (i--)
@@ -273,3 +449,768 @@ bool gfx_draw_bitmap_to_framebuffer_rotate_3(
     return true;
   }
 }
+
+// 4-bit alpha to the 0-32 blend weight
+static const uint8_t alpha4_weight[16] = {0, 2, 4, 6, 9, 11, 13, 15, 17, 19, 21, 23, 26, 28, 30, 32};
+
+GFX_INLINE static uint16_t gfx_blend_weight_16bit(uint16_t fg, uint16_t bg, uint32_t weight)
+{
+  // spread 5-6-5 channels to 0b00000GGGGGG00000RRRRR000000BBBBB so that one multiply blends all of them
+  uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F;
+  uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F;
+  uint32_t r = ((f * weight + b * (32 - weight)) >> 5) & 0x07E0F81F;
+  return (uint16_t)(r | (r >> 16));
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend 2 16-bit colors
+   @param    fg      Foreground color
+   @param    bg      Background color
+   @param    alpha   Foreground opacity, 0 - 255
+   @return   Blended color
+*/
+/**************************************************************************/
+uint16_t gfx_blend_16bit(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+  return gfx_blend_weight_16bit(fg, bg, (alpha + 4) >> 3);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Fill a lookup table of blended colors for opaque alpha drawing
+   @param    lut     16 entries for 4-bit alpha, 33 entries (by blend weight) for 8-bit alpha
+   @param    color   Foreground color
+   @param    bg      Background color
+   @param    bpp     Alpha bits per pixel, 4 or 8
+*/
+/**************************************************************************/
+void gfx_alpha_lut_16bit(uint16_t *lut, uint16_t color, uint16_t bg, uint8_t bpp)
+{
+  if (bpp == 4)
+  {
+    for (uint8_t i = 0; i < 16; ++i)
+    {
+      lut[i] = gfx_blend_weight_16bit(color, bg, alpha4_weight[i]);
+    }
+  }
+  else
+  {
+    for (uint8_t i = 0; i <= 32; ++i)
+    {
+      lut[i] = gfx_blend_weight_16bit(color, bg, i);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Expand an alpha row to 16-bit pixels through a lookup table, destination is not read
+   @param    dst        First destination pixel
+   @param    dst_step   Distance between destination pixels, negative or row length for rotated framebuffers
+   @param    alpha      Alpha row, 4-bit pixels are high nibble first
+   @param    bpp        Alpha bits per pixel, 4 or 8
+   @param    skip       Pixels to skip from the row start
+   @param    len        Number of pixels
+   @param    lut        Table from gfx_alpha_lut_16bit()
+*/
+/**************************************************************************/
+void gfx_expand_alpha_16bit(uint16_t *dst, int32_t dst_step, const uint8_t *alpha, uint8_t bpp, int16_t skip, int16_t len, const uint16_t *lut)
+{
+  if (bpp == 4)
+  {
+    alpha += skip >> 1;
+    if (skip & 1)
+    {
+      *dst = lut[*alpha++ & 0x0F];
+      dst += dst_step;
+      --len;
+    }
+    while (len >= 2)
+    {
+      uint8_t a = *alpha++;
+      *dst = lut[a >> 4];
+      dst += dst_step;
+      *dst = lut[a & 0x0F];
+      dst += dst_step;
+      len -= 2;
+    }
+    if (len)
+    {
+      *dst = lut[*alpha >> 4];
+    }
+  }
+  else
+  {
+    alpha += skip;
+    while (len--)
+    {
+      *dst = lut[(*alpha++ + 4) >> 3];
+      dst += dst_step;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend a color onto 16-bit pixels through an alpha row, read-modify-write
+   @param    dst        First destination pixel
+   @param    dst_step   Distance between destination pixels, negative or row length for rotated framebuffers
+   @param    alpha      Alpha row, 4-bit pixels are high nibble first
+   @param    bpp        Alpha bits per pixel, 4 or 8
+   @param    skip       Pixels to skip from the row start
+   @param    len        Number of pixels
+   @param    color      Foreground color
+*/
+/**************************************************************************/
+void gfx_blend_alpha_16bit(uint16_t *dst, int32_t dst_step, const uint8_t *alpha, uint8_t bpp, int16_t skip, int16_t len, uint16_t color)
+{
+  uint32_t f = (color | ((uint32_t)color << 16)) & 0x07E0F81F;
+  for (int16_t i = skip; i < (skip + len); ++i, dst += dst_step)
+  {
+    uint32_t weight;
+    if (bpp == 4)
+    {
+      weight = alpha4_weight[(i & 1) ? (alpha[i >> 1] & 0x0F) : (alpha[i >> 1] >> 4)];
+    }
+    else
+    {
+      weight = (alpha[i] + 4) >> 3;
+    }
+
+    if (weight == 32)
+    {
+      *dst = color; // opaque
+    }
+    else if (weight)
+    {
+      uint32_t b = (*dst | ((uint32_t)*dst << 16)) & 0x07E0F81F;
+      uint32_t r = ((f * weight + b * (32 - weight)) >> 5) & 0x07E0F81F;
+      *dst = (uint16_t)(r | (r >> 16));
+    }
+  }
+}
+
+// clip a bitmap to a framebuffer of any rotation, coordinates are rotated, false if nothing is visible
+static bool gfx_framebuffer_clip(int16_t *x, int16_t *y, int16_t *skip_x, int16_t *skip_y, int16_t *w, int16_t *h,
+                                 int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation)
+{
+  int16_t max_w = (rotation & 1) ? framebuffer_h : framebuffer_w;
+  int16_t max_h = (rotation & 1) ? framebuffer_w : framebuffer_h;
+  if (
+      ((*x + *w - 1) < 0) || // Outside left
+      ((*y + *h - 1) < 0) || // Outside top
+      (*x >= max_w) ||       // Outside right
+      (*y >= max_h)          // Outside bottom
+  )
+  {
+    return false;
+  }
+
+  *skip_x = 0;
+  *skip_y = 0;
+  if (*x < 0)
+  {
+    *skip_x = -*x;
+    *w += *x;
+    *x = 0;
+  }
+  if ((*x + *w) > max_w)
+  {
+    *w = max_w - *x;
+  }
+  if (*y < 0)
+  {
+    *skip_y = -*y;
+    *h += *y;
+    *y = 0;
+  }
+  if ((*y + *h) > max_h)
+  {
+    *h = max_h - *y;
+  }
+  return true;
+}
+
+// framebuffer position of rotated coordinates (x, y) and the steps along a rotated row and column
+static void gfx_framebuffer_steps(int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation,
+                                  int32_t *pos, int32_t *step_x, int32_t *step_y)
+{
+  switch (rotation)
+  {
+  case 1:
+    *pos = (int32_t)x * framebuffer_w + (framebuffer_w - 1 - y);
+    *step_x = framebuffer_w;
+    *step_y = -1;
+    break;
+  case 2:
+    *pos = (int32_t)(framebuffer_h - 1 - y) * framebuffer_w + (framebuffer_w - 1 - x);
+    *step_x = -1;
+    *step_y = -framebuffer_w;
+    break;
+  case 3:
+    *pos = (int32_t)(framebuffer_h - 1 - x) * framebuffer_w + y;
+    *step_x = -framebuffer_w;
+    *step_y = 1;
+    break;
+  default: // case 0:
+    *pos = (int32_t)y * framebuffer_w + x;
+    *step_x = 1;
+    *step_y = framebuffer_w;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw an alpha bitmap to a 16-bit framebuffer of any rotation
+   @param    bitmap          Alpha rows, each starts on a byte boundary
+   @param    bpp             Alpha bits per pixel, 4 or 8
+   @param    bitmap_w        Width in pixels
+   @param    bitmap_h        Height in pixels
+   @param    color           Foreground color
+   @param    bg              Background color, same as color to blend with the framebuffer content
+   @param    framebuffer     Framebuffer
+   @param    x               Left, in rotated coordinates
+   @param    y               Top, in rotated coordinates
+   @param    framebuffer_w   Framebuffer width, not rotated
+   @param    framebuffer_h   Framebuffer height, not rotated
+   @param    rotation        0 - 3, same mapping as Arduino_Canvas
+   @return   false if nothing is visible
+*/
+/**************************************************************************/
+bool gfx_draw_alpha_bitmap_to_framebuffer(
+    const uint8_t *bitmap, uint8_t bpp, int16_t bitmap_w, int16_t bitmap_h, uint16_t color, uint16_t bg,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation)
+{
+  int16_t skip, skip_y;
+  int16_t len = bitmap_w;
+  if (!gfx_framebuffer_clip(&x, &y, &skip, &skip_y, &len, &bitmap_h, framebuffer_w, framebuffer_h, rotation))
+  {
+    return false;
+  }
+  int32_t stride = ((int32_t)bitmap_w * bpp + 7) / 8;
+  bitmap += skip_y * stride;
+
+  int32_t pos, step_x, step_y;
+  gfx_framebuffer_steps(x, y, framebuffer_w, framebuffer_h, rotation, &pos, &step_x, &step_y);
+  uint16_t *row = framebuffer + pos;
+  if (bg != color)
+  {
+    uint16_t lut[33];
+    gfx_alpha_lut_16bit(lut, color, bg, bpp);
+    while (bitmap_h--)
+    {
+      gfx_expand_alpha_16bit(row, step_x, bitmap, bpp, skip, len, lut);
+      bitmap += stride;
+      row += step_y;
+    }
+  }
+  else
+  {
+    while (bitmap_h--)
+    {
+      gfx_blend_alpha_16bit(row, step_x, bitmap, bpp, skip, len, color);
+      bitmap += stride;
+      row += step_y;
+    }
+  }
+  return true;
+}
+
+static int64_t gfx_floor_div(int64_t a, int64_t b)
+{
+  int64_t q = a / b;
+  if ((q * b) > a)
+  {
+    --q;
+  }
+  return q;
+}
+
+// narrow the steps [*k1, *k2) to those with 0 <= s + k * ds < limit
+static void gfx_affine_clip(int64_t s, int32_t ds, int64_t limit, int32_t *k1, int32_t *k2)
+{
+  int64_t lo, hi;
+  if (ds == 0)
+  {
+    if ((s < 0) || (s >= limit))
+    {
+      *k2 = *k1;
+    }
+    return;
+  }
+  if (ds > 0)
+  {
+    lo = gfx_floor_div(ds - 1 - s, ds);
+    hi = gfx_floor_div(limit - s + ds - 1, ds);
+  }
+  else
+  {
+    lo = gfx_floor_div(s - limit, -ds) + 1;
+    hi = gfx_floor_div(s, -ds) + 1;
+  }
+  if (lo > *k1)
+  {
+    *k1 = (int32_t)lo;
+  }
+  if (hi < *k2)
+  {
+    *k2 = (int32_t)hi;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Find the pixels of a destination row that map inside the bitmap,
+             solved per row so that the pixel loop needs no bounds checks
+   @param    affine  Mapping
+   @param    y       Destination row, affine->y1 to affine->y2
+   @param    x       Returns the first destination column
+   @return   Number of pixels, 0 if the row misses the bitmap
+*/
+/**************************************************************************/
+int16_t gfx_affine_span(const gfx_affine_t *affine, int16_t y, int16_t *x)
+{
+  int32_t r = y - affine->y1;
+  int32_t k1 = 0;
+  int32_t k2 = affine->x2 - affine->x1 + 1;
+  gfx_affine_clip(affine->u + (int64_t)r * affine->du_dy, affine->du_dx, (int64_t)affine->bitmap_w << 16, &k1, &k2);
+  gfx_affine_clip(affine->v + (int64_t)r * affine->dv_dy, affine->dv_dx, (int64_t)affine->bitmap_h << 16, &k1, &k2);
+  if (k2 <= k1)
+  {
+    return 0;
+  }
+  *x = affine->x1 + k1;
+  return k2 - k1;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Sample destination pixels (x, y) to (x + len - 1, y), inside the span of gfx_affine_span()
+   @param    dst       First destination pixel
+   @param    dst_step  Pixels between destination columns, 1 for a row buffer
+   @param    affine    Mapping
+   @param    x         First destination column
+   @param    y         Destination row
+   @param    len       Number of pixels
+*/
+/**************************************************************************/
+void gfx_affine_row_16bit(uint16_t *dst, int32_t dst_step, const gfx_affine_t *affine, int16_t x, int16_t y, int16_t len)
+{
+  int32_t r = y - affine->y1;
+  int32_t k = x - affine->x1;
+  int32_t u = (int32_t)(affine->u + (int64_t)r * affine->du_dy + (int64_t)k * affine->du_dx);
+  int32_t v = (int32_t)(affine->v + (int64_t)r * affine->dv_dy + (int64_t)k * affine->dv_dx);
+  int32_t du = affine->du_dx;
+  int32_t dv = affine->dv_dx;
+  const uint16_t *bitmap = affine->bitmap;
+  int32_t bw = affine->bitmap_w;
+
+  if (!affine->bilinear)
+  {
+    if (dv == 0) // scaled only, one source row
+    {
+      const uint16_t *src = bitmap + (v >> 16) * bw;
+      while (len--)
+      {
+        *dst = src[u >> 16];
+        dst += dst_step;
+        u += du;
+      }
+    }
+    else
+    {
+      while (len--)
+      {
+        *dst = bitmap[(v >> 16) * bw + (u >> 16)];
+        dst += dst_step;
+        u += du;
+        v += dv;
+      }
+    }
+    return;
+  }
+
+  // 4 neighbours of the pixel center, edge pixels repeated, 5-bit weights
+  int32_t max_x = bw - 1;
+  int32_t max_y = affine->bitmap_h - 1;
+  u -= 0x8000;
+  v -= 0x8000;
+  if (dv == 0) // scaled only, same source rows and vertical weight
+  {
+    int32_t sy0 = v >> 16;
+    int32_t sy1 = sy0 + 1;
+    if (sy0 < 0)
+    {
+      sy0 = 0;
+    }
+    if (sy1 > max_y)
+    {
+      sy1 = max_y;
+    }
+    uint32_t fy = (v >> 11) & 0x1F;
+    const uint16_t *row0 = bitmap + sy0 * bw;
+    const uint16_t *row1 = bitmap + sy1 * bw;
+    while (len--)
+    {
+      int32_t sx0 = u >> 16;
+      int32_t sx1 = sx0 + 1;
+      if (sx0 < 0)
+      {
+        sx0 = 0;
+      }
+      if (sx1 > max_x)
+      {
+        sx1 = max_x;
+      }
+      uint32_t fx = (u >> 11) & 0x1F;
+      uint16_t top = gfx_blend_weight_16bit(row0[sx1], row0[sx0], fx);
+      *dst = fy ? gfx_blend_weight_16bit(gfx_blend_weight_16bit(row1[sx1], row1[sx0], fx), top, fy) : top;
+      dst += dst_step;
+      u += du;
+    }
+    return;
+  }
+  while (len--)
+  {
+    int32_t sx0 = u >> 16;
+    int32_t sy0 = v >> 16;
+    int32_t sx1 = sx0 + 1;
+    int32_t sy1 = sy0 + 1;
+    if (sx0 < 0)
+    {
+      sx0 = 0;
+    }
+    if (sx1 > max_x)
+    {
+      sx1 = max_x;
+    }
+    if (sy0 < 0)
+    {
+      sy0 = 0;
+    }
+    if (sy1 > max_y)
+    {
+      sy1 = max_y;
+    }
+    uint32_t fx = (u >> 11) & 0x1F;
+    uint32_t fy = (v >> 11) & 0x1F;
+    const uint16_t *row0 = bitmap + sy0 * bw;
+    const uint16_t *row1 = bitmap + sy1 * bw;
+    uint16_t top = gfx_blend_weight_16bit(row0[sx1], row0[sx0], fx);
+    uint16_t bottom = gfx_blend_weight_16bit(row1[sx1], row1[sx0], fx);
+    *dst = gfx_blend_weight_16bit(bottom, top, fy);
+    dst += dst_step;
+    u += du;
+    v += dv;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Draw an affine mapped bitmap to the framebuffer, turned by the display rotation
+   @param    affine         Mapping, bounds in rotated coordinates
+   @param    framebuffer    Framebuffer
+   @param    x              Offset added to the destination x coordinates
+   @param    y              Offset added to the destination y coordinates
+   @param    framebuffer_w  Framebuffer width, rotation 0
+   @param    framebuffer_h  Framebuffer height, rotation 0
+   @param    rotation       0 to 3, as gfx_draw_alpha_bitmap_to_framebuffer()
+   @return   false if the bounds are outside the framebuffer
+*/
+/**************************************************************************/
+bool gfx_draw_affine_bitmap_to_framebuffer(
+    const gfx_affine_t *affine,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation)
+{
+  int16_t w = (rotation & 1) ? framebuffer_h : framebuffer_w;
+  int16_t h = (rotation & 1) ? framebuffer_w : framebuffer_h;
+  if (((x + affine->x1) < 0) || ((y + affine->y1) < 0) ||
+      ((x + affine->x2) >= w) || ((y + affine->y2) >= h) ||
+      (affine->x1 > affine->x2) || (affine->y1 > affine->y2))
+  {
+    return false;
+  }
+
+  for (int16_t j = affine->y1; j <= affine->y2; ++j)
+  {
+    int16_t i;
+    int16_t len = gfx_affine_span(affine, j, &i);
+    if (len)
+    {
+      int32_t pos, step, step_y;
+      gfx_framebuffer_steps(x + i, y + j, framebuffer_w, framebuffer_h, rotation, &pos, &step, &step_y);
+      gfx_affine_row_16bit(framebuffer + pos, step, affine, i, j, len);
+    }
+  }
+  return true;
+}
+
+GFX_INLINE static uint16_t gfx_argb_to_16bit(uint32_t argb)
+{
+  return ((argb >> 8) & 0xF800) | ((argb >> 5) & 0x07E0) | ((argb >> 3) & 0x001F);
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend 16-bit pixels with their own 8-bit alpha onto 16-bit pixels, read-modify-write.
+             Contiguous rows go by pixel pairs in aligned 32-bit words (little-endian):
+             transparent pairs are skipped and opaque runs copied without blending.
+   @param    dst        First destination pixel
+   @param    dst_step   Distance between destination pixels, negative or row length for rotated framebuffers
+   @param    src        16-bit 5-6-5 pixels
+   @param    alpha      8-bit alpha of each pixel, 255 is opaque
+   @param    len        Number of pixels
+*/
+/**************************************************************************/
+void gfx_blend_rgb_alpha_16bit(uint16_t *dst, int32_t dst_step, const uint16_t *src, const uint8_t *alpha, int16_t len)
+{
+  if ((dst_step == 1) && (len >= 2))
+  {
+    if ((uintptr_t)dst & 2)
+    {
+      uint32_t weight = (*alpha++ + 4) >> 3;
+      *dst = gfx_blend_weight_16bit(*src++, *dst, weight);
+      ++dst;
+      --len;
+    }
+    uint32_t *d32 = (uint32_t *)dst;
+    while (len >= 2)
+    {
+      uint8_t a0 = alpha[0];
+      uint8_t a1 = alpha[1];
+      int16_t n = 2;
+      if ((a0 | a1) < 4) // both weights 0
+      {
+        while ((n + 2 <= len) && ((alpha[n] | alpha[n + 1]) < 4))
+        {
+          n += 2;
+        }
+      }
+      else if ((a0 & a1) >= 252) // both weights 32
+      {
+        while ((n + 2 <= len) && ((alpha[n] & alpha[n + 1]) >= 252))
+        {
+          n += 2;
+        }
+        memcpy(d32, src, n * 2);
+      }
+      else
+      {
+        uint32_t d = *d32;
+        *d32 = gfx_blend_weight_16bit(src[0], (uint16_t)d, (a0 + 4) >> 3) |
+               ((uint32_t)gfx_blend_weight_16bit(src[1], (uint16_t)(d >> 16), (a1 + 4) >> 3) << 16);
+      }
+      d32 += n >> 1;
+      src += n;
+      alpha += n;
+      len -= n;
+    }
+    dst = (uint16_t *)d32;
+  }
+  while (len--)
+  {
+    uint32_t weight = (*alpha++ + 4) >> 3;
+    if (weight == 32)
+    {
+      *dst = *src;
+    }
+    else if (weight)
+    {
+      *dst = gfx_blend_weight_16bit(*src, *dst, weight);
+    }
+    ++src;
+    dst += dst_step;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend 32-bit ARGB pixels onto 16-bit pixels, read-modify-write.
+             Contiguous rows go by pixel pairs in aligned 32-bit words (little-endian),
+             transparent pairs are skipped and opaque pairs only converted.
+   @param    dst        First destination pixel
+   @param    dst_step   Distance between destination pixels, negative or row length for rotated framebuffers
+   @param    src        0xAARRGGBB pixels, alpha 255 is opaque
+   @param    len        Number of pixels
+*/
+/**************************************************************************/
+void gfx_blend_argb_16bit(uint16_t *dst, int32_t dst_step, const uint32_t *src, int16_t len)
+{
+  if ((dst_step == 1) && (len >= 2))
+  {
+    if ((uintptr_t)dst & 2)
+    {
+      uint32_t weight = ((*src >> 24) + 4) >> 3;
+      *dst = gfx_blend_weight_16bit(gfx_argb_to_16bit(*src++), *dst, weight);
+      ++dst;
+      --len;
+    }
+    uint32_t *d32 = (uint32_t *)dst;
+    while (len >= 2)
+    {
+      uint32_t p0 = src[0];
+      uint32_t p1 = src[1];
+      if (((p0 | p1) >> 24) >= 4) // else both weights 0
+      {
+        if (((p0 & p1) >> 24) >= 252) // both weights 32
+        {
+          *d32 = gfx_argb_to_16bit(p0) | ((uint32_t)gfx_argb_to_16bit(p1) << 16);
+        }
+        else
+        {
+          uint32_t d = *d32;
+          *d32 = gfx_blend_weight_16bit(gfx_argb_to_16bit(p0), (uint16_t)d, ((p0 >> 24) + 4) >> 3) |
+                 ((uint32_t)gfx_blend_weight_16bit(gfx_argb_to_16bit(p1), (uint16_t)(d >> 16), ((p1 >> 24) + 4) >> 3) << 16);
+        }
+      }
+      ++d32;
+      src += 2;
+      len -= 2;
+    }
+    dst = (uint16_t *)d32;
+  }
+  while (len--)
+  {
+    uint32_t weight = ((*src >> 24) + 4) >> 3;
+    if (weight)
+    {
+      *dst = gfx_blend_weight_16bit(gfx_argb_to_16bit(*src), *dst, weight);
+    }
+    ++src;
+    dst += dst_step;
+  }
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend a 16-bit bitmap with an 8-bit alpha plane onto a 16-bit framebuffer of any rotation
+   @param    bitmap          16-bit 5-6-5 pixels
+   @param    alpha           8-bit alpha of each pixel, same size as bitmap
+   @param    bitmap_w        Width in pixels
+   @param    bitmap_h        Height in pixels
+   @param    framebuffer     Framebuffer
+   @param    x               Left, in rotated coordinates
+   @param    y               Top, in rotated coordinates
+   @param    framebuffer_w   Framebuffer width, not rotated
+   @param    framebuffer_h   Framebuffer height, not rotated
+   @param    rotation        0 - 3, same mapping as Arduino_Canvas
+   @return   false if nothing is visible
+*/
+/**************************************************************************/
+bool gfx_draw_rgb_alpha_bitmap_to_framebuffer(
+    const uint16_t *bitmap, const uint8_t *alpha, int16_t bitmap_w, int16_t bitmap_h,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation)
+{
+  int16_t skip_x, skip_y;
+  int16_t len = bitmap_w;
+  if (!gfx_framebuffer_clip(&x, &y, &skip_x, &skip_y, &len, &bitmap_h, framebuffer_w, framebuffer_h, rotation))
+  {
+    return false;
+  }
+  int32_t offset = (int32_t)skip_y * bitmap_w + skip_x;
+  bitmap += offset;
+  alpha += offset;
+
+  int32_t pos, step_x, step_y;
+  gfx_framebuffer_steps(x, y, framebuffer_w, framebuffer_h, rotation, &pos, &step_x, &step_y);
+  uint16_t *row = framebuffer + pos;
+  while (bitmap_h--)
+  {
+    gfx_blend_rgb_alpha_16bit(row, step_x, bitmap, alpha, len);
+    bitmap += bitmap_w;
+    alpha += bitmap_w;
+    row += step_y;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Blend a 32-bit ARGB bitmap onto a 16-bit framebuffer of any rotation
+   @param    bitmap          0xAARRGGBB pixels
+   @param    bitmap_w        Width in pixels
+   @param    bitmap_h        Height in pixels
+   @param    framebuffer     Framebuffer
+   @param    x               Left, in rotated coordinates
+   @param    y               Top, in rotated coordinates
+   @param    framebuffer_w   Framebuffer width, not rotated
+   @param    framebuffer_h   Framebuffer height, not rotated
+   @param    rotation        0 - 3, same mapping as Arduino_Canvas
+   @return   false if nothing is visible
+*/
+/**************************************************************************/
+bool gfx_draw_argb_bitmap_to_framebuffer(
+    const uint32_t *bitmap, int16_t bitmap_w, int16_t bitmap_h,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation)
+{
+  int16_t skip_x, skip_y;
+  int16_t len = bitmap_w;
+  if (!gfx_framebuffer_clip(&x, &y, &skip_x, &skip_y, &len, &bitmap_h, framebuffer_w, framebuffer_h, rotation))
+  {
+    return false;
+  }
+  bitmap += (int32_t)skip_y * bitmap_w + skip_x;
+
+  int32_t pos, step_x, step_y;
+  gfx_framebuffer_steps(x, y, framebuffer_w, framebuffer_h, rotation, &pos, &step_x, &step_y);
+  uint16_t *row = framebuffer + pos;
+  while (bitmap_h--)
+  {
+    gfx_blend_argb_16bit(row, step_x, bitmap, len);
+    bitmap += bitmap_w;
+    row += step_y;
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+   @brief    Move the content of rotated rows up inside an area of a 16-bit framebuffer
+   @param    framebuffer    Framebuffer
+   @param    framebuffer_w  Framebuffer width, not rotated
+   @param    framebuffer_h  Framebuffer height, not rotated
+   @param    rotation       0 to 3
+   @param    y              Top row of the area, in rotated coordinates
+   @param    h              Number of rows
+   @param    dy             Rows to move up, negative to move down, the uncovered rows keep their content
+*/
+/**************************************************************************/
+void gfx_scroll_framebuffer_16bit(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation, int16_t y, int16_t h, int16_t dy)
+{
+  // rotated rows are framebuffer rows or columns, rotation 1 and 2 run them backwards
+  int16_t first;
+  switch (rotation)
+  {
+  case 1:
+    first = framebuffer_w - y - h;
+    dy = -dy;
+    break;
+  case 2:
+    first = framebuffer_h - y - h;
+    dy = -dy;
+    break;
+  default: // case 0, 3:
+    first = y;
+  }
+  int16_t n = h - ((dy < 0) ? -dy : dy);
+  if ((dy == 0) || (n <= 0))
+  {
+    return;
+  }
+  int16_t dst = (dy < 0) ? (first - dy) : first;
+  int16_t src = (dy < 0) ? first : (first + dy);
+
+  if (rotation & 1)
+  {
+    for (int16_t row = 0; row < framebuffer_h; ++row)
+    {
+      uint16_t *p = framebuffer + ((int32_t)row * framebuffer_w);
+      memmove(p + dst, p + src, n * 2);
+    }
+  }
+  else
+  {
+    memmove(framebuffer + ((int32_t)dst * framebuffer_w), framebuffer + ((int32_t)src * framebuffer_w), (size_t)n * framebuffer_w * 2);
+  }
+}
@@ -3,6 +3,10 @@
 
 #include "Arduino_DataBus.h"
 
+#if !defined(LITTLE_FOOT_PRINT)
+class Arduino_FrameSync;
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 /// A generic graphics superclass that can handle all sorts of drawing. At a minimum you can subclass and provide drawPixel(). At a maximum you can do a ton of overriding to optimize. Used for any/all Adafruit displays!
 class Arduino_G
 {
@@ -18,15 +22,37 @@ public:
   virtual void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) = 0;
   virtual void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) = 0;
 
+#if !defined(LITTLE_FOOT_PRINT)
+  virtual void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
+  virtual Arduino_FrameSync *getFrameSync();
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 protected:
   int16_t
       WIDTH,  ///< This is the 'raw' display width - never changes
       HEIGHT; ///< This is the 'raw' display height - never changes
 };
 
+// affine bitmap mapping, source coordinates in 16.16 fixed point
+typedef struct
+{
+  const uint16_t *bitmap;
+  int16_t bitmap_w, bitmap_h;
+  int16_t x1, y1, x2, y2;             // destination bounds, clipped, inclusive
+  int32_t u, v;                       // source position of the center of (x1, y1)
+  int32_t du_dx, dv_dx, du_dy, dv_dy; // source steps per destination column and row
+  bool bilinear;
+  int16_t scaled_x, scaled_y, scaled_w, scaled_h; // unclipped destination of a plain scale, scaled_w is 0 if rotated
+} gfx_affine_t;
+
 #endif // _ARDUINO_G_H_
 
 // utility functions
+void gfx_fill_16bit(uint16_t *dst, uint16_t color, uint32_t len);
+void gfx_fill_rect_16bit(uint16_t *dst, int16_t dst_stride, int16_t w, int16_t h, uint16_t color);
+void gfx_copy_rect_16bit(uint16_t *dst, int16_t dst_stride, const uint16_t *src, int16_t src_stride, int16_t w, int16_t h);
+void gfx_swap_rect_16bit(uint16_t *dst, int16_t dst_stride, int16_t w, int16_t h);
+
 bool gfx_draw_bitmap_to_framebuffer(
     uint16_t *from_bitmap, int16_t bitmap_w, int16_t bitmap_h,
     uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h);
@@ -42,3 +68,34 @@ bool gfx_draw_bitmap_to_framebuffer_rotate_2(
 bool gfx_draw_bitmap_to_framebuffer_rotate_3(
     uint16_t *from_bitmap, int16_t bitmap_w, int16_t bitmap_h,
     uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h);
+
+// alpha blending, 5-bit fixed point per channel
+uint16_t gfx_blend_16bit(uint16_t fg, uint16_t bg, uint8_t alpha);
+void gfx_alpha_lut_16bit(uint16_t *lut, uint16_t color, uint16_t bg, uint8_t bpp);
+void gfx_expand_alpha_16bit(uint16_t *dst, int32_t dst_step, const uint8_t *alpha, uint8_t bpp, int16_t skip, int16_t len, const uint16_t *lut);
+void gfx_blend_alpha_16bit(uint16_t *dst, int32_t dst_step, const uint8_t *alpha, uint8_t bpp, int16_t skip, int16_t len, uint16_t color);
+
+bool gfx_draw_alpha_bitmap_to_framebuffer(
+    const uint8_t *bitmap, uint8_t bpp, int16_t bitmap_w, int16_t bitmap_h, uint16_t color, uint16_t bg,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation);
+
+// per pixel alpha blending
+void gfx_blend_rgb_alpha_16bit(uint16_t *dst, int32_t dst_step, const uint16_t *src, const uint8_t *alpha, int16_t len);
+void gfx_blend_argb_16bit(uint16_t *dst, int32_t dst_step, const uint32_t *src, int16_t len);
+
+bool gfx_draw_rgb_alpha_bitmap_to_framebuffer(
+    const uint16_t *bitmap, const uint8_t *alpha, int16_t bitmap_w, int16_t bitmap_h,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation);
+
+bool gfx_draw_argb_bitmap_to_framebuffer(
+    const uint32_t *bitmap, int16_t bitmap_w, int16_t bitmap_h,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation);
+
+int16_t gfx_affine_span(const gfx_affine_t *affine, int16_t y, int16_t *x);
+void gfx_affine_row_16bit(uint16_t *dst, int32_t dst_step, const gfx_affine_t *affine, int16_t x, int16_t y, int16_t len);
+
+bool gfx_draw_affine_bitmap_to_framebuffer(
+    const gfx_affine_t *affine,
+    uint16_t *framebuffer, int16_t x, int16_t y, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation);
+
+void gfx_scroll_framebuffer_16bit(uint16_t *framebuffer, int16_t framebuffer_w, int16_t framebuffer_h, uint8_t rotation, int16_t y, int16_t h, int16_t dy);
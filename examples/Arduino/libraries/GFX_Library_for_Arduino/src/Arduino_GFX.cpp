@@ -53,6 +53,19 @@ Arduino_GFX::Arduino_GFX(int16_t w, int16_t h) : Arduino_G(w, h)
 #endif // !defined(ATTINY_CORE)
 }
 
+Arduino_GFX::~Arduino_GFX()
+{
+#if !defined(LITTLE_FOOT_PRINT)
+  free(_text_run_buf);
+#if defined(U8G2_FONT_SUPPORT)
+  setGlyphCacheSize(0);
+#ifdef U8G2_WITH_UNICODE
+  u8g2_font_free_unicode_index();
+#endif // U8G2_WITH_UNICODE
+#endif // defined(U8G2_FONT_SUPPORT)
+#endif // !defined(LITTLE_FOOT_PRINT)
+}
+
 /**************************************************************************/
 /*!
   @brief  Write a line. Check straight or slash line and call corresponding function
@@ -677,15 +690,15 @@ void Arduino_GFX::drawArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float st
     end += 360.0;
 
   startWrite();
-  writeFillArcHelper(x, y, r1, r2, start, start, color);
-  writeFillArcHelper(x, y, r1, r2, end, end, color);
+  writeFillArcSpanHelper(x, y, r1, r2, start, start, color);
+  writeFillArcSpanHelper(x, y, r1, r2, end, end, color);
   if (!equal && (fabsf(start - end) <= 0.0001))
   {
     start = .0;
     end = 360.0;
   }
-  writeFillArcHelper(x, y, r1, r1, start, end, color);
-  writeFillArcHelper(x, y, r2, r2, start, end, color);
+  writeFillArcSpanHelper(x, y, r1, r1, start, end, color);
+  writeFillArcSpanHelper(x, y, r2, r2, start, end, color);
   endWrite();
 }
 
@@ -729,7 +742,69 @@ void Arduino_GFX::fillArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float st
   }
 
   startWrite();
-  writeFillArcHelper(x, y, r1, r2, start, end, color);
+  writeFillArcSpanHelper(x, y, r1, r2, start, end, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Redraw a filled arc gauge whose end angle moved, only the changed angle range is drawn.
+    Arcs sharing an end angle never overlap or leave a gap, so the result equals a full fillArc() redraw.
+  @param  x         Center-point x coordinate
+  @param  y         Center-point y coordinate
+  @param  r1        Outer radius of arc
+  @param  r2        Inner radius of arc
+  @param  start     degree of arc start, the gauge zero
+  @param  old_end   degree of arc end drawn last time
+  @param  new_end   degree of arc end to draw
+  @param  color     16-bit 5-6-5 Color of the gauge arc
+  @param  bg        16-bit 5-6-5 Color of the gauge background
+*/
+/**************************************************************************/
+void Arduino_GFX::updateArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float old_end, float new_end, uint16_t color, uint16_t bg)
+{
+  if (r1 < r2)
+  {
+    _swap_int16_t(r1, r2);
+  }
+  if (r1 < 1)
+  {
+    r1 = 1;
+  }
+  if (r2 < 1)
+  {
+    r2 = 1;
+  }
+  // sweep from start, 0 to 360 degree
+  float old_sweep = old_end - start;
+  float new_sweep = new_end - start;
+  old_sweep = (old_sweep >= 360.0) ? 360.0 : (old_sweep <= 0) ? 0 : old_sweep;
+  new_sweep = (new_sweep >= 360.0) ? 360.0 : (new_sweep <= 0) ? 0 : new_sweep;
+  if (old_sweep == new_sweep)
+  {
+    return;
+  }
+  float from = start + ((old_sweep < new_sweep) ? old_sweep : new_sweep);
+  float to = start + ((old_sweep < new_sweep) ? new_sweep : old_sweep);
+  bool full = (to - from) >= 360.0;
+  from = fmodf(from, 360);
+  to = fmodf(to, 360);
+  if (from < 0)
+    from += 360.0;
+  if (to < 0)
+    to += 360.0;
+  if (full)
+  {
+    from = .0;
+    to = 360.0;
+  }
+  else if (from == to)
+  {
+    return;
+  }
+
+  startWrite();
+  writeFillArcSpanHelper(x, y, r1, r2, from, to, (old_sweep < new_sweep) ? color : bg);
   endWrite();
 }
 
@@ -839,133 +914,771 @@ void Arduino_GFX::writeFillArcHelper(int16_t cx, int16_t cy, int16_t oradius, in
   } while (++y <= ye);
 }
 
+// sin() of 0 to 90 degree in Q14 fixed point
+static const int16_t sin_q14_table[91] PROGMEM = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+// sin() of integer degree in Q14 fixed point
+static int32_t sin_q14(int32_t deg)
+{
+  deg %= 360;
+  if (deg < 0)
+  {
+    deg += 360;
+  }
+  if (deg <= 90)
+  {
+    return (int16_t)pgm_read_word(&sin_q14_table[deg]);
+  }
+  else if (deg <= 180)
+  {
+    return (int16_t)pgm_read_word(&sin_q14_table[180 - deg]);
+  }
+  else if (deg <= 270)
+  {
+    return -(int16_t)pgm_read_word(&sin_q14_table[deg - 180]);
+  }
+  return -(int16_t)pgm_read_word(&sin_q14_table[360 - deg]);
+}
+
+// direction of an angle in Q14 fixed point, 1/256 degree resolution
+static void arc_direction(float deg, int32_t *c, int32_t *s)
+{
+  int32_t a = (int32_t)(deg * 256 + 0.5);
+  int32_t d = a >> 8;
+  int32_t f = a & 0xFF;
+  int32_t s0 = sin_q14(d), s1 = sin_q14(d + 1);
+  int32_t c0 = sin_q14(d + 90), c1 = sin_q14(d + 91);
+  *s = s0 + (((s1 - s0) * f) >> 8);
+  *c = c0 + (((c1 - c0) * f) >> 8);
+}
+
+// round toward negative infinity
+static int32_t floor_div(int32_t a, int32_t b)
+{
+  int32_t q = a / b;
+  if (((a % b) != 0) && ((a < 0) != (b < 0)))
+  {
+    --q;
+  }
+  return q;
+}
+
+// row x range of s * x <= k, lo > hi if none
+static void arc_half_row(int32_t s, int32_t k, int32_t *lo, int32_t *hi)
+{
+  *lo = INT16_MIN;
+  *hi = INT16_MAX;
+  if (s > 0)
+  {
+    *hi = floor_div(k, s);
+  }
+  else if (s < 0)
+  {
+    *lo = -floor_div(k, -s);
+  }
+  else if (k < 0)
+  {
+    *hi = INT16_MIN;
+  }
+}
+
+// row x range of pixels 0 to 180 degree (excluded) after direction (c, s), lo > hi if none
+// pixels on the direction ray are after it, the center is taken as at 90 degree
+static void arc_after_row(int32_t c, int32_t s, int32_t y, int32_t *lo, int32_t *hi)
+{
+  int32_t k = c * y;
+  if (y == 0)
+  {
+    // s * x < 0, or x on the ray
+    bool center = (c > 0) || ((c == 0) && (s > 0));
+    *lo = INT16_MIN;
+    *hi = INT16_MAX;
+    if (s > 0)
+    {
+      *hi = center ? 0 : -1;
+    }
+    else if (s < 0)
+    {
+      *lo = center ? 0 : 1;
+    }
+    else if (c > 0)
+    {
+      *lo = 0;
+    }
+    else
+    {
+      *hi = -1;
+    }
+    return;
+  }
+  // s * x < c * y, or on the ray
+  arc_half_row(s, k - 1, lo, hi);
+  if ((s != 0) && ((k % s) == 0))
+  {
+    int32_t x = k / s;
+    if ((c * x + s * y) > 0)
+    {
+      if (s > 0)
+      {
+        *hi = x;
+      }
+      else
+      {
+        *lo = x;
+      }
+    }
+  }
+}
+
 /**************************************************************************/
 /*!
-  @brief  Draw a rectangle with no fill color
-  @param  x       Top left corner x coordinate
-  @param  y       Top left corner y coordinate
-  @param  w       Width in pixels
-  @param  h       Height in pixels
-  @param  color   16-bit 5-6-5 Color to draw with
+  @brief  Arc drawer with fill, one writeFastHLine() per row segment
+    Row boundaries are solved per scanline in fixed point, ring edges are tracked incrementally
+    and the angle edges are the two half planes through the center.
+    Pixel of angle a is inside if start <= a < end, so arcs sharing an end angle tile exactly.
+    start equals end draws a 1 pixel wide radial line.
+  @param  cx      Center-point x coordinate
+  @param  cy      Center-point y coordinate
+  @param  oradius Outer radius of arc
+  @param  iradius Inner radius of arc
+  @param  start   degree of arc start, 0 to 360
+  @param  end     degree of arc end, 0 to 360
+  @param  color   16-bit 5-6-5 Color to fill with
 */
 /**************************************************************************/
-void Arduino_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
-                           uint16_t color)
+void Arduino_GFX::writeFillArcSpanHelper(int16_t cx, int16_t cy, int16_t oradius, int16_t iradius, float start, float end, uint16_t color)
 {
-  startWrite();
-  writeFastHLine(x, y, w, color);
-  writeFastHLine(x, y + h - 1, w, color);
-  writeFastVLine(x, y, h, color);
-  writeFastVLine(x + w - 1, y, h, color);
-  endWrite();
+  // same ring as writeFillArcHelper(): ir2 <= x * x + y * y < or2
+  --iradius;
+  int32_t ir2 = (int32_t)iradius * iradius + iradius;
+  int32_t or2 = (int32_t)oradius * oradius + oradius;
+
+  int32_t sc, ss, ec, es;
+  arc_direction(start, &sc, &ss);
+  bool ray = (start == end);
+  bool reversed = false;
+  int32_t half = 0;
+  if (ray)
+  {
+    // within half a pixel of the ray along the minor axis
+    half = ((sc < 0) ? -sc : sc);
+    if (((ss < 0) ? -ss : ss) > half)
+    {
+      half = (ss < 0) ? -ss : ss;
+    }
+    half >>= 1;
+  }
+  else
+  {
+    arc_direction(end, &ec, &es);
+    float sweep = end - start;
+    if (sweep < 0)
+    {
+      sweep += 360.0;
+    }
+    reversed = sweep > 180.0;
+  }
+
+  // visible rows only
+  int32_t y_min = -oradius, y_max = oradius;
+  if ((cy + y_min) < 0)
+  {
+    y_min = -cy;
+  }
+  if ((cy + y_max) > _max_y)
+  {
+    y_max = _max_y - cy;
+  }
+
+  int32_t xo = oradius; // outer edge, largest x with x * x + y * y < or2
+  int32_t xi = 0;       // inner edge, smallest x >= 0 with x * x + y * y >= ir2
+  while ((xi * xi) < ir2)
+  {
+    ++xi;
+  }
+  for (int32_t ay = 0; ay <= oradius; ++ay)
+  {
+    int32_t y2 = ay * ay;
+    while ((xo >= 0) && ((xo * xo + y2) >= or2))
+    {
+      --xo;
+    }
+    while ((xi > 0) && (((xi - 1) * (xi - 1) + y2) >= ir2))
+    {
+      --xi;
+    }
+    if (xo < 0)
+    {
+      break;
+    }
+
+    // ring segments of this row
+    int32_t ring[4] = {-xo, xo, 0, -1};
+    if (xi > 0)
+    {
+      ring[1] = -xi;
+      ring[2] = xi;
+      ring[3] = xo;
+    }
+
+    for (int8_t side = 0; side < 2; ++side)
+    {
+      int32_t y = (side == 0) ? ay : -ay;
+      if ((side == 1) && (ay == 0))
+      {
+        break;
+      }
+      if ((y < y_min) || (y > y_max))
+      {
+        continue;
+      }
+
+      // angle segments of this row
+      int32_t ang[4] = {0, -1, 0, -1};
+      int32_t lo, hi;
+      if (ray)
+      {
+        // |ss * x - sc * y| <= half and sc * x + ss * y >= 0
+        int32_t k = sc * y;
+        arc_half_row(ss, k + half, &ang[0], &ang[1]);
+        arc_half_row(-ss, half - k, &lo, &hi);
+        ang[0] = (lo > ang[0]) ? lo : ang[0];
+        ang[1] = (hi < ang[1]) ? hi : ang[1];
+        arc_half_row(-sc, ss * y, &lo, &hi);
+        ang[0] = (lo > ang[0]) ? lo : ang[0];
+        ang[1] = (hi < ang[1]) ? hi : ang[1];
+      }
+      else
+      {
+        // after start, and not after end
+        arc_after_row(sc, ss, y, &ang[0], &ang[1]);
+        arc_after_row(ec, es, y, &lo, &hi);
+        if (lo > hi) // none after end
+        {
+          ang[2] = INT16_MIN;
+          ang[3] = INT16_MAX;
+        }
+        else if (lo == INT16_MIN)
+        {
+          ang[2] = (hi == INT16_MAX) ? INT16_MAX : (hi + 1);
+          ang[3] = (hi == INT16_MAX) ? INT16_MIN : INT16_MAX;
+        }
+        else
+        {
+          ang[2] = INT16_MIN;
+          ang[3] = lo - 1;
+        }
+        if (reversed)
+        {
+          // union, merge overlapping half lines
+          if ((ang[0] <= ang[1]) && (ang[2] <= ang[3]) && (ang[0] <= (ang[3] + 1)) && (ang[2] <= (ang[1] + 1)))
+          {
+            ang[0] = (ang[0] < ang[2]) ? ang[0] : ang[2];
+            ang[1] = (ang[1] > ang[3]) ? ang[1] : ang[3];
+            ang[3] = -1;
+            ang[2] = 0;
+          }
+          else if (ang[0] > ang[2])
+          {
+            lo = ang[0];
+            hi = ang[1];
+            ang[0] = ang[2];
+            ang[1] = ang[3];
+            ang[2] = lo;
+            ang[3] = hi;
+          }
+        }
+        else
+        {
+          // intersection
+          ang[0] = (ang[0] > ang[2]) ? ang[0] : ang[2];
+          ang[1] = (ang[1] < ang[3]) ? ang[1] : ang[3];
+          ang[3] = -1;
+          ang[2] = 0;
+        }
+      }
+
+      // one span per overlap of ring and angle segments, left to right
+      for (int8_t r = 0; r < 4; r += 2)
+      {
+        for (int8_t a = 0; a < 4; a += 2)
+        {
+          lo = (ring[r] > ang[a]) ? ring[r] : ang[a];
+          hi = (ring[r + 1] < ang[a + 1]) ? ring[r + 1] : ang[a + 1];
+          if (lo <= hi)
+          {
+            writeFastHLine(cx + lo, cy + y, hi - lo + 1, color);
+          }
+        }
+      }
+    }
+  }
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
 /**************************************************************************/
 /*!
-  @brief  Draw a rounded rectangle with no fill color
-  @param  x       Top left corner x coordinate
-  @param  y       Top left corner y coordinate
-  @param  w       Width in pixels
-  @param  h       Height in pixels
-  @param  r       Radius of corner rounding
-  @param  color   16-bit 5-6-5 Color to draw with
+  @brief  Draw a filled polygon
+  @param  points  x, y pairs of the vertices, in pixel corner coordinates
+  @param  n       number of vertices
+  @param  color   16-bit 5-6-5 Color to fill with
+  @param  rule    GFX_FILL_NONZERO or GFX_FILL_EVEN_ODD for self-intersecting polygons
 */
 /**************************************************************************/
-void Arduino_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w,
-                                int16_t h, int16_t r, uint16_t color)
+void Arduino_GFX::fillPolygon(const int16_t *points, uint16_t n, uint16_t color, gfx_fill_rule_t rule)
 {
-  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
-  if (r > max_radius)
-    r = max_radius;
-  // smarter version
-  startWrite();
-  writeFastHLine(x + r, y, w - 2 * r, color);         // Top
-  writeFastHLine(x + r, y + h - 1, w - 2 * r, color); // Bottom
-  writeFastVLine(x, y + r, h - 2 * r, color);         // Left
-  writeFastVLine(x + w - 1, y + r, h - 2 * r, color); // Right
-  // draw four corners
-  writeEllipseHelper(x + r, y + r, r, r, 1, color);
-  writeEllipseHelper(x + w - r - 1, y + r, r, r, 2, color);
-  writeEllipseHelper(x + w - r - 1, y + h - r - 1, r, r, 4, color);
-  writeEllipseHelper(x + r, y + h - r - 1, r, r, 8, color);
-  endWrite();
+  fillPath(points, &n, 1, color, rule);
 }
 
 /**************************************************************************/
 /*!
-  @brief  Draw a rounded rectangle with fill color
-  @param  x       Top left corner x coordinate
-  @param  y       Top left corner y coordinate
-  @param  w       Width in pixels
-  @param  h       Height in pixels
-  @param  r       Radius of corner rounding
-  @param  color   16-bit 5-6-5 Color to draw/fill with
+  @brief  Draw a filled polygon with anti-aliased edges
+  @param  points  x, y pairs of the vertices, in pixel corner coordinates
+  @param  n       number of vertices
+  @param  color   16-bit 5-6-5 Color to fill with
+  @param  bg      16-bit 5-6-5 Color to blend edges with, same as color to blend with the framebuffer content
+  @param  rule    GFX_FILL_NONZERO or GFX_FILL_EVEN_ODD for self-intersecting polygons
 */
 /**************************************************************************/
-void Arduino_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w,
-                                int16_t h, int16_t r, uint16_t color)
+void Arduino_GFX::fillPolygonAA(const int16_t *points, uint16_t n, uint16_t color, uint16_t bg, gfx_fill_rule_t rule)
 {
-  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
-  if (r > max_radius)
-    r = max_radius;
-  // smarter version
-  startWrite();
-  writeFillRect(x, y + r, w, h - (r << 1), color);
-  // draw four corners
-  writeFillEllipseHelper(x + r, y + r, r, r, 1, w - 2 * r - 1, color);
-  writeFillEllipseHelper(x + r, y + h - r - 1, r, r, 2, w - 2 * r - 1, color);
-  endWrite();
+  fillPathAA(points, &n, 1, color, bg, rule);
 }
 
 /**************************************************************************/
 /*!
-  @brief  Draw a triangle with no fill color
-  @param  x0      Vertex #0 x coordinate
-  @param  y0      Vertex #0 y coordinate
-  @param  x1      Vertex #1 x coordinate
-  @param  y1      Vertex #1 y coordinate
-  @param  x2      Vertex #2 x coordinate
-  @param  y2      Vertex #2 y coordinate
-  @param  color   16-bit 5-6-5 Color to draw with
+  @brief  Draw a filled path of closed contours, e.g. a shape with holes
+  @param  points        x, y pairs of the vertices of all contours, in pixel corner coordinates
+  @param  contour_ends  vertex count after the last vertex of each contour, ascending
+  @param  contours      number of contours
+  @param  color         16-bit 5-6-5 Color to fill with
+  @param  rule          GFX_FILL_NONZERO or GFX_FILL_EVEN_ODD
 */
 /**************************************************************************/
-void Arduino_GFX::drawTriangle(int16_t x0, int16_t y0,
-                               int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+void Arduino_GFX::fillPath(const int16_t *points, const uint16_t *contour_ends, uint16_t contours, uint16_t color, gfx_fill_rule_t rule)
 {
   startWrite();
-  writeLine(x0, y0, x1, y1, color);
-  writeLine(x1, y1, x2, y2, color);
-  writeLine(x2, y2, x0, y0, color);
+  writeFillPathHelper(points, contour_ends, contours, color, color, rule, false);
   endWrite();
 }
 
 /**************************************************************************/
 /*!
-  @brief  Draw a triangle with color-fill
-  @param  x0      Vertex #0 x coordinate
-  @param  y0      Vertex #0 y coordinate
-  @param  x1      Vertex #1 x coordinate
-  @param  y1      Vertex #1 y coordinate
-  @param  x2      Vertex #2 x coordinate
-  @param  y2      Vertex #2 y coordinate
-  @param  color   16-bit 5-6-5 Color to fill/draw with
+  @brief  Draw a filled path of closed contours with anti-aliased edges
+  @param  points        x, y pairs of the vertices of all contours, in pixel corner coordinates
+  @param  contour_ends  vertex count after the last vertex of each contour, ascending
+  @param  contours      number of contours
+  @param  color         16-bit 5-6-5 Color to fill with
+  @param  bg            16-bit 5-6-5 Color to blend edges with, same as color to blend with the framebuffer content
+  @param  rule          GFX_FILL_NONZERO or GFX_FILL_EVEN_ODD
 */
 /**************************************************************************/
-void Arduino_GFX::fillTriangle(int16_t x0, int16_t y0,
-                               int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+void Arduino_GFX::fillPathAA(const int16_t *points, const uint16_t *contour_ends, uint16_t contours, uint16_t color, uint16_t bg, gfx_fill_rule_t rule)
 {
-  int16_t a, b, y, last;
-
-  // Sort coordinates by Y order (y2 >= y1 >= y0)
-  if (y0 > y1)
-  {
-    _swap_int16_t(y0, y1);
-    _swap_int16_t(x0, x1);
-  }
-  if (y1 > y2)
+  startWrite();
+  if (!writeFillPathHelper(points, contour_ends, contours, color, bg, rule, true))
   {
-    _swap_int16_t(y2, y1);
-    _swap_int16_t(x2, x1);
+    // no memory for the coverage row, fill without anti-aliasing
+    writeFillPathHelper(points, contour_ends, contours, color, color, rule, false);
+  }
+  endWrite();
+}
+
+typedef struct
+{
+  int64_t x;      // 32.32 x where the edge crosses the current sample row
+  int64_t dx;     // 32.32 x step per sample row
+  int32_t top;    // first sample row crossed
+  int32_t bottom; // sample row after the last crossed
+  int8_t dir;     // 1 if the contour goes down, -1 if up
+} gfx_path_edge_t;
+
+static int path_edge_cmp(const void *a, const void *b)
+{
+  return ((const gfx_path_edge_t *)a)->top - ((const gfx_path_edge_t *)b)->top;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Scanline fill of closed contours with an edge table, one span per inside run of a row.
+    Pixel (x, y) covers the square from corner (x, y) to (x + 1, y + 1) and is filled if its center is inside,
+    so a rectangle of 4 corners fills the same pixels as fillRect() and shapes sharing edges tile without overlap.
+    Anti-aliasing samples 4 sub-rows per pixel row with 1/16 pixel horizontal coverage,
+    fully covered runs are still sent as spans and partly covered pixels go to writeAlphaSpan().
+  @param  points        x, y pairs of the vertices of all contours
+  @param  contour_ends  vertex count after the last vertex of each contour, ascending
+  @param  contours      number of contours
+  @param  color         16-bit 5-6-5 Color to fill with
+  @param  bg            16-bit 5-6-5 Color to blend anti-aliased edges with
+  @param  rule          GFX_FILL_NONZERO or GFX_FILL_EVEN_ODD
+  @param  antialias     true for 4x vertical supersampling
+  @return false if the buffers cannot be allocated
+*/
+/**************************************************************************/
+bool Arduino_GFX::writeFillPathHelper(const int16_t *points, const uint16_t *contour_ends, uint16_t contours, uint16_t color, uint16_t bg, gfx_fill_rule_t rule, bool antialias)
+{
+  uint16_t n = contours ? contour_ends[contours - 1] : 0;
+  if (n < 3)
+  {
+    return true;
+  }
+  int16_t xmin = points[0], xmax = points[0];
+  for (uint16_t i = 1; i < n; ++i)
+  {
+    int16_t x = points[i * 2];
+    xmin = (x < xmin) ? x : xmin;
+    xmax = (x > xmax) ? x : xmax;
+  }
+  // visible columns of the bounding box
+  int32_t bx0 = (xmin > 0) ? xmin : 0;
+  int32_t bx1 = (xmax <= _max_x) ? xmax : (_max_x + 1);
+  if (bx1 <= bx0)
+  {
+    return true;
+  }
+
+  int8_t sub = antialias ? 4 : 1;
+  uint32_t size = n * (sizeof(gfx_path_edge_t) + sizeof(gfx_path_edge_t *));
+  if (antialias)
+  {
+    size += (bx1 - bx0 + 2) * sizeof(int16_t) + (bx1 - bx0 + 1);
+  }
+  gfx_path_edge_t *edges = (gfx_path_edge_t *)malloc(size);
+  if (!edges)
+  {
+    return false;
+  }
+  gfx_path_edge_t **active = (gfx_path_edge_t **)(edges + n);
+  int16_t *acc = (int16_t *)(active + n);              // coverage deltas of the pixel row
+  uint8_t *alpha = (uint8_t *)(acc + (bx1 - bx0 + 2)); // alpha of the pixel row
+
+  // edge table, horizontal edges never cross a sample row
+  uint16_t cnt = 0;
+  uint16_t first = 0;
+  for (uint16_t c = 0; c < contours; ++c)
+  {
+    uint16_t last = contour_ends[c];
+    for (uint16_t i = first; i < last; ++i)
+    {
+      uint16_t j = ((i + 1) < last) ? (i + 1) : first;
+      int32_t x0 = points[i * 2], y0 = points[i * 2 + 1];
+      int32_t x1 = points[j * 2], y1 = points[j * 2 + 1];
+      if (y0 == y1)
+      {
+        continue;
+      }
+      gfx_path_edge_t *e = &edges[cnt++];
+      e->dir = 1;
+      if (y0 > y1)
+      {
+        int32_t t = x0;
+        x0 = x1;
+        x1 = t;
+        t = y0;
+        y0 = y1;
+        y1 = t;
+        e->dir = -1;
+      }
+      e->top = y0 * sub;
+      e->bottom = y1 * sub;
+      e->dx = (int64_t)(x1 - x0) * 0x100000000LL / (e->bottom - e->top);
+      e->x = (int64_t)x0 * 0x100000000LL + (e->dx / 2); // sample rows are at the middle of each sub-row
+    }
+    first = last;
+  }
+  qsort(edges, cnt, sizeof(gfx_path_edge_t), path_edge_cmp);
+
+  int32_t s_end = (int32_t)(_max_y + 1) * sub;
+  int32_t s = (cnt && (edges[0].top > 0)) ? edges[0].top : 0;
+  uint16_t next = 0;
+  uint16_t nactive = 0;
+  int32_t lo = INT16_MAX, hi = -1; // touched range of acc
+  if (antialias)
+  {
+    memset(acc, 0, (bx1 - bx0 + 2) * sizeof(int16_t));
+  }
+  for (; s < s_end; ++s)
+  {
+    // drop finished edges, add new ones
+    uint16_t k = 0;
+    for (uint16_t i = 0; i < nactive; ++i)
+    {
+      if (active[i]->bottom > s)
+      {
+        active[k++] = active[i];
+      }
+    }
+    nactive = k;
+    while ((next < cnt) && (edges[next].top <= s))
+    {
+      gfx_path_edge_t *e = &edges[next++];
+      if (e->bottom > s)
+      {
+        e->x += e->dx * (s - e->top);
+        active[nactive++] = e;
+      }
+    }
+    if (nactive == 0)
+    {
+      if (next >= cnt)
+      {
+        break;
+      }
+      if (lo > hi)
+      {
+        // no coverage pending, jump to the first row of the next edge
+        s = edges[next].top - 1;
+        continue;
+      }
+    }
+
+    // sort crossings by x, the order changes little between rows
+    for (uint16_t i = 1; i < nactive; ++i)
+    {
+      gfx_path_edge_t *e = active[i];
+      int32_t j = i - 1;
+      while ((j >= 0) && (active[j]->x > e->x))
+      {
+        active[j + 1] = active[j];
+        --j;
+      }
+      active[j + 1] = e;
+    }
+
+    int16_t y = s / sub;
+    int16_t winding = 0;
+    int32_t xa = 0;
+    for (uint16_t i = 0; i < nactive; ++i)
+    {
+      gfx_path_edge_t *e = active[i];
+      int32_t x = (int32_t)(e->x >> 16); // 16.16
+      bool was_inside = (rule == GFX_FILL_EVEN_ODD) ? (winding & 1) : (winding != 0);
+      winding += e->dir;
+      bool inside = (rule == GFX_FILL_EVEN_ODD) ? (winding & 1) : (winding != 0);
+      e->x += e->dx;
+      if (inside == was_inside)
+      {
+        continue;
+      }
+      if (inside)
+      {
+        xa = x;
+        continue;
+      }
+
+      if (antialias)
+      {
+        // 1/16 pixel coverage of [xa, x), as deltas of a running sum
+        int32_t a = xa >> 12, b = x >> 12;
+        a = (a < (bx0 << 4)) ? (bx0 << 4) : a;
+        b = (b > (bx1 << 4)) ? (bx1 << 4) : b;
+        if (a < b)
+        {
+          int32_t pa = (a >> 4) - bx0, pb = (b >> 4) - bx0;
+          acc[pa] += 16 - (a & 15);
+          acc[pa + 1] += a & 15;
+          acc[pb] -= 16 - (b & 15);
+          acc[pb + 1] -= b & 15;
+          lo = (pa < lo) ? pa : lo;
+          hi = ((pb + 1) > hi) ? (pb + 1) : hi;
+        }
+      }
+      else
+      {
+        // pixels with center in [xa, x)
+        int32_t l = (xa + 0x7FFF) >> 16, r = (x + 0x7FFF) >> 16;
+        l = (l < bx0) ? bx0 : l;
+        r = (r > bx1) ? bx1 : r;
+        if (l < r)
+        {
+          writeFastHLine(l, y, r - l, color);
+        }
+      }
+    }
+
+    if (antialias && ((s % sub) == (sub - 1)) && (lo <= hi))
+    {
+      // full coverage runs as spans, edge pixels blended
+      int16_t sum = 0;
+      for (int32_t i = lo; i <= hi; ++i)
+      {
+        sum += acc[i];
+        acc[i] = 0;
+        if (i < hi)
+        {
+          alpha[i] = (sum >= 64) ? 255 : (sum << 2);
+        }
+      }
+      int32_t i = lo;
+      while (i < hi)
+      {
+        int32_t j = i + 1;
+        if (alpha[i] == 255)
+        {
+          while ((j < hi) && (alpha[j] == 255))
+          {
+            ++j;
+          }
+          writeFastHLine(bx0 + i, y, j - i, color);
+        }
+        else if (alpha[i])
+        {
+          while ((j < hi) && alpha[j] && (alpha[j] != 255))
+          {
+            ++j;
+          }
+          writeAlphaSpan(bx0 + i, y, alpha + i, j - i, color, bg);
+        }
+        i = j;
+      }
+      lo = INT16_MAX;
+      hi = -1;
+    }
+  }
+
+  free(edges);
+  return true;
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+/**************************************************************************/
+/*!
+  @brief  Draw a rectangle with no fill color
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  w       Width in pixels
+  @param  h       Height in pixels
+  @param  color   16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Arduino_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                           uint16_t color)
+{
+  startWrite();
+  writeFastHLine(x, y, w, color);
+  writeFastHLine(x, y + h - 1, w, color);
+  writeFastVLine(x, y, h, color);
+  writeFastVLine(x + w - 1, y, h, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a rounded rectangle with no fill color
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  w       Width in pixels
+  @param  h       Height in pixels
+  @param  r       Radius of corner rounding
+  @param  color   16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Arduino_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w,
+                                int16_t h, int16_t r, uint16_t color)
+{
+  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
+  if (r > max_radius)
+    r = max_radius;
+  // smarter version
+  startWrite();
+  writeFastHLine(x + r, y, w - 2 * r, color);         // Top
+  writeFastHLine(x + r, y + h - 1, w - 2 * r, color); // Bottom
+  writeFastVLine(x, y + r, h - 2 * r, color);         // Left
+  writeFastVLine(x + w - 1, y + r, h - 2 * r, color); // Right
+  // draw four corners
+  writeEllipseHelper(x + r, y + r, r, r, 1, color);
+  writeEllipseHelper(x + w - r - 1, y + r, r, r, 2, color);
+  writeEllipseHelper(x + w - r - 1, y + h - r - 1, r, r, 4, color);
+  writeEllipseHelper(x + r, y + h - r - 1, r, r, 8, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a rounded rectangle with fill color
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  w       Width in pixels
+  @param  h       Height in pixels
+  @param  r       Radius of corner rounding
+  @param  color   16-bit 5-6-5 Color to draw/fill with
+*/
+/**************************************************************************/
+void Arduino_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w,
+                                int16_t h, int16_t r, uint16_t color)
+{
+  int16_t max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
+  if (r > max_radius)
+    r = max_radius;
+  // smarter version
+  startWrite();
+  writeFillRect(x, y + r, w, h - (r << 1), color);
+  // draw four corners
+  writeFillEllipseHelper(x + r, y + r, r, r, 1, w - 2 * r - 1, color);
+  writeFillEllipseHelper(x + r, y + h - r - 1, r, r, 2, w - 2 * r - 1, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a triangle with no fill color
+  @param  x0      Vertex #0 x coordinate
+  @param  y0      Vertex #0 y coordinate
+  @param  x1      Vertex #1 x coordinate
+  @param  y1      Vertex #1 y coordinate
+  @param  x2      Vertex #2 x coordinate
+  @param  y2      Vertex #2 y coordinate
+  @param  color   16-bit 5-6-5 Color to draw with
+*/
+/**************************************************************************/
+void Arduino_GFX::drawTriangle(int16_t x0, int16_t y0,
+                               int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+  startWrite();
+  writeLine(x0, y0, x1, y1, color);
+  writeLine(x1, y1, x2, y2, color);
+  writeLine(x2, y2, x0, y0, color);
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a triangle with color-fill
+  @param  x0      Vertex #0 x coordinate
+  @param  y0      Vertex #0 y coordinate
+  @param  x1      Vertex #1 x coordinate
+  @param  y1      Vertex #1 y coordinate
+  @param  x2      Vertex #2 x coordinate
+  @param  y2      Vertex #2 y coordinate
+  @param  color   16-bit 5-6-5 Color to fill/draw with
+*/
+/**************************************************************************/
+void Arduino_GFX::fillTriangle(int16_t x0, int16_t y0,
+                               int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+  int16_t a, b, y, last;
+
+  // Sort coordinates by Y order (y2 >= y1 >= y0)
+  if (y0 > y1)
+  {
+    _swap_int16_t(y0, y1);
+    _swap_int16_t(x0, x1);
+  }
+  if (y1 > y2)
+  {
+    _swap_int16_t(y2, y1);
+    _swap_int16_t(x2, x1);
   }
   if (y0 > y1)
   {
@@ -1722,48 +2435,556 @@ void Arduino_GFX::draw16bitRGBBitmapWithMask(int16_t x, int16_t y,
   endWrite();
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
 /**************************************************************************/
 /*!
-  @brief  Draw a PROGMEM-resident 24-bit image (RGB 5/6/5) at the specified (x,y) position.
+  @brief  Draw a 4-bit or 8-bit alpha bitmap, e.g. an anti-aliased glyph.
+    Rows are byte aligned, 4-bit pixels are packed high nibble first.
+    With bg != color the edges are blended with bg and the result is sent as 16-bit blocks,
+    otherwise framebuffer sub-classes blend with the existing pixels
+    and others draw the pixels of at least half coverage.
   @param  x       Top left corner x coordinate
   @param  y       Top left corner y coordinate
-  @param  bitmap  byte array with 16-bit color bitmap
+  @param  bitmap  byte array with alpha bitmap
+  @param  bpp     bits per alpha pixel, 4 or 8
   @param  w       Width of bitmap in pixels
   @param  h       Height of bitmap in pixels
+  @param  color   16-bit 5-6-5 Color to draw pixels with
+  @param  bg      16-bit 5-6-5 Color to blend with, same as color for transparent
 */
 /**************************************************************************/
-void Arduino_GFX::draw24bitRGBBitmap(int16_t x, int16_t y,
-                                     const uint8_t bitmap[], int16_t w, int16_t h)
+void Arduino_GFX::drawAlphaBitmap(int16_t x, int16_t y,
+                                  const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg)
 {
-  int32_t offset = 0;
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++)
+  if ((w <= 0) || (h <= 0) || ((bpp != 4) && (bpp != 8)))
   {
-    for (int16_t i = 0; i < w; i++)
-    {
-      writePixel(x + i, y, color565(pgm_read_byte(&bitmap[offset]), pgm_read_byte(&bitmap[offset + 1]), pgm_read_byte(&bitmap[offset + 2])));
-      offset += 3;
-    }
+    return;
   }
-  endWrite();
-}
+  uint16_t stride = ((int32_t)w * bpp + 7) / 8;
 
-/**************************************************************************/
-/*!
-  @brief  Draw a RAM-resident 24-bit image (RGB 5/6/5) at the specified (x,y) position.
-  @param  x       Top left corner x coordinate
-  @param  y       Top left corner y coordinate
-  @param  bitmap  byte array with 16-bit color bitmap
-  @param  w       Width of bitmap in pixels
-  @param  h       Height of bitmap in pixels
-*/
-/**************************************************************************/
-void Arduino_GFX::draw24bitRGBBitmap(int16_t x, int16_t y,
-                                     uint8_t *bitmap, int16_t w, int16_t h)
-{
-  int32_t offset = 0;
-  startWrite();
-  for (int16_t j = 0; j < h; j++, y++)
+  if (bg != color)
+  {
+    uint16_t lut[33];
+    uint16_t buf[ALPHA_BITMAP_BUF_PIXELS];
+    gfx_alpha_lut_16bit(lut, color, bg, bpp);
+    for (int16_t col = 0; col < w; col += ALPHA_BITMAP_BUF_PIXELS)
+    {
+      int16_t cw = w - col;
+      if (cw > ALPHA_BITMAP_BUF_PIXELS)
+      {
+        cw = ALPHA_BITMAP_BUF_PIXELS;
+      }
+      int16_t band = ALPHA_BITMAP_BUF_PIXELS / cw;
+      const uint8_t *row = bitmap;
+      for (int16_t j = 0; j < h; j += band)
+      {
+        int16_t bh = h - j;
+        if (bh > band)
+        {
+          bh = band;
+        }
+        uint16_t *dst = buf;
+        for (int16_t k = 0; k < bh; ++k, row += stride, dst += cw)
+        {
+          gfx_expand_alpha_16bit(dst, 1, row, bpp, col, cw, lut);
+        }
+        draw16bitRGBBitmap(x + col, y + j, buf, cw, bh);
+      }
+    }
+  }
+  else
+  {
+    uint8_t half = (bpp == 4) ? 8 : 128;
+    startWrite();
+    for (int16_t j = 0; j < h; ++j, bitmap += stride)
+    {
+      int16_t run = -1;
+      for (int16_t i = 0; i <= w; ++i)
+      {
+        bool on = false;
+        if (i < w)
+        {
+          uint8_t a = (bpp == 4) ? ((i & 1) ? (bitmap[i >> 1] & 0x0F) : (bitmap[i >> 1] >> 4)) : bitmap[i];
+          on = (a >= half);
+        }
+        if (on)
+        {
+          if (run < 0)
+          {
+            run = i;
+          }
+        }
+        else if (run >= 0)
+        {
+          writeFastHLine(x + run, y + j, i - run, color);
+          run = -1;
+        }
+      }
+    }
+    endWrite();
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a row of alpha pixels inside a startWrite() / endWrite() transaction,
+    framebuffer classes blend with the framebuffer content when bg equals color
+  @param  x       Left x coordinate
+  @param  y       y coordinate
+  @param  alpha   8-bit alpha of each pixel
+  @param  w       Width in pixels
+  @param  color   16-bit 5-6-5 Color of full coverage
+  @param  bg      16-bit 5-6-5 Color of no coverage, same as color to blend with the framebuffer content
+*/
+/**************************************************************************/
+void Arduino_GFX::writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg)
+{
+  for (int16_t i = 0; i < w; ++i)
+  {
+    if (bg != color)
+    {
+      writePixel(x + i, y, gfx_blend_16bit(color, bg, alpha[i]));
+    }
+    else if (alpha[i] >= 128) // nothing to blend with, draw pixels of at least half coverage
+    {
+      writePixel(x + i, y, color);
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a 16-bit image (RGB 5/6/5) with an 8-bit alpha plane at the specified (x,y) position.
+    Framebuffer sub-classes blend with the existing pixels,
+    others draw the pixels of at least half opacity.
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  bitmap  16-bit color bitmap
+  @param  alpha   8-bit alpha of each pixel, 255 is opaque
+  @param  w       Width of bitmap in pixels
+  @param  h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Arduino_GFX::draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h)
+{
+  for (int16_t j = 0; j < h; ++j, bitmap += w, alpha += w)
+  {
+    int16_t run = -1;
+    for (int16_t i = 0; i <= w; ++i)
+    {
+      if ((i < w) && (alpha[i] >= 128))
+      {
+        if (run < 0)
+        {
+          run = i;
+        }
+      }
+      else if (run >= 0)
+      {
+        draw16bitRGBBitmap(x + run, y + j, (uint16_t *)bitmap + run, i - run, 1);
+        run = -1;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a 32-bit ARGB image (0xAARRGGBB) at the specified (x,y) position.
+    Framebuffer sub-classes blend with the existing pixels,
+    others draw the pixels of at least half opacity.
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  bitmap  32-bit ARGB bitmap, alpha 255 is opaque
+  @param  w       Width of bitmap in pixels
+  @param  h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Arduino_GFX::draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h)
+{
+  uint16_t buf[ALPHA_BITMAP_BUF_PIXELS];
+  for (int16_t j = 0; j < h; ++j, bitmap += w)
+  {
+    int16_t run = -1;
+    for (int16_t i = 0; i <= w; ++i)
+    {
+      bool on = (i < w) && ((bitmap[i] >> 24) >= 128);
+      if (on)
+      {
+        if (run < 0)
+        {
+          run = i;
+        }
+        uint32_t p = bitmap[i];
+        buf[i - run] = ((p >> 8) & 0xF800) | ((p >> 5) & 0x07E0) | ((p >> 3) & 0x001F);
+      }
+      if ((run >= 0) && ((!on) || ((i - run + 1) == ALPHA_BITMAP_BUF_PIXELS)))
+      {
+        int16_t len = on ? (i - run + 1) : (i - run);
+        draw16bitRGBBitmap(x + run, y + j, buf, len, 1);
+        run = -1;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a 16-bit image (RGB 5/6/5) scaled to dst_w x dst_h at the specified (x,y) position.
+    Each destination pixel samples the bitmap at its center, nearest or bilinear.
+  @param  x         Top left corner x coordinate
+  @param  y         Top left corner y coordinate
+  @param  bitmap    byte array with 16-bit color bitmap
+  @param  w         Width of bitmap in pixels
+  @param  h         Height of bitmap in pixels
+  @param  dst_w     Width drawn in pixels
+  @param  dst_h     Height drawn in pixels
+  @param  bilinear  true to blend the 4 nearest bitmap pixels
+*/
+/**************************************************************************/
+void Arduino_GFX::draw16bitRGBBitmapScaled(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h,
+                                           int16_t dst_w, int16_t dst_h, bool bilinear)
+{
+  if ((w <= 0) || (h <= 0) || (dst_w <= 0) || (dst_h <= 0))
+  {
+    return;
+  }
+  int32_t x1 = (x < 0) ? 0 : x;
+  int32_t y1 = (y < 0) ? 0 : y;
+  int32_t x2 = (int32_t)x + dst_w - 1;
+  int32_t y2 = (int32_t)y + dst_h - 1;
+  if (x2 > (_width - 1))
+  {
+    x2 = _width - 1;
+  }
+  if (y2 > (_height - 1))
+  {
+    y2 = _height - 1;
+  }
+  if ((x1 > x2) || (y1 > y2))
+  {
+    return;
+  }
+
+  gfx_affine_t affine;
+  affine.bitmap = bitmap;
+  affine.bitmap_w = w;
+  affine.bitmap_h = h;
+  affine.x1 = x1;
+  affine.y1 = y1;
+  affine.x2 = x2;
+  affine.y2 = y2;
+  // rounded down steps keep the last pixel center inside the bitmap
+  affine.du_dx = ((int32_t)w << 16) / dst_w;
+  affine.dv_dy = ((int32_t)h << 16) / dst_h;
+  affine.dv_dx = 0;
+  affine.du_dy = 0;
+  affine.u = (affine.du_dx >> 1) + (x1 - x) * affine.du_dx;
+  affine.v = (affine.dv_dy >> 1) + (y1 - y) * affine.dv_dy;
+  affine.bilinear = bilinear;
+  affine.scaled_x = x;
+  affine.scaled_y = y;
+  affine.scaled_w = dst_w;
+  affine.scaled_h = dst_h;
+  drawAffineBitmap(&affine);
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a 16-bit image (RGB 5/6/5) turned and scaled around its center.
+  @param  x         Center x coordinate
+  @param  y         Center y coordinate
+  @param  bitmap    byte array with 16-bit color bitmap
+  @param  w         Width of bitmap in pixels
+  @param  h         Height of bitmap in pixels
+  @param  angle     Clockwise rotation in degrees
+  @param  scale     Size factor
+  @param  bilinear  true to blend the 4 nearest bitmap pixels
+*/
+/**************************************************************************/
+void Arduino_GFX::draw16bitRGBBitmapRotated(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h,
+                                            float angle, float scale, bool bilinear)
+{
+  if ((w <= 0) || (h <= 0) || (scale <= 0))
+  {
+    return;
+  }
+  float s = sin(angle * DEGTORAD);
+  float c = cos(angle * DEGTORAD);
+
+  // bounding box of the turned bitmap
+  float ex = (fabsf(c) * w + fabsf(s) * h) * scale / 2;
+  float ey = (fabsf(s) * w + fabsf(c) * h) * scale / 2;
+  int32_t x1 = (int32_t)floorf(x - ex);
+  int32_t y1 = (int32_t)floorf(y - ey);
+  int32_t x2 = (int32_t)ceilf(x + ex) - 1;
+  int32_t y2 = (int32_t)ceilf(y + ey) - 1;
+  if (x1 < 0)
+  {
+    x1 = 0;
+  }
+  if (y1 < 0)
+  {
+    y1 = 0;
+  }
+  if (x2 > (_width - 1))
+  {
+    x2 = _width - 1;
+  }
+  if (y2 > (_height - 1))
+  {
+    y2 = _height - 1;
+  }
+  if ((x1 > x2) || (y1 > y2))
+  {
+    return;
+  }
+
+  // inverse mapping from destination pixel centers to the bitmap
+  float du_dx = c / scale;
+  float dv_dx = -s / scale;
+  float du_dy = s / scale;
+  float dv_dy = c / scale;
+  float dx = x1 + 0.5f - x;
+  float dy = y1 + 0.5f - y;
+
+  gfx_affine_t affine;
+  affine.bitmap = bitmap;
+  affine.bitmap_w = w;
+  affine.bitmap_h = h;
+  affine.x1 = x1;
+  affine.y1 = y1;
+  affine.x2 = x2;
+  affine.y2 = y2;
+  affine.u = (int32_t)floorf((du_dx * dx + du_dy * dy + w / 2.0f) * 65536);
+  affine.v = (int32_t)floorf((dv_dx * dx + dv_dy * dy + h / 2.0f) * 65536);
+  affine.du_dx = (int32_t)lroundf(du_dx * 65536);
+  affine.dv_dx = (int32_t)lroundf(dv_dx * 65536);
+  affine.du_dy = (int32_t)lroundf(du_dy * 65536);
+  affine.dv_dy = (int32_t)lroundf(dv_dy * 65536);
+  affine.bilinear = bilinear;
+  affine.scaled_x = 0;
+  affine.scaled_y = 0;
+  affine.scaled_w = 0;
+  affine.scaled_h = 0;
+  drawAffineBitmap(&affine);
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw the clipped bounds of an affine mapped bitmap, row by row through a small buffer.
+    Sub-classes write framebuffers directly or stream the rows to the panel.
+  @param  affine  Mapping from destination pixels to the bitmap
+*/
+/**************************************************************************/
+void Arduino_GFX::drawAffineBitmap(const gfx_affine_t *affine)
+{
+  uint16_t buf[AFFINE_BITMAP_BUF_PIXELS];
+  for (int16_t j = affine->y1; j <= affine->y2; ++j)
+  {
+    int16_t i;
+    int16_t len = gfx_affine_span(affine, j, &i);
+    while (len > 0)
+    {
+      int16_t n = (len > AFFINE_BITMAP_BUF_PIXELS) ? AFFINE_BITMAP_BUF_PIXELS : len;
+      gfx_affine_row_16bit(buf, 1, affine, i, j, n);
+      draw16bitRGBBitmap(i, j, buf, n, 1);
+      i += n;
+      len -= n;
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Set the rows that scroll with scrollTo(), the rows above and below stay in place.
+    This display cannot scroll, sub-classes scroll in hardware or move framebuffer rows.
+  @param  y  Top row of the area, in rotated coordinates
+  @param  h  Number of rows, 0 to end scrolling
+  @return true if the display scrolls this area
+*/
+/**************************************************************************/
+bool Arduino_GFX::setScrollArea(int16_t y, int16_t h)
+{
+  UNUSED(y);
+  UNUSED(h);
+  return false;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Show the scroll area from offset rows down at its top, wrapping around at its end.
+    Panels that scroll in hardware keep every row and show them at a new place, draw at getScrollDrawY().
+    Framebuffer displays move the rows by the change of offset (the shorter way round):
+    rows moved out of the area are lost and the uncovered rows must be redrawn.
+    A log view adds a line with scrollTo(getScrollOffset() + line_h) and draws it at getScrollDrawY(area_y + area_h - line_h),
+    an area height that is a multiple of line_h keeps the line in one piece.
+  @param  offset  Rows, taken modulo the area height
+*/
+/**************************************************************************/
+void Arduino_GFX::scrollTo(int16_t offset)
+{
+  UNUSED(offset);
+}
+
+/**************************************************************************/
+/*!
+  @brief  Row to draw at so that the pixels show on screen row y after scrollTo()
+  @param  y  Screen row, in rotated coordinates
+  @return drawing row, y itself outside the scroll area or if the display moves its framebuffer rows
+*/
+/**************************************************************************/
+int16_t Arduino_GFX::getScrollDrawY(int16_t y)
+{
+  return y;
+}
+
+int16_t Arduino_GFX::getScrollOffset()
+{
+  return _scroll_offset;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Wait until the panel starts a new refresh, see Arduino_FrameSync::waitForVSync()
+  @param  timeout_ms  Give up after this time
+  @return false if the display has no sync signal (TE pin, VSYNC or refresh done event) or on timeout
+*/
+/**************************************************************************/
+bool Arduino_GFX::waitForVSync(uint32_t timeout_ms)
+{
+  Arduino_FrameSync *frame_sync = getFrameSync();
+  return frame_sync && frame_sync->waitForVSync(timeout_ms);
+}
+
+/**************************************************************************/
+/*!
+  @brief  Send the frame drawn since the previous flush() right after the panel starts a refresh and count it.
+    The transfer follows the scan line, it does not tear if it is faster than the refresh.
+  @param  force_flush  Passed to flush()
+*/
+/**************************************************************************/
+void Arduino_GFX::presentOnVSync(bool force_flush)
+{
+  waitForVSync();
+  flush(force_flush);
+  Arduino_FrameSync *frame_sync = getFrameSync();
+  if (frame_sync)
+  {
+    frame_sync->framePresented();
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a 16-bit bitmap right after the panel starts a refresh and count it as a frame,
+    e.g. an animation sent straight to a panel with its own frame memory
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  bitmap  16-bit 5-6-5 bitmap
+  @param  w       Width of bitmap in pixels
+  @param  h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Arduino_GFX::presentOnVSync(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+  waitForVSync();
+  draw16bitRGBBitmap(x, y, bitmap, w, h);
+  Arduino_FrameSync *frame_sync = getFrameSync();
+  if (frame_sync)
+  {
+    frame_sync->framePresented();
+  }
+}
+
+// refreshes, frames presented, missed refreshes and fps, nullptr if the display has no sync signal
+const frame_sync_stats_t *Arduino_GFX::getFrameStats()
+{
+  Arduino_FrameSync *frame_sync = getFrameSync();
+  return frame_sync ? frame_sync->getStats() : nullptr;
+}
+
+// check and keep a scroll area for setScrollArea() of sub-classes
+bool Arduino_GFX::initScrollArea(int16_t y, int16_t h)
+{
+  if ((y < 0) || (h < 0) || ((y + h) > _height))
+  {
+    return false;
+  }
+  _scroll_y = y;
+  _scroll_h = h;
+  _scroll_offset = 0;
+  return true;
+}
+
+// keep a new offset wrapped into the area, return how far the content moves up, the shorter way round
+int16_t Arduino_GFX::scrollDelta(int16_t offset)
+{
+  if (_scroll_h == 0)
+  {
+    return 0;
+  }
+  offset %= _scroll_h;
+  if (offset < 0)
+  {
+    offset += _scroll_h;
+  }
+  int16_t delta = offset - _scroll_offset;
+  if (delta > (_scroll_h / 2))
+  {
+    delta -= _scroll_h;
+  }
+  else if (delta < -(_scroll_h / 2))
+  {
+    delta += _scroll_h;
+  }
+  _scroll_offset = offset;
+  return delta;
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+/**************************************************************************/
+/*!
+  @brief  Draw a PROGMEM-resident 24-bit image (RGB 5/6/5) at the specified (x,y) position.
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  bitmap  byte array with 16-bit color bitmap
+  @param  w       Width of bitmap in pixels
+  @param  h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Arduino_GFX::draw24bitRGBBitmap(int16_t x, int16_t y,
+                                     const uint8_t bitmap[], int16_t w, int16_t h)
+{
+  int32_t offset = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++)
+  {
+    for (int16_t i = 0; i < w; i++)
+    {
+      writePixel(x + i, y, color565(pgm_read_byte(&bitmap[offset]), pgm_read_byte(&bitmap[offset + 1]), pgm_read_byte(&bitmap[offset + 2])));
+      offset += 3;
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a RAM-resident 24-bit image (RGB 5/6/5) at the specified (x,y) position.
+  @param  x       Top left corner x coordinate
+  @param  y       Top left corner y coordinate
+  @param  bitmap  byte array with 16-bit color bitmap
+  @param  w       Width of bitmap in pixels
+  @param  h       Height of bitmap in pixels
+*/
+/**************************************************************************/
+void Arduino_GFX::draw24bitRGBBitmap(int16_t x, int16_t y,
+                                     uint8_t *bitmap, int16_t w, int16_t h)
+{
+  int32_t offset = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++)
   {
     for (int16_t i = 0; i < w; i++)
     {
@@ -1917,16 +3138,12 @@ void Arduino_GFX::u8g2_font_decode_len(uint8_t len, uint8_t is_foreground, uint1
   uint8_t current; /* number of pixels, which need to be drawn for the draw procedure */
   /* current is either equal to cnt or equal to rem */
 
-  /* target position on the screen */
-  uint16_t x, y;
-
   cnt = len;
 
   /* get the local position */
   uint8_t lx = _u8g2_dx;
   uint8_t ly = _u8g2_dy;
 
-  int16_t curW;
   for (;;)
   {
     /* calculate the number of pixel to the right edge of the glyph */
@@ -1941,70 +3158,427 @@ void Arduino_GFX::u8g2_font_decode_len(uint8_t len, uint8_t is_foreground, uint1
 
     /* now draw the line, but apply the rotation around the glyph target position */
     // u8g2_font_decode_draw_pixel(u8g2, lx,ly,current, is_foreground);
+    if (is_foreground)
+    {
+      u8g2_font_draw_run(lx, ly, current, color);
+    }
+    else if (bg != color)
+    {
+      u8g2_font_draw_run(lx, ly, current, bg);
+    }
 
-    if (textsize_x == 1 && textsize_y == 1)
+    /* check, whether the end of the run length code has been reached */
+    if (cnt < rem)
+      break;
+    cnt -= rem;
+    lx = 0;
+    ly++;
+  }
+  lx += cnt;
+
+  _u8g2_dx = lx;
+  _u8g2_dy = ly;
+}
+
+void Arduino_GFX::u8g2_font_draw_run(uint8_t lx, uint8_t ly, uint8_t len, uint16_t color)
+{
+  /* target position on the screen */
+  uint16_t x, y;
+  int16_t curW;
+
+  if (textsize_x == 1 && textsize_y == 1)
+  {
+    /* get target position */
+    x = _u8g2_target_x + lx;
+    y = _u8g2_target_y + ly;
+
+    /* draw foreground and background (if required) */
+    if ((x <= _max_text_x) && (y <= _max_text_y))
     {
-      /* get target position */
-      x = _u8g2_target_x + lx;
-      y = _u8g2_target_y + ly;
+      curW = len;
+      if ((x + curW - 1) > _max_text_x)
+      {
+        curW = _max_text_x - x + 1;
+      }
+      writeFillRect(x, y, curW, 1, color);
+    }
+  }
+  else
+  {
+    /* get target position */
+    x = _u8g2_target_x + (lx * textsize_x);
+    y = _u8g2_target_y + (ly * textsize_y);
 
-      /* draw foreground and background (if required) */
-      if ((x <= _max_text_x) && (y <= _max_text_y))
+    /* draw foreground and background (if required) */
+    if (((x + textsize_x - 1) <= _max_text_x) && ((y + textsize_y - 1) <= _max_text_y))
+    {
+      curW = len * textsize_x;
+      while ((x + curW - 1) > _max_text_x)
       {
-        curW = current;
-        if ((x + curW - 1) > _max_text_x)
+        curW -= textsize_x;
+      }
+      writeFillRect(x, y, curW - text_pixel_margin,
+                    textsize_y - text_pixel_margin, color);
+    }
+  }
+}
+
+// extract from u8g2_font_get_glyph_data()
+const uint8_t *Arduino_GFX::u8g2_font_get_glyph_data(uint16_t encoding)
+{
+  const uint8_t *font = u8g2Font;
+  const uint8_t *glyph_data = 0;
+
+  font += 23; // U8G2_FONT_DATA_STRUCT_SIZE
+  if (encoding <= 255)
+  {
+    if (encoding >= 'a')
+    {
+      font += _u8g2_start_pos_lower_a;
+    }
+    else if (encoding >= 'A')
+    {
+      font += _u8g2_start_pos_upper_A;
+    }
+
+    for (;;)
+    {
+      if (pgm_read_byte(font + 1) == 0)
+        break;
+      if (pgm_read_byte(font) == encoding)
+      {
+        glyph_data = font + 2; /* skip encoding and glyph size */
+      }
+      font += pgm_read_byte(font + 1);
+    }
+  }
+#ifdef U8G2_WITH_UNICODE
+#if !defined(LITTLE_FOOT_PRINT)
+  else if (_u8g2_unicode_index_cnt)
+  {
+    /* binary search the last indexed glyph not after encoding, then scan forward */
+    uint16_t lo = 0;
+    uint16_t hi = _u8g2_unicode_index_cnt;
+    while (lo < hi)
+    {
+      uint16_t mid = (lo + hi) / 2;
+      if (_u8g2_unicode_index_encoding[mid] <= encoding)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    if (lo > 0)
+    {
+      uint16_t e;
+      font = u8g2Font + _u8g2_unicode_index_offset[lo - 1];
+      for (;;)
+      {
+        e = u8g2_font_get_word(font, 0);
+
+        if ((e == 0) || (e > encoding))
+          break;
+
+        if (e == encoding)
+        {
+          glyph_data = font + 3; /* skip encoding and glyph size */
+          break;
+        }
+        font += pgm_read_byte(font + 2);
+      }
+    }
+  }
+#endif // !defined(LITTLE_FOOT_PRINT)
+  else
+  {
+    uint16_t e;
+    font += _u8g2_start_pos_unicode;
+    const uint8_t *unicode_lookup_table = font;
+
+    /* issue 596: search for the glyph start in the unicode lookup table */
+    do
+    {
+      font += u8g2_font_get_word(unicode_lookup_table, 0);
+      e = u8g2_font_get_word(unicode_lookup_table, 2);
+      unicode_lookup_table += 4;
+    } while (e < encoding);
+
+    for (;;)
+    {
+      e = u8g2_font_get_word(font, 0);
+
+      if (e == 0)
+        break;
+
+      if (e == encoding)
+      {
+        glyph_data = font + 3; /* skip encoding and glyph size */
+        break;
+      }
+      font += pgm_read_byte(font + 2);
+    }
+  }
+#endif
+
+  return glyph_data;
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+/**************************************************************************/
+/*!
+  @brief  Enable U8g2 glyph cache, decoded glyphs are kept as 1-bit bitmaps
+  @param  size  Memory budget in bytes, 0 to disable and free the cache
+  @return true if the cache is ready or disabled as requested
+*/
+/**************************************************************************/
+bool Arduino_GFX::setGlyphCacheSize(uint32_t size)
+{
+  _u8g2_cached_glyph = nullptr;
+  if (size == 0)
+  {
+    if (_glyph_cache)
+    {
+      delete _glyph_cache;
+      _glyph_cache = nullptr;
+    }
+    return true;
+  }
+
+  if (_glyph_cache)
+  {
+    _glyph_cache->setBudget(size);
+  }
+  else
+  {
+    _glyph_cache = new Arduino_GlyphCache(size);
+  }
+  return _glyph_cache != nullptr;
+}
+
+Arduino_GlyphCache *Arduino_GFX::getGlyphCache()
+{
+  return _glyph_cache;
+}
+
+// decode the run length data following the glyph header into glyph bitmap
+void Arduino_GFX::u8g2_font_decode_glyph_bitmap(gfx_cached_glyph_t *glyph)
+{
+  uint8_t w = glyph->width;
+  uint8_t h = glyph->height;
+  uint8_t lx = 0, ly = 0;
+  uint8_t a, b, len, current;
+  uint8_t *row = glyph->bitmap;
+
+  if (w == 0)
+  {
+    return;
+  }
+
+  for (;;)
+  {
+    a = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_0);
+    b = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_1);
+    do
+    {
+      // skip background run
+      len = a;
+      while (len >= (w - lx))
+      {
+        len -= w - lx;
+        lx = 0;
+        ly++;
+        row += glyph->stride;
+      }
+      lx += len;
+
+      // set foreground run
+      len = b;
+      while (len)
+      {
+        current = w - lx;
+        if (len < current)
         {
-          curW = _max_text_x - x + 1;
+          current = len;
         }
-        if (is_foreground)
+        if (ly < h)
         {
-          writeFillRect(x, y, curW, 1, color);
+          for (uint8_t i = lx; i < lx + current; i++)
+          {
+            row[i >> 3] |= 0x80 >> (i & 7);
+          }
         }
-        else if (bg != color)
+        len -= current;
+        lx += current;
+        if (lx >= w)
         {
-          writeFillRect(x, y, curW, 1, bg);
+          lx = 0;
+          ly++;
+          row += glyph->stride;
+        }
+      }
+    } while (u8g2_font_decode_get_unsigned_bits(1) != 0);
+
+    if (ly >= h)
+      break;
+  }
+}
+
+// draw _u8g2_cached_glyph at _u8g2_target_x, _u8g2_target_y
+void Arduino_GFX::u8g2_font_draw_cached_glyph(uint16_t color, uint16_t bg)
+{
+  gfx_cached_glyph_t *glyph = _u8g2_cached_glyph;
+  int16_t w = glyph->width;
+  int16_t h = glyph->height;
+
+  // opaque glyph fully inside text bound: expand and send as a single bitmap
+  if (
+      (bg != color) && (textsize_x == 1) && (textsize_y == 1) &&
+      (_u8g2_target_x >= _min_text_x) && (_u8g2_target_y >= _min_text_y) &&
+      ((_u8g2_target_x + w - 1) <= _max_text_x) && ((_u8g2_target_y + h - 1) <= _max_text_y))
+  {
+    uint16_t *buf = _glyph_cache->getPixelBuffer(w * h);
+    if (buf)
+    {
+      uint16_t *p = buf;
+      const uint8_t *row = glyph->bitmap;
+      for (int16_t j = 0; j < h; j++)
+      {
+        uint8_t byte = 0;
+        for (int16_t i = 0; i < w; i++)
+        {
+          if (i & 7)
+          {
+            byte <<= 1;
+          }
+          else
+          {
+            byte = row[i >> 3];
+          }
+          *p++ = (byte & 0x80) ? color : bg;
         }
+        row += glyph->stride;
       }
+      draw16bitRGBBitmap(_u8g2_target_x, _u8g2_target_y, buf, w, h);
+      return;
     }
-    else
-    {
-      /* get target position */
-      x = _u8g2_target_x + (lx * textsize_x);
-      y = _u8g2_target_y + (ly * textsize_y);
+  }
 
-      /* draw foreground and background (if required) */
-      if (((x + textsize_x - 1) <= _max_text_x) && ((y + textsize_y - 1) <= _max_text_y))
+  // draw the runs of each row, clipped the same as u8g2_font_decode_len()
+  startWrite();
+  const uint8_t *row = glyph->bitmap;
+  for (uint8_t ly = 0; ly < h; ly++)
+  {
+    uint8_t lx = 0;
+    while (lx < w)
+    {
+      bool is_foreground = row[lx >> 3] & (0x80 >> (lx & 7));
+      uint8_t len = 1;
+      while (((lx + len) < w) && (((row[(lx + len) >> 3] & (0x80 >> ((lx + len) & 7))) != 0) == is_foreground))
       {
-        curW = current * textsize_x;
-        while ((x + curW - 1) > _max_text_x)
-        {
-          curW -= textsize_x;
-        }
-        if (is_foreground)
-        {
-          writeFillRect(x, y, curW - text_pixel_margin,
-                                  textsize_y - text_pixel_margin, color);
-        }
-        else if (bg != color)
-        {
-          writeFillRect(x, y, curW - text_pixel_margin,
-                                  textsize_y - text_pixel_margin, bg);
-        }
+        len++;
+      }
+      if (is_foreground)
+      {
+        u8g2_font_draw_run(lx, ly, len, color);
+      }
+      else if (bg != color)
+      {
+        u8g2_font_draw_run(lx, ly, len, bg);
       }
+      lx += len;
     }
+    row += glyph->stride;
+  }
+  endWrite();
+}
 
-    /* check, whether the end of the run length code has been reached */
-    if (cnt < rem)
-      break;
-    cnt -= rem;
-    lx = 0;
-    ly++;
+#ifdef U8G2_WITH_UNICODE
+// index the unicode glyphs of u8g2Font, glyph lookup falls back to the font's own jump table if out of memory
+void Arduino_GFX::u8g2_font_build_unicode_index()
+{
+  if (_u8g2_unicode_index_font == u8g2Font)
+  {
+    return; // already indexed
+  }
+  u8g2_font_free_unicode_index();
+
+  /* the first unicode lookup table entry jumps over the table to the first glyph */
+  const uint8_t *unicode_lookup_table = u8g2Font + 23 + _u8g2_start_pos_unicode; // U8G2_FONT_DATA_STRUCT_SIZE
+  const uint8_t *first_glyph = unicode_lookup_table + u8g2_font_get_word(unicode_lookup_table, 0);
+  const uint8_t *font = first_glyph;
+  uint32_t glyph_cnt = 0;
+  while (u8g2_font_get_word(font, 0) != 0)
+  {
+    ++glyph_cnt;
+    font += pgm_read_byte(font + 2);
+  }
+  if (glyph_cnt <= U8G2_UNICODE_INDEX_STEP)
+  {
+    return; // the jump table lookup is short enough
   }
-  lx += cnt;
 
-  _u8g2_dx = lx;
-  _u8g2_dy = ly;
+  uint32_t cnt = (glyph_cnt + U8G2_UNICODE_INDEX_STEP - 1) / U8G2_UNICODE_INDEX_STEP;
+  if (cnt > 0xFFFF)
+  {
+    cnt = 0xFFFF;
+  }
+#if defined(ESP32)
+  if (psramFound())
+  {
+    _u8g2_unicode_index_encoding = (uint16_t *)ps_malloc(cnt * 2);
+    _u8g2_unicode_index_offset = (uint32_t *)ps_malloc(cnt * 4);
+  }
+  else
+  {
+    _u8g2_unicode_index_encoding = (uint16_t *)malloc(cnt * 2);
+    _u8g2_unicode_index_offset = (uint32_t *)malloc(cnt * 4);
+  }
+#else
+  _u8g2_unicode_index_encoding = (uint16_t *)malloc(cnt * 2);
+  _u8g2_unicode_index_offset = (uint32_t *)malloc(cnt * 4);
+#endif
+  if ((!_u8g2_unicode_index_encoding) || (!_u8g2_unicode_index_offset))
+  {
+    u8g2_font_free_unicode_index();
+    return;
+  }
+
+  font = first_glyph;
+  uint32_t i = 0;
+  for (uint32_t g = 0; (g < glyph_cnt) && (i < cnt); ++g)
+  {
+    if ((g % U8G2_UNICODE_INDEX_STEP) == 0)
+    {
+      _u8g2_unicode_index_encoding[i] = u8g2_font_get_word(font, 0);
+      _u8g2_unicode_index_offset[i] = font - u8g2Font;
+      ++i;
+    }
+    font += pgm_read_byte(font + 2);
+  }
+  _u8g2_unicode_index_cnt = i;
+  _u8g2_unicode_index_font = u8g2Font;
+}
+
+void Arduino_GFX::u8g2_font_free_unicode_index()
+{
+  if (_u8g2_unicode_index_encoding)
+  {
+    free(_u8g2_unicode_index_encoding);
+    _u8g2_unicode_index_encoding = nullptr;
+  }
+  if (_u8g2_unicode_index_offset)
+  {
+    free(_u8g2_unicode_index_offset);
+    _u8g2_unicode_index_offset = nullptr;
+  }
+  _u8g2_unicode_index_cnt = 0;
+  _u8g2_unicode_index_font = nullptr;
 }
+#endif // U8G2_WITH_UNICODE
+#endif // !defined(LITTLE_FOOT_PRINT)
 #endif // defined(U8G2_FONT_SUPPORT)
 
 // TEXT- AND CHARACTER-HANDLING FUNCTIONS ----------------------------------
@@ -2026,7 +3600,73 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
   int16_t block_w, block_h, curX, curY, curW, curH;
 
 #if !defined(ATTINY_CORE)
-  if (gfxFont) // custom font
+#if !defined(LITTLE_FOOT_PRINT)
+  if (gfxAlphaFont) // anti-aliased font
+  {
+    GFXglyph *glyph = gfxAlphaFont->glyph + (c - gfxAlphaFont->first);
+    const uint8_t *bitmap = gfxAlphaFont->bitmap + glyph->bitmapOffset;
+    uint8_t w = glyph->width,
+            h = glyph->height,
+            bpp = gfxAlphaFont->bpp;
+    curX = x + (glyph->xOffset * textsize_x);
+    curY = y + (glyph->yOffset * textsize_y);
+    block_w = w * textsize_x;
+    block_h = h * textsize_y;
+    if (
+        (w == 0) ||
+        (curX > _max_text_x) ||                 // Clip right
+        (curY > _max_text_y) ||                 // Clip bottom
+        ((curX + block_w - 1) < _min_text_x) || // Clip left
+        ((curY + block_h - 1) < _min_text_y)    // Clip top
+    )
+    {
+      return;
+    }
+
+    if (
+        (textsize_x == 1) && (textsize_y == 1) &&
+        (((curX >= _min_text_x) && (curY >= _min_text_y) && ((curX + w - 1) <= _max_text_x) && ((curY + h - 1) <= _max_text_y)) ||
+         ((_min_text_x <= 0) && (_min_text_y <= 0) && (_max_text_x >= _max_x) && (_max_text_y >= _max_y))))
+    {
+      // inside text bound, or the bound is the whole screen that drawAlphaBitmap() clips to
+      drawAlphaBitmap(curX, curY, bitmap, bpp, w, h, color, bg);
+    }
+    else // scaled or partly outside text bound, a rectangle per alpha pixel
+    {
+      uint16_t lut[33];
+      gfx_alpha_lut_16bit(lut, color, bg, bpp);
+      uint16_t stride = ((uint16_t)w * bpp + 7) / 8;
+      uint8_t half = (bpp == 4) ? 8 : 128;
+      int16_t rowX = curX;
+      startWrite();
+      for (uint8_t j = 0; j < h; ++j, curY += textsize_y, bitmap += stride)
+      {
+        if ((curY >= _min_text_y) && ((curY + textsize_y - 1) <= _max_text_y))
+        {
+          curX = rowX;
+          for (uint8_t i = 0; i < w; ++i, curX += textsize_x)
+          {
+            if ((curX >= _min_text_x) && ((curX + textsize_x - 1) <= _max_text_x))
+            {
+              uint8_t a = (bpp == 4) ? ((i & 1) ? (bitmap[i >> 1] & 0x0F) : (bitmap[i >> 1] >> 4)) : bitmap[i];
+              if (bg != color)
+              {
+                writeFillRect(curX, curY, textsize_x, textsize_y, lut[(bpp == 4) ? a : ((a + 4) >> 3)]);
+              }
+              else if (a >= half) // nothing to blend with, draw pixels of at least half coverage
+              {
+                writeFillRect(curX, curY, textsize_x - text_pixel_margin, textsize_y - text_pixel_margin, color);
+              }
+            }
+          }
+        }
+      }
+      endWrite();
+    }
+  }
+  else
+#endif // !defined(LITTLE_FOOT_PRINT)
+      if (gfxFont) // custom font
   {
     // Character is assumed previously filtered by write() to eliminate
     // newlines, returns, non-printable characters, etc.  Calling
@@ -2061,10 +3701,10 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
     block_h = yAdvance * textsize_y;
     curY = y - (baseline * textsize_y);
     if (
-        (x > _max_text_x) ||                 // Clip right
-        (curY > _max_text_y) ||              // Clip bottom
-        ((x + block_w - 1) < _min_text_x) || // Clip left
-        ((y + block_h - 1) < _min_text_y)    // Clip top
+        (x > _max_text_x) ||                                                   // Clip right
+        ((curY > _max_text_y) && ((y + (yo16 * textsize_y)) > _max_text_y)) || // Clip bottom, glyph may start above background block
+        ((x + block_w - 1) < _min_text_x) ||                                   // Clip left
+        ((y + block_h - 1) < _min_text_y)                                      // Clip top
     )
     {
       return;
@@ -2101,7 +3741,7 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
             {
               bits = pgm_read_byte(&bitmap[bo++]);
             }
-            if (curX <= _max_text_x)
+            if ((curX >= _min_text_x) && (curX <= _max_text_x) && (curY >= _min_text_y))
             {
               if (bits & 0x80)
               {
@@ -2150,7 +3790,18 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
       return;
     }
 
-    if ((_u8g2_decode_ptr) && (_u8g2_char_width > 0))
+#if !defined(LITTLE_FOOT_PRINT)
+    if (_u8g2_cached_glyph)
+    {
+      if (_u8g2_char_width > 0)
+      {
+        _u8g2_target_x = x + (_u8g2_char_x * textsize_x);
+        u8g2_font_draw_cached_glyph(color, bg);
+      }
+    }
+    else
+#endif // !defined(LITTLE_FOOT_PRINT)
+      if ((_u8g2_decode_ptr) && (_u8g2_char_width > 0))
     {
       uint8_t a, b;
 
@@ -2201,12 +3852,12 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
       for (int8_t i = 0; i < 5; ++i, ++curX) // Char bitmap = 5 columns
       {
         uint8_t line = pgm_read_byte(&font[c * 5 + i]);
-        if (curX <= _max_text_x)
+        if ((curX >= _min_text_x) && (curX <= _max_text_x))
         {
           curY = y;
           for (int8_t j = 0; j < 8; ++j, ++curY, line >>= 1)
           {
-            if (curY <= _max_text_y)
+            if ((curY >= _min_text_y) && (curY <= _max_text_y))
             {
               if (line & 1)
               {
@@ -2282,6 +3933,19 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
   }
 }
 
+// draw character of write() at the cursor, rasterized into the drawTextRun() strip if one is active
+void Arduino_GFX::drawCursorChar(unsigned char c)
+{
+#if !defined(LITTLE_FOOT_PRINT)
+  if (_text_run_h > 0)
+  {
+    textRunChar(cursor_x, cursor_y, c, textcolor, textbgcolor);
+    return;
+  }
+#endif // !defined(LITTLE_FOOT_PRINT)
+  drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor);
+}
+
 /**************************************************************************/
 /*!
   @brief  Print one byte/character of data, used to support print()
@@ -2291,7 +3955,32 @@ void Arduino_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
 size_t Arduino_GFX::write(uint8_t c)
 {
 #if !defined(ATTINY_CORE)
-  if (gfxFont) // custom font
+#if !defined(LITTLE_FOOT_PRINT)
+  if (gfxAlphaFont) // anti-aliased font
+  {
+    if (c == '\n') // Newline
+    {
+      cursor_x = _min_text_x; // Reset x to zero, advance y by one line
+      cursor_y += (int16_t)textsize_y * gfxAlphaFont->yAdvance;
+    }
+    else if (c != '\r') // Not a carriage return; is normal char
+    {
+      if ((c >= gfxAlphaFont->first) && (c <= gfxAlphaFont->last)) // Char present in this font?
+      {
+        GFXglyph *glyph = gfxAlphaFont->glyph + (c - gfxAlphaFont->first);
+        if (wrap && ((cursor_x + ((glyph->xOffset + glyph->width) * textsize_x) - 1) > _max_text_x))
+        {
+          cursor_x = _min_text_x; // Reset x to zero, advance y by one line
+          cursor_y += (int16_t)textsize_y * gfxAlphaFont->yAdvance;
+        }
+        drawCursorChar(c);
+        cursor_x += (int16_t)textsize_x * glyph->xAdvance;
+      }
+    }
+  }
+  else
+#endif // !defined(LITTLE_FOOT_PRINT)
+      if (gfxFont) // custom font
   {
     if (c == '\n') // Newline
     {
@@ -2313,7 +4002,7 @@ size_t Arduino_GFX::write(uint8_t c)
           cursor_x = _min_text_x; // Reset x to zero, advance y by one line
           cursor_y += (int16_t)textsize_y * pgm_read_byte(&gfxFont->yAdvance);
         }
-        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor);
+        drawCursorChar(c);
         cursor_x += (int16_t)textsize_x * xa;
       }
     }
@@ -2324,6 +4013,9 @@ size_t Arduino_GFX::write(uint8_t c)
       if (u8g2Font)
   {
     _u8g2_decode_ptr = 0;
+#if !defined(LITTLE_FOOT_PRINT)
+    _u8g2_cached_glyph = nullptr;
+#endif // !defined(LITTLE_FOOT_PRINT)
 
     if (_enableUTF8Print)
     {
@@ -2379,79 +4071,58 @@ size_t Arduino_GFX::write(uint8_t c)
       }
       else if (_encoding != '\r')
       { // Ignore carriage returns
-        uint8_t *font = u8g2Font;
         const uint8_t *glyph_data = 0;
 
-        // extract from u8g2_font_get_glyph_data()
-        font += 23; // U8G2_FONT_DATA_STRUCT_SIZE
-        if (_encoding <= 255)
+#if !defined(LITTLE_FOOT_PRINT)
+        if (_glyph_cache)
         {
-          if (_encoding >= 'a')
-          {
-            font += _u8g2_start_pos_lower_a;
-          }
-          else if (_encoding >= 'A')
-          {
-            font += _u8g2_start_pos_upper_A;
-          }
-
-          for (;;)
-          {
-            if (pgm_read_byte(font + 1) == 0)
-              break;
-            if (pgm_read_byte(font) == _encoding)
-            {
-              glyph_data = font + 2; /* skip encoding and glyph size */
-            }
-            font += pgm_read_byte(font + 1);
-          }
+          _u8g2_cached_glyph = _glyph_cache->get(u8g2Font, _encoding);
+        }
+        if (_u8g2_cached_glyph)
+        {
+          _u8g2_char_width = _u8g2_cached_glyph->width;
+          _u8g2_char_height = _u8g2_cached_glyph->height;
+          _u8g2_char_x = _u8g2_cached_glyph->x_offset;
+          _u8g2_char_y = _u8g2_cached_glyph->y_offset;
+          _u8g2_delta_x = _u8g2_cached_glyph->x_advance;
+          glyph_data = _u8g2_cached_glyph->bitmap;
         }
-#ifdef U8G2_WITH_UNICODE
         else
+#endif // !defined(LITTLE_FOOT_PRINT)
         {
-          uint16_t e;
-          font += _u8g2_start_pos_unicode;
-          const uint8_t *unicode_lookup_table = font;
-
-          /* issue 596: search for the glyph start in the unicode lookup table */
-          do
+          glyph_data = u8g2_font_get_glyph_data(_encoding);
+          if (glyph_data)
           {
-            font += u8g2_font_get_word(unicode_lookup_table, 0);
-            e = u8g2_font_get_word(unicode_lookup_table, 2);
-            unicode_lookup_table += 4;
-          } while (e < _encoding);
-
-          for (;;)
-          {
-            e = u8g2_font_get_word(font, 0);
-
-            if (e == 0)
-              break;
+            // u8g2_font_decode_glyph
+            _u8g2_decode_ptr = glyph_data;
+            _u8g2_decode_bit_pos = 0;
+
+            _u8g2_char_width = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_char_width);
+            _u8g2_char_height = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_char_height);
+            _u8g2_char_x = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_char_x);
+            _u8g2_char_y = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_char_y);
+            _u8g2_delta_x = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_delta_x);
+            // log_d("c: %c, _encoding: %d, _u8g2_char_width: %d, _u8g2_char_height: %d, _u8g2_char_x: %d, _u8g2_char_y: %d, _u8g2_delta_x: %d",
+            //       c, _encoding, _u8g2_char_width, _u8g2_char_height, _u8g2_char_x, _u8g2_char_y, _u8g2_delta_x);
 
-            if (e == _encoding)
+#if !defined(LITTLE_FOOT_PRINT)
+            if (_glyph_cache)
             {
-              glyph_data = font + 3; /* skip encoding and glyph size */
-              break;
+              _u8g2_cached_glyph = _glyph_cache->add(u8g2Font, _encoding, _u8g2_char_width, _u8g2_char_height, 1);
+              if (_u8g2_cached_glyph)
+              {
+                _u8g2_cached_glyph->x_offset = _u8g2_char_x;
+                _u8g2_cached_glyph->y_offset = _u8g2_char_y;
+                _u8g2_cached_glyph->x_advance = _u8g2_delta_x;
+                u8g2_font_decode_glyph_bitmap(_u8g2_cached_glyph);
+              }
             }
-            font += pgm_read_byte(font + 2);
+#endif // !defined(LITTLE_FOOT_PRINT)
           }
         }
-#endif
 
         if (glyph_data)
         {
-          // u8g2_font_decode_glyph
-          _u8g2_decode_ptr = glyph_data;
-          _u8g2_decode_bit_pos = 0;
-
-          _u8g2_char_width = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_char_width);
-          _u8g2_char_height = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_char_height);
-          _u8g2_char_x = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_char_x);
-          _u8g2_char_y = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_char_y);
-          _u8g2_delta_x = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_delta_x);
-          // log_d("c: %c, _encoding: %d, _u8g2_char_width: %d, _u8g2_char_height: %d, _u8g2_char_x: %d, _u8g2_char_y: %d, _u8g2_delta_x: %d",
-          //       c, _encoding, _u8g2_char_width, _u8g2_char_height, _u8g2_char_x, _u8g2_char_y, _u8g2_delta_x);
-
           if (_u8g2_char_width > 0)
           {
             if (wrap && ((cursor_x + (textsize_x * _u8g2_char_width) - 1) > _max_text_x))
@@ -2461,7 +4132,7 @@ size_t Arduino_GFX::write(uint8_t c)
             }
           }
 
-          drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor);
+          drawCursorChar(c);
           cursor_x += (int16_t)textsize_x * _u8g2_delta_x;
         }
       }
@@ -2482,7 +4153,7 @@ size_t Arduino_GFX::write(uint8_t c)
         cursor_x = _min_text_x;     // Reset x to zero,
         cursor_y += textsize_y * 8; // advance y one line
       }
-      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor);
+      drawCursorChar(c);
       cursor_x += textsize_x * 6; // Advance x one char
     }
   }
@@ -2571,10 +4242,266 @@ void Arduino_GFX::setRotation(uint8_t r)
 void Arduino_GFX::setFont(const GFXfont *f)
 {
   gfxFont = (GFXfont *)f;
+#if !defined(LITTLE_FOOT_PRINT)
+  gfxAlphaFont = NULL;
+#endif // !defined(LITTLE_FOOT_PRINT)
+#if defined(U8G2_FONT_SUPPORT)
+  u8g2Font = NULL;
+#if !defined(LITTLE_FOOT_PRINT)
+  _u8g2_cached_glyph = nullptr;
+#endif // !defined(LITTLE_FOOT_PRINT)
+#endif // defined(U8G2_FONT_SUPPORT)
+}
+
+#if !defined(LITTLE_FOOT_PRINT)
+/**************************************************************************/
+/*!
+  @brief  Set the anti-aliased font to display when print()ing
+  @param  f   The GFXalphaFont object, if NULL use built in 6x8 font
+*/
+/**************************************************************************/
+void Arduino_GFX::setFont(const GFXalphaFont *f)
+{
+  gfxFont = NULL;
+  gfxAlphaFont = (GFXalphaFont *)f;
 #if defined(U8G2_FONT_SUPPORT)
   u8g2Font = NULL;
+  _u8g2_cached_glyph = nullptr;
+#endif // defined(U8G2_FONT_SUPPORT)
+}
+
+/**************************************************************************/
+/*!
+  @brief  Get the metrics and optionally the 1-bit bitmap of a glyph of current GFXfont or U8g2 font
+  @param  encoding  character code
+  @param  metrics   output, yOffset is from baseline to glyph top, bitmapOffset unused
+  @param  scratch   output row aligned bitmap, at least 32 x 255 bytes, NULL for metrics only
+  @return false if the glyph does not exist
+*/
+/**************************************************************************/
+bool Arduino_GFX::decodeMonoGlyph(uint16_t encoding, GFXglyph *metrics, gfx_cached_glyph_t *scratch)
+{
+  if (gfxFont)
+  {
+    uint16_t first = pgm_read_word(&gfxFont->first);
+    if ((encoding < first) || (encoding > pgm_read_word(&gfxFont->last)))
+    {
+      return false;
+    }
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, encoding - first);
+    metrics->width = pgm_read_byte(&glyph->width);
+    metrics->height = pgm_read_byte(&glyph->height);
+    metrics->xAdvance = pgm_read_byte(&glyph->xAdvance);
+    metrics->xOffset = pgm_read_byte(&glyph->xOffset);
+    metrics->yOffset = pgm_read_byte(&glyph->yOffset);
+    if (scratch)
+    {
+      const uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont) + pgm_read_word(&glyph->bitmapOffset);
+      uint8_t w = metrics->width, h = metrics->height;
+      uint8_t bits = 0, bit = 0;
+      scratch->width = w;
+      scratch->height = h;
+      scratch->stride = (w + 7) / 8;
+      memset(scratch->bitmap, 0, scratch->stride * h);
+      uint8_t *row = scratch->bitmap;
+      for (uint8_t yy = 0; yy < h; ++yy, row += scratch->stride)
+      {
+        for (uint8_t xx = 0; xx < w; ++xx)
+        {
+          if (!(bit++ & 7))
+          {
+            bits = pgm_read_byte(bitmap++);
+          }
+          if (bits & 0x80)
+          {
+            row[xx >> 3] |= 0x80 >> (xx & 7);
+          }
+          bits <<= 1;
+        }
+      }
+    }
+    return true;
+  }
+#if defined(U8G2_FONT_SUPPORT)
+  else if (u8g2Font)
+  {
+    const uint8_t *glyph_data = u8g2_font_get_glyph_data(encoding);
+    if (!glyph_data)
+    {
+      return false;
+    }
+    _u8g2_decode_ptr = glyph_data;
+    _u8g2_decode_bit_pos = 0;
+    uint8_t w = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_char_width);
+    uint8_t h = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_char_height);
+    int8_t char_x = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_char_x);
+    int8_t char_y = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_char_y);
+    metrics->xAdvance = u8g2_font_decode_get_signed_bits(_u8g2_bits_per_delta_x);
+    metrics->width = w;
+    metrics->height = h;
+    metrics->xOffset = char_x;
+    metrics->yOffset = -(h + char_y);
+    if (scratch)
+    {
+      scratch->width = w;
+      scratch->height = h;
+      scratch->stride = (w + 7) / 8;
+      memset(scratch->bitmap, 0, scratch->stride * h);
+      u8g2_font_decode_glyph_bitmap(scratch);
+    }
+    return true;
+  }
+#endif // defined(U8G2_FONT_SUPPORT)
+  return false;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Convert the current GFXfont or U8g2 font to an anti-aliased font by box filtering.
+    Draw the source font at scale times the wanted size, e.g. a 32 pixels font with scale 2 results a 16 pixels font.
+  @param  first   first character code
+  @param  last    last character code
+  @param  scale   source pixels per alpha pixel in each direction, 1 to 8
+  @param  bpp     bits per alpha pixel, 4 or 8
+  @return new font in one allocated block, release with free(); NULL if failed
+*/
+/**************************************************************************/
+GFXalphaFont *Arduino_GFX::createAlphaFont(uint16_t first, uint16_t last, uint8_t scale, uint8_t bpp)
+{
+  if ((last < first) || (scale < 1) || (scale > 8) || ((bpp != 4) && (bpp != 8)))
+  {
+    return NULL;
+  }
+  if (!gfxFont
+#if defined(U8G2_FONT_SUPPORT)
+      && !u8g2Font
+#endif // defined(U8G2_FONT_SUPPORT)
+  )
+  {
+    return NULL;
+  }
+
+  uint16_t count = last - first + 1;
+  uint8_t max_alpha = (1 << bpp) - 1;
+  uint16_t area = (uint16_t)scale * scale;
+  GFXglyph metrics;
+
+  // 1st pass: alpha glyph metrics and bitmap size
+  uint32_t bitmap_size = 0;
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    if (decodeMonoGlyph(first + i, &metrics, NULL) && (metrics.width > 0))
+    {
+      int16_t x0 = floor_div(metrics.xOffset, scale);
+      int16_t y0 = floor_div(metrics.yOffset, scale);
+      int16_t w = floor_div(metrics.xOffset + metrics.width + scale - 1, scale) - x0;
+      int16_t h = floor_div(metrics.yOffset + metrics.height + scale - 1, scale) - y0;
+      bitmap_size += (uint32_t)((w * bpp + 7) / 8) * h;
+    }
+  }
+  if (bitmap_size > 0xFFFF)
+  {
+    return NULL;
+  }
+
+  uint32_t size = sizeof(GFXalphaFont) + (sizeof(GFXglyph) * count) + bitmap_size;
+  uint8_t *block;
+#if defined(ESP32) && defined(BOARD_HAS_PSRAM)
+  block = (uint8_t *)ps_malloc(size);
+  if (!block)
+#endif
+    block = (uint8_t *)malloc(size);
+  gfx_cached_glyph_t *scratch = (gfx_cached_glyph_t *)malloc(sizeof(gfx_cached_glyph_t) + (32 * 255));
+  if ((!block) || (!scratch))
+  {
+    free(block);
+    free(scratch);
+    return NULL;
+  }
+  memset(block, 0, size);
+  GFXalphaFont *font = (GFXalphaFont *)block;
+  font->glyph = (GFXglyph *)(block + sizeof(GFXalphaFont));
+  font->bitmap = block + sizeof(GFXalphaFont) + (sizeof(GFXglyph) * count);
+  font->first = first;
+  font->last = last;
+  font->bpp = bpp;
+#if defined(U8G2_FONT_SUPPORT)
+  if (u8g2Font)
+  {
+    font->yAdvance = (_u8g2_max_char_height + (scale / 2)) / scale;
+  }
+  else
 #endif // defined(U8G2_FONT_SUPPORT)
+  {
+    font->yAdvance = (pgm_read_byte(&gfxFont->yAdvance) + (scale / 2)) / scale;
+  }
+
+  // 2nd pass: box filter source pixels into alpha pixels
+  uint16_t offset = 0;
+  for (uint16_t i = 0; i < count; ++i)
+  {
+    GFXglyph *glyph = font->glyph + i;
+    if (!decodeMonoGlyph(first + i, &metrics, scratch))
+    {
+      continue;
+    }
+    glyph->xAdvance = (metrics.xAdvance + (scale / 2)) / scale;
+    if (metrics.width == 0)
+    {
+      continue;
+    }
+    int16_t x0 = floor_div(metrics.xOffset, scale);
+    int16_t y0 = floor_div(metrics.yOffset, scale);
+    int16_t w = floor_div(metrics.xOffset + metrics.width + scale - 1, scale) - x0;
+    int16_t h = floor_div(metrics.yOffset + metrics.height + scale - 1, scale) - y0;
+    uint16_t stride = (w * bpp + 7) / 8;
+    glyph->bitmapOffset = offset;
+    glyph->width = w;
+    glyph->height = h;
+    glyph->xOffset = x0;
+    glyph->yOffset = y0;
+
+    uint8_t *dst = font->bitmap + offset;
+    // source pixel of alpha pixel (0, 0) relative to the source glyph top left
+    int16_t sx0 = (x0 * scale) - metrics.xOffset;
+    int16_t sy0 = (y0 * scale) - metrics.yOffset;
+    for (int16_t j = 0; j < h; ++j, dst += stride)
+    {
+      for (int16_t k = 0; k < w; ++k)
+      {
+        uint16_t cnt = 0;
+        for (int16_t sy = sy0 + (j * scale); sy < sy0 + ((j + 1) * scale); ++sy)
+        {
+          if ((sy < 0) || (sy >= metrics.height))
+          {
+            continue;
+          }
+          const uint8_t *src = scratch->bitmap + (sy * scratch->stride);
+          for (int16_t sx = sx0 + (k * scale); sx < sx0 + ((k + 1) * scale); ++sx)
+          {
+            if ((sx >= 0) && (sx < metrics.width) && (src[sx >> 3] & (0x80 >> (sx & 7))))
+            {
+              ++cnt;
+            }
+          }
+        }
+        uint8_t a = ((cnt * max_alpha) + (area / 2)) / area;
+        if (bpp == 4)
+        {
+          dst[k >> 1] |= (k & 1) ? a : (a << 4);
+        }
+        else
+        {
+          dst[k] = a;
+        }
+      }
+    }
+    offset += stride * h;
+  }
+  free(scratch);
+  return font;
 }
+#endif // !defined(LITTLE_FOOT_PRINT)
 
 /**************************************************************************/
 /*!
@@ -2590,7 +4517,13 @@ void Arduino_GFX::flush(bool force_flush)
 void Arduino_GFX::setFont(const uint8_t *font)
 {
   gfxFont = NULL;
+#if !defined(LITTLE_FOOT_PRINT)
+  gfxAlphaFont = NULL;
+#endif // !defined(LITTLE_FOOT_PRINT)
   u8g2Font = (uint8_t *)font;
+#if !defined(LITTLE_FOOT_PRINT)
+  _u8g2_cached_glyph = nullptr;
+#endif // !defined(LITTLE_FOOT_PRINT)
 
   // extract from u8g2_read_font_info()
   /* offset 0 */
@@ -2633,6 +4566,9 @@ void Arduino_GFX::setFont(const uint8_t *font)
   _u8g2_start_pos_unicode = u8g2_font_get_word(font, 21);
 #endif
   _u8g2_first_char = pgm_read_byte(font + 23);
+#if !defined(LITTLE_FOOT_PRINT) && defined(U8G2_WITH_UNICODE)
+  u8g2_font_build_unicode_index();
+#endif // !defined(LITTLE_FOOT_PRINT) && defined(U8G2_WITH_UNICODE)
   // log_d("_u8g2_start_pos_upper_A: %d, _u8g2_start_pos_lower_a: %d, _u8g2_start_pos_unicode: %d, _u8g2_first_char: %d",
   //       _u8g2_start_pos_upper_A, _u8g2_start_pos_lower_a, _u8g2_start_pos_unicode, _u8g2_first_char);
 }
@@ -2660,7 +4596,55 @@ void Arduino_GFX::charBounds(char c, int16_t *x, int16_t *y,
                              int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy)
 {
 #if !defined(ATTINY_CORE)
-  if (gfxFont) // custom font
+#if !defined(LITTLE_FOOT_PRINT)
+  if (gfxAlphaFont) // anti-aliased font
+  {
+    if (c == '\n') // Newline
+    {
+      *x = _min_text_x; // Reset x to zero, advance y by one line
+      *y += (int16_t)textsize_y * gfxAlphaFont->yAdvance;
+    }
+    else if (c != '\r') // Not a carriage return; is normal char
+    {
+      uint8_t uc = c;
+      if ((uc >= gfxAlphaFont->first) && (uc <= gfxAlphaFont->last)) // Char present in this font?
+      {
+        GFXglyph *glyph = gfxAlphaFont->glyph + (uc - gfxAlphaFont->first);
+        if (wrap && ((*x + ((glyph->xOffset + glyph->width) * textsize_x) - 1) > _max_text_x))
+        {
+          *x = _min_text_x; // Reset x to zero, advance y by one line
+          *y += (int16_t)textsize_y * gfxAlphaFont->yAdvance;
+        }
+        int16_t x1 = *x + ((int16_t)glyph->xOffset * textsize_x),
+                y1 = *y + ((int16_t)glyph->yOffset * textsize_y),
+                x2 = x1 + ((int16_t)glyph->width * textsize_x) - 1,
+                y2 = y1 + ((int16_t)glyph->height * textsize_y) - 1;
+        if (glyph->width > 0)
+        {
+          if (x1 < *minx)
+          {
+            *minx = x1;
+          }
+          if (y1 < *miny)
+          {
+            *miny = y1;
+          }
+          if (x2 > *maxx)
+          {
+            *maxx = x2;
+          }
+          if (y2 > *maxy)
+          {
+            *maxy = y2;
+          }
+        }
+        *x += glyph->xAdvance * textsize_x;
+      }
+    }
+  }
+  else
+#endif // !defined(LITTLE_FOOT_PRINT)
+      if (gfxFont) // custom font
   {
     if (c == '\n') // Newline
     {
@@ -2714,6 +4698,9 @@ void Arduino_GFX::charBounds(char c, int16_t *x, int16_t *y,
       if (u8g2Font)
   {
     _u8g2_decode_ptr = 0;
+#if !defined(LITTLE_FOOT_PRINT)
+    _u8g2_cached_glyph = nullptr;
+#endif // !defined(LITTLE_FOOT_PRINT)
 
     if (_enableUTF8Print)
     {
@@ -2769,64 +4756,7 @@ void Arduino_GFX::charBounds(char c, int16_t *x, int16_t *y,
       }
       else if (_encoding != '\r')
       { // Ignore carriage returns
-        uint8_t *font = u8g2Font;
-        const uint8_t *glyph_data = 0;
-
-        // extract from u8g2_font_get_glyph_data()
-        font += 23; // U8G2_FONT_DATA_STRUCT_SIZE
-        if (_encoding <= 255)
-        {
-          if (_encoding >= 'a')
-          {
-            font += _u8g2_start_pos_lower_a;
-          }
-          else if (_encoding >= 'A')
-          {
-            font += _u8g2_start_pos_upper_A;
-          }
-
-          for (;;)
-          {
-            if (pgm_read_byte(font + 1) == 0)
-              break;
-            if (pgm_read_byte(font) == _encoding)
-            {
-              glyph_data = font + 2; /* skip encoding and glyph size */
-            }
-            font += pgm_read_byte(font + 1);
-          }
-        }
-#ifdef U8G2_WITH_UNICODE
-        else
-        {
-          uint16_t e;
-          font += _u8g2_start_pos_unicode;
-          const uint8_t *unicode_lookup_table = font;
-
-          /* issue 596: search for the glyph start in the unicode lookup table */
-          do
-          {
-            font += u8g2_font_get_word(unicode_lookup_table, 0);
-            e = u8g2_font_get_word(unicode_lookup_table, 2);
-            unicode_lookup_table += 4;
-          } while (e < _encoding);
-
-          for (;;)
-          {
-            e = u8g2_font_get_word(font, 0);
-
-            if (e == 0)
-              break;
-
-            if (e == _encoding)
-            {
-              glyph_data = font + 3; /* skip encoding and glyph size */
-              break;
-            }
-            font += pgm_read_byte(font + 2);
-          }
-        }
-#endif
+        const uint8_t *glyph_data = u8g2_font_get_glyph_data(_encoding);
 
         if (glyph_data)
         {
@@ -3014,6 +4944,388 @@ void Arduino_GFX::getTextBounds(const __FlashStringHelper *str,
   }
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
+/**************************************************************************/
+/*!
+  @brief  Draw a single line of text with the current font and text size.
+    Opaque runs are rasterized into a strip buffer and sent as one bitmap
+    per strip instead of one address window per character. The whole text
+    bounding box is filled with bg. Cursor and text colors are not changed.
+    The strip buffer is allocated on first use and kept until destruction.
+  @param  x      Cursor X of the first character, same as setCursor()
+  @param  y      Cursor Y of the first character, same as setCursor()
+  @param  str    The string to draw, no wrapping is applied
+  @param  color  16-bit 5-6-5 Color to draw text with
+  @param  bg     16-bit 5-6-5 Color to draw background with, same as color for transparent text
+*/
+/**************************************************************************/
+void Arduino_GFX::drawTextRun(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg)
+{
+  int16_t saved_cursor_x = cursor_x;
+  int16_t saved_cursor_y = cursor_y;
+  uint16_t saved_textcolor = textcolor;
+  uint16_t saved_textbgcolor = textbgcolor;
+  bool saved_wrap = wrap;
+  wrap = false;
+  textcolor = color;
+  textbgcolor = bg;
+
+  bool drawn = false;
+  if (bg != color)
+  {
+    int16_t x1, y1, x2, y2;
+    bool measured = true;
+#if defined(U8G2_FONT_SUPPORT)
+    if (u8g2Font)
+    {
+      // start with the font bounding box, the glyph boxes are collected while rasterizing the
+      // first strip, so glyphs are not looked up once more by getTextBounds()
+      int8_t bbx_x = pgm_read_byte(u8g2Font + 11);
+      int8_t bbx_y = pgm_read_byte(u8g2Font + 12);
+      x1 = x + (bbx_x * textsize_x);
+      x2 = _max_text_x;
+      y1 = y - ((_u8g2_max_char_height + bbx_y) * textsize_y);
+      y2 = y - (bbx_y * textsize_y) - 1;
+      measured = false;
+    }
+    else
+#endif // defined(U8G2_FONT_SUPPORT)
+    {
+      uint16_t w, h;
+      getTextBounds(str, x, y, &x1, &y1, &w, &h);
+      x2 = (w && h) ? (x1 + w - 1) : (x1 - 1);
+      y2 = y1 + h - 1;
+    }
+    if (x1 < _min_text_x)
+    {
+      x1 = _min_text_x;
+    }
+    if (y1 < _min_text_y)
+    {
+      y1 = _min_text_y;
+    }
+    if (x2 > _max_text_x)
+    {
+      x2 = _max_text_x;
+    }
+    if (y2 > _max_text_y)
+    {
+      y2 = _max_text_y;
+    }
+    if ((x1 > x2) || (y1 > y2))
+    {
+      drawn = true; // nothing visible
+    }
+    else if ((y2 - y1 + 1) <= TEXT_RUN_BUF_PIXELS)
+    {
+      if (!_text_run_buf)
+      {
+        _text_run_buf = (uint16_t *)malloc(TEXT_RUN_BUF_PIXELS * 2);
+      }
+      if (_text_run_buf)
+      {
+        // strips are vertical slices of the text box, usually the whole box fits in one
+        int16_t strip_w = TEXT_RUN_BUF_PIXELS / (y2 - y1 + 1);
+        for (int16_t sx = x1, sw; sx <= x2; sx += sw)
+        {
+          sw = ((x2 - sx + 1) < strip_w) ? (x2 - sx + 1) : strip_w;
+          _text_run_x = sx;
+          _text_run_y = y1;
+          _text_run_w = sw;
+          _text_run_h = y2 - y1 + 1;
+          _text_run_min_x = _text_run_min_y = INT16_MAX;
+          _text_run_max_x = _text_run_max_y = INT16_MIN;
+          gfx_fill_16bit(_text_run_buf, bg, (uint32_t)sw * _text_run_h);
+          setCursor(x, y);
+          print(str);
+          _text_run_h = 0; // back to drawing, for the strip itself
+
+          if (!measured)
+          {
+            // shrink the text box to the glyph boxes, same as getTextBounds()
+            measured = true;
+            if (_text_run_min_x > x1)
+            {
+              x1 = _text_run_min_x;
+            }
+            if (_text_run_min_y > y1)
+            {
+              y1 = _text_run_min_y;
+            }
+            if (_text_run_max_x < x2)
+            {
+              x2 = _text_run_max_x;
+            }
+            if (_text_run_max_y < y2)
+            {
+              y2 = _text_run_max_y;
+            }
+            if ((x1 > x2) || (y1 > y2))
+            {
+              break;
+            }
+          }
+
+          // send the part of the strip inside the text box, rows packed if narrower than the strip
+          int16_t cx = (sx > x1) ? sx : x1;
+          int16_t cw = (((sx + sw - 1) < x2) ? (sx + sw - 1) : x2) - cx + 1;
+          int16_t ch = y2 - y1 + 1;
+          if (cw > 0)
+          {
+            uint16_t *p = _text_run_buf + ((int32_t)(y1 - _text_run_y) * sw) + (cx - sx);
+            if (cw < sw)
+            {
+              for (int16_t j = 0; j < ch; ++j)
+              {
+                memmove(_text_run_buf + ((int32_t)j * cw), p + ((int32_t)j * sw), cw * 2);
+              }
+              p = _text_run_buf;
+            }
+            draw16bitRGBBitmap(cx, y1, p, cw, ch);
+          }
+        }
+        drawn = true;
+      }
+    }
+  }
+
+  if (!drawn)
+  {
+    // transparent text or out of memory, draw char by char
+    setCursor(x, y);
+    print(str);
+  }
+
+  cursor_x = saved_cursor_x;
+  cursor_y = saved_cursor_y;
+  textcolor = saved_textcolor;
+  textbgcolor = saved_textbgcolor;
+  wrap = saved_wrap;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw a single line of text, see drawTextRun(int16_t, int16_t, const char *, uint16_t, uint16_t)
+  @param  x      Cursor X of the first character
+  @param  y      Cursor Y of the first character
+  @param  str    The string to draw (as an arduino String() class)
+  @param  color  16-bit 5-6-5 Color to draw text with
+  @param  bg     16-bit 5-6-5 Color to draw background with
+*/
+/**************************************************************************/
+void Arduino_GFX::drawTextRun(int16_t x, int16_t y, const String &str, uint16_t color, uint16_t bg)
+{
+  drawTextRun(x, y, str.c_str(), color, bg);
+}
+
+// rasterize the foreground of a character into the drawTextRun() strip, the strip is already filled with bg
+void Arduino_GFX::textRunChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg)
+{
+  // text pixel size, margin is always 0 for unscaled text
+  int16_t pw = textsize_x - text_pixel_margin;
+  int16_t ph = textsize_y - text_pixel_margin;
+
+  if (gfxAlphaFont) // anti-aliased font
+  {
+    GFXglyph *glyph = gfxAlphaFont->glyph + (c - gfxAlphaFont->first);
+    const uint8_t *bitmap = gfxAlphaFont->bitmap + glyph->bitmapOffset;
+    uint8_t w = glyph->width,
+            h = glyph->height,
+            bpp = gfxAlphaFont->bpp;
+    int16_t curX = x + (glyph->xOffset * textsize_x);
+    int16_t curY = y + (glyph->yOffset * textsize_y);
+    if ((textsize_x == 1) && (textsize_y == 1))
+    {
+      gfx_draw_alpha_bitmap_to_framebuffer(bitmap, bpp, w, h, color, bg,
+                                           _text_run_buf, curX - _text_run_x, curY - _text_run_y, _text_run_w, _text_run_h, 0);
+    }
+    else
+    {
+      uint16_t lut[33];
+      gfx_alpha_lut_16bit(lut, color, bg, bpp);
+      uint16_t stride = ((uint16_t)w * bpp + 7) / 8;
+      for (uint8_t j = 0; j < h; ++j, curY += textsize_y, bitmap += stride)
+      {
+        for (uint8_t i = 0; i < w; ++i)
+        {
+          uint8_t a = (bpp == 4) ? ((i & 1) ? (bitmap[i >> 1] & 0x0F) : (bitmap[i >> 1] >> 4)) : bitmap[i];
+          textRunFill(curX + (i * textsize_x), curY, textsize_x, textsize_y, lut[(bpp == 4) ? a : ((a + 4) >> 3)]);
+        }
+      }
+    }
+  }
+  else if (gfxFont) // custom font
+  {
+    c -= pgm_read_byte(&gfxFont->first);
+    GFXglyph *glyph = pgm_read_glyph_ptr(gfxFont, c);
+    const uint8_t *bitmap = pgm_read_bitmap_ptr(gfxFont) + pgm_read_word(&glyph->bitmapOffset);
+    uint8_t w = pgm_read_byte(&glyph->width),
+            h = pgm_read_byte(&glyph->height);
+    int16_t curX = x + (pgm_read_sbyte(&glyph->xOffset) * textsize_x);
+    int16_t curY = y + (pgm_read_sbyte(&glyph->yOffset) * textsize_y);
+    uint8_t bits = 0, bit = 0;
+    for (uint8_t yy = 0; yy < h; ++yy, curY += textsize_y)
+    {
+      for (uint8_t xx = 0; xx < w; ++xx, bits <<= 1)
+      {
+        if (!(bit++ & 7))
+        {
+          bits = pgm_read_byte(bitmap++);
+        }
+        if (bits & 0x80)
+        {
+          textRunFill(curX + (xx * textsize_x), curY, pw, ph, color);
+        }
+      }
+    }
+  }
+  else
+#if defined(U8G2_FONT_SUPPORT)
+      if (u8g2Font)
+  {
+    uint8_t w = _u8g2_char_width;
+    uint8_t h = _u8g2_char_height;
+    int16_t curX = x + (_u8g2_char_x * textsize_x);
+    int16_t curY = y - ((h + _u8g2_char_y) * textsize_y);
+    int16_t x2 = curX + (w * textsize_x) - 1;
+    int16_t y2 = curY + (h * textsize_y) - 1;
+    if (curX < _text_run_min_x)
+    {
+      _text_run_min_x = curX;
+    }
+    if (curY < _text_run_min_y)
+    {
+      _text_run_min_y = curY;
+    }
+    if (x2 > _text_run_max_x)
+    {
+      _text_run_max_x = x2;
+    }
+    if (y2 > _text_run_max_y)
+    {
+      _text_run_max_y = y2;
+    }
+    if ((x2 < _text_run_x) || (curX >= (_text_run_x + _text_run_w)))
+    {
+      return; // outside this strip, no need to decode
+    }
+
+    if (_u8g2_cached_glyph)
+    {
+      const uint8_t *row = _u8g2_cached_glyph->bitmap;
+      for (uint8_t ly = 0; ly < h; ++ly, row += _u8g2_cached_glyph->stride)
+      {
+        for (uint8_t lx = 0; lx < w; ++lx)
+        {
+          if (row[lx >> 3] & (0x80 >> (lx & 7)))
+          {
+            uint8_t len = 1;
+            while (((lx + len) < w) && (row[(lx + len) >> 3] & (0x80 >> ((lx + len) & 7))))
+            {
+              ++len;
+            }
+            textRunFill(curX + (lx * textsize_x), curY + (ly * textsize_y), (len * textsize_x) - text_pixel_margin, ph, color);
+            lx += len;
+          }
+        }
+      }
+    }
+    else if ((_u8g2_decode_ptr) && (w > 0))
+    {
+      // same run length decoding as u8g2_font_decode_glyph_bitmap()
+      uint8_t lx = 0, ly = 0;
+      uint8_t a, b, len, current;
+      for (;;)
+      {
+        a = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_0);
+        b = u8g2_font_decode_get_unsigned_bits(_u8g2_bits_per_1);
+        do
+        {
+          // skip background run
+          len = a;
+          while (len >= (w - lx))
+          {
+            len -= w - lx;
+            lx = 0;
+            ly++;
+          }
+          lx += len;
+
+          // fill foreground run, row by row
+          len = b;
+          while (len)
+          {
+            current = w - lx;
+            if (len < current)
+            {
+              current = len;
+            }
+            if (ly < h)
+            {
+              textRunFill(curX + (lx * textsize_x), curY + (ly * textsize_y), (current * textsize_x) - text_pixel_margin, ph, color);
+            }
+            len -= current;
+            lx += current;
+            if (lx >= w)
+            {
+              lx = 0;
+              ly++;
+            }
+          }
+        } while (u8g2_font_decode_get_unsigned_bits(1) != 0);
+
+        if (ly >= h)
+          break;
+      }
+    }
+  }
+  else // glcdfont
+#endif // defined(U8G2_FONT_SUPPORT)
+  {
+    for (int8_t i = 0; i < 5; ++i) // Char bitmap = 5 columns
+    {
+      uint8_t line = pgm_read_byte(&font[c * 5 + i]);
+      for (int8_t j = 0; j < 8; ++j, line >>= 1)
+      {
+        if (line & 1)
+        {
+          textRunFill(x + (i * textsize_x), y + (j * textsize_y), pw, ph, color);
+        }
+      }
+    }
+  }
+}
+
+// fill a rectangle of the drawTextRun() strip, in screen coordinates and clipped to the strip
+void Arduino_GFX::textRunFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  x -= _text_run_x;
+  y -= _text_run_y;
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if ((x + w) > _text_run_w)
+  {
+    w = _text_run_w - x;
+  }
+  if ((y + h) > _text_run_h)
+  {
+    h = _text_run_h - y;
+  }
+  if ((w > 0) && (h > 0))
+  {
+    gfx_fill_rect_16bit(_text_run_buf + ((int32_t)y * _text_run_w) + x, _text_run_w, w, h, color);
+  }
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 /**************************************************************************/
 /*!
   @brief  Invert the display (ideally using built-in hardware command)
@@ -12,11 +12,24 @@
 #if !defined(ATTINY_CORE)
 #include "gfxfont.h"
 #endif // !defined(ATTINY_CORE)
+#include "Arduino_GlyphCache.h"
+#include "Arduino_FrameSync.h"
 
 #ifndef DEGTORAD
 #define DEGTORAD 0.017453292519943295769236907684886F
 #endif
 
+#ifndef TEXT_RUN_BUF_PIXELS
+#define TEXT_RUN_BUF_PIXELS 4096 // drawTextRun() strip buffer size, longer runs are sent in several strips
+#endif
+
+#ifndef ALPHA_BITMAP_BUF_PIXELS
+#define ALPHA_BITMAP_BUF_PIXELS 256 // drawAlphaBitmap() blended pixels buffer on stack
+#endif
+#ifndef AFFINE_BITMAP_BUF_PIXELS
+#define AFFINE_BITMAP_BUF_PIXELS 256 // scaled and rotated bitmap row buffer on stack
+#endif
+
 #if __has_include(<U8g2lib.h>)
 #include <U8g2lib.h>
 #define U8G2_FONT_SUPPORT
@@ -27,6 +40,10 @@
 #include "font/u8g2_font_unifont_t_chinese.h"
 #include "font/u8g2_font_unifont_t_chinese4.h"
 #include "font/u8g2_font_unifont_t_cjk.h"
+
+#ifndef U8G2_UNICODE_INDEX_STEP
+#define U8G2_UNICODE_INDEX_STEP 16 // index every 16th unicode glyph, at most 16 glyphs are scanned per lookup
+#endif
 #endif
 
 #define RGB565(r, g, b) ((((r) & 0xF8) << 8) | (((g) & 0xFC) << 3) | ((b) >> 3))
@@ -137,6 +154,12 @@
 #define _in_range(v, a, b) ((a > b) ? _ordered_in_range(v, b, a) : _ordered_in_range(v, a, b))
 #endif
 
+typedef enum
+{
+  GFX_FILL_NONZERO,  // inside where the edges wind around a pixel at least once
+  GFX_FILL_EVEN_ODD, // inside where a pixel is crossed by an odd number of edges
+} gfx_fill_rule_t;
+
 #if !defined(ATTINY_CORE)
 GFX_INLINE static GFXglyph *pgm_read_glyph_ptr(const GFXfont *gfxFont, uint8_t c)
 {
@@ -172,6 +195,7 @@ class Arduino_GFX : public Print, public Arduino_G
 {
 public:
   Arduino_GFX(int16_t w, int16_t h); // Constructor
+  virtual ~Arduino_GFX();
 
   // This MUST be defined by the subclass:
   virtual bool begin(int32_t speed = GFX_NOT_DEFINED) = 0;
@@ -226,19 +250,39 @@ public:
   void getTextBounds(const char *string, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
   void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
+#if !defined(LITTLE_FOOT_PRINT)
+  void drawTextRun(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg);
+  void drawTextRun(int16_t x, int16_t y, const String &str, uint16_t color, uint16_t bg);
+#endif // !defined(LITTLE_FOOT_PRINT)
   void setTextSize(uint8_t s);
   void setTextSize(uint8_t sx, uint8_t sy);
   void setTextSize(uint8_t sx, uint8_t sy, uint8_t pixel_margin);
 
 #if !defined(ATTINY_CORE)
   void setFont(const GFXfont *f = NULL);
+#if !defined(LITTLE_FOOT_PRINT)
+  void setFont(const GFXalphaFont *f);
+  GFXalphaFont *createAlphaFont(uint16_t first, uint16_t last, uint8_t scale, uint8_t bpp = 4);
+#endif // !defined(LITTLE_FOOT_PRINT)
 #if defined(U8G2_FONT_SUPPORT)
   void setFont(const uint8_t *font);
   void setUTF8Print(bool isEnable);
   uint16_t u8g2_font_get_word(const uint8_t *font, uint8_t offset);
+  const uint8_t *u8g2_font_get_glyph_data(uint16_t encoding);
   uint8_t u8g2_font_decode_get_unsigned_bits(uint8_t cnt);
   int8_t u8g2_font_decode_get_signed_bits(uint8_t cnt);
   void u8g2_font_decode_len(uint8_t len, uint8_t is_foreground, uint16_t color, uint16_t bg);
+  void u8g2_font_draw_run(uint8_t lx, uint8_t ly, uint8_t len, uint16_t color);
+#if !defined(LITTLE_FOOT_PRINT)
+  bool setGlyphCacheSize(uint32_t size);
+  Arduino_GlyphCache *getGlyphCache();
+  void u8g2_font_decode_glyph_bitmap(gfx_cached_glyph_t *glyph);
+  void u8g2_font_draw_cached_glyph(uint16_t color, uint16_t bg);
+#ifdef U8G2_WITH_UNICODE
+  void u8g2_font_build_unicode_index();
+  void u8g2_font_free_unicode_index();
+#endif // U8G2_WITH_UNICODE
+#endif // !defined(LITTLE_FOOT_PRINT)
 #endif // defined(U8G2_FONT_SUPPORT)
   virtual void flush(bool force_flush = false);
 #endif // !defined(ATTINY_CORE)
@@ -250,7 +294,23 @@ public:
   void writeFillEllipseHelper(int32_t x, int32_t y, int32_t rx, int32_t ry, uint8_t cornername, int16_t delta, uint16_t color);
   void drawArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color);
   void fillArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float end, uint16_t color);
+  void updateArc(int16_t x, int16_t y, int16_t r1, int16_t r2, float start, float old_end, float new_end, uint16_t color, uint16_t bg);
   void writeFillArcHelper(int16_t cx, int16_t cy, int16_t oradius, int16_t iradius, float start, float end, uint16_t color);
+  void writeFillArcSpanHelper(int16_t cx, int16_t cy, int16_t oradius, int16_t iradius, float start, float end, uint16_t color);
+#if !defined(LITTLE_FOOT_PRINT)
+  void fillPolygon(const int16_t *points, uint16_t n, uint16_t color, gfx_fill_rule_t rule = GFX_FILL_NONZERO);
+  void fillPolygonAA(const int16_t *points, uint16_t n, uint16_t color, uint16_t bg, gfx_fill_rule_t rule = GFX_FILL_NONZERO);
+  void fillPath(const int16_t *points, const uint16_t *contour_ends, uint16_t contours, uint16_t color, gfx_fill_rule_t rule = GFX_FILL_NONZERO);
+  void fillPathAA(const int16_t *points, const uint16_t *contour_ends, uint16_t contours, uint16_t color, uint16_t bg, gfx_fill_rule_t rule = GFX_FILL_NONZERO);
+  bool writeFillPathHelper(const int16_t *points, const uint16_t *contour_ends, uint16_t contours, uint16_t color, uint16_t bg, gfx_fill_rule_t rule, bool antialias);
+  void draw16bitRGBBitmapScaled(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h, int16_t dst_w, int16_t dst_h, bool bilinear = false);
+  void draw16bitRGBBitmapRotated(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h, float angle, float scale = 1.0, bool bilinear = false);
+  int16_t getScrollOffset();
+  bool waitForVSync(uint32_t timeout_ms = FRAME_SYNC_TIMEOUT_MS);
+  void presentOnVSync(bool force_flush = false);
+  void presentOnVSync(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
+  const frame_sync_stats_t *getFrameStats();
+#endif // !defined(LITTLE_FOOT_PRINT)
 
 // TFT optimization code, too big for ATMEL family
 #if defined(LITTLE_FOOT_PRINT)
@@ -287,6 +347,14 @@ public:
   virtual void draw24bitRGBBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h);
   virtual void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h);
   virtual void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg);
+  virtual void drawAlphaBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg);
+  virtual void writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg);
+  virtual void draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h);
+  virtual void draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h);
+  virtual void drawAffineBitmap(const gfx_affine_t *affine);
+  virtual bool setScrollArea(int16_t y, int16_t h);
+  virtual void scrollTo(int16_t offset);
+  virtual int16_t getScrollDrawY(int16_t y);
 
   virtual void draw16bitBeRGBBitmapR1(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
 #endif // !defined(LITTLE_FOOT_PRINT)
@@ -411,6 +479,14 @@ public:
 
 protected:
   void charBounds(char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy);
+#if !defined(ATTINY_CORE) && !defined(LITTLE_FOOT_PRINT)
+  bool decodeMonoGlyph(uint16_t encoding, GFXglyph *metrics, gfx_cached_glyph_t *scratch);
+#endif // !defined(ATTINY_CORE) && !defined(LITTLE_FOOT_PRINT)
+  void drawCursorChar(unsigned char c);
+#if !defined(LITTLE_FOOT_PRINT)
+  void textRunChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg);
+  void textRunFill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+#endif // !defined(LITTLE_FOOT_PRINT)
   int16_t
       _width,  ///< Display width as modified by current rotation
       _height, ///< Display height as modified by current rotation
@@ -434,7 +510,10 @@ protected:
       wrap; ///< If set, 'wrap' text at right edge of display
 #if !defined(ATTINY_CORE)
   GFXfont *gfxFont; ///< Pointer to special font
-#endif              // !defined(ATTINY_CORE)
+#if !defined(LITTLE_FOOT_PRINT)
+  GFXalphaFont *gfxAlphaFont = NULL; ///< Pointer to anti-aliased font
+#endif // !defined(LITTLE_FOOT_PRINT)
+#endif // !defined(ATTINY_CORE)
 
 #if defined(U8G2_FONT_SUPPORT)
   uint8_t *u8g2Font;
@@ -470,8 +549,38 @@ protected:
 
   const uint8_t *_u8g2_decode_ptr;
   uint8_t _u8g2_decode_bit_pos;
+
+#if !defined(LITTLE_FOOT_PRINT)
+  Arduino_GlyphCache *_glyph_cache = nullptr;
+  gfx_cached_glyph_t *_u8g2_cached_glyph = nullptr; // current glyph if rendering from cache
+#ifdef U8G2_WITH_UNICODE
+  // sparse unicode glyph index, encoding and font offset of every U8G2_UNICODE_INDEX_STEP glyph
+  const uint8_t *_u8g2_unicode_index_font = nullptr;
+  uint16_t *_u8g2_unicode_index_encoding = nullptr;
+  uint32_t *_u8g2_unicode_index_offset = nullptr;
+  uint16_t _u8g2_unicode_index_cnt = 0;
+#endif // U8G2_WITH_UNICODE
+#endif // !defined(LITTLE_FOOT_PRINT)
 #endif // defined(U8G2_FONT_SUPPORT)
 
+#if !defined(LITTLE_FOOT_PRINT)
+  bool initScrollArea(int16_t y, int16_t h);
+  int16_t scrollDelta(int16_t offset);
+
+  // vertical scroll area in rotated rows, _scroll_h is 0 if not set
+  int16_t _scroll_y = 0;
+  int16_t _scroll_h = 0;
+  int16_t _scroll_offset = 0;
+
+  // drawTextRun() strip, print() rasterizes glyphs into it instead of drawing while _text_run_h is not 0
+  uint16_t *_text_run_buf = nullptr; // TEXT_RUN_BUF_PIXELS, allocated on first use
+  int16_t _text_run_x = 0;
+  int16_t _text_run_y = 0;
+  int16_t _text_run_w = 0;
+  int16_t _text_run_h = 0;
+  int16_t _text_run_min_x, _text_run_min_y, _text_run_max_x, _text_run_max_y; // U8g2 glyph boxes of the run
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 #if defined(LITTLE_FOOT_PRINT)
   int16_t
       WIDTH,  ///< This is the 'raw' display width - never changes
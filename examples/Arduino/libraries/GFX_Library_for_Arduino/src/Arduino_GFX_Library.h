@@ -32,6 +32,8 @@
 #include "databus/Arduino_RPiPicoPAR16.h"
 #include "databus/Arduino_RPiPicoSPI.h"
 #include "databus/Arduino_RTLPAR8.h"
+#include "databus/Arduino_RecordBus.h"
+#include "databus/Arduino_SharedBus.h"
 #include "databus/Arduino_STM32PAR8.h"
 #include "databus/Arduino_SWPAR8.h"
 #include "databus/Arduino_SWPAR16.h"
@@ -42,10 +44,16 @@
 
 #include "Arduino_GFX.h" // Core graphics library
 #if !defined(LITTLE_FOOT_PRINT)
+#include "Arduino_Accel.h"
+#include "Arduino_ESP32PPA.h"
+#include "Arduino_FrameSync.h"
 #include "canvas/Arduino_Canvas.h"
 #include "canvas/Arduino_Canvas_Indexed.h"
 #include "canvas/Arduino_Canvas_3bit.h"
 #include "canvas/Arduino_Canvas_Mono.h"
+#include "canvas/Arduino_Canvas_DisplayList.h"
+#include "canvas/Arduino_Compositor.h"
+#include "canvas/Arduino_SpriteEngine.h"
 #include "display/Arduino_ILI9488_3bit.h"
 #endif // !defined(LITTLE_FOOT_PRINT)
 
@@ -0,0 +1,248 @@
+#include "Arduino_GlyphCache.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+/**
+ * @brief Arduino_GlyphCache
+ *
+ * @param budget memory budget in bytes, glyph bitmaps, their headers and the pixel buffer all count
+ */
+Arduino_GlyphCache::Arduino_GlyphCache(uint32_t budget)
+    : _budget(budget)
+{
+  memset(_buckets, 0, sizeof(_buckets));
+}
+
+Arduino_GlyphCache::~Arduino_GlyphCache()
+{
+  clear();
+  if (_pixel_buf)
+  {
+    free(_pixel_buf);
+    _pixel_buf = nullptr;
+  }
+}
+
+/**
+ * @brief get
+ *
+ * @return cached glyph and mark it as most recently used, nullptr if not cached
+ */
+gfx_cached_glyph_t *Arduino_GlyphCache::get(const void *font, uint32_t encoding)
+{
+  gfx_cached_glyph_t *glyph = _buckets[hash(font, encoding)];
+  while (glyph)
+  {
+    if ((glyph->encoding == encoding) && (glyph->font == font))
+    {
+      if (glyph != _lru_head)
+      {
+        // move to LRU head
+        glyph->lru_prev->lru_next = glyph->lru_next;
+        if (glyph->lru_next)
+        {
+          glyph->lru_next->lru_prev = glyph->lru_prev;
+        }
+        else
+        {
+          _lru_tail = glyph->lru_prev;
+        }
+        glyph->lru_prev = nullptr;
+        glyph->lru_next = _lru_head;
+        _lru_head->lru_prev = glyph;
+        _lru_head = glyph;
+      }
+      ++_hits;
+      return glyph;
+    }
+    glyph = glyph->hash_next;
+  }
+  ++_misses;
+  return nullptr;
+}
+
+/**
+ * @brief add
+ *
+ * Allocate a cleared glyph bitmap, least recently used glyphs are evicted to fit the budget.
+ * The caller fills the bitmap and metrics.
+ *
+ * @return new glyph, nullptr if it can never fit the budget or allocation failed
+ */
+gfx_cached_glyph_t *Arduino_GlyphCache::add(const void *font, uint32_t encoding, uint8_t width, uint8_t height, uint8_t bpp)
+{
+  uint16_t stride = ((uint16_t)width * bpp + 7) / 8;
+  uint32_t size = sizeof(gfx_cached_glyph_t) - 1 + ((uint32_t)stride * height);
+  if (size > _budget)
+  {
+    return nullptr;
+  }
+  evict(size);
+
+  gfx_cached_glyph_t *glyph = (gfx_cached_glyph_t *)malloc(size);
+  if (!glyph)
+  {
+    return nullptr;
+  }
+  memset(glyph, 0, size);
+  glyph->font = font;
+  glyph->encoding = encoding;
+  glyph->width = width;
+  glyph->height = height;
+  glyph->bpp = bpp;
+  glyph->stride = stride;
+
+  uint16_t h = hash(font, encoding);
+  glyph->hash_next = _buckets[h];
+  _buckets[h] = glyph;
+  glyph->lru_next = _lru_head;
+  if (_lru_head)
+  {
+    _lru_head->lru_prev = glyph;
+  }
+  else
+  {
+    _lru_tail = glyph;
+  }
+  _lru_head = glyph;
+
+  _used += size;
+  ++_count;
+  return glyph;
+}
+
+void Arduino_GlyphCache::remove(gfx_cached_glyph_t *glyph)
+{
+  unlink(glyph);
+  free(glyph);
+}
+
+void Arduino_GlyphCache::clear()
+{
+  while (_lru_head)
+  {
+    remove(_lru_head);
+  }
+}
+
+/**
+ * @brief getPixelBuffer
+ *
+ * @return RGB565 scratch buffer of at least pixels size, nullptr if it does not fit the budget
+ */
+uint16_t *Arduino_GlyphCache::getPixelBuffer(uint32_t pixels)
+{
+  if (pixels > _pixel_buf_size)
+  {
+    uint32_t extra = (pixels - _pixel_buf_size) * 2;
+    // never evict the most recently used glyph, it is the one being drawn
+    while ((_lru_tail != _lru_head) && ((_used + extra) > _budget))
+    {
+      remove(_lru_tail);
+      ++_evictions;
+    }
+    if ((_used + extra) > _budget)
+    {
+      return nullptr;
+    }
+    uint16_t *buf = (uint16_t *)realloc(_pixel_buf, pixels * 2);
+    if (!buf)
+    {
+      return nullptr;
+    }
+    _pixel_buf = buf;
+    _pixel_buf_size = pixels;
+    _used += extra;
+  }
+  return _pixel_buf;
+}
+
+void Arduino_GlyphCache::setBudget(uint32_t budget)
+{
+  _budget = budget;
+  evict(0);
+}
+
+uint32_t Arduino_GlyphCache::getBudget()
+{
+  return _budget;
+}
+
+uint32_t Arduino_GlyphCache::getUsed()
+{
+  return _used;
+}
+
+uint32_t Arduino_GlyphCache::getCount()
+{
+  return _count;
+}
+
+uint32_t Arduino_GlyphCache::getHits()
+{
+  return _hits;
+}
+
+uint32_t Arduino_GlyphCache::getMisses()
+{
+  return _misses;
+}
+
+uint32_t Arduino_GlyphCache::getEvictions()
+{
+  return _evictions;
+}
+
+void Arduino_GlyphCache::resetStats()
+{
+  _hits = 0;
+  _misses = 0;
+  _evictions = 0;
+}
+
+uint16_t Arduino_GlyphCache::hash(const void *font, uint32_t encoding)
+{
+  uint32_t h = (encoding ^ ((uint32_t)(uintptr_t)font >> 2)) * 2654435761u; // Knuth multiplicative hash
+  return h >> (32 - GLYPH_CACHE_HASH_BITS);
+}
+
+void Arduino_GlyphCache::unlink(gfx_cached_glyph_t *glyph)
+{
+  gfx_cached_glyph_t **p = &_buckets[hash(glyph->font, glyph->encoding)];
+  while (*p != glyph)
+  {
+    p = &(*p)->hash_next;
+  }
+  *p = glyph->hash_next;
+
+  if (glyph->lru_prev)
+  {
+    glyph->lru_prev->lru_next = glyph->lru_next;
+  }
+  else
+  {
+    _lru_head = glyph->lru_next;
+  }
+  if (glyph->lru_next)
+  {
+    glyph->lru_next->lru_prev = glyph->lru_prev;
+  }
+  else
+  {
+    _lru_tail = glyph->lru_prev;
+  }
+
+  _used -= sizeof(gfx_cached_glyph_t) - 1 + ((uint32_t)glyph->stride * glyph->height);
+  --_count;
+}
+
+void Arduino_GlyphCache::evict(uint32_t needed)
+{
+  while (_lru_tail && ((_used + needed) > _budget))
+  {
+    remove(_lru_tail);
+    ++_evictions;
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
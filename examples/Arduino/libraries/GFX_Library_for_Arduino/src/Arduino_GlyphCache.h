@@ -0,0 +1,77 @@
+#ifndef _ARDUINO_GLYPHCACHE_H_
+#define _ARDUINO_GLYPHCACHE_H_
+
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef GLYPH_CACHE_HASH_BITS
+#define GLYPH_CACHE_HASH_BITS 7 // 128 buckets
+#endif
+#define GLYPH_CACHE_HASH_SIZE (1 << GLYPH_CACHE_HASH_BITS)
+
+typedef struct gfx_cached_glyph_s
+{
+  struct gfx_cached_glyph_s *hash_next;
+  struct gfx_cached_glyph_s *lru_prev;
+  struct gfx_cached_glyph_s *lru_next;
+  const void *font;
+  uint32_t encoding;
+  uint8_t width;
+  uint8_t height;
+  int8_t x_offset;
+  int8_t y_offset;
+  int8_t x_advance;
+  uint8_t bpp;        // 1: mono, MSB first; 4 or 8: alpha
+  uint16_t stride;    // bytes per bitmap row
+  uint8_t bitmap[1];  // stride * height bytes, allocated together with the struct
+} gfx_cached_glyph_t;
+
+/**
+ * LRU cache of decoded glyph bitmaps keyed by (font, encoding), bounded by a memory budget.
+ */
+class Arduino_GlyphCache
+{
+public:
+  Arduino_GlyphCache(uint32_t budget);
+  ~Arduino_GlyphCache();
+
+  gfx_cached_glyph_t *get(const void *font, uint32_t encoding);
+  gfx_cached_glyph_t *add(const void *font, uint32_t encoding, uint8_t width, uint8_t height, uint8_t bpp);
+  void remove(gfx_cached_glyph_t *glyph);
+  void clear();
+  uint16_t *getPixelBuffer(uint32_t pixels);
+
+  void setBudget(uint32_t budget);
+  uint32_t getBudget();
+  uint32_t getUsed();
+  uint32_t getCount();
+  uint32_t getHits();
+  uint32_t getMisses();
+  uint32_t getEvictions();
+  void resetStats();
+
+protected:
+  uint16_t hash(const void *font, uint32_t encoding);
+  void unlink(gfx_cached_glyph_t *glyph);
+  void evict(uint32_t needed);
+
+  gfx_cached_glyph_t *_buckets[GLYPH_CACHE_HASH_SIZE];
+  gfx_cached_glyph_t *_lru_head = nullptr; // most recently used
+  gfx_cached_glyph_t *_lru_tail = nullptr; // least recently used
+  uint32_t _budget;
+  uint32_t _used = 0;
+  uint32_t _count = 0;
+  uint32_t _hits = 0;
+  uint32_t _misses = 0;
+  uint32_t _evictions = 0;
+
+  uint16_t *_pixel_buf = nullptr; // glyph sized RGB565 scratch buffer for single window output
+  uint32_t _pixel_buf_size = 0;
+
+private:
+};
+
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+#endif // _ARDUINO_GLYPHCACHE_H_
@@ -18,6 +18,36 @@ Arduino_TFT::Arduino_TFT(
   _rotation = r;
 }
 
+#if !defined(LITTLE_FOOT_PRINT)
+#if !(defined(ESP32) || defined(ESP8266))
+// attachInterrupt() takes no argument, the last setTEPin() call wins
+static Arduino_FrameSync *te_frame_sync = nullptr;
+static void te_isr()
+{
+  te_frame_sync->notifyVSync();
+}
+#endif
+
+Arduino_TFT::~Arduino_TFT()
+{
+  if (_te != GFX_NOT_DEFINED)
+  {
+    detachInterrupt(digitalPinToInterrupt(_te));
+  }
+#if !(defined(ESP32) || defined(ESP8266))
+  if (te_frame_sync == _frame_sync)
+  {
+    te_frame_sync = nullptr;
+  }
+#endif
+  if (_frame_sync)
+  {
+    delete _frame_sync;
+    _frame_sync = nullptr;
+  }
+}
+#endif // !defined(LITTLE_FOOT_PRINT)
+
 bool Arduino_TFT::begin(int32_t speed)
 {
   if (_override_datamode != GFX_NOT_DEFINED)
@@ -649,6 +679,174 @@ void Arduino_TFT::draw16bitRGBBitmap(
   }
 }
 
+// stream the rows through a small buffer, rows of the same span share one address window
+void Arduino_TFT::drawAffineBitmap(const gfx_affine_t *affine)
+{
+  if (_isRoundMode)
+  {
+    Arduino_GFX::drawAffineBitmap(affine);
+    return;
+  }
+
+  uint16_t buf[AFFINE_BITMAP_BUF_PIXELS];
+  int16_t win_x = 0, win_len = 0, next_y = -1;
+  startWrite();
+  for (int16_t j = affine->y1; j <= affine->y2; ++j)
+  {
+    int16_t i;
+    int16_t len = gfx_affine_span(affine, j, &i);
+    if (!len)
+    {
+      continue;
+    }
+    if ((j != next_y) || (i != win_x) || (len != win_len))
+    {
+      writeAddrWindow(i, j, len, affine->y2 - j + 1);
+      win_x = i;
+      win_len = len;
+    }
+    next_y = j + 1;
+    while (len > 0)
+    {
+      int16_t n = (len > AFFINE_BITMAP_BUF_PIXELS) ? AFFINE_BITMAP_BUF_PIXELS : len;
+      gfx_affine_row_16bit(buf, 1, affine, i, j, n);
+      _bus->writePixels(buf, n);
+      i += n;
+      len -= n;
+    }
+  }
+  endWrite();
+}
+
+/**************************************************************************/
+/*!
+  @brief  Set the rows that scroll in hardware with scrollTo(), see Arduino_GFX::scrollTo()
+  @param  y  Top row of the area
+  @param  h  Number of rows, 0 to end scrolling
+  @return false if the controller cannot scroll, the display is turned by 90 degrees or the area is outside
+*/
+/**************************************************************************/
+bool Arduino_TFT::setScrollArea(int16_t y, int16_t h)
+{
+  // the controller scrolls frame memory rows, the columns of a display turned by 90 degrees
+  if ((_scroll_memory_h == 0) || (_rotation & 1) || (!initScrollArea(y, h)))
+  {
+    return false;
+  }
+
+  uint16_t top = 0;
+  uint16_t rows = _scroll_memory_h;
+  if (h)
+  {
+    top = scrollMemoryTop();
+    rows = h;
+  }
+  _bus->beginWrite();
+  _bus->writeCommand(TFT_VSCRDEF);
+  _bus->write16(top);
+  _bus->write16(rows);
+  _bus->write16(_scroll_memory_h - top - rows);
+  _bus->writeC8D16(TFT_VSCRSADD, top);
+  _bus->endWrite();
+  return true;
+}
+
+// one command, the frame memory keeps every row
+void Arduino_TFT::scrollTo(int16_t offset)
+{
+  if (_scroll_h == 0)
+  {
+    return;
+  }
+  scrollDelta(offset);
+  // flipped displays show the frame memory bottom up, their content moves the other way
+  uint16_t start = ((_rotation & 3) == 2) ? ((_scroll_h - _scroll_offset) % _scroll_h) : _scroll_offset;
+  _bus->beginWrite();
+  _bus->writeC8D16(TFT_VSCRSADD, scrollMemoryTop() + start);
+  _bus->endWrite();
+}
+
+int16_t Arduino_TFT::getScrollDrawY(int16_t y)
+{
+  if ((y < _scroll_y) || (y >= (_scroll_y + _scroll_h)))
+  {
+    return y;
+  }
+  return _scroll_y + ((y - _scroll_y + _scroll_offset) % _scroll_h);
+}
+
+// frame memory row of the scroll area top, rotation 2 and 6 write the frame memory bottom up
+uint16_t Arduino_TFT::scrollMemoryTop()
+{
+  if ((_rotation & 3) == 2)
+  {
+    return _scroll_memory_h - _yStart - _scroll_y - _scroll_h;
+  }
+  return _yStart + _scroll_y;
+}
+
+void FRAME_SYNC_ISR_ATTR Arduino_TFT::teISR(void *arg)
+{
+#if defined(ESP32)
+  if (Arduino_FrameSync::vsyncCallback(arg))
+  {
+    portYIELD_FROM_ISR();
+  }
+#else
+  Arduino_FrameSync::vsyncCallback(arg);
+#endif
+}
+
+/**************************************************************************/
+/*!
+  @brief  Turn on the tearing effect output of the controller and count its pulses for waitForVSync(), call after begin().
+    The controller drives TE high in the vertical blanking, a transfer started at the rising edge
+    follows the scan line and does not tear if it is faster than the refresh.
+  @param  te  GPIO connected to the TE pin, it must support interrupts
+  @return false if the pin is not defined
+*/
+/**************************************************************************/
+bool Arduino_TFT::setTEPin(int8_t te)
+{
+  if (te == GFX_NOT_DEFINED)
+  {
+    return false;
+  }
+  if (!_frame_sync)
+  {
+    _frame_sync = new Arduino_FrameSync();
+    if (!_frame_sync->begin())
+    {
+      delete _frame_sync;
+      _frame_sync = nullptr;
+      return false;
+    }
+  }
+  if (_te != GFX_NOT_DEFINED)
+  {
+    detachInterrupt(digitalPinToInterrupt(_te));
+  }
+  _te = te;
+  pinMode(_te, INPUT);
+
+  _bus->beginWrite();
+  _bus->writeC8D8(TFT_TEON, 0x00); // V-blanking only
+  _bus->endWrite();
+
+#if defined(ESP32) || defined(ESP8266)
+  attachInterruptArg(digitalPinToInterrupt(_te), teISR, _frame_sync, RISING);
+#else
+  te_frame_sync = _frame_sync;
+  attachInterrupt(digitalPinToInterrupt(_te), te_isr, RISING);
+#endif
+  return true;
+}
+
+Arduino_FrameSync *Arduino_TFT::getFrameSync()
+{
+  return _frame_sync;
+}
+
 void Arduino_TFT::draw16bitBeRGBBitmap(
     int16_t x, int16_t y,
     uint16_t *bitmap, int16_t w, int16_t h)
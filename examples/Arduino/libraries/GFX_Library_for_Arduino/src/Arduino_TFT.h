@@ -8,10 +8,20 @@
 #include "Arduino_DataBus.h"
 #include "Arduino_GFX.h"
 
+// MIPI DCS vertical scrolling
+#define TFT_VSCRDEF 0x33  ///< Vertical Scrolling Definition
+#define TFT_VSCRSADD 0x37 ///< Vertical Scrolling Start Address
+
+// MIPI DCS tearing effect output
+#define TFT_TEON 0x35 ///< Tearing Effect Line ON
+
 class Arduino_TFT : public Arduino_GFX
 {
 public:
   Arduino_TFT(Arduino_DataBus *bus, int8_t rst, uint8_t r, bool ips, int16_t w, int16_t h, uint8_t col_offset1, uint8_t row_offset1, uint8_t col_offset2, uint8_t row_offset2);
+#if !defined(LITTLE_FOOT_PRINT)
+  ~Arduino_TFT();
+#endif // !defined(LITTLE_FOOT_PRINT)
 
   // This SHOULD be defined by the subclass:
   void setRotation(uint8_t r) override;
@@ -54,6 +64,12 @@ public:
   void draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) override;
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
   void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void drawAffineBitmap(const gfx_affine_t *affine) override;
+  bool setScrollArea(int16_t y, int16_t h) override;
+  void scrollTo(int16_t offset) override;
+  int16_t getScrollDrawY(int16_t y) override;
+  bool setTEPin(int8_t te);
+  Arduino_FrameSync *getFrameSync() override;
   void draw16bitBeRGBBitmapR1(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
   void draw24bitRGBBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h) override;
   void draw24bitRGBBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w, int16_t h) override;
@@ -72,6 +88,15 @@ protected:
   int16_t _currentX, _currentY;
   uint16_t _currentW, _currentH;
   int8_t _override_datamode = GFX_NOT_DEFINED;
+  // frame memory rows of controllers with vertical scrolling, 0 if the driver does not scroll
+  uint16_t _scroll_memory_h = 0;
+#if !defined(LITTLE_FOOT_PRINT)
+  uint16_t scrollMemoryTop();
+  static void teISR(void *arg);
+
+  int8_t _te = GFX_NOT_DEFINED;
+  Arduino_FrameSync *_frame_sync = nullptr;
+#endif // !defined(LITTLE_FOOT_PRINT)
 
 private:
 };
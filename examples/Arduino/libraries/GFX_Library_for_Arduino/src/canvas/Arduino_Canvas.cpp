@@ -15,10 +15,15 @@ Arduino_Canvas::Arduino_Canvas(
 
 Arduino_Canvas::~Arduino_Canvas()
 {
+  setAsyncFlush(false);
   if (_framebuffer)
   {
     free(_framebuffer);
   }
+  if (_flushBuf)
+  {
+    free(_flushBuf);
+  }
 }
 
 bool Arduino_Canvas::begin(int32_t speed)
@@ -51,29 +56,32 @@ bool Arduino_Canvas::begin(int32_t speed)
 
 void Arduino_Canvas::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
 {
-
-  uint16_t *fb = _framebuffer;
+  int16_t t;
   switch (_rotation)
   {
   case 1:
-    fb += (int32_t)x * _height;
-    fb += _max_y - y;
-    *fb = color;
+    t = x;
+    x = _max_y - y;
+    y = t;
     break;
   case 2:
-    fb += (int32_t)(_max_y - y) * _width;
-    fb += _max_x - x;
-    *fb = color;
+    x = _max_x - x;
+    y = _max_y - y;
     break;
   case 3:
-    fb += (int32_t)(_max_x - x) * _height;
-    fb += y;
-    *fb = color;
+    t = x;
+    x = y;
+    y = _max_x - t;
     break;
-  default: // case 0:
-    fb += (int32_t)y * _width;
-    fb += x;
-    *fb = color;
+  }
+  if (_big_endian)
+  {
+    MSB_16_SET(color, color);
+  }
+  _framebuffer[(int32_t)y * WIDTH + x] = color;
+  if (_dirty_tracking)
+  {
+    addDirtyRect(x, y, 1, 1);
   }
 }
 
@@ -123,6 +131,14 @@ void Arduino_Canvas::writeFastVLineCore(int16_t x, int16_t y,
           h = MAX_Y - y + 1;
         } // Clip bottom
 
+        if (_dirty_tracking)
+        {
+          addDirtyRect(x, y, 1, h);
+        }
+        if (_big_endian)
+        {
+          MSB_16_SET(color, color);
+        }
         uint16_t *fb = _framebuffer + ((int32_t)y * WIDTH) + x;
         while (h--)
         {
@@ -181,11 +197,15 @@ void Arduino_Canvas::writeFastHLineCore(int16_t x, int16_t y,
           w = MAX_X - x + 1;
         } // Clip right
 
-        uint16_t *fb = _framebuffer + ((int32_t)y * WIDTH) + x;
-        while (w--)
+        if (_dirty_tracking)
         {
-          *(fb++) = color;
+          addDirtyRect(x, y, w, 1);
         }
+        if (_big_endian)
+        {
+          MSB_16_SET(color, color);
+        }
+        gfx_fill_16bit(_framebuffer + ((int32_t)y * WIDTH) + x, color, w);
       }
     }
   }
@@ -221,16 +241,17 @@ void Arduino_Canvas::writeFillRectPreclipped(int16_t x, int16_t y,
     }
   }
   // log_i("adjusted writeFillRectPreclipped(x: %d, y: %d, w: %d, h: %d)", x, y, w, h);
-  uint16_t *row = _framebuffer;
-  row += y * WIDTH;
-  row += x;
-  for (int j = 0; j < h; j++)
+  if (_dirty_tracking)
   {
-    for (int i = 0; i < w; i++)
-    {
-      row[i] = color;
-    }
-    row += WIDTH;
+    addDirtyRect(x, y, w, h);
+  }
+  if (_big_endian)
+  {
+    MSB_16_SET(color, color);
+  }
+  if ((!_accel) || (!_accel->fillRect(_framebuffer, WIDTH, HEIGHT, x, y, w, h, color)))
+  {
+    gfx_fill_rect_16bit(_framebuffer + ((int32_t)y * WIDTH) + x, WIDTH, w, h, color);
   }
 }
 
@@ -277,9 +298,15 @@ void Arduino_Canvas::drawIndexedBitmap(
         w += x;
         x = 0;
       }
+      if (_dirty_tracking)
+      {
+        addDirtyRect(x, y, w, h);
+      }
       uint16_t *row = _framebuffer;
       row += y * _width;
       row += x;
+      uint16_t *first_row = row;
+      int16_t rows = h;
       int16_t i;
       int16_t wi;
       while (h--)
@@ -303,6 +330,11 @@ void Arduino_Canvas::drawIndexedBitmap(
         bitmap += x_skip;
         row += _width;
       }
+      if (_big_endian)
+      {
+        // every pixel was overwritten, swap the rect once into wire order
+        gfx_swap_rect_16bit(first_row, _width, w, rows);
+      }
     }
   }
 }
@@ -350,9 +382,20 @@ void Arduino_Canvas::drawIndexedBitmap(
         w += x;
         x = 0;
       }
+      if (_dirty_tracking)
+      {
+        addDirtyRect(x, y, w, h);
+      }
       uint16_t *row = _framebuffer;
       row += y * _width;
       row += x;
+      uint16_t *first_row = row;
+      int16_t rows = h;
+      if (_big_endian)
+      {
+        // keyed pixels are kept, swap to host order and back so they end up unchanged
+        gfx_swap_rect_16bit(first_row, _width, w, rows);
+      }
       int16_t i;
       int16_t wi;
       uint8_t color_key;
@@ -402,6 +445,10 @@ void Arduino_Canvas::drawIndexedBitmap(
         bitmap += x_skip;
         row += _width;
       }
+      if (_big_endian)
+      {
+        gfx_swap_rect_16bit(first_row, _width, w, rows);
+      }
     }
   }
 }
@@ -409,6 +456,14 @@ void Arduino_Canvas::drawIndexedBitmap(
 void Arduino_Canvas::draw16bitRGBBitmap(int16_t x, int16_t y,
                                         uint16_t *bitmap, int16_t w, int16_t h)
 {
+  if (_dirty_tracking)
+  {
+    markDirty(x, y, w, h);
+  }
+  if ((!_big_endian) && (_accel) && (_accel->drawBitmap(bitmap, w, h, _framebuffer, x, y, _width, _height, _rotation)))
+  {
+    return;
+  }
   switch (_rotation)
   {
   case 1:
@@ -423,6 +478,117 @@ void Arduino_Canvas::draw16bitRGBBitmap(int16_t x, int16_t y,
   default: // case 0:
     gfx_draw_bitmap_to_framebuffer(bitmap, w, h, _framebuffer, x, y, _width, _height);
   }
+  if (_big_endian)
+  {
+    // every pixel was overwritten, swap the rect once into wire order
+    swapRect(x, y, w, h);
+  }
+}
+
+// blend with the framebuffer pixels, no need to threshold transparent glyph edges
+void Arduino_Canvas::drawAlphaBitmap(int16_t x, int16_t y,
+                                     const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+  if ((bpp != 4) && (bpp != 8))
+  {
+    return;
+  }
+  if (_dirty_tracking)
+  {
+    markDirty(x, y, w, h);
+  }
+  if (_big_endian)
+  {
+    // blend in host order, untouched pixels are swapped twice and end up unchanged
+    swapRect(x, y, w, h);
+    gfx_draw_alpha_bitmap_to_framebuffer(bitmap, bpp, w, h, color, bg, _framebuffer, x, y, WIDTH, HEIGHT, _rotation);
+    swapRect(x, y, w, h);
+    return;
+  }
+  gfx_draw_alpha_bitmap_to_framebuffer(bitmap, bpp, w, h, color, bg, _framebuffer, x, y, WIDTH, HEIGHT, _rotation);
+}
+
+void Arduino_Canvas::writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg)
+{
+  drawAlphaBitmap(x, y, alpha, 8, w, 1, color, bg);
+}
+
+// sample straight into the framebuffer, plain scales may go to the accelerator
+void Arduino_Canvas::drawAffineBitmap(const gfx_affine_t *affine)
+{
+  int16_t w = affine->x2 - affine->x1 + 1;
+  int16_t h = affine->y2 - affine->y1 + 1;
+  if (_dirty_tracking)
+  {
+    markDirty(affine->x1, affine->y1, w, h);
+  }
+  if (_big_endian)
+  {
+    // sample in host order, untouched pixels of the bounds are swapped twice and end up unchanged
+    swapRect(affine->x1, affine->y1, w, h);
+    gfx_draw_affine_bitmap_to_framebuffer(affine, _framebuffer, 0, 0, WIDTH, HEIGHT, _rotation);
+    swapRect(affine->x1, affine->y1, w, h);
+    return;
+  }
+  if ((affine->scaled_w) && (!affine->bilinear) && (_rotation == 0) && (_accel) &&
+      (_accel->drawScaledBitmap(affine->bitmap, affine->bitmap_w, affine->bitmap_h, _framebuffer,
+                                affine->scaled_x, affine->scaled_y, WIDTH, HEIGHT, affine->scaled_w, affine->scaled_h)))
+  {
+    return;
+  }
+  gfx_draw_affine_bitmap_to_framebuffer(affine, _framebuffer, 0, 0, WIDTH, HEIGHT, _rotation);
+}
+
+// blend with the framebuffer pixels
+void Arduino_Canvas::draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h)
+{
+  if (_dirty_tracking)
+  {
+    markDirty(x, y, w, h);
+  }
+  if (_big_endian)
+  {
+    swapRect(x, y, w, h);
+    gfx_draw_rgb_alpha_bitmap_to_framebuffer(bitmap, alpha, w, h, _framebuffer, x, y, WIDTH, HEIGHT, _rotation);
+    swapRect(x, y, w, h);
+    return;
+  }
+  gfx_draw_rgb_alpha_bitmap_to_framebuffer(bitmap, alpha, w, h, _framebuffer, x, y, WIDTH, HEIGHT, _rotation);
+}
+
+void Arduino_Canvas::draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h)
+{
+  if (_dirty_tracking)
+  {
+    markDirty(x, y, w, h);
+  }
+  if (_big_endian)
+  {
+    swapRect(x, y, w, h);
+    gfx_draw_argb_bitmap_to_framebuffer(bitmap, w, h, _framebuffer, x, y, WIDTH, HEIGHT, _rotation);
+    swapRect(x, y, w, h);
+    return;
+  }
+  gfx_draw_argb_bitmap_to_framebuffer(bitmap, w, h, _framebuffer, x, y, WIDTH, HEIGHT, _rotation);
+}
+
+bool Arduino_Canvas::setScrollArea(int16_t y, int16_t h)
+{
+  return initScrollArea(y, h);
+}
+
+// move the framebuffer rows, the next flush() sends the whole area
+void Arduino_Canvas::scrollTo(int16_t offset)
+{
+  int16_t dy = scrollDelta(offset);
+  if (dy)
+  {
+    if (_dirty_tracking)
+    {
+      markDirty(0, _scroll_y, _width, _scroll_h);
+    }
+    gfx_scroll_framebuffer_16bit(_framebuffer, WIDTH, HEIGHT, _rotation, _scroll_y, _scroll_h, dy);
+  }
 }
 
 void Arduino_Canvas::draw16bitRGBBitmapWithTranColor(
@@ -469,9 +635,20 @@ void Arduino_Canvas::draw16bitRGBBitmapWithTranColor(
         w += x;
         x = 0;
       }
+      if (_dirty_tracking)
+      {
+        addDirtyRect(x, y, w, h);
+      }
       uint16_t *row = _framebuffer;
       row += y * _width;
       row += x;
+      uint16_t *first_row = row;
+      int16_t rows = h;
+      if (_big_endian)
+      {
+        // transparent pixels are kept, swap to host order and back so they end up unchanged
+        gfx_swap_rect_16bit(first_row, _width, w, rows);
+      }
       int16_t i;
       int16_t wi;
       uint16_t p;
@@ -509,6 +686,10 @@ void Arduino_Canvas::draw16bitRGBBitmapWithTranColor(
         bitmap += x_skip;
         row += _width;
       }
+      if (_big_endian)
+      {
+        gfx_swap_rect_16bit(first_row, _width, w, rows);
+      }
     }
   }
 }
@@ -516,7 +697,29 @@ void Arduino_Canvas::draw16bitRGBBitmapWithTranColor(
 void Arduino_Canvas::draw16bitBeRGBBitmap(int16_t x, int16_t y,
                                           uint16_t *bitmap, int16_t w, int16_t h)
 {
-  if (_rotation > 0)
+  if (_big_endian)
+  {
+    // already in wire order, plain copy
+    if (_dirty_tracking)
+    {
+      markDirty(x, y, w, h);
+    }
+    switch (_rotation)
+    {
+    case 1:
+      gfx_draw_bitmap_to_framebuffer_rotate_1(bitmap, w, h, _framebuffer, x, y, _width, _height);
+      break;
+    case 2:
+      gfx_draw_bitmap_to_framebuffer_rotate_2(bitmap, w, h, _framebuffer, x, y, _width, _height);
+      break;
+    case 3:
+      gfx_draw_bitmap_to_framebuffer_rotate_3(bitmap, w, h, _framebuffer, x, y, _width, _height);
+      break;
+    default: // case 0:
+      gfx_draw_bitmap_to_framebuffer(bitmap, w, h, _framebuffer, x, y, _width, _height);
+    }
+  }
+  else if (_rotation > 0)
   {
     Arduino_GFX::draw16bitBeRGBBitmap(x, y, bitmap, w, h);
   }
@@ -556,6 +759,10 @@ void Arduino_Canvas::draw16bitBeRGBBitmap(int16_t x, int16_t y,
         w += x;
         x = 0;
       }
+      if (_dirty_tracking)
+      {
+        addDirtyRect(x, y, w, h);
+      }
       uint16_t *row = _framebuffer;
       row += y * _width;
       row += x;
@@ -578,12 +785,119 @@ void Arduino_Canvas::flush(bool force_flush)
 {
   if (_output)
   {
-    _output->draw16bitRGBBitmap(_output_x, _output_y, _framebuffer, WIDTH, HEIGHT);
+#if defined(ESP32)
+    if (_framebuffer2)
+    {
+      xSemaphoreTake(_flush_done, portMAX_DELAY); // front buffer free again
+
+      _flush_full = force_flush || (!_partial_flush);
+      _flush_count = _dirty_count;
+      memcpy(_flush_rects, _dirty_rects, _dirty_count * sizeof(canvas_dirty_rect_t));
+
+      uint16_t *fb = _framebuffer2;
+      _framebuffer2 = _framebuffer;
+      _framebuffer = fb;
+
+      // new back buffer still holds previous frame, copy forward only what changed in this frame
+      for (uint8_t i = 0; i < _flush_count; ++i)
+      {
+        int32_t offset = ((int32_t)_flush_rects[i].y1 * WIDTH) + _flush_rects[i].x1;
+        gfx_copy_rect_16bit(
+            _framebuffer + offset, WIDTH, _framebuffer2 + offset, WIDTH,
+            _flush_rects[i].x2 - _flush_rects[i].x1 + 1, _flush_rects[i].y2 - _flush_rects[i].y1 + 1);
+      }
+      _dirty_count = 0;
+
+      xTaskNotifyGive(_flush_task);
+      return;
+    }
+#endif
+    flushFrame(_framebuffer, force_flush || (!_partial_flush), _dirty_rects, _dirty_count);
+  }
+  _dirty_count = 0;
+}
+
+void Arduino_Canvas::flushFrame(uint16_t *fb, bool full, canvas_dirty_rect_t *rects, uint8_t count)
+{
+  if (full)
+  {
+    flushBitmap(_output_x, _output_y, fb, WIDTH, HEIGHT);
+  }
+  else
+  {
+    for (uint8_t i = 0; i < count; ++i)
+    {
+      flushRect(fb, rects[i].x1, rects[i].y1, rects[i].x2, rects[i].y2);
+    }
+  }
+}
+
+void Arduino_Canvas::flushRect(uint16_t *fb, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  int16_t w = x2 - x1 + 1;
+  int16_t h = y2 - y1 + 1;
+  uint16_t *src = fb + ((int32_t)y1 * WIDTH) + x1;
+
+  if (w == WIDTH) // full rows are already contiguous
+  {
+    flushBitmap(_output_x, _output_y + y1, src, w, h);
+    return;
+  }
+
+  int16_t rows = CANVAS_FLUSH_BUF_PIXELS / w;
+  if ((rows > 1) && (!_flushBuf))
+  {
+    _flushBuf = (uint16_t *)malloc(CANVAS_FLUSH_BUF_PIXELS * 2);
+  }
+  if ((rows <= 1) || (!_flushBuf))
+  {
+    // no staging buffer, send row by row
+    while (h--)
+    {
+      flushBitmap(_output_x + x1, _output_y + y1++, src, w, 1);
+      src += WIDTH;
+    }
+    return;
+  }
+
+  // pack rows into staging buffer so that each chunk needs only one address window
+  while (h)
+  {
+    int16_t rh = (h < rows) ? h : rows;
+    gfx_copy_rect_16bit(_flushBuf, w, src, WIDTH, w, rh);
+    src += (int32_t)rh * WIDTH;
+    flushBitmap(_output_x + x1, _output_y + y1, _flushBuf, w, rh);
+    y1 += rh;
+    h -= rh;
   }
 }
 
+// wire order framebuffer goes out as a byte stream, e.g. straight to DMA with Arduino_TFT
+void Arduino_Canvas::flushBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h)
+{
+  if (_big_endian)
+  {
+    _output->draw16bitBeRGBBitmap(x, y, bitmap, w, h);
+  }
+  else
+  {
+    _output->draw16bitRGBBitmap(x, y, bitmap, w, h);
+  }
+}
+
+// quarter of a pixel in host order, four of them add up to the average
+static inline uint16_t quad_part(uint16_t p, bool big_endian)
+{
+  if (big_endian)
+  {
+    MSB_16_SET(p, p);
+  }
+  return (p & 0b1110011110011100) >> 2;
+}
+
 void Arduino_Canvas::flushQuad(bool force_flush)
 {
+  waitFlushDone();
   int16_t y = _output_y;
   uint16_t *row1 = _framebuffer;
   uint16_t *row2 = _framebuffer + WIDTH;
@@ -600,10 +914,10 @@ void Arduino_Canvas::flushQuad(bool force_flush)
     {
       for (int16_t i = 0; i < wQuad; ++i)
       {
-        p = (*row1++ & 0b1110011110011100) >> 2;
-        p += (*row1++ & 0b1110011110011100) >> 2;
-        p += (*row2++ & 0b1110011110011100) >> 2;
-        p += (*row2++ & 0b1110011110011100) >> 2;
+        p = quad_part(*row1++, _big_endian);
+        p += quad_part(*row1++, _big_endian);
+        p += quad_part(*row2++, _big_endian);
+        p += quad_part(*row2++, _big_endian);
         _rowBuf[i] = p;
       }
       _output->draw16bitRGBBitmap(_output_x, _output_y + y++, _rowBuf, wQuad, 1);
@@ -613,6 +927,259 @@ void Arduino_Canvas::flushQuad(bool force_flush)
   }
 }
 
+void Arduino_Canvas::setPartialFlush(bool enable)
+{
+  _partial_flush = enable;
+  _dirty_tracking = _partial_flush;
+#if defined(ESP32)
+  _dirty_tracking |= (_framebuffer2 != nullptr);
+#endif
+  // display content unknown at this point, next flush must send all
+  _dirty_count = 0;
+  if (enable)
+  {
+    addDirtyRect(0, 0, WIDTH, HEIGHT);
+  }
+}
+
+bool Arduino_Canvas::getPartialFlush()
+{
+  return _partial_flush;
+}
+
+// mark a region in current rotation coordinates, e.g. after writing to getFramebuffer() directly
+void Arduino_Canvas::markDirty(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  toFramebufferRect(&x, &y, &w, &h);
+  addDirtyRect(x, y, w, h);
+}
+
+// region in current rotation coordinates to framebuffer (rotation 0) coordinates, not clipped
+void Arduino_Canvas::toFramebufferRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h)
+{
+  int16_t t = *x;
+  switch (_rotation)
+  {
+  case 1:
+    *x = WIDTH - *y - *h;
+    *y = t;
+    t = *w;
+    *w = *h;
+    *h = t;
+    break;
+  case 2:
+    *x = WIDTH - *x - *w;
+    *y = HEIGHT - *y - *h;
+    break;
+  case 3:
+    *x = *y;
+    *y = HEIGHT - t - *w;
+    t = *w;
+    *w = *h;
+    *h = t;
+    break;
+  }
+}
+
+// swap a region in current rotation coordinates between host and wire order
+void Arduino_Canvas::swapRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  toFramebufferRect(&x, &y, &w, &h);
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if ((x + w - 1) > MAX_X)
+  {
+    w = MAX_X - x + 1;
+  }
+  if ((y + h - 1) > MAX_Y)
+  {
+    h = MAX_Y - y + 1;
+  }
+  if ((w > 0) && (h > 0))
+  {
+    gfx_swap_rect_16bit(_framebuffer + ((int32_t)y * WIDTH) + x, WIDTH, w, h);
+  }
+}
+
+void Arduino_Canvas::clearDirty()
+{
+  _dirty_count = 0;
+}
+
+uint8_t Arduino_Canvas::getDirtyRectCount()
+{
+  return _dirty_count;
+}
+
+// report dirty rect in framebuffer (rotation 0) coordinates
+bool Arduino_Canvas::getDirtyRect(uint8_t idx, int16_t *x, int16_t *y, int16_t *w, int16_t *h)
+{
+  if (idx >= _dirty_count)
+  {
+    return false;
+  }
+  *x = _dirty_rects[idx].x1;
+  *y = _dirty_rects[idx].y1;
+  *w = _dirty_rects[idx].x2 - _dirty_rects[idx].x1 + 1;
+  *h = _dirty_rects[idx].y2 - _dirty_rects[idx].y1 + 1;
+  return true;
+}
+
+void Arduino_Canvas::addDirtyRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  // most drawing hits the same area repeatedly, check last touched rect first
+  if (_dirty_count)
+  {
+    if ((x >= _dirty_rects[_dirty_last].x1) && (y >= _dirty_rects[_dirty_last].y1) && ((x + w - 1) <= _dirty_rects[_dirty_last].x2) && ((y + h - 1) <= _dirty_rects[_dirty_last].y2))
+    {
+      return;
+    }
+  }
+
+  int16_t i = gfx_add_dirty_rect(_dirty_rects, &_dirty_count, CANVAS_MAX_DIRTY_RECTS, false, x, y, w, h, WIDTH, HEIGHT);
+  if (i >= 0)
+  {
+    _dirty_last = i;
+  }
+}
+
+// Double buffered flush, flush() returns once the frame is handed over to a background task.
+// getFramebuffer() changes after every flush(), direct framebuffer writes must call markDirty().
+bool Arduino_Canvas::setAsyncFlush(bool enable)
+{
+#if defined(ESP32)
+  if (enable)
+  {
+    if (_framebuffer2)
+    {
+      return true;
+    }
+    if (!_framebuffer)
+    {
+      return false; // call begin() first
+    }
+
+    size_t s = WIDTH * HEIGHT * 2;
+    _framebuffer2 = (uint16_t *)aligned_alloc(16, s);
+    if (!_framebuffer2)
+    {
+      return false;
+    }
+    memcpy(_framebuffer2, _framebuffer, s);
+
+    _flush_done = xSemaphoreCreateBinary();
+    if (!_flush_done)
+    {
+      free(_framebuffer2);
+      _framebuffer2 = nullptr;
+      return false;
+    }
+    xSemaphoreGive(_flush_done);
+
+    if (xTaskCreatePinnedToCore(flushTask, "canvas_flush", CANVAS_FLUSH_TASK_STACK, this, CANVAS_FLUSH_TASK_PRIORITY, &_flush_task, CANVAS_FLUSH_TASK_CORE) != pdPASS)
+    {
+      vSemaphoreDelete(_flush_done);
+      _flush_done = nullptr;
+      free(_framebuffer2);
+      _framebuffer2 = nullptr;
+      return false;
+    }
+
+    _dirty_tracking = true;
+    addDirtyRect(0, 0, WIDTH, HEIGHT);
+    return true;
+  }
+  else
+  {
+    if (_framebuffer2)
+    {
+      xSemaphoreTake(_flush_done, portMAX_DELAY);
+      vTaskDelete(_flush_task);
+      _flush_task = nullptr;
+      vSemaphoreDelete(_flush_done);
+      _flush_done = nullptr;
+      free(_framebuffer2);
+      _framebuffer2 = nullptr;
+      _dirty_tracking = _partial_flush;
+    }
+    return true;
+  }
+#else
+  return !enable;
+#endif
+}
+
+void Arduino_Canvas::waitFlushDone()
+{
+#if defined(ESP32)
+  if (_flush_done)
+  {
+    xSemaphoreTake(_flush_done, portMAX_DELAY);
+    xSemaphoreGive(_flush_done);
+  }
+#endif
+}
+
+#if defined(ESP32)
+void Arduino_Canvas::flushTask(void *arg)
+{
+  Arduino_Canvas *canvas = (Arduino_Canvas *)arg;
+  while (true)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    canvas->flushFrame(canvas->_framebuffer2, canvas->_flush_full, canvas->_flush_rects, canvas->_flush_count);
+    xSemaphoreGive(canvas->_flush_done);
+  }
+}
+#endif
+
+// presentOnVSync() paces the flush() by the output panel
+Arduino_FrameSync *Arduino_Canvas::getFrameSync()
+{
+  return _output->getFrameSync();
+}
+
+// offload large fills and 16-bit bitmaps, e.g. to Arduino_ESP32PPA, nullptr to draw on the CPU only
+void Arduino_Canvas::setAccel(Arduino_Accel *accel)
+{
+  _accel = accel;
+}
+
+// Store pixels in wire order (Big Endian RGB565), flush() then hands the framebuffer to the output as is.
+// Drawing converts colors and bitmaps on the way in, getFramebuffer() holds wire order pixels in this mode.
+void Arduino_Canvas::setBigEndian(bool enable)
+{
+  if (enable == _big_endian)
+  {
+    return;
+  }
+  waitFlushDone();
+  if (_framebuffer)
+  {
+    gfx_swap_rect_16bit(_framebuffer, WIDTH, WIDTH, HEIGHT);
+  }
+#if defined(ESP32)
+  if (_framebuffer2)
+  {
+    gfx_swap_rect_16bit(_framebuffer2, WIDTH, WIDTH, HEIGHT);
+  }
+#endif
+  _big_endian = enable;
+}
+
+bool Arduino_Canvas::getBigEndian()
+{
+  return _big_endian;
+}
+
 uint16_t *Arduino_Canvas::getFramebuffer()
 {
   return _framebuffer;
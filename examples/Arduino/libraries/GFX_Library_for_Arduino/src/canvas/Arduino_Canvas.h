@@ -5,6 +5,31 @@
 #define _ARDUINO_CANVAS_H_
 
 #include "../Arduino_GFX.h"
+#include "../Arduino_Accel.h"
+#include "Arduino_DirtyRects.h"
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#ifndef CANVAS_FLUSH_TASK_STACK
+#define CANVAS_FLUSH_TASK_STACK 4096
+#endif
+#ifndef CANVAS_FLUSH_TASK_PRIORITY
+#define CANVAS_FLUSH_TASK_PRIORITY 2
+#endif
+#ifndef CANVAS_FLUSH_TASK_CORE
+#define CANVAS_FLUSH_TASK_CORE tskNO_AFFINITY
+#endif
+#endif // defined(ESP32)
+
+#ifndef CANVAS_MAX_DIRTY_RECTS
+#define CANVAS_MAX_DIRTY_RECTS 8
+#endif
+#ifndef CANVAS_FLUSH_BUF_PIXELS
+#define CANVAS_FLUSH_BUF_PIXELS 4096
+#endif
 
 class Arduino_Canvas : public Arduino_GFX
 {
@@ -24,12 +49,40 @@ public:
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
   void draw16bitRGBBitmapWithTranColor(int16_t x, int16_t y, uint16_t *bitmap, uint16_t transparent_color, int16_t w, int16_t h) override;
   void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void drawAlphaBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg) override;
+  void writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg) override;
+  void drawAffineBitmap(const gfx_affine_t *affine) override;
+  void draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h) override;
+  void draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h) override;
+  bool setScrollArea(int16_t y, int16_t h) override;
+  void scrollTo(int16_t offset) override;
   void flush(bool force_flush = false) override;
   void flushQuad(bool force_flush = false);
+  Arduino_FrameSync *getFrameSync() override;
+
+  void setPartialFlush(bool enable);
+  bool getPartialFlush();
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+  void clearDirty();
+  uint8_t getDirtyRectCount();
+  bool getDirtyRect(uint8_t idx, int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+  bool setAsyncFlush(bool enable);
+  void waitFlushDone();
+  void setAccel(Arduino_Accel *accel);
+  void setBigEndian(bool enable);
+  bool getBigEndian();
 
   uint16_t *getFramebuffer();
 
 protected:
+  void toFramebufferRect(int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+  void addDirtyRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void swapRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void flushFrame(uint16_t *fb, bool full, canvas_dirty_rect_t *rects, uint8_t count);
+  void flushRect(uint16_t *fb, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+  void flushBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h);
+
+
   uint16_t *_framebuffer = nullptr;
   Arduino_G *_output = nullptr;
   int16_t _output_x, _output_y;
@@ -38,6 +91,31 @@ protected:
   // for flushQuad() only
   uint16_t *_rowBuf = nullptr;
 
+  // for partial flush(), dirty rects in framebuffer coordinates
+  bool _partial_flush = false;
+  bool _dirty_tracking = false;
+  uint8_t _dirty_count = 0;
+  uint8_t _dirty_last = 0;
+  canvas_dirty_rect_t _dirty_rects[CANVAS_MAX_DIRTY_RECTS];
+  uint16_t *_flushBuf = nullptr;
+
+  // fills and blits offloaded if large enough, nullptr for CPU only
+  Arduino_Accel *_accel = nullptr;
+
+  // framebuffer pixels stored in wire order (Big Endian), flushed without byte swapping
+  bool _big_endian = false;
+
+#if defined(ESP32)
+  // for async flush(), _framebuffer is drawn while _framebuffer2 is sent out by _flush_task
+  static void flushTask(void *arg);
+  uint16_t *_framebuffer2 = nullptr;
+  TaskHandle_t _flush_task = nullptr;
+  SemaphoreHandle_t _flush_done = nullptr;
+  bool _flush_full = true;
+  uint8_t _flush_count = 0;
+  canvas_dirty_rect_t _flush_rects[CANVAS_MAX_DIRTY_RECTS];
+#endif
+
 private:
 };
 
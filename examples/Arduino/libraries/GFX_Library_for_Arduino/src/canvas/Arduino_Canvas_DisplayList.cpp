@@ -0,0 +1,665 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas_DisplayList.h"
+
+#define DISPLAY_LIST_HEADER_WORDS 5
+#define DISPLAY_LIST_PTR_WORDS ((sizeof(void *) + 1) / 2)
+
+// data words of a command after the header
+static uint32_t command_words(const uint16_t *c)
+{
+  switch (c[0] & 0xFF)
+  {
+  case DISPLAY_LIST_RECT:
+    return 1;
+  case DISPLAY_LIST_BITMAP:
+    return (uint32_t)c[3] * c[4];
+  case DISPLAY_LIST_BITMAP_REF:
+    return DISPLAY_LIST_PTR_WORDS;
+  case DISPLAY_LIST_ALPHA:
+    return 2 + (((uint32_t)c[3] * c[4] + 1) / 2);
+  default: // case DISPLAY_LIST_ALPHA_REF:
+    return 2 + DISPLAY_LIST_PTR_WORDS;
+  }
+}
+
+// true if the command sets every pixel of its rectangle regardless of what is below
+static bool command_is_opaque(const uint16_t *c)
+{
+  uint8_t type = c[0] & 0xFF;
+  if ((type == DISPLAY_LIST_ALPHA) || (type == DISPLAY_LIST_ALPHA_REF))
+  {
+    return c[5] != c[6]; // color != bg
+  }
+  return true;
+}
+
+Arduino_Canvas_DisplayList::Arduino_Canvas_DisplayList(
+    int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y, uint32_t band_pixels)
+    : Arduino_GFX(w, h), _output(output), _output_x(output_x), _output_y(output_y), _band_pixels(band_pixels)
+{
+}
+
+Arduino_Canvas_DisplayList::~Arduino_Canvas_DisplayList()
+{
+  if (_list)
+  {
+    free(_list);
+  }
+  if (_band_buf)
+  {
+    free(_band_buf);
+  }
+  if (_band_tiles)
+  {
+    free(_band_tiles);
+  }
+}
+
+bool Arduino_Canvas_DisplayList::begin(int32_t speed)
+{
+  if (
+      (speed != GFX_SKIP_OUTPUT_BEGIN) && (_output))
+  {
+    if (!_output->begin(speed))
+    {
+      return false;
+    }
+  }
+
+  if (!_list)
+  {
+    _list = (uint16_t *)malloc(DISPLAY_LIST_SIZE);
+    if (!_list)
+    {
+      return false;
+    }
+    _list_size = DISPLAY_LIST_SIZE / 2;
+  }
+
+  if (!_band_buf)
+  {
+    if (!allocBands())
+    {
+      return false;
+    }
+
+    // the panel content is unknown, the first flush() sends everything
+    markBands(0, 0, _width, _height);
+  }
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Set the rotation, the bands are sized again for the new width and height and the next flush() sends
+          the whole screen rendered from the list
+  @param  r  rotation, 0 to 7
+*/
+/**************************************************************************/
+void Arduino_Canvas_DisplayList::setRotation(uint8_t r)
+{
+  Arduino_GFX::setRotation(r);
+
+  if (_band_buf)
+  {
+    free(_band_buf);
+    _band_buf = nullptr;
+    free(_band_tiles);
+    _band_tiles = nullptr;
+    if (allocBands())
+    {
+      markBands(0, 0, _width, _height);
+    }
+  }
+}
+
+void Arduino_Canvas_DisplayList::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
+{
+  writeFillRectPreclipped(x, y, 1, 1, color);
+}
+
+void Arduino_Canvas_DisplayList::writeFastVLine(int16_t x, int16_t y,
+                                                int16_t h, uint16_t color)
+{
+  if (h < 0)
+  {
+    y += h + 1;
+    h = -h;
+  }
+  if ((x < 0) || (x > _max_x) || (y > _max_y) || ((y + h - 1) < 0))
+  {
+    return;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if ((y + h - 1) > _max_y)
+  {
+    h = _max_y - y + 1;
+  }
+  writeFillRectPreclipped(x, y, 1, h, color);
+}
+
+void Arduino_Canvas_DisplayList::writeFastHLine(int16_t x, int16_t y,
+                                                int16_t w, uint16_t color)
+{
+  if (w < 0)
+  {
+    x += w + 1;
+    w = -w;
+  }
+  if ((y < 0) || (y > _max_y) || (x > _max_x) || ((x + w - 1) < 0))
+  {
+    return;
+  }
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if ((x + w - 1) > _max_x)
+  {
+    w = _max_x - x + 1;
+  }
+  writeFillRectPreclipped(x, y, w, 1, color);
+}
+
+void Arduino_Canvas_DisplayList::writeFillRectPreclipped(int16_t x, int16_t y,
+                                                         int16_t w, int16_t h, uint16_t color)
+{
+  if ((x == 0) && (y == 0) && (w == _width) && (h == _height))
+  {
+    // nothing drawn before is visible any more
+    _list_len = 0;
+    _last_rect = UINT32_MAX;
+    _bg = color;
+    _overlay = false;
+    markBands(0, 0, _width, _height);
+    return;
+  }
+
+  if (_last_rect != UINT32_MAX)
+  {
+    // extend the last rect if adjacent, e.g. font pixels of a row or a column
+    uint16_t *r = _list + _last_rect;
+    if (r[5] == color)
+    {
+      if (((int16_t)r[2] == y) && ((int16_t)r[4] == h) && ((int16_t)(r[1] + r[3]) == x))
+      {
+        r[3] += w;
+        markBands(x, y, w, h);
+        return;
+      }
+      if (((int16_t)r[1] == x) && ((int16_t)r[3] == w) && ((int16_t)(r[2] + r[4]) == y))
+      {
+        r[4] += h;
+        markBands(x, y, w, h);
+        return;
+      }
+    }
+  }
+
+  uint16_t *d = addCommand(DISPLAY_LIST_RECT, x, y, w, h, 1);
+  if (d)
+  {
+    d[0] = color;
+    _last_rect = (d - _list) - DISPLAY_LIST_HEADER_WORDS;
+  }
+}
+
+void Arduino_Canvas_DisplayList::drawIndexedBitmap(int16_t x, int16_t y,
+                                                   uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip)
+{
+  int16_t x1 = (x < 0) ? 0 : x;
+  int16_t y1 = (y < 0) ? 0 : y;
+  int16_t x2 = ((x + w) > _width) ? _width : (x + w);
+  int16_t y2 = ((y + h) > _height) ? _height : (y + h);
+  if ((x1 >= x2) || (y1 >= y2))
+  {
+    return;
+  }
+
+  // expanded to 16-bit, the palette may change before flush()
+  uint16_t *d = addCommand(DISPLAY_LIST_BITMAP, x1, y1, x2 - x1, y2 - y1, (uint32_t)(x2 - x1) * (y2 - y1));
+  if (d)
+  {
+    for (int16_t j = y1; j < y2; ++j)
+    {
+      uint8_t *row = bitmap + ((int32_t)(j - y) * (w + x_skip)) + (x1 - x);
+      for (int16_t i = x1; i < x2; ++i)
+      {
+        *d++ = color_index[*row++];
+      }
+    }
+  }
+}
+
+void Arduino_Canvas_DisplayList::drawIndexedBitmap(int16_t x, int16_t y,
+                                                   uint8_t *bitmap, uint16_t *color_index, uint8_t chroma_key, int16_t w, int16_t h, int16_t x_skip)
+{
+  // transparent pixels, recorded as runs of pixels
+  Arduino_GFX::drawIndexedBitmap(x, y, bitmap, color_index, chroma_key, w, h, x_skip);
+}
+
+void Arduino_Canvas_DisplayList::draw16bitRGBBitmap(int16_t x, int16_t y,
+                                                    const uint16_t bitmap[], int16_t w, int16_t h)
+{
+  if ((w <= 0) || (h <= 0) || ((x + w) <= 0) || ((y + h) <= 0) || (x > _max_x) || (y > _max_y))
+  {
+    return;
+  }
+
+  uint16_t *d = addCommand(DISPLAY_LIST_BITMAP_REF, x, y, w, h, DISPLAY_LIST_PTR_WORDS);
+  if (d)
+  {
+    memcpy(d, &bitmap, sizeof(void *));
+  }
+}
+
+void Arduino_Canvas_DisplayList::draw16bitRGBBitmap(int16_t x, int16_t y,
+                                                    uint16_t *bitmap, int16_t w, int16_t h)
+{
+  int16_t x1 = (x < 0) ? 0 : x;
+  int16_t y1 = (y < 0) ? 0 : y;
+  int16_t x2 = ((x + w) > _width) ? _width : (x + w);
+  int16_t y2 = ((y + h) > _height) ? _height : (y + h);
+  if ((x1 >= x2) || (y1 >= y2))
+  {
+    return;
+  }
+
+  uint16_t *d = addCommand(DISPLAY_LIST_BITMAP, x1, y1, x2 - x1, y2 - y1, (uint32_t)(x2 - x1) * (y2 - y1));
+  if (d)
+  {
+    gfx_copy_rect_16bit(d, x2 - x1, bitmap + ((int32_t)(y1 - y) * w) + (x1 - x), w, x2 - x1, y2 - y1);
+  }
+}
+
+void Arduino_Canvas_DisplayList::drawAlphaBitmap(int16_t x, int16_t y,
+                                                 const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+  if (((bpp != 4) && (bpp != 8)) || (w <= 0) || (h <= 0) || ((x + w) <= 0) || ((y + h) <= 0) || (x > _max_x) || (y > _max_y))
+  {
+    return;
+  }
+
+  uint16_t *d = addCommand(DISPLAY_LIST_ALPHA_REF, x, y, w, h, 2 + DISPLAY_LIST_PTR_WORDS);
+  if (d)
+  {
+    d[-DISPLAY_LIST_HEADER_WORDS] |= (uint16_t)bpp << 8;
+    d[0] = color;
+    d[1] = bg;
+    memcpy(d + 2, &bitmap, sizeof(void *));
+  }
+}
+
+void Arduino_Canvas_DisplayList::writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg)
+{
+  int16_t x1 = (x < 0) ? 0 : x;
+  int16_t x2 = ((x + w) > _width) ? _width : (x + w);
+  if ((y < 0) || (y > _max_y) || (x1 >= x2))
+  {
+    return;
+  }
+
+  // the span is a temporary buffer, copy it
+  uint16_t *d = addCommand(DISPLAY_LIST_ALPHA, x1, y, x2 - x1, 1, 2 + ((x2 - x1 + 1) / 2));
+  if (d)
+  {
+    d[-DISPLAY_LIST_HEADER_WORDS] |= (uint16_t)8 << 8;
+    d[0] = color;
+    d[1] = bg;
+    memcpy(d + 2, alpha + (x1 - x), x2 - x1);
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Send the tiles drawn since the previous flush(), each run of dirty tiles in a band is rendered from the
+          whole command list and sent with one address window
+  @param  force_flush  send all tiles
+*/
+/**************************************************************************/
+void Arduino_Canvas_DisplayList::flush(bool force_flush)
+{
+  if ((!_output) || (!_band_buf))
+  {
+    return;
+  }
+  if (_overlay)
+  {
+    flushOverlay();
+    return;
+  }
+
+  for (int16_t b = 0; b < _bands; ++b)
+  {
+    uint32_t tiles = force_flush ? UINT32_MAX : _band_tiles[b];
+    int16_t y = b * _band_h;
+    int16_t h = ((y + _band_h) > _height) ? (_height - y) : _band_h;
+    int16_t t = 0;
+    while ((t < 32) && ((t * _tile_w) < _width))
+    {
+      if (!(tiles & (1UL << t)))
+      {
+        ++t;
+        continue;
+      }
+      int16_t t1 = t;
+      while ((t < 32) && (tiles & (1UL << t)))
+      {
+        ++t;
+      }
+      int16_t x1 = t1 * _tile_w;
+      int16_t x2 = t * _tile_w;
+      if (x2 > _width)
+      {
+        x2 = _width;
+      }
+      renderBand(y, h, x1, x2);
+      _output->draw16bitRGBBitmap(_output_x + x1, _output_y + y, _band_buf, x2 - x1, h);
+    }
+    _band_tiles[b] = 0;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Get the size of the recorded commands
+  @return bytes in use by the command list
+*/
+/**************************************************************************/
+uint32_t Arduino_Canvas_DisplayList::getDisplayListBytes()
+{
+  return _list_len * 2;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Append a command to the list, making room by compact() first, growing the list up to DISPLAY_LIST_MAX_SIZE
+          second and restartList() last
+  @param  type    command type
+  @param  x       Left x coordinate
+  @param  y       Top y coordinate
+  @param  w       Width in pixels
+  @param  h       Height in pixels
+  @param  words   16-bit words of data after the header
+  @return pointer to the data words, nullptr if the command is larger than the whole list
+*/
+/**************************************************************************/
+uint16_t *Arduino_Canvas_DisplayList::addCommand(display_list_command_t type, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t words)
+{
+  if (!_list)
+  {
+    return nullptr;
+  }
+
+  uint32_t need = DISPLAY_LIST_HEADER_WORDS + words;
+  if ((_list_len + need) > _list_size)
+  {
+    compact();
+  }
+  // grow unless compact() freed a quarter, compacting an almost full list on every command is slow
+  if ((_list_len + need) > (_list_size - (_list_size / 4)))
+  {
+    uint32_t size = _list_size * 2;
+    if (size < (_list_len + need))
+    {
+      size = _list_len + need;
+    }
+    if (size > (DISPLAY_LIST_MAX_SIZE / 2))
+    {
+      size = DISPLAY_LIST_MAX_SIZE / 2;
+    }
+    if (size > _list_size)
+    {
+      uint16_t *list = (uint16_t *)realloc(_list, size * 2);
+      if (list)
+      {
+        _list = list;
+        _list_size = size;
+      }
+    }
+    if ((_list_len + need) > _list_size)
+    {
+      // at the cap or out of memory
+      restartList();
+      if (need > _list_size)
+      {
+        return nullptr;
+      }
+    }
+  }
+
+  uint16_t *c = _list + _list_len;
+  _list_len += need;
+  c[0] = type;
+  c[1] = x;
+  c[2] = y;
+  c[3] = w;
+  c[4] = h;
+  _last_rect = UINT32_MAX;
+
+  // mark the visible part
+  int16_t x1 = (x < 0) ? 0 : x;
+  int16_t y1 = (y < 0) ? 0 : y;
+  int16_t x2 = ((x + w) > _width) ? _width : (x + w);
+  int16_t y2 = ((y + h) > _height) ? _height : (y + h);
+  markBands(x1, y1, x2 - x1, y2 - y1);
+
+  return c + DISPLAY_LIST_HEADER_WORDS;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Drop commands fully covered by a later opaque command, e.g. old text under a redrawn label background
+*/
+/**************************************************************************/
+void Arduino_Canvas_DisplayList::compact()
+{
+  uint32_t out = 0;
+  for (uint32_t i = 0; i < _list_len;)
+  {
+    uint16_t *c = _list + i;
+    uint32_t len = DISPLAY_LIST_HEADER_WORDS + command_words(c);
+    int16_t x1 = c[1], y1 = c[2];
+    int16_t x2 = x1 + (int16_t)c[3], y2 = y1 + (int16_t)c[4];
+
+    bool covered = false;
+    for (uint32_t j = i + len; j < _list_len;)
+    {
+      uint16_t *o = _list + j;
+      if (((int16_t)o[1] <= x1) && ((int16_t)o[2] <= y1) && (((int16_t)o[1] + (int16_t)o[3]) >= x2) && (((int16_t)o[2] + (int16_t)o[4]) >= y2) && command_is_opaque(o))
+      {
+        covered = true;
+        break;
+      }
+      j += DISPLAY_LIST_HEADER_WORDS + command_words(o);
+    }
+
+    if (!covered)
+    {
+      if (out != i)
+      {
+        memmove(_list + out, c, len * 2);
+      }
+      out += len;
+    }
+    i += len;
+  }
+  _list_len = out;
+  _last_rect = UINT32_MAX;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Send what the full list holds and empty it, the panel then keeps it and later commands are drawn over it
+*/
+/**************************************************************************/
+void Arduino_Canvas_DisplayList::restartList()
+{
+  flush();
+  _list_len = 0;
+  _last_rect = UINT32_MAX;
+  _overlay = true;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Send the area of each command since restartList(), rendered from the list so overlaps get the last pixel.
+          Alpha commands without a bg color blend over the fillScreen() color, the panel content is not known
+*/
+/**************************************************************************/
+void Arduino_Canvas_DisplayList::flushOverlay()
+{
+  for (uint32_t i = 0; i < _list_len;)
+  {
+    uint16_t *c = _list + i;
+    i += DISPLAY_LIST_HEADER_WORDS + command_words(c);
+
+    int16_t x1 = ((int16_t)c[1] < 0) ? 0 : (int16_t)c[1];
+    int16_t y1 = ((int16_t)c[2] < 0) ? 0 : (int16_t)c[2];
+    int16_t x2 = (((int16_t)c[1] + (int16_t)c[3]) > _width) ? _width : ((int16_t)c[1] + (int16_t)c[3]);
+    int16_t y2 = (((int16_t)c[2] + (int16_t)c[4]) > _height) ? _height : ((int16_t)c[2] + (int16_t)c[4]);
+    for (int16_t y = y1; y < y2; y += _band_h)
+    {
+      int16_t h = ((y + _band_h) > y2) ? (y2 - y) : _band_h;
+      renderBand(y, h, x1, x2);
+      _output->draw16bitRGBBitmap(_output_x + x1, _output_y + y, _band_buf, x2 - x1, h);
+    }
+  }
+  _list_len = 0;
+  _last_rect = UINT32_MAX;
+  memset(_band_tiles, 0, _bands * sizeof(uint32_t));
+}
+
+/**************************************************************************/
+/*!
+  @brief  Size the bands and tiles for _width and _height and allocate the band buffer and the tile masks
+  @return true if allocated
+*/
+/**************************************************************************/
+bool Arduino_Canvas_DisplayList::allocBands()
+{
+  _band_h = _band_pixels / _width;
+  if (_band_h < 1)
+  {
+    _band_h = 1;
+  }
+  else if (_band_h > _height)
+  {
+    _band_h = _height;
+  }
+  _bands = (_height + _band_h - 1) / _band_h;
+  _tile_w = (_width + 31) / 32;
+  if (_tile_w < DISPLAY_LIST_TILE_MIN_WIDTH)
+  {
+    _tile_w = DISPLAY_LIST_TILE_MIN_WIDTH;
+  }
+
+  size_t s = (size_t)_width * _band_h * 2;
+#if defined(ESP32)
+  _band_buf = (uint16_t *)aligned_alloc(16, s);
+#else
+  _band_buf = (uint16_t *)malloc(s);
+#endif
+  _band_tiles = (uint32_t *)calloc(_bands, sizeof(uint32_t));
+  if ((!_band_buf) || (!_band_tiles))
+  {
+    free(_band_buf);
+    _band_buf = nullptr;
+    free(_band_tiles);
+    _band_tiles = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void Arduino_Canvas_DisplayList::markBands(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  if ((!_band_tiles) || (w <= 0) || (h <= 0))
+  {
+    return;
+  }
+  int16_t t1 = x / _tile_w;
+  int16_t t2 = (x + w - 1) / _tile_w;
+  uint32_t tiles = ((t2 >= 31) ? UINT32_MAX : ((1UL << (t2 + 1)) - 1)) & ~((1UL << t1) - 1);
+  int16_t last = (y + h - 1) / _band_h;
+  for (int16_t b = y / _band_h; b <= last; ++b)
+  {
+    _band_tiles[b] |= tiles;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Render the commands in list order into the band buffer
+  @param  band_y  Top y coordinate of the band
+  @param  band_h  Rows of the band
+  @param  x1      Left x coordinate
+  @param  x2      Right x coordinate, exclusive; the buffer stride is x2 - x1
+*/
+/**************************************************************************/
+void Arduino_Canvas_DisplayList::renderBand(int16_t band_y, int16_t band_h, int16_t x1, int16_t x2)
+{
+  int16_t bw = x2 - x1;
+  int16_t band_y2 = band_y + band_h;
+  gfx_fill_16bit(_band_buf, _bg, (uint32_t)bw * band_h);
+
+  for (uint32_t i = 0; i < _list_len;)
+  {
+    uint16_t *c = _list + i;
+    i += DISPLAY_LIST_HEADER_WORDS + command_words(c);
+
+    int16_t x = c[1], y = c[2], w = c[3], h = c[4];
+    int16_t l = (x > x1) ? x : x1;
+    int16_t r = ((x + w) < x2) ? (x + w) : x2;
+    int16_t t = (y > band_y) ? y : band_y;
+    int16_t b = ((y + h) < band_y2) ? (y + h) : band_y2;
+    if ((l >= r) || (t >= b))
+    {
+      continue;
+    }
+
+    uint16_t *d = c + DISPLAY_LIST_HEADER_WORDS;
+    uint16_t *dst = _band_buf + ((int32_t)(t - band_y) * bw) + (l - x1);
+    const uint16_t *pixels;
+    const uint8_t *alpha;
+    switch (c[0] & 0xFF)
+    {
+    case DISPLAY_LIST_RECT:
+      gfx_fill_rect_16bit(dst, bw, r - l, b - t, d[0]);
+      break;
+    case DISPLAY_LIST_BITMAP:
+    case DISPLAY_LIST_BITMAP_REF:
+      if ((c[0] & 0xFF) == DISPLAY_LIST_BITMAP)
+      {
+        pixels = d;
+      }
+      else
+      {
+        memcpy(&pixels, d, sizeof(void *));
+      }
+      gfx_copy_rect_16bit(dst, bw, pixels + ((int32_t)(t - y) * w) + (l - x), w, r - l, b - t);
+      break;
+    default: // DISPLAY_LIST_ALPHA, DISPLAY_LIST_ALPHA_REF
+      if ((c[0] & 0xFF) == DISPLAY_LIST_ALPHA)
+      {
+        alpha = (const uint8_t *)(d + 2);
+      }
+      else
+      {
+        memcpy(&alpha, d + 2, sizeof(void *));
+      }
+      gfx_draw_alpha_bitmap_to_framebuffer(alpha, c[0] >> 8, w, h, d[0], d[1], _band_buf, x - x1, y - band_y, bw, band_h, 0);
+    }
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
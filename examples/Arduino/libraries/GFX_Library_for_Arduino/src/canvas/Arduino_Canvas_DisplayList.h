@@ -0,0 +1,92 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_CANVAS_DISPLAYLIST_H_
+#define _ARDUINO_CANVAS_DISPLAYLIST_H_
+
+#include "../Arduino_GFX.h"
+
+#ifndef DISPLAY_LIST_SIZE
+#define DISPLAY_LIST_SIZE 4096 // initial command buffer bytes, grows when a frame needs more
+#endif
+#ifndef DISPLAY_LIST_MAX_SIZE
+#define DISPLAY_LIST_MAX_SIZE 65536 // command buffer bytes at most, a full list is sent and restarted
+#endif
+#ifndef DISPLAY_LIST_BAND_PIXELS
+#define DISPLAY_LIST_BAND_PIXELS 4096 // band buffer pixels, a band is full width and as many rows as fit
+#endif
+#ifndef DISPLAY_LIST_TILE_MIN_WIDTH
+#define DISPLAY_LIST_TILE_MIN_WIDTH 16 // a band is split into at most 32 tiles of at least this width
+#endif
+
+typedef enum
+{
+  DISPLAY_LIST_RECT,         // color
+  DISPLAY_LIST_BITMAP,       // 16-bit pixels copied into the list
+  DISPLAY_LIST_BITMAP_REF,   // pointer to const 16-bit pixels
+  DISPLAY_LIST_ALPHA,        // color, bg, 8-bit alpha copied into the list
+  DISPLAY_LIST_ALPHA_REF,    // color, bg, pointer to const 4 or 8-bit alpha
+} display_list_command_t;
+
+/// Canvas without a framebuffer: draw calls since the last fillScreen() are kept in a command list and flush()
+/// renders the tiles touched since the previous flush() into a small band buffer, one address window per run of
+/// dirty tiles, so every changed pixel is sent once and nothing is sent half drawn.
+/// RAM bitmaps are copied into the list, const bitmaps and alpha font glyphs are referenced and must stay valid.
+/// A list that reaches DISPLAY_LIST_MAX_SIZE is sent and restarted; until the next fillScreen() flush() then sends
+/// the area of each command drawn since, as the rest of the panel is not in the list any more.
+class Arduino_Canvas_DisplayList : public Arduino_GFX
+{
+public:
+  Arduino_Canvas_DisplayList(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0,
+                             uint32_t band_pixels = DISPLAY_LIST_BAND_PIXELS);
+  ~Arduino_Canvas_DisplayList();
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED) override;
+  void setRotation(uint8_t r) override;
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip = 0) override;
+  void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, uint8_t chroma_key, int16_t w, int16_t h, int16_t x_skip = 0) override;
+  void draw16bitRGBBitmap(int16_t x, int16_t y, const uint16_t bitmap[], int16_t w, int16_t h) override;
+  void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void drawAlphaBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg) override;
+  void writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg) override;
+  void flush(bool force_flush = false) override;
+
+  uint32_t getDisplayListBytes();
+
+protected:
+  uint16_t *addCommand(display_list_command_t type, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t words);
+  void compact();
+  void restartList();
+  void flushOverlay();
+  bool allocBands();
+  void markBands(int16_t x, int16_t y, int16_t w, int16_t h);
+  void renderBand(int16_t band_y, int16_t band_h, int16_t x1, int16_t x2);
+
+  Arduino_G *_output = nullptr;
+  int16_t _output_x, _output_y;
+
+  // command list, 16-bit words: type | bpp << 8, x, y, w, h, then data of the type
+  uint16_t *_list = nullptr;
+  uint32_t _list_len = 0;
+  uint32_t _list_size = 0;
+  uint32_t _last_rect = UINT32_MAX; // offset of the last rect command, extended by adjacent rects of the same color
+  uint16_t _bg = 0;                 // color of the last fillScreen()
+  bool _overlay = false;            // the list was restarted, it holds only what is drawn over the panel since
+
+  uint16_t *_band_buf = nullptr;
+  uint32_t _band_pixels;
+  int16_t _band_h = 0;
+  int16_t _bands = 0;
+  int16_t _tile_w = 0;
+  uint32_t *_band_tiles = nullptr; // per band bit mask of the tiles drawn since the previous flush()
+
+private:
+};
+
+#endif // _ARDUINO_CANVAS_DISPLAYLIST_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -17,6 +17,7 @@ Arduino_Canvas_Indexed::Arduino_Canvas_Indexed(int16_t w, int16_t h, Arduino_G *
   }
   _current_mask_level = mask_level;
   _color_mask = mask_level_list[_current_mask_level];
+  clear_color_hash();
 }
 
 Arduino_Canvas_Indexed::~Arduino_Canvas_Indexed()
@@ -509,24 +510,45 @@ void Arduino_Canvas_Indexed::setDirectUseColorIndex(bool isEnable)
 
 uint8_t Arduino_Canvas_Indexed::get_color_index(uint16_t color)
 {
+  // consecutive draws mostly use the same color
+  if (_last_color_valid && (_last_color == color))
+  {
+    return _last_color_idx;
+  }
+  uint16_t raw_color = color;
   color &= _color_mask;
-  for (uint8_t i = 0; i < _indexed_size; i++)
+  uint16_t slot = (uint16_t)(color * 40503u) >> (16 - COLOR_IDX_HASH_BITS); // Fibonacci hashing
+  while (_color_hash[slot])
   {
-    if (_color_index[i] == color)
+    if (_color_index[_color_hash[slot] - 1] == color)
     {
-      return i;
+      _last_color = raw_color;
+      _last_color_idx = _color_hash[slot] - 1;
+      _last_color_valid = true;
+      return _last_color_idx;
     }
+    slot = (slot + 1) & (COLOR_IDX_HASH_SIZE - 1);
   }
   if (_indexed_size == (COLOR_IDX_SIZE - 1)) // overflowed
   {
+    uint8_t mask_level = _current_mask_level;
     raise_mask_level();
+    if (_current_mask_level != mask_level)
+    {
+      // color mask changed, lookup again
+      return get_color_index(raw_color);
+    }
   }
   _color_index[_indexed_size] = color;
+  _color_hash[slot] = _indexed_size + 1;
   // print("color_index[");
   // print(_indexed_size);
   // print("] = ");
   // println(color);
-  return _indexed_size++;
+  _last_color = raw_color;
+  _last_color_idx = _indexed_size++;
+  _last_color_valid = true;
+  return _last_color_idx;
 }
 
 GFX_INLINE uint16_t Arduino_Canvas_Indexed::get_index_color(uint8_t idx)
@@ -540,25 +562,37 @@ void Arduino_Canvas_Indexed::raise_mask_level()
   {
     int32_t buffer_size = _width * _height;
     uint8_t old_indexed_size = _indexed_size;
-    uint8_t new_color;
+    uint8_t remap[COLOR_IDX_SIZE];
     _indexed_size = 0;
     _color_mask = mask_level_list[++_current_mask_level];
+    clear_color_hash();
     // print("Raised mask level: ");
     // println(_current_mask_level);
 
-    // update _framebuffer color index, it is a time consuming job
+    // new index never exceeds the old one, so _color_index can be rebuilt in place
+    for (int i = 0; i < COLOR_IDX_SIZE; i++)
+    {
+      remap[i] = i;
+    }
     for (uint8_t old_color = 0; old_color < old_indexed_size; old_color++)
     {
-      new_color = get_color_index(_color_index[old_color]);
-      for (int32_t i = 0; i < buffer_size; i++)
-      {
-        if (_framebuffer[i] == old_color)
-        {
-          _framebuffer[i] = new_color;
-        }
-      }
+      remap[old_color] = get_color_index(_color_index[old_color]);
+    }
+    _last_color_valid = false;
+
+    // update _framebuffer color index in a single pass
+    uint8_t *fb = _framebuffer;
+    for (int32_t i = 0; i < buffer_size; i++)
+    {
+      fb[i] = remap[fb[i]];
     }
   }
 }
 
+void Arduino_Canvas_Indexed::clear_color_hash()
+{
+  memset(_color_hash, 0, sizeof(_color_hash));
+  _last_color_valid = false;
+}
+
 #endif // !defined(LITTLE_FOOT_PRINT)
@@ -7,6 +7,8 @@
 #include "../Arduino_GFX.h"
 
 #define COLOR_IDX_SIZE 256
+#define COLOR_IDX_HASH_BITS 9 // reverse lookup table size 2^9, keep load factor <= 0.5
+#define COLOR_IDX_HASH_SIZE (1 << COLOR_IDX_HASH_BITS)
 
 class Arduino_Canvas_Indexed : public Arduino_GFX
 {
@@ -34,6 +36,8 @@ public:
   void raise_mask_level();
 
 protected:
+  void clear_color_hash();
+
   uint8_t *_framebuffer = nullptr;
   Arduino_G *_output = nullptr;
   int16_t _output_x, _output_y;
@@ -41,6 +45,10 @@ protected:
 
   uint16_t _color_index[COLOR_IDX_SIZE];
   uint8_t _indexed_size = 0;
+  uint16_t _color_hash[COLOR_IDX_HASH_SIZE]; // masked color -> index + 1, 0 is empty slot
+  uint16_t _last_color = 0;
+  uint8_t _last_color_idx = 0;
+  bool _last_color_valid = false;
   bool _isDirectUseColorIndex = false;
 
   uint8_t _current_mask_level;
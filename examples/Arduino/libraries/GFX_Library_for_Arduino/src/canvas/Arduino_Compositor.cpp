@@ -0,0 +1,417 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Compositor.h"
+
+static inline void compose_pixel(uint16_t *d, uint16_t c, const compositor_layer_t *l)
+{
+  if (l->use_key && (c == l->key))
+  {
+    return;
+  }
+  *d = (l->alpha == 255) ? c : gfx_blend_16bit(c, *d, l->alpha);
+}
+
+Arduino_Compositor::Arduino_Compositor(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y)
+    : Arduino_DirtyComposer(w, h, output, output_x, output_y, _dirty_rect_list, COMPOSITOR_MAX_DIRTY_RECTS, false, COMPOSITOR_BUF_PIXELS)
+{
+}
+
+Arduino_Compositor::~Arduino_Compositor()
+{
+  while (_layer_count)
+  {
+    removeLayer(_layers[_layer_count - 1].canvas);
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Add a RGB565 layer, drawing into it is tracked and composed at the next flush()
+  @param  x  Left x coordinate on screen
+  @param  y  Top y coordinate on screen
+  @param  w  Width in pixels
+  @param  h  Height in pixels
+  @param  z  Stacking order, higher is on top
+  @return the layer canvas, nullptr if out of layers or memory
+*/
+/**************************************************************************/
+Arduino_Canvas *Arduino_Compositor::addLayer(int16_t x, int16_t y, int16_t w, int16_t h, int8_t z)
+{
+  Arduino_Canvas *canvas = new Arduino_Canvas(w, h, nullptr);
+  if ((!canvas->begin(GFX_SKIP_OUTPUT_BEGIN)) || (!addLayerEntry(canvas, COMPOSITOR_LAYER_RGB565, x, y, w, h, z)))
+  {
+    delete canvas;
+    return nullptr;
+  }
+  canvas->setPartialFlush(true); // dirty tracking, the whole layer is dirty now
+  return canvas;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Add a 8-bit indexed layer, call markLayerDirty() after drawing into it
+  @param  x  Left x coordinate on screen
+  @param  y  Top y coordinate on screen
+  @param  w  Width in pixels
+  @param  h  Height in pixels
+  @param  z  Stacking order, higher is on top
+  @return the layer canvas, nullptr if out of layers or memory
+*/
+/**************************************************************************/
+Arduino_Canvas_Indexed *Arduino_Compositor::addIndexedLayer(int16_t x, int16_t y, int16_t w, int16_t h, int8_t z)
+{
+  Arduino_Canvas_Indexed *canvas = new Arduino_Canvas_Indexed(w, h, nullptr);
+  if ((!canvas->begin(GFX_SKIP_OUTPUT_BEGIN)) || (!addLayerEntry(canvas, COMPOSITOR_LAYER_INDEXED, x, y, w, h, z)))
+  {
+    delete canvas;
+    return nullptr;
+  }
+  return canvas;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Add a 1-bit layer, call markLayerDirty() after drawing into it
+  @param  x   Left x coordinate on screen
+  @param  y   Top y coordinate on screen
+  @param  w   Width in pixels
+  @param  h   Height in pixels
+  @param  fg  Color of set pixels
+  @param  bg  Color of clear pixels, setLayerColorKey(layer, bg) makes them transparent
+  @param  z   Stacking order, higher is on top
+  @return the layer canvas, nullptr if out of layers or memory
+*/
+/**************************************************************************/
+Arduino_Canvas_Mono *Arduino_Compositor::addMonoLayer(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t fg, uint16_t bg, int8_t z)
+{
+  Arduino_Canvas_Mono *canvas = new Arduino_Canvas_Mono(w, h, nullptr);
+  compositor_layer_t *l = nullptr;
+  if ((!canvas->begin(GFX_SKIP_OUTPUT_BEGIN)) || (!(l = addLayerEntry(canvas, COMPOSITOR_LAYER_MONO, x, y, w, h, z))))
+  {
+    delete canvas;
+    return nullptr;
+  }
+  l->fg = fg;
+  l->bg = bg;
+  return canvas;
+}
+
+void Arduino_Compositor::removeLayer(Arduino_GFX *layer)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if (!l)
+  {
+    return;
+  }
+  markLayer(l);
+  delete l->canvas;
+  --_layer_count;
+  for (compositor_layer_t *e = _layers + _layer_count; l < e; ++l)
+  {
+    *l = *(l + 1);
+  }
+  sortLayers();
+}
+
+void Arduino_Compositor::setLayerPosition(Arduino_GFX *layer, int16_t x, int16_t y)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if ((l) && ((l->x != x) || (l->y != y)))
+  {
+    markLayer(l); // uncovered area
+    l->x = x;
+    l->y = y;
+    markLayer(l);
+  }
+}
+
+void Arduino_Compositor::setLayerZ(Arduino_GFX *layer, int8_t z)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if ((l) && (l->z != z))
+  {
+    l->z = z;
+    sortLayers();
+    markLayer(l);
+  }
+}
+
+void Arduino_Compositor::setLayerVisible(Arduino_GFX *layer, bool visible)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if ((l) && (l->visible != visible))
+  {
+    l->visible = true;
+    markLayer(l); // shown or uncovered area
+    l->visible = visible;
+  }
+}
+
+void Arduino_Compositor::setLayerAlpha(Arduino_GFX *layer, uint8_t alpha)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if ((l) && (l->alpha != alpha))
+  {
+    l->alpha = alpha;
+    markLayer(l);
+  }
+}
+
+void Arduino_Compositor::setLayerColorKey(Arduino_GFX *layer, uint16_t key)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if ((l) && ((!l->use_key) || (l->key != key)))
+  {
+    l->use_key = true;
+    l->key = key;
+    markLayer(l);
+  }
+}
+
+void Arduino_Compositor::clearLayerColorKey(Arduino_GFX *layer)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if ((l) && (l->use_key))
+  {
+    l->use_key = false;
+    markLayer(l);
+  }
+}
+
+// mark a region in layer framebuffer coordinates, e.g. after drawing into an indexed or mono layer
+void Arduino_Compositor::markLayerDirty(Arduino_GFX *layer, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if ((l) && (l->visible))
+  {
+    if (x < 0)
+    {
+      w += x;
+      x = 0;
+    }
+    if (y < 0)
+    {
+      h += y;
+      y = 0;
+    }
+    if ((x + w) > l->w)
+    {
+      w = l->w - x;
+    }
+    if ((y + h) > l->h)
+    {
+      h = l->h - y;
+    }
+    addDirtyRect(l->x + x, l->y + y, w, h);
+  }
+}
+
+void Arduino_Compositor::markLayerDirty(Arduino_GFX *layer)
+{
+  compositor_layer_t *l = findLayer(layer);
+  if (l)
+  {
+    markLayer(l);
+  }
+}
+
+void Arduino_Compositor::setBackground(uint16_t color)
+{
+  if (_bg != color)
+  {
+    _bg = color;
+    addDirtyRect(0, 0, _width, _height);
+  }
+}
+
+uint8_t Arduino_Compositor::getLayerCount()
+{
+  return _layer_count;
+}
+
+compositor_layer_t *Arduino_Compositor::findLayer(Arduino_GFX *layer)
+{
+  for (uint8_t i = 0; i < _layer_count; ++i)
+  {
+    if (_layers[i].canvas == layer)
+    {
+      return _layers + i;
+    }
+  }
+  return nullptr;
+}
+
+compositor_layer_t *Arduino_Compositor::addLayerEntry(Arduino_GFX *canvas, uint8_t type, int16_t x, int16_t y, int16_t w, int16_t h, int8_t z)
+{
+  if (_layer_count >= COMPOSITOR_MAX_LAYERS)
+  {
+    return nullptr;
+  }
+  compositor_layer_t *l = _layers + _layer_count++;
+  l->canvas = canvas;
+  l->type = type;
+  l->x = x;
+  l->y = y;
+  l->w = w;
+  l->h = h;
+  l->z = z;
+  l->visible = true;
+  l->alpha = 255;
+  l->use_key = false;
+  l->key = 0;
+  l->fg = RGB565_WHITE;
+  l->bg = RGB565_BLACK;
+  sortLayers();
+  markLayer(l);
+  return l;
+}
+
+// stable insertion sort by z, layers of the same z keep the order of adding
+void Arduino_Compositor::sortLayers()
+{
+  for (uint8_t i = 0; i < _layer_count; ++i)
+  {
+    uint8_t j = i;
+    while ((j > 0) && (_layers[_order[j - 1]].z > _layers[i].z))
+    {
+      _order[j] = _order[j - 1];
+      --j;
+    }
+    _order[j] = i;
+  }
+}
+
+void Arduino_Compositor::markLayer(compositor_layer_t *l)
+{
+  if (l->visible)
+  {
+    addDirtyRect(l->x, l->y, l->w, l->h);
+  }
+}
+
+// move the regions drawn into RGB565 layers to the screen dirty list
+void Arduino_Compositor::collectDirty()
+{
+  int16_t x, y, w, h;
+  for (uint8_t i = 0; i < _layer_count; ++i)
+  {
+    compositor_layer_t *l = _layers + i;
+    if (l->type == COMPOSITOR_LAYER_RGB565)
+    {
+      Arduino_Canvas *canvas = (Arduino_Canvas *)l->canvas;
+      if (l->visible)
+      {
+        for (uint8_t r = 0; canvas->getDirtyRect(r, &x, &y, &w, &h); ++r)
+        {
+          addDirtyRect(l->x + x, l->y + y, w, h);
+        }
+      }
+      canvas->clearDirty();
+    }
+  }
+}
+
+uint8_t Arduino_Compositor::getItemCount()
+{
+  return _layer_count;
+}
+
+bool Arduino_Compositor::getItemRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w, int16_t *h)
+{
+  compositor_layer_t *l = _layers + _order[i];
+  *x = l->x;
+  *y = l->y;
+  *w = l->w;
+  *h = l->h;
+  return (l->visible) && (l->alpha != 0);
+}
+
+bool Arduino_Compositor::isItemOpaque(uint8_t i)
+{
+  compositor_layer_t *l = _layers + _order[i];
+  return (l->alpha == 255) && (!l->use_key);
+}
+
+void Arduino_Compositor::composeBackground(uint16_t *buf, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  gfx_fill_16bit(buf, _bg, (uint32_t)(x2 - x1 + 1) * (y2 - y1 + 1));
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw the part of a layer inside a screen region over the buffer
+  @param  item    Layer index in stacking order
+  @param  buf     Buffer position of (x1, y1)
+  @param  stride  Buffer pixels per row
+  @param  x1      Left x coordinate on screen, inside the layer
+  @param  y1      Top y coordinate on screen, inside the layer
+  @param  x2      Right x coordinate, inclusive
+  @param  y2      Bottom y coordinate, inclusive
+*/
+/**************************************************************************/
+void Arduino_Compositor::composeItemRows(uint8_t item, uint16_t *buf, int16_t stride, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  compositor_layer_t *l = _layers + _order[item];
+  int16_t w = x2 - x1 + 1;
+  int16_t h = y2 - y1 + 1;
+  int16_t lx = x1 - l->x;
+  int16_t ly = y1 - l->y;
+
+  switch (l->type)
+  {
+  case COMPOSITOR_LAYER_RGB565:
+  {
+    const uint16_t *src = ((Arduino_Canvas *)l->canvas)->getFramebuffer() + ((int32_t)ly * l->w) + lx;
+    if ((l->alpha == 255) && (!l->use_key))
+    {
+      gfx_copy_rect_16bit(buf, stride, src, l->w, w, h);
+      break;
+    }
+    for (int16_t j = 0; j < h; ++j)
+    {
+      for (int16_t i = 0; i < w; ++i)
+      {
+        compose_pixel(buf + i, src[i], l);
+      }
+      buf += stride;
+      src += l->w;
+    }
+    break;
+  }
+  case COMPOSITOR_LAYER_INDEXED:
+  {
+    Arduino_Canvas_Indexed *canvas = (Arduino_Canvas_Indexed *)l->canvas;
+    const uint8_t *src = canvas->getFramebuffer() + ((int32_t)ly * l->w) + lx;
+    const uint16_t *palette = canvas->getColorIndex();
+    for (int16_t j = 0; j < h; ++j)
+    {
+      for (int16_t i = 0; i < w; ++i)
+      {
+        compose_pixel(buf + i, palette[src[i]], l);
+      }
+      buf += stride;
+      src += l->w;
+    }
+    break;
+  }
+  default: // case COMPOSITOR_LAYER_MONO:
+  {
+    int16_t byte_w = (l->w + 7) / 8;
+    const uint8_t *src = ((Arduino_Canvas_Mono *)l->canvas)->getFramebuffer() + ((int32_t)ly * byte_w);
+    for (int16_t j = 0; j < h; ++j)
+    {
+      for (int16_t i = 0; i < w; ++i)
+      {
+        int16_t x = lx + i;
+        compose_pixel(buf + i, (src[x >> 3] & (0x80 >> (x & 7))) ? l->fg : l->bg, l);
+      }
+      buf += stride;
+      src += byte_w;
+    }
+  }
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
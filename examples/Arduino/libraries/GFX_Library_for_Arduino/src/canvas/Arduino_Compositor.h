@@ -0,0 +1,95 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_COMPOSITOR_H_
+#define _ARDUINO_COMPOSITOR_H_
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas.h"
+#include "Arduino_Canvas_Indexed.h"
+#include "Arduino_Canvas_Mono.h"
+#include "Arduino_DirtyRects.h"
+
+#ifndef COMPOSITOR_MAX_LAYERS
+#define COMPOSITOR_MAX_LAYERS 8
+#endif
+#ifndef COMPOSITOR_MAX_DIRTY_RECTS
+#define COMPOSITOR_MAX_DIRTY_RECTS 16
+#endif
+#ifndef COMPOSITOR_BUF_PIXELS
+#define COMPOSITOR_BUF_PIXELS 4096 // composition buffer, at least one screen row is allocated
+#endif
+
+typedef enum
+{
+  COMPOSITOR_LAYER_RGB565,
+  COMPOSITOR_LAYER_INDEXED,
+  COMPOSITOR_LAYER_MONO,
+} compositor_layer_type_t;
+
+typedef struct
+{
+  Arduino_GFX *canvas;
+  uint8_t type;   // compositor_layer_type_t
+  int16_t x, y;   // position on screen
+  int16_t w, h;   // framebuffer size, rotation 0
+  int8_t z;       // higher is on top, same z keeps the order of adding
+  bool visible;
+  uint8_t alpha;  // global alpha, 255 is opaque
+  bool use_key;
+  uint16_t key;   // RGB565 color not drawn, compared after palette or mono lookup
+  uint16_t fg, bg; // mono layer colors
+} compositor_layer_t;
+
+/// Stacks canvas layers on screen and sends only the regions changed since the previous flush().
+/// RGB565 layers track their own drawing, indexed and mono layers have no dirty tracking and need markLayerDirty().
+/// Layers are owned by the compositor, draw into them with their Arduino_GFX functions and never call their flush().
+class Arduino_Compositor : public Arduino_DirtyComposer
+{
+public:
+  Arduino_Compositor(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0);
+  ~Arduino_Compositor();
+
+  Arduino_Canvas *addLayer(int16_t x, int16_t y, int16_t w, int16_t h, int8_t z = 0);
+  Arduino_Canvas_Indexed *addIndexedLayer(int16_t x, int16_t y, int16_t w, int16_t h, int8_t z = 0);
+  Arduino_Canvas_Mono *addMonoLayer(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t fg, uint16_t bg, int8_t z = 0);
+  void removeLayer(Arduino_GFX *layer);
+
+  void setLayerPosition(Arduino_GFX *layer, int16_t x, int16_t y);
+  void setLayerZ(Arduino_GFX *layer, int8_t z);
+  void setLayerVisible(Arduino_GFX *layer, bool visible);
+  void setLayerAlpha(Arduino_GFX *layer, uint8_t alpha);
+  void setLayerColorKey(Arduino_GFX *layer, uint16_t key);
+  void clearLayerColorKey(Arduino_GFX *layer);
+  void markLayerDirty(Arduino_GFX *layer, int16_t x, int16_t y, int16_t w, int16_t h);
+  void markLayerDirty(Arduino_GFX *layer);
+  void setBackground(uint16_t color);
+
+  uint8_t getLayerCount();
+
+protected:
+  compositor_layer_t *findLayer(Arduino_GFX *layer);
+  compositor_layer_t *addLayerEntry(Arduino_GFX *canvas, uint8_t type, int16_t x, int16_t y, int16_t w, int16_t h, int8_t z);
+  void sortLayers();
+  void markLayer(compositor_layer_t *l);
+  void collectDirty() override;
+  uint8_t getItemCount() override;
+  bool getItemRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w, int16_t *h) override;
+  bool isItemOpaque(uint8_t i) override;
+  void composeBackground(uint16_t *buf, int16_t x1, int16_t y1, int16_t x2, int16_t y2) override;
+  void composeItemRows(uint8_t item, uint16_t *buf, int16_t stride, int16_t x1, int16_t y1, int16_t x2, int16_t y2) override;
+
+  uint16_t _bg = 0;
+
+  compositor_layer_t _layers[COMPOSITOR_MAX_LAYERS];
+  uint8_t _order[COMPOSITOR_MAX_LAYERS]; // layer index from bottom to top
+  uint8_t _layer_count = 0;
+
+  canvas_dirty_rect_t _dirty_rect_list[COMPOSITOR_MAX_DIRTY_RECTS];
+
+private:
+};
+
+#endif // _ARDUINO_COMPOSITOR_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,237 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "Arduino_DirtyRects.h"
+
+static inline int32_t rect_area(int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  return (int32_t)(x2 - x1 + 1) * (y2 - y1 + 1);
+}
+
+// extra pixels sent if two rects are sent as their bounding box
+static inline int32_t rect_merge_cost(const canvas_dirty_rect_t *a, const canvas_dirty_rect_t *b)
+{
+  return rect_area(min(a->x1, b->x1), min(a->y1, b->y1), max(a->x2, b->x2), max(a->y2, b->y2)) - rect_area(a->x1, a->y1, a->x2, a->y2) - rect_area(b->x1, b->y1, b->x2, b->y2);
+}
+
+static inline bool rect_overlap(const canvas_dirty_rect_t *a, const canvas_dirty_rect_t *b)
+{
+  return (a->x1 <= b->x2) && (b->x1 <= a->x2) && (a->y1 <= b->y2) && (b->y1 <= a->y2);
+}
+
+/**************************************************************************/
+/*!
+  @brief  Add a region to a dirty rect list, clipped to the area. It is merged with the rect
+    that grows least if that sends at most CANVAS_DIRTY_MERGE_SLACK extra pixels or the list is full,
+    the grown rect is merged further the same way.
+  @param  rects              Dirty rect list
+  @param  count              Number of rects in the list, updated
+  @param  max_count          List size
+  @param  merge_overlapping  Always merge overlapping rects, no pixel is in two rects
+  @param  x                  Left x coordinate
+  @param  y                  Top y coordinate
+  @param  w                  Width in pixels
+  @param  h                  Height in pixels
+  @param  area_w             Area width
+  @param  area_h             Area height
+  @return index of the rect holding the region, -1 if it is outside the area
+*/
+/**************************************************************************/
+int16_t gfx_add_dirty_rect(
+    canvas_dirty_rect_t *rects, uint8_t *count, uint8_t max_count, bool merge_overlapping,
+    int16_t x, int16_t y, int16_t w, int16_t h, int16_t area_w, int16_t area_h)
+{
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if ((x + w) > area_w)
+  {
+    w = area_w - x;
+  }
+  if ((y + h) > area_h)
+  {
+    h = area_h - y;
+  }
+  if ((w <= 0) || (h <= 0))
+  {
+    return -1;
+  }
+
+  canvas_dirty_rect_t r = {x, y, (int16_t)(x + w - 1), (int16_t)(y + h - 1)};
+  for (;;)
+  {
+    int32_t cost, best_cost = INT32_MAX;
+    uint8_t best = 0;
+    for (uint8_t i = 0; i < *count; ++i)
+    {
+      cost = (merge_overlapping && rect_overlap(rects + i, &r)) ? INT32_MIN : rect_merge_cost(rects + i, &r);
+      if (cost < best_cost)
+      {
+        best_cost = cost;
+        best = i;
+      }
+    }
+    if ((best_cost > CANVAS_DIRTY_MERGE_SLACK) && (*count < max_count))
+    {
+      rects[*count] = r;
+      return (*count)++;
+    }
+
+    // take the rect out and merge, the grown rect may now overlap or be cheap to merge with others
+    r.x1 = min(r.x1, rects[best].x1);
+    r.y1 = min(r.y1, rects[best].y1);
+    r.x2 = max(r.x2, rects[best].x2);
+    r.y2 = max(r.y2, rects[best].y2);
+    rects[best] = rects[--(*count)];
+  }
+}
+
+Arduino_DirtyComposer::Arduino_DirtyComposer(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y,
+                                             canvas_dirty_rect_t *dirty_rects, uint8_t max_dirty_rects, bool merge_overlapping, uint32_t buf_pixels)
+    : _output(output), _width(w), _height(h), _output_x(output_x), _output_y(output_y),
+      _dirty_rects(dirty_rects), _max_dirty_rects(max_dirty_rects), _merge_overlapping(merge_overlapping),
+      _buf_pixels((buf_pixels > (uint32_t)w) ? buf_pixels : w) // at least one screen row
+{
+}
+
+Arduino_DirtyComposer::~Arduino_DirtyComposer()
+{
+  if (_buf)
+  {
+    free(_buf);
+  }
+}
+
+bool Arduino_DirtyComposer::begin(int32_t speed)
+{
+  if (
+      (speed != GFX_SKIP_OUTPUT_BEGIN) && (_output))
+  {
+    if (!_output->begin(speed))
+    {
+      return false;
+    }
+  }
+
+  if (!_buf)
+  {
+#if defined(ESP32)
+    _buf = (uint16_t *)aligned_alloc(16, _buf_pixels * 2);
+#else
+    _buf = (uint16_t *)malloc(_buf_pixels * 2);
+#endif
+    if (!_buf)
+    {
+      return false;
+    }
+  }
+
+  // the panel content is unknown, the first flush() sends everything
+  addDirtyRect(0, 0, _width, _height);
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+  @brief  Compose the regions changed since the previous flush() and send them to the output
+  @param  force_flush  compose and send the whole screen
+*/
+/**************************************************************************/
+void Arduino_DirtyComposer::flush(bool force_flush)
+{
+  if ((!_output) || (!_buf))
+  {
+    return;
+  }
+
+  collectDirty();
+  if (force_flush)
+  {
+    _dirty_count = 0;
+    addDirtyRect(0, 0, _width, _height);
+  }
+  for (uint8_t i = 0; i < _dirty_count; ++i)
+  {
+    composeRect(_dirty_rects[i].x1, _dirty_rects[i].y1, _dirty_rects[i].x2, _dirty_rects[i].y2);
+  }
+  _dirty_count = 0;
+}
+
+// pixels composed by all flush() calls, e.g. to check that cost follows the changed area
+uint32_t Arduino_DirtyComposer::getComposedPixels()
+{
+  return _composed_pixels;
+}
+
+// add a screen region, merged with an existing one as gfx_add_dirty_rect()
+void Arduino_DirtyComposer::addDirtyRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  gfx_add_dirty_rect(_dirty_rects, &_dirty_count, _max_dirty_rects, _merge_overlapping, x, y, w, h, _width, _height);
+}
+
+/**************************************************************************/
+/*!
+  @brief  Compose a screen region bottom up in bands that fit the buffer and send each band
+  @param  x1  Left x coordinate
+  @param  y1  Top y coordinate
+  @param  x2  Right x coordinate, inclusive
+  @param  y2  Bottom y coordinate, inclusive
+*/
+/**************************************************************************/
+void Arduino_DirtyComposer::composeRect(int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  int16_t w = x2 - x1 + 1;
+  int16_t band_h = _buf_pixels / w;
+  uint8_t count = getItemCount();
+  int16_t ix, iy, iw, ih;
+
+  for (int16_t by = y1; by <= y2; by += band_h)
+  {
+    int16_t by2 = ((by + band_h - 1) < y2) ? (by + band_h - 1) : y2;
+
+    // nothing below the topmost opaque item covering the band is visible
+    int16_t first = -1;
+    for (int16_t i = count - 1; i >= 0; --i)
+    {
+      if (getItemRect(i, &ix, &iy, &iw, &ih) && isItemOpaque(i) && (ix <= x1) && (iy <= by) && ((ix + iw) > x2) && ((iy + ih) > by2))
+      {
+        first = i;
+        break;
+      }
+    }
+    if (first < 0)
+    {
+      composeBackground(_buf, x1, by, x2, by2);
+      first = 0;
+    }
+
+    for (uint8_t i = first; i < count; ++i)
+    {
+      if (!getItemRect(i, &ix, &iy, &iw, &ih))
+      {
+        continue;
+      }
+      int16_t l1 = max(x1, ix);
+      int16_t t1 = max(by, iy);
+      int16_t r1 = min(x2, (int16_t)(ix + iw - 1));
+      int16_t b1 = min(by2, (int16_t)(iy + ih - 1));
+      if ((l1 <= r1) && (t1 <= b1))
+      {
+        composeItemRows(i, _buf + ((int32_t)(t1 - by) * w) + (l1 - x1), w, l1, t1, r1, b1);
+      }
+    }
+
+    _output->draw16bitRGBBitmap(_output_x + x1, _output_y + by, _buf, w, by2 - by + 1);
+    _composed_pixels += (uint32_t)w * (by2 - by + 1);
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
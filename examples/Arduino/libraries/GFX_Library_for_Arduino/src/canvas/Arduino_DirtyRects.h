@@ -0,0 +1,71 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_DIRTYRECTS_H_
+#define _ARDUINO_DIRTYRECTS_H_
+
+#include "../Arduino_G.h"
+
+#ifndef CANVAS_DIRTY_MERGE_SLACK
+#define CANVAS_DIRTY_MERGE_SLACK 64 // extra pixels worth sending to save one address window
+#endif
+
+typedef struct
+{
+  int16_t x1, y1, x2, y2; // inclusive
+} canvas_dirty_rect_t;
+
+int16_t gfx_add_dirty_rect(
+    canvas_dirty_rect_t *rects, uint8_t *count, uint8_t max_count, bool merge_overlapping,
+    int16_t x, int16_t y, int16_t w, int16_t h, int16_t area_w, int16_t area_h);
+
+/// Composes the damaged regions of a screen bottom up in bands that fit a small buffer and sends each band once.
+/// Base of Arduino_Compositor and Arduino_SpriteEngine, a subclass provides the items (layers or sprites) from bottom to top.
+class Arduino_DirtyComposer
+{
+public:
+  Arduino_DirtyComposer(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y,
+                        canvas_dirty_rect_t *dirty_rects, uint8_t max_dirty_rects, bool merge_overlapping, uint32_t buf_pixels);
+  virtual ~Arduino_DirtyComposer();
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED);
+  void flush(bool force_flush = false);
+
+  uint32_t getComposedPixels();
+
+protected:
+  void addDirtyRect(int16_t x, int16_t y, int16_t w, int16_t h);
+  void composeRect(int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+
+  // add the regions changed since the previous flush() with addDirtyRect()
+  virtual void collectDirty() = 0;
+  virtual uint8_t getItemCount() = 0;
+  // screen rect of the i-th item from the bottom, false if it is not drawn
+  virtual bool getItemRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w, int16_t *h) = 0;
+  // the item hides everything below it inside its rect
+  virtual bool isItemOpaque(uint8_t i) = 0;
+  // fill the buffer of a screen region, buffer stride is the region width
+  virtual void composeBackground(uint16_t *buf, int16_t x1, int16_t y1, int16_t x2, int16_t y2) = 0;
+  // draw the part of the i-th item inside a screen region over the buffer
+  virtual void composeItemRows(uint8_t i, uint16_t *buf, int16_t stride, int16_t x1, int16_t y1, int16_t x2, int16_t y2) = 0;
+
+  Arduino_G *_output = nullptr;
+  int16_t _width, _height;
+  int16_t _output_x, _output_y;
+
+  // damaged screen regions since the previous flush(), inclusive, storage of the subclass
+  canvas_dirty_rect_t *_dirty_rects;
+  uint8_t _max_dirty_rects;
+  uint8_t _dirty_count = 0;
+  bool _merge_overlapping; // never compose and send a pixel twice
+
+  uint16_t *_buf = nullptr;
+  uint32_t _buf_pixels;
+  uint32_t _composed_pixels = 0;
+
+private:
+};
+
+#endif // _ARDUINO_DIRTYRECTS_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,420 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#include "../Arduino_GFX.h"
+#include "Arduino_SpriteEngine.h"
+
+Arduino_SpriteEngine::Arduino_SpriteEngine(int16_t w, int16_t h, Arduino_G *output, int16_t output_x, int16_t output_y)
+    : Arduino_DirtyComposer(w, h, output, output_x, output_y, _dirty_rect_list, SPRITE_MAX_DIRTY_RECTS, true, SPRITE_BUF_PIXELS)
+{
+  for (uint8_t i = 0; i < SPRITE_MAX_SPRITES; ++i)
+  {
+    _sprites[i].used = false;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Add a RGB565 sprite
+  @param  bitmap      First frame
+  @param  w           Width in pixels
+  @param  h           Height in pixels
+  @param  x           Left x coordinate on screen
+  @param  y           Top y coordinate on screen
+  @param  z           Stacking order, higher is on top
+  @param  frames      Number of animation frames
+  @param  stride      Bitmap pixels per row, 0 for w
+  @param  frame_step  Bitmap pixels from one frame to the next, 0 for frames stacked vertically (stride * h),
+                      w for frames side by side in a sheet of stride = frames * w
+  @return sprite id, -1 if the sprite table is full
+*/
+/**************************************************************************/
+int16_t Arduino_SpriteEngine::addSprite(const uint16_t *bitmap, int16_t w, int16_t h, int16_t x, int16_t y, int8_t z,
+                                        uint16_t frames, int16_t stride, int32_t frame_step)
+{
+  return addSpriteEntry(bitmap, nullptr, SPRITE_RGB565, w, h, x, y, z, frames, stride, frame_step);
+}
+
+/**************************************************************************/
+/*!
+  @brief  Add a 8-bit indexed sprite, the color key of indexed sprites is a palette index
+  @param  bitmap      First frame
+  @param  palette     256 RGB565 colors
+  @param  w           Width in pixels
+  @param  h           Height in pixels
+  @param  x           Left x coordinate on screen
+  @param  y           Top y coordinate on screen
+  @param  z           Stacking order, higher is on top
+  @param  frames      Number of animation frames
+  @param  stride      Bitmap pixels per row, 0 for w
+  @param  frame_step  Bitmap pixels from one frame to the next, as addSprite()
+  @return sprite id, -1 if the sprite table is full
+*/
+/**************************************************************************/
+int16_t Arduino_SpriteEngine::addIndexedSprite(const uint8_t *bitmap, const uint16_t *palette, int16_t w, int16_t h, int16_t x, int16_t y, int8_t z,
+                                               uint16_t frames, int16_t stride, int32_t frame_step)
+{
+  return addSpriteEntry(bitmap, palette, SPRITE_INDEXED, w, h, x, y, z, frames, stride, frame_step);
+}
+
+void Arduino_SpriteEngine::removeSprite(int16_t id)
+{
+  sprite_t *s = findSprite(id);
+  if (!s)
+  {
+    return;
+  }
+  if (s->drawn)
+  {
+    addDirtyRect(s->drawn_x, s->drawn_y, s->w, s->h); // uncovered area
+  }
+  s->used = false;
+  removeOrder(id);
+}
+
+void Arduino_SpriteEngine::setSpritePosition(int16_t id, int16_t x, int16_t y)
+{
+  sprite_t *s = findSprite(id);
+  if ((s) && ((s->x != x) || (s->y != y)))
+  {
+    s->x = x;
+    s->y = y;
+    s->changed = true;
+  }
+}
+
+void Arduino_SpriteEngine::moveSprite(int16_t id, int16_t dx, int16_t dy)
+{
+  sprite_t *s = findSprite(id);
+  if (s)
+  {
+    setSpritePosition(id, s->x + dx, s->y + dy);
+  }
+}
+
+void Arduino_SpriteEngine::setSpriteFrame(int16_t id, uint16_t frame)
+{
+  sprite_t *s = findSprite(id);
+  if ((s) && (frame < s->frames) && (s->frame != frame))
+  {
+    s->frame = frame;
+    s->changed = true;
+  }
+}
+
+// advance the animation, back to the first frame after the last one
+void Arduino_SpriteEngine::nextSpriteFrame(int16_t id)
+{
+  sprite_t *s = findSprite(id);
+  if (s)
+  {
+    setSpriteFrame(id, ((s->frame + 1) < s->frames) ? (s->frame + 1) : 0);
+  }
+}
+
+void Arduino_SpriteEngine::setSpriteZ(int16_t id, int8_t z)
+{
+  sprite_t *s = findSprite(id);
+  if ((s) && (s->z != z))
+  {
+    removeOrder(id);
+    s->z = z;
+    insertOrder(id);
+    s->changed = true;
+  }
+}
+
+void Arduino_SpriteEngine::setSpriteVisible(int16_t id, bool visible)
+{
+  sprite_t *s = findSprite(id);
+  if ((s) && (s->visible != visible))
+  {
+    s->visible = visible;
+    s->changed = true;
+  }
+}
+
+void Arduino_SpriteEngine::setSpriteColorKey(int16_t id, uint16_t key)
+{
+  sprite_t *s = findSprite(id);
+  if ((s) && ((!s->use_key) || (s->key != key)))
+  {
+    s->use_key = true;
+    s->key = key;
+    s->changed = true;
+  }
+}
+
+void Arduino_SpriteEngine::clearSpriteColorKey(int16_t id)
+{
+  sprite_t *s = findSprite(id);
+  if ((s) && (s->use_key))
+  {
+    s->use_key = false;
+    s->changed = true;
+  }
+}
+
+// sprite state, e.g. for hit tests, nullptr if the id is not in use
+const sprite_t *Arduino_SpriteEngine::getSprite(int16_t id)
+{
+  return findSprite(id);
+}
+
+void Arduino_SpriteEngine::setBackground(uint16_t color)
+{
+  if (_bg != color)
+  {
+    _bg = color;
+    addDirtyRect(0, 0, _width, _height);
+  }
+}
+
+// RGB565 background bitmap at (0, 0), the background color shows outside it, nullptr for none
+void Arduino_SpriteEngine::setBackgroundBitmap(const uint16_t *bitmap, int16_t w, int16_t h)
+{
+  _bg_bitmap = bitmap;
+  _bg_palette = nullptr;
+  _bg_w = w;
+  _bg_h = h;
+  addDirtyRect(0, 0, _width, _height);
+}
+
+// 8-bit indexed background bitmap at (0, 0), the background color shows outside it, nullptr for none
+void Arduino_SpriteEngine::setBackgroundIndexedBitmap(const uint8_t *bitmap, const uint16_t *palette, int16_t w, int16_t h)
+{
+  _bg_bitmap = bitmap;
+  _bg_palette = palette;
+  _bg_w = w;
+  _bg_h = h;
+  addDirtyRect(0, 0, _width, _height);
+}
+
+// mark a screen region for the next flush(), e.g. after changing the background bitmap content
+void Arduino_SpriteEngine::markDirty(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  addDirtyRect(x, y, w, h);
+}
+
+uint8_t Arduino_SpriteEngine::getSpriteCount()
+{
+  return _sprite_count;
+}
+
+sprite_t *Arduino_SpriteEngine::findSprite(int16_t id)
+{
+  if ((id < 0) || (id >= SPRITE_MAX_SPRITES) || (!_sprites[id].used))
+  {
+    return nullptr;
+  }
+  return _sprites + id;
+}
+
+int16_t Arduino_SpriteEngine::addSpriteEntry(const void *bitmap, const uint16_t *palette, uint8_t type, int16_t w, int16_t h, int16_t x, int16_t y, int8_t z,
+                                             uint16_t frames, int16_t stride, int32_t frame_step)
+{
+  if ((!bitmap) || (w <= 0) || (h <= 0))
+  {
+    return GFX_NOT_DEFINED;
+  }
+  for (uint8_t id = 0; id < SPRITE_MAX_SPRITES; ++id)
+  {
+    sprite_t *s = _sprites + id;
+    if (!s->used)
+    {
+      s->bitmap = bitmap;
+      s->palette = palette;
+      s->type = type;
+      s->x = x;
+      s->y = y;
+      s->w = w;
+      s->h = h;
+      s->stride = stride ? stride : w;
+      s->frame_step = frame_step ? frame_step : ((int32_t)s->stride * h);
+      s->frames = frames ? frames : 1;
+      s->frame = 0;
+      s->z = z;
+      s->used = true;
+      s->visible = true;
+      s->use_key = false;
+      s->key = 0;
+      s->changed = true;
+      s->drawn = false;
+      insertOrder(id);
+      return id;
+    }
+  }
+  return GFX_NOT_DEFINED;
+}
+
+// insert above all sprites of the same or lower z
+void Arduino_SpriteEngine::insertOrder(uint8_t id)
+{
+  uint8_t j = _sprite_count++;
+  while ((j > 0) && (_sprites[_order[j - 1]].z > _sprites[id].z))
+  {
+    _order[j] = _order[j - 1];
+    --j;
+  }
+  _order[j] = id;
+}
+
+void Arduino_SpriteEngine::removeOrder(uint8_t id)
+{
+  uint8_t j = 0;
+  while ((j < _sprite_count) && (_order[j] != id))
+  {
+    ++j;
+  }
+  if (j < _sprite_count)
+  {
+    --_sprite_count;
+    for (; j < _sprite_count; ++j)
+    {
+      _order[j] = _order[j + 1];
+    }
+  }
+}
+
+// add the old and new rect of each changed sprite, a sprite moved by a few pixels merges into their union
+void Arduino_SpriteEngine::collectDirty()
+{
+  for (uint8_t i = 0; i < _sprite_count; ++i)
+  {
+    sprite_t *s = _sprites + _order[i];
+    if (s->changed)
+    {
+      if (s->drawn)
+      {
+        addDirtyRect(s->drawn_x, s->drawn_y, s->w, s->h);
+      }
+      if (s->visible)
+      {
+        addDirtyRect(s->x, s->y, s->w, s->h);
+      }
+      s->changed = false;
+    }
+    s->drawn = s->visible;
+    s->drawn_x = s->x;
+    s->drawn_y = s->y;
+  }
+}
+
+uint8_t Arduino_SpriteEngine::getItemCount()
+{
+  return _sprite_count;
+}
+
+bool Arduino_SpriteEngine::getItemRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w, int16_t *h)
+{
+  sprite_t *s = _sprites + _order[i];
+  *x = s->x;
+  *y = s->y;
+  *w = s->w;
+  *h = s->h;
+  return s->visible;
+}
+
+// an unkeyed sprite hides what is below
+bool Arduino_SpriteEngine::isItemOpaque(uint8_t i)
+{
+  return !_sprites[_order[i]].use_key;
+}
+
+// fill the buffer of a screen region with the background, buffer stride is the region width
+void Arduino_SpriteEngine::composeBackground(uint16_t *buf, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  int16_t w = x2 - x1 + 1;
+  int16_t r = _bg_bitmap ? min(x2, (int16_t)(_bg_w - 1)) : -1;
+  int16_t b = _bg_bitmap ? min(y2, (int16_t)(_bg_h - 1)) : -1;
+  if ((r < x2) || (b < y2))
+  {
+    gfx_fill_16bit(buf, _bg, (uint32_t)w * (y2 - y1 + 1));
+  }
+  if ((x1 > r) || (y1 > b))
+  {
+    return;
+  }
+
+  int16_t bw = r - x1 + 1;
+  int16_t bh = b - y1 + 1;
+  if (!_bg_palette)
+  {
+    gfx_copy_rect_16bit(buf, w, ((const uint16_t *)_bg_bitmap) + ((int32_t)y1 * _bg_w) + x1, _bg_w, bw, bh);
+    return;
+  }
+  const uint8_t *src = ((const uint8_t *)_bg_bitmap) + ((int32_t)y1 * _bg_w) + x1;
+  for (int16_t j = 0; j < bh; ++j)
+  {
+    for (int16_t i = 0; i < bw; ++i)
+    {
+      buf[i] = _bg_palette[src[i]];
+    }
+    buf += w;
+    src += _bg_w;
+  }
+}
+
+/**************************************************************************/
+/*!
+  @brief  Draw the part of a sprite inside a screen region over the buffer
+  @param  item    Sprite index in stacking order
+  @param  buf     Buffer position of (x1, y1)
+  @param  stride  Buffer pixels per row
+  @param  x1      Left x coordinate on screen, inside the sprite
+  @param  y1      Top y coordinate on screen, inside the sprite
+  @param  x2      Right x coordinate, inclusive
+  @param  y2      Bottom y coordinate, inclusive
+*/
+/**************************************************************************/
+void Arduino_SpriteEngine::composeItemRows(uint8_t item, uint16_t *buf, int16_t stride, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
+{
+  sprite_t *s = _sprites + _order[item];
+  int16_t w = x2 - x1 + 1;
+  int16_t h = y2 - y1 + 1;
+  int32_t offset = ((int32_t)s->frame * s->frame_step) + ((int32_t)(y1 - s->y) * s->stride) + (x1 - s->x);
+
+  if (s->type == SPRITE_RGB565)
+  {
+    const uint16_t *src = ((const uint16_t *)s->bitmap) + offset;
+    if (!s->use_key)
+    {
+      gfx_copy_rect_16bit(buf, stride, src, s->stride, w, h);
+      return;
+    }
+    uint16_t key = s->key;
+    for (int16_t j = 0; j < h; ++j)
+    {
+      for (int16_t i = 0; i < w; ++i)
+      {
+        if (src[i] != key)
+        {
+          buf[i] = src[i];
+        }
+      }
+      buf += stride;
+      src += s->stride;
+    }
+  }
+  else // SPRITE_INDEXED
+  {
+    const uint8_t *src = ((const uint8_t *)s->bitmap) + offset;
+    const uint16_t *palette = s->palette;
+    // an index past the palette never matches, unkeyed sprites draw every pixel
+    uint16_t key = s->use_key ? s->key : 256;
+    for (int16_t j = 0; j < h; ++j)
+    {
+      for (int16_t i = 0; i < w; ++i)
+      {
+        if (src[i] != key)
+        {
+          buf[i] = palette[src[i]];
+        }
+      }
+      buf += stride;
+      src += s->stride;
+    }
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
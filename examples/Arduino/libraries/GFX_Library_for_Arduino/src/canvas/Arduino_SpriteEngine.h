@@ -0,0 +1,111 @@
+#include "../Arduino_DataBus.h"
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef _ARDUINO_SPRITEENGINE_H_
+#define _ARDUINO_SPRITEENGINE_H_
+
+#include "../Arduino_GFX.h"
+#include "Arduino_Canvas.h"
+#include "Arduino_DirtyRects.h"
+
+#ifndef SPRITE_MAX_SPRITES
+#define SPRITE_MAX_SPRITES 64
+#endif
+#ifndef SPRITE_MAX_DIRTY_RECTS
+#define SPRITE_MAX_DIRTY_RECTS 32
+#endif
+#ifndef SPRITE_BUF_PIXELS
+#define SPRITE_BUF_PIXELS 4096 // composition buffer, at least one screen row is allocated
+#endif
+
+typedef enum
+{
+  SPRITE_RGB565,
+  SPRITE_INDEXED,
+} sprite_type_t;
+
+typedef struct
+{
+  const void *bitmap;      // first frame, uint16_t for RGB565 and uint8_t for indexed sprites
+  const uint16_t *palette; // indexed sprites
+  uint8_t type;            // sprite_type_t
+  int16_t x, y;            // position on screen
+  int16_t w, h;
+  int16_t stride;     // bitmap pixels per row
+  int32_t frame_step; // bitmap pixels from one frame to the next
+  uint16_t frames, frame;
+  int8_t z; // higher is on top, same z keeps the order of adding
+  bool used;
+  bool visible;
+  bool use_key;
+  uint16_t key; // RGB565 color not drawn, palette index for indexed sprites
+
+  // state of the previous flush()
+  bool changed;
+  bool drawn;
+  int16_t drawn_x, drawn_y;
+} sprite_t;
+
+/// Draws sprites over a background and sends only the regions changed since the previous flush():
+/// the old and new rectangle of each moved, animated or restacked sprite.
+/// Each region is composed in a small buffer and sent once, the panel needs no framebuffer.
+/// Sprite bitmaps are not copied and must stay valid while in use.
+class Arduino_SpriteEngine : public Arduino_DirtyComposer
+{
+public:
+  Arduino_SpriteEngine(int16_t w, int16_t h, Arduino_G *output, int16_t output_x = 0, int16_t output_y = 0);
+
+  int16_t addSprite(const uint16_t *bitmap, int16_t w, int16_t h, int16_t x, int16_t y, int8_t z = 0,
+                    uint16_t frames = 1, int16_t stride = 0, int32_t frame_step = 0);
+  int16_t addIndexedSprite(const uint8_t *bitmap, const uint16_t *palette, int16_t w, int16_t h, int16_t x, int16_t y, int8_t z = 0,
+                           uint16_t frames = 1, int16_t stride = 0, int32_t frame_step = 0);
+  void removeSprite(int16_t id);
+
+  void setSpritePosition(int16_t id, int16_t x, int16_t y);
+  void moveSprite(int16_t id, int16_t dx, int16_t dy);
+  void setSpriteFrame(int16_t id, uint16_t frame);
+  void nextSpriteFrame(int16_t id);
+  void setSpriteZ(int16_t id, int8_t z);
+  void setSpriteVisible(int16_t id, bool visible);
+  void setSpriteColorKey(int16_t id, uint16_t key);
+  void clearSpriteColorKey(int16_t id);
+  const sprite_t *getSprite(int16_t id);
+
+  void setBackground(uint16_t color);
+  void setBackgroundBitmap(const uint16_t *bitmap, int16_t w, int16_t h);
+  void setBackgroundIndexedBitmap(const uint8_t *bitmap, const uint16_t *palette, int16_t w, int16_t h);
+  void markDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  uint8_t getSpriteCount();
+
+protected:
+  sprite_t *findSprite(int16_t id);
+  int16_t addSpriteEntry(const void *bitmap, const uint16_t *palette, uint8_t type, int16_t w, int16_t h, int16_t x, int16_t y, int8_t z,
+                         uint16_t frames, int16_t stride, int32_t frame_step);
+  void insertOrder(uint8_t id);
+  void removeOrder(uint8_t id);
+  void collectDirty() override;
+  uint8_t getItemCount() override;
+  bool getItemRect(uint8_t i, int16_t *x, int16_t *y, int16_t *w, int16_t *h) override;
+  bool isItemOpaque(uint8_t i) override;
+  void composeBackground(uint16_t *buf, int16_t x1, int16_t y1, int16_t x2, int16_t y2) override;
+  void composeItemRows(uint8_t item, uint16_t *buf, int16_t stride, int16_t x1, int16_t y1, int16_t x2, int16_t y2) override;
+
+  // background color, with a bitmap at (0, 0) on top if set
+  uint16_t _bg = 0;
+  const void *_bg_bitmap = nullptr;
+  const uint16_t *_bg_palette = nullptr; // indexed background bitmap
+  int16_t _bg_w = 0, _bg_h = 0;
+
+  sprite_t _sprites[SPRITE_MAX_SPRITES];
+  uint8_t _order[SPRITE_MAX_SPRITES]; // sprite id from bottom to top
+  uint8_t _sprite_count = 0;
+
+  canvas_dirty_rect_t _dirty_rect_list[SPRITE_MAX_DIRTY_RECTS]; // never overlapping
+
+private:
+};
+
+#endif // _ARDUINO_SPRITEENGINE_H_
+
+#endif // !defined(LITTLE_FOOT_PRINT)
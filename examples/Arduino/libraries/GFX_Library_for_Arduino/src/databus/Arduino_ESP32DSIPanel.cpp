@@ -105,4 +105,33 @@ uint16_t *Arduino_ESP32DSIPanel::getFrameBuffer()
   return ((uint16_t *)frame_buffer);
 }
 
+/**
+ * Call cb from the interrupt each time the DPI has sent a whole frame out of the framebuffer, after begin().
+ * nullptr removes the callback.
+ */
+bool Arduino_ESP32DSIPanel::setVSyncCallback(gfx_vsync_cb_t cb, void *user_ctx)
+{
+  if (!_panel_handle)
+  {
+    return false;
+  }
+  _vsync_cb = cb;
+  _vsync_user_ctx = user_ctx;
+
+  esp_lcd_dpi_panel_event_callbacks_t cbs = {};
+  if (cb)
+  {
+    cbs.on_refresh_done = onRefreshDone;
+  }
+  return esp_lcd_dpi_panel_register_event_callbacks(_panel_handle, &cbs, this) == ESP_OK;
+}
+
+bool IRAM_ATTR Arduino_ESP32DSIPanel::onRefreshDone(esp_lcd_panel_handle_t panel, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+{
+  UNUSED(panel);
+  UNUSED(edata);
+  Arduino_ESP32DSIPanel *dsipanel = (Arduino_ESP32DSIPanel *)user_ctx;
+  return dsipanel->_vsync_cb(dsipanel->_vsync_user_ctx);
+}
+
 #endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
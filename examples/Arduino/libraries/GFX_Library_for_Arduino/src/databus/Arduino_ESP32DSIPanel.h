@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Arduino_DataBus.h"
+#include "../Arduino_FrameSync.h"
 
 #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
 
@@ -43,9 +44,12 @@ public:
   bool begin(int16_t w, int16_t h, int32_t speed = GFX_NOT_DEFINED, const lcd_init_cmd_t *init_operations = NULL, size_t init_operations_len = GFX_NOT_DEFINED);
 
   uint16_t *getFrameBuffer();
+  bool setVSyncCallback(gfx_vsync_cb_t cb, void *user_ctx);
 
 protected:
 private:
+  static bool onRefreshDone(esp_lcd_panel_handle_t panel, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx);
+
   uint32_t _hsync_pulse_width;
   uint32_t _hsync_back_porch;
   uint32_t _hsync_front_porch;
@@ -56,6 +60,8 @@ private:
   uint32_t _lane_bit_rate; // 新增成员变量
 
   esp_lcd_panel_handle_t _panel_handle = NULL;
+  gfx_vsync_cb_t _vsync_cb = NULL;
+  void *_vsync_user_ctx = NULL;
 };
 
 #endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
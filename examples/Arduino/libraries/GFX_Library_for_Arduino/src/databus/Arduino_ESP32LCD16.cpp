@@ -9,6 +9,16 @@
 
 #define WAIT_LCD_NOT_BUSY while (LCD_CAM.lcd_user.val & LCD_CAM_LCD_START)
 
+// pixels of the next DMA chunk, never leaving a remainder too short for DMA
+static inline uint32_t dma_chunk_len(uint32_t len)
+{
+  if (len <= LCD_MAX_PIXELS_AT_ONCE)
+  {
+    return len;
+  }
+  return ((len - LCD_MAX_PIXELS_AT_ONCE) > USE_DMA_THRESHOLD) ? LCD_MAX_PIXELS_AT_ONCE : (len - USE_DMA_THRESHOLD - 1);
+}
+
 Arduino_ESP32LCD16::Arduino_ESP32LCD16(
     int8_t dc, int8_t cs, int8_t wr, int8_t rd,
     int8_t d0, int8_t d1, int8_t d2, int8_t d3, int8_t d4, int8_t d5, int8_t d6, int8_t d7,
@@ -154,6 +164,7 @@ bool Arduino_ESP32LCD16::begin(int32_t speed, int8_t dataMode)
 
 void Arduino_ESP32LCD16::beginWrite()
 {
+  WAIT_ASYNC();
   CS_LOW();
 
   LCD_CAM.lcd_misc.val = LCD_CAM_LCD_CD_IDLE_EDGE;
@@ -163,6 +174,7 @@ void Arduino_ESP32LCD16::beginWrite()
 
 void Arduino_ESP32LCD16::endWrite()
 {
+  WAIT_ASYNC();
   WAIT_LCD_NOT_BUSY;
 
   CS_HIGH();
@@ -180,6 +192,7 @@ void Arduino_ESP32LCD16::writeCommand16(uint16_t c)
 
 void Arduino_ESP32LCD16::writeCommandBytes(uint8_t *data, uint32_t len)
 {
+  WAIT_ASYNC();
   LCD_CAM.lcd_misc.val = LCD_CAM_LCD_CD_IDLE_EDGE | LCD_CAM_LCD_CD_CMD_SET;
 
   while (len--)
@@ -212,53 +225,117 @@ void Arduino_ESP32LCD16::writeRepeat(uint16_t p, uint32_t len)
   }
   else
   {
-    uint32_t bufLen = (len < LCD_MAX_PIXELS_AT_ONCE) ? len : LCD_MAX_PIXELS_AT_ONCE;
-    uint32_t xferLen, l;
-    uint32_t c32 = p * 0x10001;
+    writeRepeatAsync(p, len);
+    WAIT_ASYNC();
+  }
+}
 
-    l = (bufLen + 1) / 2;
-    for (uint32_t i = 0; i < l; i++)
+void Arduino_ESP32LCD16::writePixels(uint16_t *data, uint32_t len)
+{
+  if (len > USE_DMA_THRESHOLD)
+  {
+    writePixelsAsync(data, len);
+    WAIT_ASYNC();
+  }
+  else
+  {
+    while (len--)
     {
-      _buffer32[i] = c32;
+      WRITE16(*data++);
     }
+  }
+}
 
-    while (len) // While pixels remain
-    {
-      xferLen = (bufLen <= len) ? bufLen : len; // How many this pass?
+/**
+ * @brief writeRepeatAsync, returns once the last block is started,
+ *   it is finished by the next bus call, isTransferDone() or waitWriteDone(), cb is called from there
+ *
+ * @param p
+ * @param len
+ * @param cb
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32LCD16::writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if (len < USE_DMA_THRESHOLD)
+  {
+    return Arduino_DataBus::writeRepeatAsync(p, len, cb, user_ctx);
+  }
 
-      l = (xferLen - 2) * 2;
-      *(uint32_t *)_dmadesc = ((l + 3) & (~3)) | l << 12 | 0xC0000000;
-      _dmadesc->buffer = _buffer;
-      _dmadesc->next = nullptr;
-      gdma_start(_dma_chan, (intptr_t)(_dmadesc));
-      LCD_CAM.lcd_misc.val = LCD_CAM_LCD_CD_IDLE_EDGE;
-      LCD_CAM.lcd_cmd_val.val = c32;
+  WAIT_ASYNC(); // _buffer may still be sent
+  gfx_transfer_t transfer = nextTransfer();
+  uint32_t bufLen = dma_chunk_len(len);
+  uint32_t xferLen, l;
+  uint32_t c32 = p * 0x10001;
 
-      uint32_t wait = _fast_wait;
-      if (wait > 0)
+  l = (bufLen + 1) / 2;
+  for (uint32_t i = 0; i < l; i++)
+  {
+    _buffer32[i] = c32;
+  }
+
+  while (len) // While pixels remain
+  {
+    xferLen = dma_chunk_len(len); // How many this pass?
+
+    l = (xferLen - 2) * 2;
+    *(uint32_t *)_dmadesc = ((l + 3) & (~3)) | l << 12 | 0xC0000000;
+    _dmadesc->buffer = _buffer;
+    _dmadesc->next = nullptr;
+    gdma_start(_dma_chan, (intptr_t)(_dmadesc));
+    LCD_CAM.lcd_misc.val = LCD_CAM_LCD_CD_IDLE_EDGE;
+    LCD_CAM.lcd_cmd_val.val = c32;
+
+    uint32_t wait = _fast_wait;
+    if (wait > 0)
+    {
+      do
       {
-        do
-        {
-          __asm__ __volatile__("nop");
-        } while (--wait);
-      }
+        __asm__ __volatile__("nop");
+      } while (--wait);
+    }
 
-      len -= xferLen;
+    len -= xferLen;
 
-      LCD_CAM.lcd_user.val = LCD_CAM_LCD_ALWAYS_OUT_EN | LCD_CAM_LCD_2BYTE_EN | LCD_CAM_LCD_CMD_2_CYCLE_EN | LCD_CAM_LCD_DOUT | LCD_CAM_LCD_CMD | LCD_CAM_LCD_UPDATE_REG | LCD_CAM_LCD_START;
+    LCD_CAM.lcd_user.val = LCD_CAM_LCD_ALWAYS_OUT_EN | LCD_CAM_LCD_2BYTE_EN | LCD_CAM_LCD_CMD_2_CYCLE_EN | LCD_CAM_LCD_DOUT | LCD_CAM_LCD_CMD | LCD_CAM_LCD_UPDATE_REG | LCD_CAM_LCD_START;
 
+    if (len)
+    {
       WAIT_LCD_NOT_BUSY;
     }
   }
+
+  _async_transfer = transfer;
+  _async_cb = cb;
+  _async_ctx = user_ctx;
+  return transfer;
 }
 
-void Arduino_ESP32LCD16::writePixels(uint16_t *data, uint32_t len)
+/**
+ * @brief writePixelsAsync, pixels are sent in place, data must be unchanged until the transfer is done,
+ *   it is finished by the next bus call, isTransferDone() or waitWriteDone(), cb is called from there
+ *
+ * @param data
+ * @param len
+ * @param cb
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32LCD16::writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
 {
+  if (len <= USE_DMA_THRESHOLD)
+  {
+    return Arduino_DataBus::writePixelsAsync(data, len, cb, user_ctx);
+  }
+
+  WAIT_ASYNC();
+  gfx_transfer_t transfer = nextTransfer();
   uint32_t xferLen, l;
 
-  while (len > USE_DMA_THRESHOLD) // While pixels remain
+  while (len) // While pixels remain
   {
-    xferLen = (len < LCD_MAX_PIXELS_AT_ONCE) ? len : LCD_MAX_PIXELS_AT_ONCE; // How many this pass?
+    xferLen = dma_chunk_len(len); // How many this pass?
     _data32.value16 = *data++;
     _data32.value16_2 = *data++;
 
@@ -282,12 +359,41 @@ void Arduino_ESP32LCD16::writePixels(uint16_t *data, uint32_t len)
 
     LCD_CAM.lcd_user.val = LCD_CAM_LCD_ALWAYS_OUT_EN | LCD_CAM_LCD_2BYTE_EN | LCD_CAM_LCD_CMD_2_CYCLE_EN | LCD_CAM_LCD_DOUT | LCD_CAM_LCD_CMD | LCD_CAM_LCD_UPDATE_REG | LCD_CAM_LCD_START;
 
-    WAIT_LCD_NOT_BUSY;
+    if (len)
+    {
+      WAIT_LCD_NOT_BUSY;
+    }
   }
 
-  while (len--)
+  _async_transfer = transfer;
+  _async_cb = cb;
+  _async_ctx = user_ctx;
+  return transfer;
+}
+
+bool Arduino_ESP32LCD16::isTransferDone(gfx_transfer_t transfer)
+{
+  if (_async_transfer && !(LCD_CAM.lcd_user.val & LCD_CAM_LCD_START))
+  {
+    finishAsync();
+  }
+  return Arduino_DataBus::isTransferDone(transfer);
+}
+
+void Arduino_ESP32LCD16::waitWriteDone()
+{
+  WAIT_ASYNC();
+}
+
+void Arduino_ESP32LCD16::finishAsync()
+{
+  gfx_write_done_cb_t cb = _async_cb;
+  _transfer_done = _async_transfer;
+  _async_transfer = 0;
+  _async_cb = nullptr;
+  if (cb)
   {
-    WRITE16(*data++);
+    cb(_async_ctx);
   }
 }
 
@@ -325,6 +431,7 @@ void Arduino_ESP32LCD16::writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2)
 
 void Arduino_ESP32LCD16::writeBytes(uint8_t *data, uint32_t len)
 {
+  WAIT_ASYNC();
   uint32_t xferLen, l;
 
   while (len > (USE_DMA_THRESHOLD * 2)) // While pixels remain
@@ -382,6 +489,7 @@ void Arduino_ESP32LCD16::writeBytes(uint8_t *data, uint32_t len)
 
 void Arduino_ESP32LCD16::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len)
 {
+  WAIT_ASYNC();
   uint32_t xferLen, l;
   uint32_t p;
 
@@ -426,6 +534,7 @@ void Arduino_ESP32LCD16::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32
 
 void Arduino_ESP32LCD16::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len)
 {
+  WAIT_ASYNC();
   len <<= 1; // double length
   uint32_t xferLen, l;
   uint32_t p;
@@ -477,6 +586,8 @@ void Arduino_ESP32LCD16::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8
   }
   else
   {
+    WAIT_ASYNC();
+
     int cols = w >> 1;
     int rows = h >> 1;
     uint8_t *yData2 = yData + w;
@@ -554,8 +665,18 @@ void Arduino_ESP32LCD16::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8
   }
 }
 
+GFX_INLINE void Arduino_ESP32LCD16::WAIT_ASYNC()
+{
+  if (_async_transfer)
+  {
+    WAIT_LCD_NOT_BUSY;
+    finishAsync();
+  }
+}
+
 GFX_INLINE void Arduino_ESP32LCD16::WRITECOMMAND16(uint16_t c)
 {
+  WAIT_ASYNC();
   LCD_CAM.lcd_misc.val = LCD_CAM_LCD_CD_IDLE_EDGE | LCD_CAM_LCD_CD_CMD_SET;
   LCD_CAM.lcd_cmd_val.val = c;
   WAIT_LCD_NOT_BUSY;
@@ -564,6 +685,7 @@ GFX_INLINE void Arduino_ESP32LCD16::WRITECOMMAND16(uint16_t c)
 
 GFX_INLINE void Arduino_ESP32LCD16::WRITE16(uint16_t d)
 {
+  WAIT_ASYNC();
   LCD_CAM.lcd_misc.val = LCD_CAM_LCD_CD_IDLE_EDGE;
   LCD_CAM.lcd_cmd_val.val = d;
   WAIT_LCD_NOT_BUSY;
@@ -572,6 +694,7 @@ GFX_INLINE void Arduino_ESP32LCD16::WRITE16(uint16_t d)
 
 GFX_INLINE void Arduino_ESP32LCD16::WRITE32(uint32_t d)
 {
+  WAIT_ASYNC();
   LCD_CAM.lcd_misc.val = LCD_CAM_LCD_CD_IDLE_EDGE;
   LCD_CAM.lcd_cmd_val.val = d;
   WAIT_LCD_NOT_BUSY;
@@ -41,8 +41,15 @@ public:
   void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
   void writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_t *crData, uint16_t w, uint16_t h) override;
 
+  gfx_transfer_t writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  bool isTransferDone(gfx_transfer_t transfer) override;
+  void waitWriteDone() override;
+
 protected:
 private:
+  GFX_INLINE void WAIT_ASYNC();
+  void finishAsync();
   GFX_INLINE void WRITECOMMAND16(uint16_t c);
   GFX_INLINE void WRITE16(uint16_t d);
   GFX_INLINE void WRITE32(uint32_t d);
@@ -58,6 +65,11 @@ private:
   uint32_t _csPinMask;  ///< Bitmask
 
   uint32_t _fast_wait;
+  // the async write still sent by DMA, there is no completion interrupt so it is finished by polling
+  gfx_transfer_t _async_transfer = 0;
+  gfx_write_done_cb_t _async_cb = nullptr;
+  void *_async_ctx = nullptr;
+
   esp_lcd_i80_bus_handle_t _i80_bus = nullptr;
   dma_descriptor_t *_dmadesc = nullptr;
   gdma_channel_handle_t _dma_chan;
@@ -151,7 +151,11 @@ bool Arduino_ESP32LCD8::begin(int32_t speed, int8_t dataMode)
   LCD_CAM.lcd_clock.val = lcd_clock.val;
 
   _dma_chan = _i80_bus->dma_chan;
-  _dmadesc = (dma_descriptor_t *)heap_caps_malloc(sizeof(dma_descriptor_t), MALLOC_CAP_DMA);
+  _dmadesc = (dma_descriptor_t *)heap_caps_malloc(sizeof(dma_descriptor_t) * LCD_DMA_DESC_COUNT, MALLOC_CAP_DMA);
+  if (!_dmadesc)
+  {
+    return false;
+  }
 
   _buffer = (uint8_t *)heap_caps_aligned_alloc(16, LCD_MAX_PIXELS_AT_ONCE * 2, MALLOC_CAP_DMA);
   if (!_buffer)
@@ -515,9 +519,11 @@ void Arduino_ESP32LCD8::writeBytes(uint8_t *data, uint32_t len)
 
   if (esp_ptr_dma_capable(data))
   {
+    dma_descriptor_t *desc;
+    uint32_t dl;
     while (len > (USE_DMA_THRESHOLD << 1)) // While pixels remain
     {
-      xferLen = (len >= LCD_MAX_PIXELS_AT_ONCE << 1) ? (LCD_MAX_PIXELS_AT_ONCE << 1) : len; // How many this pass?
+      xferLen = (len >= LCD_MAX_DMA_BYTES) ? LCD_MAX_DMA_BYTES : len; // How many this pass?
 
       _data32.value = 0;
       _data32.lsb = *data++;
@@ -531,20 +537,30 @@ void Arduino_ESP32LCD8::writeBytes(uint8_t *data, uint32_t len)
       _data32.lsb = *data++;
       _data32.lsb_2 = *data++;
 
+      // link descriptors over the caller's buffer, EOF on the last one
       l = xferLen - 4;
-      *(uint32_t *)_dmadesc = ((l + 3) & (~3)) | l << 12 | 0xC0000000;
-      _dmadesc->buffer = data;
-      _dmadesc->next = nullptr;
+      desc = _dmadesc;
+      while (l)
+      {
+        dl = (l > LCD_DMA_DESC_BYTES) ? LCD_DMA_DESC_BYTES : l;
+        l -= dl;
+        *(uint32_t *)desc = ((dl + 3) & (~3)) | dl << 12 | (l ? 0x80000000 : 0xC0000000);
+        desc->buffer = data;
+        desc->next = l ? (desc + 1) : nullptr;
+        data += dl;
+        ++desc;
+      }
       gdma_start(_dma_chan, (intptr_t)(_dmadesc));
       LCD_CAM.lcd_cmd_val.val = _data32.value;
       LCD_CAM.lcd_user.val = LCD_CAM_LCD_ALWAYS_OUT_EN | LCD_CAM_LCD_DOUT | LCD_CAM_LCD_CMD | LCD_CAM_LCD_CMD_2_CYCLE_EN | LCD_CAM_LCD_UPDATE_REG;
 
-      data += xferLen - 4;
       len -= xferLen;
 
       WAIT_LCD_NOT_BUSY;
       LCD_CAM.lcd_user.val = LCD_CAM_LCD_ALWAYS_OUT_EN | LCD_CAM_LCD_DOUT | LCD_CAM_LCD_CMD | LCD_CAM_LCD_CMD_2_CYCLE_EN | LCD_CAM_LCD_START;
     }
+    // the caller may change its buffer after return
+    WAIT_LCD_NOT_BUSY;
   }
   else
   {
@@ -613,6 +629,16 @@ void Arduino_ESP32LCD8::writeBytes(uint8_t *data, uint32_t len)
   }
 }
 
+/**
+ * @brief waitWriteDone, the LCD peripheral has no completion interrupt here,
+ *   writeBytesAsync() sends at once
+ *
+ */
+void Arduino_ESP32LCD8::waitWriteDone()
+{
+  WAIT_LCD_NOT_BUSY;
+}
+
 /**
  * @brief writeIndexedPixels
  *
@@ -767,6 +793,11 @@ bool Arduino_ESP32LCD8::begin(int32_t speed, int8_t dataMode)
     _speed = speed;
   }
 
+  if (!_color_done_sem)
+  {
+    _color_done_sem = xSemaphoreCreateBinary();
+  }
+
   if (_cs != GFX_NOT_DEFINED)
   {
     pinMode(_cs, OUTPUT);
@@ -788,7 +819,7 @@ bool Arduino_ESP32LCD8::begin(int32_t speed, int8_t dataMode)
       .clk_src = LCD_CLK_SRC_PLL160M, // ??? LCD_CLK_SRC_DEFAULT,
       .data_gpio_nums = {_d0, _d1, _d2, _d3, _d4, _d5, _d6, _d7},
       .bus_width = 8,
-      .max_transfer_bytes = LCD_MAX_PIXELS_AT_ONCE * 2,
+      .max_transfer_bytes = LCD_MAX_DMA_BYTES,
       .dma_burst_size = 64,
       // .sram_trans_align = 4
   };
@@ -800,8 +831,8 @@ bool Arduino_ESP32LCD8::begin(int32_t speed, int8_t dataMode)
       .cs_gpio_num = _cs,
       .pclk_hz = _speed,
       .trans_queue_depth = 10,
-      // on_color_trans_done = nullptr,
-      // user_ctx = nullptr,
+      .on_color_trans_done = color_trans_done_cb,
+      .user_ctx = this,
       .lcd_cmd_bits = 8,
       .lcd_param_bits = 8,
       .dc_levels = {
@@ -890,6 +921,10 @@ void Arduino_ESP32LCD8::writeCommandBytes(uint8_t *data, uint32_t len)
  */
 void Arduino_ESP32LCD8::write(uint8_t d)
 {
+  if (!_bufferLen)
+  {
+    WAIT_BUFFER();
+  }
   _buffer[_bufferLen++] = d;
   if (_bufferLen >= LCD_MAX_PIXELS_AT_ONCE * 2)
   {
@@ -903,6 +938,10 @@ void Arduino_ESP32LCD8::write(uint8_t d)
  */
 void Arduino_ESP32LCD8::write16(uint16_t d)
 {
+  if (!_bufferLen)
+  {
+    WAIT_BUFFER();
+  }
   _data16.value = d;
   _buffer[_bufferLen++] = _data16.msb;
   _buffer[_bufferLen++] = _data16.lsb;
@@ -965,6 +1004,106 @@ void Arduino_ESP32LCD8::writePixels(uint16_t *data, uint32_t len)
   }
 }
 
+/**
+ * @brief writeRepeatAsync, the last chunk is sent in the background
+ *
+ * @param p
+ * @param len
+ * @param cb called from the LCD interrupt when the last pixel is sent
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32LCD8::writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if (!len)
+  {
+    return syncTransferDone(cb, user_ctx);
+  }
+
+  _isColor = true;
+  gfx_transfer_t transfer = nextTransfer();
+  uint8_t hi = p >> 8, lo = p;
+  uint32_t l;
+  uint8_t *b;
+  while (len)
+  {
+    if (!_bufferLen)
+    {
+      WAIT_BUFFER();
+    }
+    l = (LCD_MAX_PIXELS_AT_ONCE * 2 - _bufferLen) >> 1;
+    if (l > len)
+    {
+      l = len;
+    }
+    b = _buffer + _bufferLen;
+    _bufferLen += l << 1;
+    len -= l;
+    while (l--)
+    {
+      *b++ = hi;
+      *b++ = lo;
+    }
+    if (!len)
+    {
+      queueWriteDone(transfer, cb, user_ctx);
+    }
+    flushBuffer();
+  }
+  return transfer;
+}
+
+/**
+ * @brief writePixelsAsync, pixels are copied to the buffer, data can be reused once the call returns,
+ *   the last chunk is sent in the background
+ *
+ * @param data
+ * @param len
+ * @param cb called from the LCD interrupt when the last pixel is sent
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32LCD8::writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if (!len)
+  {
+    return syncTransferDone(cb, user_ctx);
+  }
+
+  _isColor = true;
+  gfx_transfer_t transfer = nextTransfer();
+  uint32_t l;
+  uint8_t *b;
+  uint16_t d;
+  while (len)
+  {
+    if (!_bufferLen)
+    {
+      WAIT_BUFFER();
+    }
+    l = (LCD_MAX_PIXELS_AT_ONCE * 2 - _bufferLen) >> 1;
+    if (l > len)
+    {
+      l = len;
+    }
+    b = _buffer + _bufferLen;
+    _bufferLen += l << 1;
+    len -= l;
+    while (l--)
+    {
+      d = *data++;
+      *b++ = d >> 8;
+      *b++ = d;
+    }
+    if (!len)
+    {
+      queueWriteDone(transfer, cb, user_ctx);
+    }
+    flushBuffer();
+  }
+  return transfer;
+}
+
 /**
  * @brief write data bytes to the buffer
  * @param data array of data bytes
@@ -973,6 +1112,14 @@ void Arduino_ESP32LCD8::writePixels(uint16_t *data, uint32_t len)
 void Arduino_ESP32LCD8::writeBytes(uint8_t *data, uint32_t len)
 {
   // Serial.printf("  writeBytes( [...], %ld)\n", len);
+  if ((len > (USE_DMA_THRESHOLD << 1)) && esp_ptr_dma_capable(data))
+  {
+    // send in place
+    writeBytesAsync(data, len);
+    waitWriteDone();
+    return;
+  }
+
   // transfer in chunks
   while (len--)
   {
@@ -980,6 +1127,108 @@ void Arduino_ESP32LCD8::writeBytes(uint8_t *data, uint32_t len)
   }
 }
 
+/**
+ * @brief send DMA-capable data bytes without copying, after the pending command and buffer
+ * @param data array of data bytes, unchanged until cb is called
+ * @param len length of data array
+ * @param cb called from the LCD interrupt when the last byte is sent
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32LCD8::writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if ((!len) || (!esp_ptr_dma_capable(data)))
+  {
+    return Arduino_DataBus::writeBytesAsync(data, len, cb, user_ctx);
+  }
+
+  if (_bufferLen > 0)
+  {
+    flushBuffer();
+  }
+
+  gfx_transfer_t transfer = nextTransfer();
+  uint32_t l;
+  while (len)
+  {
+    l = (len > LCD_MAX_DMA_BYTES) ? LCD_MAX_DMA_BYTES : len;
+    len -= l;
+    if (!len)
+    {
+      queueWriteDone(transfer, cb, user_ctx);
+    }
+    ++_color_queued;
+    esp_lcd_panel_io_tx_color(_io_handle, _cmd, data, l);
+    _cmd = -1; // next time, we start a data send out without command.
+    data += l;
+  }
+  return transfer;
+}
+
+/**
+ * @brief send the buffered data and wait for all color transfers
+ */
+void Arduino_ESP32LCD8::waitWriteDone()
+{
+  if (_bufferLen > 0)
+  {
+    flushBuffer();
+  }
+  waitColorDone(_color_queued);
+}
+
+/**
+ * @brief WAIT_BUFFER
+ *
+ * @return GFX_INLINE
+ */
+GFX_INLINE void Arduino_ESP32LCD8::WAIT_BUFFER()
+{
+  waitColorDone(_buffer_busy_at);
+}
+
+/**
+ * @brief waitColorDone, sleep on the semaphore given by color_trans_done_cb() so other tasks keep running
+ *
+ * @param at color transfer number
+ */
+void Arduino_ESP32LCD8::waitColorDone(uint32_t at)
+{
+  while ((int32_t)(_color_done - at) < 0)
+  {
+    if (_color_done_sem)
+    {
+      xSemaphoreTake(_color_done_sem, portMAX_DELAY);
+    }
+    else
+    {
+      taskYIELD();
+    }
+  }
+}
+
+/**
+ * @brief queueWriteDone, must be called right before the color transfer that finishes the async write
+ *
+ * @param transfer
+ * @param cb
+ * @param user_ctx
+ */
+void Arduino_ESP32LCD8::queueWriteDone(gfx_transfer_t transfer, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  // wait for a free slot
+  while ((uint8_t)(_write_done_tail - _write_done_head) >= LCD_ASYNC_QUEUE_SIZE)
+  {
+    waitColorDone(_write_done[_write_done_head % LCD_ASYNC_QUEUE_SIZE].at);
+  }
+  uint8_t i = _write_done_tail % LCD_ASYNC_QUEUE_SIZE;
+  _write_done[i].at = _color_queued + 1;
+  _write_done[i].transfer = transfer;
+  _write_done[i].cb = cb;
+  _write_done[i].ctx = user_ctx;
+  _write_done_tail = _write_done_tail + 1;
+}
+
 /**
  * @brief writeIndexedPixels
  *
@@ -1035,6 +1284,8 @@ void Arduino_ESP32LCD8::flushBuffer()
     // if (_cmd == 0x2c9)
     {
       // async DMA transfer
+      ++_color_queued;
+      _buffer_busy_at = _color_queued;
       esp_lcd_panel_io_tx_color(_io_handle, _cmd, _buffer, _bufferLen);
     }
     else
@@ -1051,5 +1302,35 @@ void Arduino_ESP32LCD8::flushBuffer()
   }
 }
 
+/**
+ * @brief count finished color transfers, finish the async write waiting for this one
+ */
+bool IRAM_ATTR Arduino_ESP32LCD8::color_trans_done_cb(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+  Arduino_ESP32LCD8 *bus = (Arduino_ESP32LCD8 *)user_ctx;
+  uint32_t done = bus->_color_done + 1;
+  bus->_color_done = done;
+  uint8_t head = bus->_write_done_head;
+  if (head != bus->_write_done_tail)
+  {
+    uint8_t i = head % LCD_ASYNC_QUEUE_SIZE;
+    if (bus->_write_done[i].at == done)
+    {
+      bus->_transfer_done = bus->_write_done[i].transfer;
+      if (bus->_write_done[i].cb)
+      {
+        bus->_write_done[i].cb(bus->_write_done[i].ctx);
+      }
+      bus->_write_done_head = head + 1;
+    }
+  }
+  BaseType_t high_task_woken = pdFALSE;
+  if (bus->_color_done_sem)
+  {
+    xSemaphoreGiveFromISR(bus->_color_done_sem, &high_task_woken);
+  }
+  return high_task_woken == pdTRUE;
+}
+
 #endif // #if (!defined(ESP_ARDUINO_VERSION_MAJOR)) || (ESP_ARDUINO_VERSION_MAJOR < 3)
 #endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32S3)
@@ -10,9 +10,15 @@
 #ifndef USE_DMA_THRESHOLD
 #define USE_DMA_THRESHOLD 6
 #endif
+#ifndef LCD_MAX_DMA_BYTES
+#define LCD_MAX_DMA_BYTES (480 * 320 * 2) // bytes sent from a DMA-capable buffer in one transfer
+#endif
 
 #if (!defined(ESP_ARDUINO_VERSION_MAJOR)) || (ESP_ARDUINO_VERSION_MAJOR < 3)
 
+#define LCD_DMA_DESC_BYTES 4092 // a DMA descriptor points to at most 4095 bytes, keep word aligned
+#define LCD_DMA_DESC_COUNT ((LCD_MAX_DMA_BYTES + LCD_DMA_DESC_BYTES - 1) / LCD_DMA_DESC_BYTES)
+
 class Arduino_ESP32LCD8 : public Arduino_DataBus
 {
 public:
@@ -38,6 +44,7 @@ public:
   void writePixels(uint16_t *data, uint32_t len) override;
 
   void writeBytes(uint8_t *data, uint32_t len) override;
+  void waitWriteDone() override;
 
   void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
   void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
@@ -89,6 +96,10 @@ private:
 #include "esp_lcd_panel_io.h"
 #include <esp_private/gdma.h>
 #include <hal/dma_types.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#define LCD_ASYNC_QUEUE_SIZE 2 // async writes in flight, finished in order by color_trans_done_cb()
 
 // The Arduino_ESP32LCD8 bus can send bytes. Sending 16-bit commands is not supported.
 // Sending 16-bit pixel data is sending in msb,lsb order.
@@ -113,6 +124,10 @@ public:
   void writePixels(uint16_t *data, uint32_t len) override;
 
   void writeBytes(uint8_t *data, uint32_t len) override;
+  gfx_transfer_t writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  void waitWriteDone() override;
 
   void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
   void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
@@ -122,6 +137,13 @@ private:
 
  // flush _cmd and _buffer 
   void flushBuffer();
+  // wait until _buffer is not sent anymore, before filling it again
+  GFX_INLINE void WAIT_BUFFER();
+  // sleep until color transfer number at is finished
+  void waitColorDone(uint32_t at);
+  // finish an async write with the next color transfer
+  void queueWriteDone(gfx_transfer_t transfer, gfx_write_done_cb_t cb, void *user_ctx);
+  static bool color_trans_done_cb(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 
   int8_t _dc, _cs, _wr, _rd;
   int8_t _d0, _d1, _d2, _d3, _d4, _d5, _d6, _d7;
@@ -147,6 +169,27 @@ private:
   /// data size in _buffer for next DMA transfer
   int _bufferLen = 0;
 
+  /// color transfers started and finished
+  volatile uint32_t _color_queued = 0;
+  volatile uint32_t _color_done = 0;
+
+  /// given by color_trans_done_cb(), waiting tasks sleep on it
+  SemaphoreHandle_t _color_done_sem = nullptr;
+
+  /// color transfer number sending _buffer
+  uint32_t _buffer_busy_at = 0;
+
+  /// async writes in flight, each one finished after color transfer number at
+  struct
+  {
+    uint32_t at;
+    gfx_transfer_t transfer;
+    gfx_write_done_cb_t cb;
+    void *ctx;
+  } _write_done[LCD_ASYNC_QUEUE_SIZE];
+  volatile uint8_t _write_done_head = 0; // next one to finish
+  volatile uint8_t _write_done_tail = 0; // next one to add
+
   union
   {
     uint32_t value;
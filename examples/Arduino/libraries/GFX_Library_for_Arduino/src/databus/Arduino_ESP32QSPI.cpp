@@ -54,7 +54,7 @@ bool Arduino_ESP32QSPI::begin(int32_t speed, int8_t dataMode)
       .data5_io_num = -1,
       .data6_io_num = -1,
       .data7_io_num = -1,
-      .max_transfer_sz = (ESP32QSPI_MAX_PIXELS_AT_ONCE * 16) + 8,
+      .max_transfer_sz = (ESP32QSPI_MAX_DMA_BYTES > ((ESP32QSPI_MAX_PIXELS_AT_ONCE * 16) + 8)) ? ESP32QSPI_MAX_DMA_BYTES : ((ESP32QSPI_MAX_PIXELS_AT_ONCE * 16) + 8),
       .flags = SPICOMMON_BUSFLAG_MASTER | SPICOMMON_BUSFLAG_GPIO_PINS,
 #if (!defined(ESP_ARDUINO_VERSION_MAJOR)) || (ESP_ARDUINO_VERSION_MAJOR < 3)
       // skip this
@@ -84,9 +84,9 @@ bool Arduino_ESP32QSPI::begin(int32_t speed, int8_t dataMode)
       .input_delay_ns = 0,
       .spics_io_num = -1, // avoid use system CS control
       .flags = SPI_DEVICE_HALFDUPLEX,
-      .queue_size = 1,
+      .queue_size = ESP32QSPI_QUEUE_SIZE,
       .pre_cb = nullptr,
-      .post_cb = nullptr};
+      .post_cb = queue_done_cb};
   ret = spi_bus_add_device(ESP32QSPI_SPI_HOST, &devcfg, &_handle);
   if (ret != ESP_OK)
   {
@@ -101,6 +101,7 @@ bool Arduino_ESP32QSPI::begin(int32_t speed, int8_t dataMode)
 
   memset(&_spi_tran_ext, 0, sizeof(_spi_tran_ext));
   _spi_tran = (spi_transaction_t *)&_spi_tran_ext;
+  memset(_queue_tran, 0, sizeof(_queue_tran));
 
   _buffer = (uint8_t *)heap_caps_aligned_alloc(16, ESP32QSPI_MAX_PIXELS_AT_ONCE * 2, MALLOC_CAP_DMA);
   if (!_buffer)
@@ -134,6 +135,7 @@ void Arduino_ESP32QSPI::beginWrite()
  */
 void Arduino_ESP32QSPI::endWrite()
 {
+  QUEUE_END();
   if (_is_shared_interface)
   {
     spi_device_release_bus(_handle);
@@ -348,46 +350,59 @@ void Arduino_ESP32QSPI::writeC8Bytes(uint8_t c, uint8_t *data, uint32_t len)
  */
 void Arduino_ESP32QSPI::writeRepeat(uint16_t p, uint32_t len)
 {
-  bool first_send = true;
-
-  uint16_t bufLen = (len >= ESP32QSPI_MAX_PIXELS_AT_ONCE) ? ESP32QSPI_MAX_PIXELS_AT_ONCE : len;
-  int16_t xferLen, l;
-  uint32_t c32;
-  MSB_32_16_16_SET(c32, p, p);
+  writeRepeatAsync(p, len);
+  QUEUE_END();
+}
 
-  l = (bufLen + 1) / 2;
-  for (uint32_t i = 0; i < l; i++)
+/**
+ * @brief writeRepeatAsync, returns once the last block is queued,
+ *   CS is raised and cb is called from the SPI interrupt when the last block is sent
+ *
+ * @param p
+ * @param len
+ * @param cb
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32QSPI::writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if (!len)
   {
-    _buffer32[i] = c32;
+    return syncTransferDone(cb, user_ctx);
   }
 
+  gfx_transfer_t transfer = nextTransfer();
+  uint32_t bufLen = (len >= ESP32QSPI_MAX_PIXELS_AT_ONCE) ? ESP32QSPI_MAX_PIXELS_AT_ONCE : len;
+  uint32_t xferLen, l;
+  uint32_t c32;
+  MSB_32_16_16_SET(c32, p, p);
+
   CS_LOW();
-  // Issue pixels in blocks from temp buffer
+  // Issue pixels in blocks, each buffer is filled once and queued again while the other one is sent
+  bool first_send = true;
+  uint8_t filled = 0;
+  uint32_t *buf;
   while (len) // While pixels remain
   {
     xferLen = (bufLen <= len) ? bufLen : len; // How many this pass?
+    len -= xferLen;
 
-    if (first_send)
+    QUEUE_WAIT();
+    buf = _queue_idx ? _2nd_buffer32 : _buffer32;
+    if (!(filled & (1 << _queue_idx)))
     {
-      _spi_tran_ext.base.flags = SPI_TRANS_MODE_QIO;
-      _spi_tran_ext.base.cmd = 0x32;
-      _spi_tran_ext.base.addr = 0x003C00;
-      first_send = false;
-    }
-    else
-    {
-      _spi_tran_ext.base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD |
-                                 SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
+      l = (bufLen + 1) / 2;
+      for (uint32_t i = 0; i < l; i++)
+      {
+        buf[i] = c32;
+      }
+      filled |= 1 << _queue_idx;
     }
-    _spi_tran_ext.base.tx_buffer = _buffer16;
-    _spi_tran_ext.base.length = xferLen << 4;
-
-    POLL_START();
-    POLL_END();
 
-    len -= xferLen;
+    QUEUE_START(buf, xferLen << 4, first_send, len ? 0 : transfer, cb, user_ctx);
+    first_send = false;
   }
-  CS_HIGH();
+  return transfer;
 }
 
 /**
@@ -398,53 +413,64 @@ void Arduino_ESP32QSPI::writeRepeat(uint16_t p, uint32_t len)
  */
 void Arduino_ESP32QSPI::writePixels(uint16_t *data, uint32_t len)
 {
+  writePixelsAsync(data, len);
+  QUEUE_END();
+}
 
+/**
+ * @brief writePixelsAsync, pixels are swapped into the two buffers, data can be reused once the call returns,
+ *   CS is raised and cb is called from the SPI interrupt when the last chunk is sent
+ *
+ * @param data
+ * @param len
+ * @param cb
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32QSPI::writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if (!len)
+  {
+    return syncTransferDone(cb, user_ctx);
+  }
+
+  gfx_transfer_t transfer = nextTransfer();
   CS_LOW();
+  // swap each chunk into one buffer while the previous chunk is sent from the other
   uint32_t l, l2;
   uint16_t p1, p2;
+  uint32_t *buf;
   bool first_send = true;
   while (len)
   {
     l = (len > ESP32QSPI_MAX_PIXELS_AT_ONCE) ? ESP32QSPI_MAX_PIXELS_AT_ONCE : len;
-
-    if (first_send)
-    {
-      _spi_tran_ext.base.flags = SPI_TRANS_MODE_QIO;
-      _spi_tran_ext.base.cmd = 0x32;
-      _spi_tran_ext.base.addr = 0x003C00;
-      first_send = false;
-    }
-    else
-    {
-      _spi_tran_ext.base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD |
-                                 SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
-    }
     l2 = l >> 1;
+    QUEUE_WAIT();
+    buf = _queue_idx ? _2nd_buffer32 : _buffer32;
     for (uint32_t i = 0; i < l2; ++i)
     {
       p1 = *data++;
       p2 = *data++;
-      MSB_32_16_16_SET(_buffer32[i], p1, p2);
+      MSB_32_16_16_SET(buf[i], p1, p2);
     }
     if (l & 1)
     {
       p1 = *data++;
-      MSB_16_SET(_buffer16[l - 1], p1);
+      MSB_16_SET(((uint16_t *)buf)[l - 1], p1);
     }
 
-    _spi_tran_ext.base.tx_buffer = _buffer32;
-    _spi_tran_ext.base.length = l << 4;
-
-    POLL_START();
-    POLL_END();
-
     len -= l;
+
+    QUEUE_START(buf, l << 4, first_send, len ? 0 : transfer, cb, user_ctx);
+    first_send = false;
   }
-  CS_HIGH();
+  return transfer;
 }
 
 void Arduino_ESP32QSPI::batchOperation(const uint8_t *operations, size_t len)
 {
+  QUEUE_END(); // _buffer is reused below
+
   for (size_t i = 0; i < len; ++i)
   {
     uint8_t l = 0;
@@ -518,11 +544,13 @@ void Arduino_ESP32QSPI::batchOperation(const uint8_t *operations, size_t len)
 void Arduino_ESP32QSPI::writeBytes(uint8_t *data, uint32_t len)
 {
   CS_LOW();
+  // DMA-capable data is sent in place, other data is copied by the driver
+  uint32_t max_l = esp_ptr_dma_capable(data) ? ESP32QSPI_MAX_DMA_BYTES : (ESP32QSPI_MAX_PIXELS_AT_ONCE << 1);
   uint32_t l;
   bool first_send = true;
   while (len)
   {
-    l = (len >= (ESP32QSPI_MAX_PIXELS_AT_ONCE << 1)) ? (ESP32QSPI_MAX_PIXELS_AT_ONCE << 1) : len;
+    l = (len >= max_l) ? max_l : len;
 
     if (first_send)
     {
@@ -549,6 +577,49 @@ void Arduino_ESP32QSPI::writeBytes(uint8_t *data, uint32_t len)
   CS_HIGH();
 }
 
+/**
+ * @brief writeBytesAsync, DMA-capable data is sent in the background without copying,
+ *   CS is raised and cb is called from the SPI interrupt when the last byte is sent
+ *
+ * @param data
+ * @param len
+ * @param cb
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32QSPI::writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if ((!len) || (!esp_ptr_dma_capable(data)))
+  {
+    return Arduino_DataBus::writeBytesAsync(data, len, cb, user_ctx);
+  }
+
+  gfx_transfer_t transfer = nextTransfer();
+  CS_LOW();
+  uint32_t l;
+  bool first_send = true;
+  while (len)
+  {
+    l = (len > ESP32QSPI_MAX_DMA_BYTES) ? ESP32QSPI_MAX_DMA_BYTES : len;
+    len -= l;
+
+    QUEUE_START(data, l << 3, first_send, len ? 0 : transfer, cb, user_ctx);
+    first_send = false;
+
+    data += l;
+  }
+  return transfer;
+}
+
+/**
+ * @brief waitWriteDone
+ *
+ */
+void Arduino_ESP32QSPI::waitWriteDone()
+{
+  QUEUE_END();
+}
+
 /**
  * @brief write16bitBeRGBBitmapR1
  *
@@ -798,6 +869,7 @@ GFX_INLINE void Arduino_ESP32QSPI::CS_HIGH(void)
  */
 GFX_INLINE void Arduino_ESP32QSPI::CS_LOW(void)
 {
+  QUEUE_END();
   *_csPortClr = _csPinMask;
 }
 
@@ -808,6 +880,7 @@ GFX_INLINE void Arduino_ESP32QSPI::CS_LOW(void)
  */
 GFX_INLINE void Arduino_ESP32QSPI::POLL_START()
 {
+  QUEUE_END();
   spi_device_polling_start(_handle, _spi_tran, portMAX_DELAY);
 }
 
@@ -821,4 +894,95 @@ GFX_INLINE void Arduino_ESP32QSPI::POLL_END()
   spi_device_polling_end(_handle, portMAX_DELAY);
 }
 
+/**
+ * @brief QUEUE_WAIT, wait until the next transaction is free
+ *
+ * @return GFX_INLINE
+ */
+GFX_INLINE void Arduino_ESP32QSPI::QUEUE_WAIT()
+{
+  if (_queued >= ESP32QSPI_QUEUE_SIZE)
+  {
+    spi_transaction_t *t;
+    spi_device_get_trans_result(_handle, &t, portMAX_DELAY);
+    --_queued;
+  }
+}
+
+/**
+ * @brief QUEUE_START, queue one chunk of a pixel write, the driver starts it as soon as the previous one is sent
+ *
+ * @param buf
+ * @param bits
+ * @param first the first chunk sends the command and address
+ * @param transfer set on the last chunk only, CS is raised and cb is called once it is sent
+ * @param cb
+ * @param user_ctx
+ * @return GFX_INLINE
+ */
+GFX_INLINE void Arduino_ESP32QSPI::QUEUE_START(const void *buf, uint32_t bits, bool first, gfx_transfer_t transfer, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  QUEUE_WAIT();
+  spi_transaction_ext_t *t = &_queue_tran[_queue_idx];
+  if (first)
+  {
+    t->base.flags = SPI_TRANS_MODE_QIO;
+    t->base.cmd = 0x32;
+    t->base.addr = 0x003C00;
+  }
+  else
+  {
+    t->base.flags = SPI_TRANS_MODE_QIO | SPI_TRANS_VARIABLE_CMD |
+                    SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
+  }
+  t->base.tx_buffer = buf;
+  t->base.length = bits;
+  t->base.user = this;
+  _queue_transfer[_queue_idx] = transfer;
+  _queue_cb[_queue_idx] = cb;
+  _queue_ctx[_queue_idx] = user_ctx;
+
+  spi_device_queue_trans(_handle, &t->base, portMAX_DELAY);
+  ++_queued;
+  _queue_idx = (_queue_idx + 1) % ESP32QSPI_QUEUE_SIZE;
+}
+
+/**
+ * @brief QUEUE_END, wait until every queued transaction is sent, before polling transactions or CS changes
+ *
+ * @return GFX_INLINE
+ */
+GFX_INLINE void Arduino_ESP32QSPI::QUEUE_END()
+{
+  spi_transaction_t *t;
+  while (_queued)
+  {
+    spi_device_get_trans_result(_handle, &t, portMAX_DELAY);
+    --_queued;
+  }
+}
+
+/**
+ * @brief queue_done_cb, post_cb of the device, polling transactions have no user
+ *
+ * @param t
+ */
+void IRAM_ATTR Arduino_ESP32QSPI::queue_done_cb(spi_transaction_t *t)
+{
+  Arduino_ESP32QSPI *bus = (Arduino_ESP32QSPI *)t->user;
+  if (bus)
+  {
+    uint8_t i = (spi_transaction_ext_t *)t - bus->_queue_tran;
+    if (bus->_queue_transfer[i])
+    {
+      *bus->_csPortSet = bus->_csPinMask;
+      bus->_transfer_done = bus->_queue_transfer[i];
+      if (bus->_queue_cb[i])
+      {
+        bus->_queue_cb[i](bus->_queue_ctx[i]);
+      }
+    }
+  }
+}
+
 #endif // #if defined(ESP32)
@@ -4,10 +4,17 @@
 
 #if defined(ESP32)
 #include <driver/spi_master.h>
+#if (ESP_ARDUINO_VERSION_MAJOR >= 3)
+#include <esp_memory_utils.h>
+#endif
 
 #ifndef ESP32QSPI_MAX_PIXELS_AT_ONCE
 #define ESP32QSPI_MAX_PIXELS_AT_ONCE 1024
 #endif
+#ifndef ESP32QSPI_MAX_DMA_BYTES
+#define ESP32QSPI_MAX_DMA_BYTES 32768 // 2^18 bits, the hardware limit of one transaction
+#endif
+#define ESP32QSPI_QUEUE_SIZE 2 // async chunks sent back to back
 #ifndef ESP32QSPI_FREQUENCY
 #define ESP32QSPI_FREQUENCY 80000000
 #endif
@@ -49,6 +56,10 @@ public:
 
   void batchOperation(const uint8_t *operations, size_t len) override;
   void writeBytes(uint8_t *data, uint32_t len) override;
+  gfx_transfer_t writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  void waitWriteDone() override;
 
   void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
   void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
@@ -60,6 +71,10 @@ private:
   GFX_INLINE void CS_LOW(void);
   GFX_INLINE void POLL_START();
   GFX_INLINE void POLL_END();
+  GFX_INLINE void QUEUE_WAIT();
+  GFX_INLINE void QUEUE_START(const void *buf, uint32_t bits, bool first, gfx_transfer_t transfer, gfx_write_done_cb_t cb, void *user_ctx);
+  GFX_INLINE void QUEUE_END();
+  static void queue_done_cb(spi_transaction_t *t);
 
   int8_t _cs, _sck, _mosi, _miso, _quadwp, _quadhd;
   bool _is_shared_interface;
@@ -71,6 +86,13 @@ private:
   spi_device_handle_t _handle;
   spi_transaction_ext_t _spi_tran_ext;
   spi_transaction_t *_spi_tran;
+  // queued transactions of the async writes, CS is raised after the last one
+  spi_transaction_ext_t _queue_tran[ESP32QSPI_QUEUE_SIZE];
+  gfx_transfer_t _queue_transfer[ESP32QSPI_QUEUE_SIZE]; // set on the last transaction only
+  gfx_write_done_cb_t _queue_cb[ESP32QSPI_QUEUE_SIZE];
+  void *_queue_ctx[ESP32QSPI_QUEUE_SIZE];
+  uint8_t _queue_idx = 0; // next transaction to fill
+  uint8_t _queued = 0;    // transactions not finished yet
 
   union
   {
@@ -155,4 +155,50 @@ uint16_t *Arduino_ESP32RGBPanel::getFrameBuffer(int16_t w, int16_t h)
 #endif
 }
 
+/**
+ * Call cb from the interrupt at each refresh, after getFrameBuffer().
+ * With bounce buffers it is called when the last rows of a frame have been copied out of the framebuffer,
+ * otherwise at VSYNC. nullptr removes the callback.
+ * Needs ESP32 board version 3.x, returns false on 2.x.
+ */
+bool Arduino_ESP32RGBPanel::setVSyncCallback(gfx_vsync_cb_t cb, void *user_ctx)
+{
+#if (!defined(ESP_ARDUINO_VERSION_MAJOR)) || (ESP_ARDUINO_VERSION_MAJOR < 3)
+  UNUSED(cb);
+  UNUSED(user_ctx);
+  return false;
+#else
+  if (!_panel_handle)
+  {
+    return false;
+  }
+  _vsync_cb = cb;
+  _vsync_user_ctx = user_ctx;
+
+  esp_lcd_rgb_panel_event_callbacks_t cbs = {};
+  if (cb)
+  {
+    if (_bounce_buffer_size_px > 0)
+    {
+      cbs.on_bounce_frame_finish = onVSync;
+    }
+    else
+    {
+      cbs.on_vsync = onVSync;
+    }
+  }
+  return esp_lcd_rgb_panel_register_event_callbacks(_panel_handle, &cbs, this) == ESP_OK;
+#endif
+}
+
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && (ESP_ARDUINO_VERSION_MAJOR >= 3)
+bool IRAM_ATTR Arduino_ESP32RGBPanel::onVSync(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx)
+{
+  UNUSED(panel);
+  UNUSED(edata);
+  Arduino_ESP32RGBPanel *rgbpanel = (Arduino_ESP32RGBPanel *)user_ctx;
+  return rgbpanel->_vsync_cb(rgbpanel->_vsync_user_ctx);
+}
+#endif
+
 #endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32S3)
@@ -16,6 +16,7 @@
 // The prior implementation (ESP32 board version 2.x) was largely undocumented.
 
 #include "Arduino_DataBus.h"
+#include "../Arduino_FrameSync.h"
 
 #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32S3)
 
@@ -90,9 +91,14 @@ public:
   }
 
   uint16_t *getFrameBuffer(int16_t w, int16_t h);
+  bool setVSyncCallback(gfx_vsync_cb_t cb, void *user_ctx);
 
 protected:
 private:
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && (ESP_ARDUINO_VERSION_MAJOR >= 3)
+  static bool onVSync(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx);
+#endif
+
   int32_t _speed;
   int8_t _de, _vsync, _hsync, _pclk;
   int8_t _r0, _r1, _r2, _r3, _r4;
@@ -114,6 +120,8 @@ private:
   size_t _bounce_buffer_size_px;
 
   esp_lcd_panel_handle_t _panel_handle = NULL;
+  gfx_vsync_cb_t _vsync_cb = NULL;
+  void *_vsync_user_ctx = NULL;
 };
 
 #endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32S3)
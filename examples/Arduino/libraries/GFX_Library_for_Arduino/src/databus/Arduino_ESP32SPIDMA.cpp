@@ -118,7 +118,7 @@ bool Arduino_ESP32SPIDMA::begin(int32_t speed, int8_t dataMode)
       .data5_io_num = -1,
       .data6_io_num = -1,
       .data7_io_num = -1,
-      .max_transfer_sz = (ESP32SPIDMA_MAX_PIXELS_AT_ONCE * 16) + 8,
+      .max_transfer_sz = (ESP32SPIDMA_MAX_DMA_BYTES > ((ESP32SPIDMA_MAX_PIXELS_AT_ONCE * 16) + 8)) ? ESP32SPIDMA_MAX_DMA_BYTES : ((ESP32SPIDMA_MAX_PIXELS_AT_ONCE * 16) + 8),
       .flags = SPICOMMON_BUSFLAG_MASTER | SPICOMMON_BUSFLAG_GPIO_PINS,
       .intr_flags = 0};
 #if CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S3
@@ -144,9 +144,9 @@ bool Arduino_ESP32SPIDMA::begin(int32_t speed, int8_t dataMode)
       .input_delay_ns = 0,
       .spics_io_num = -1, // avoid use system CS control
       .flags = (_miso < 0) ? (uint32_t)SPI_DEVICE_NO_DUMMY : 0,
-      .queue_size = 1,
+      .queue_size = ESP32SPIDMA_QUEUE_SIZE,
       .pre_cb = nullptr,
-      .post_cb = nullptr};
+      .post_cb = queue_done_cb};
 #if CONFIG_IDF_TARGET_ESP32C3 || CONFIG_IDF_TARGET_ESP32S3
   ret = spi_bus_add_device((spi_host_device_t)_spi_num, &devcfg, &_handle);
 #else
@@ -164,6 +164,7 @@ bool Arduino_ESP32SPIDMA::begin(int32_t speed, int8_t dataMode)
   }
 
   memset(&_spi_tran, 0, sizeof(_spi_tran));
+  memset(_queue_tran, 0, sizeof(_queue_tran));
 
   _buffer = (uint8_t *)heap_caps_aligned_alloc(16, ESP32SPIDMA_MAX_PIXELS_AT_ONCE * 2, MALLOC_CAP_DMA);
   if (!_buffer)
@@ -210,6 +211,7 @@ void Arduino_ESP32SPIDMA::endWrite()
   {
     flush_data_buf();
   }
+  QUEUE_END();
 
   if (_is_shared_interface)
   {
@@ -531,52 +533,81 @@ void Arduino_ESP32SPIDMA::writeRepeat(uint16_t p, uint32_t len)
       _data_buf_bit_idx += 9;
     }
 
-    // Issue pixels in blocks from temp buffer
+    // Issue pixels in blocks from temp buffer, the same buffer is queued again while the previous block is sent
     while (len) // While pixels remain
     {
       xferLen = (bufLen < len) ? bufLen : len; // How many this pass?
       _data_buf_bit_idx = xferLen * 18;
 
-      _spi_tran.tx_buffer = _buffer32;
-      _spi_tran.length = _data_buf_bit_idx;
-      _spi_tran.flags = 0;
-
-      POLL_START();
-      POLL_END();
+      QUEUE_START(_buffer32, _data_buf_bit_idx);
 
       len -= xferLen;
     }
+    QUEUE_END();
   }
   else // 8-bit SPI
   {
-    uint16_t bufLen = (len >= ESP32SPIDMA_MAX_PIXELS_AT_ONCE) ? ESP32SPIDMA_MAX_PIXELS_AT_ONCE : len;
-    int16_t xferLen, l;
-    uint32_t c32;
-    MSB_32_16_16_SET(c32, p, p);
+    writeRepeatAsync(p, len);
+    QUEUE_END();
+  }
 
-    l = (bufLen + 1) / 2;
-    for (uint32_t i = 0; i < l; i++)
-    {
-      _buffer32[i] = c32;
-    }
+  _data_buf_bit_idx = 0;
+}
 
-    // Issue pixels in blocks from temp buffer
-    while (len) // While pixels remain
-    {
-      xferLen = (bufLen <= len) ? bufLen : len; // How many this pass?
+/**
+ * @brief writeRepeatAsync, returns once the last block is queued
+ *
+ * @param p
+ * @param len
+ * @param cb called from the SPI interrupt when the last block is sent
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32SPIDMA::writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if (_dc == GFX_NOT_DEFINED) // 9-bit SPI
+  {
+    return Arduino_DataBus::writeRepeatAsync(p, len, cb, user_ctx);
+  }
+  if (!len)
+  {
+    return syncTransferDone(cb, user_ctx);
+  }
 
-      _spi_tran.tx_buffer = _buffer32;
-      _spi_tran.length = xferLen << 4;
-      _spi_tran.flags = 0;
+  if (_data_buf_bit_idx > 0)
+  {
+    flush_data_buf();
+  }
 
-      POLL_START();
-      POLL_END();
+  gfx_transfer_t transfer = nextTransfer();
+  uint32_t bufLen = (len >= ESP32SPIDMA_MAX_PIXELS_AT_ONCE) ? ESP32SPIDMA_MAX_PIXELS_AT_ONCE : len;
+  uint32_t xferLen, l;
+  uint32_t c32;
+  MSB_32_16_16_SET(c32, p, p);
 
-      len -= xferLen;
+  // Issue pixels in blocks, each buffer is filled once and queued again while the other one is sent
+  uint8_t filled = 0;
+  uint32_t *buf;
+  while (len) // While pixels remain
+  {
+    xferLen = (bufLen <= len) ? bufLen : len; // How many this pass?
+    len -= xferLen;
+
+    QUEUE_WAIT();
+    buf = _queue_idx ? _2nd_buffer32 : _buffer32;
+    if (!(filled & (1 << _queue_idx)))
+    {
+      l = (bufLen + 1) / 2;
+      for (uint32_t i = 0; i < l; i++)
+      {
+        buf[i] = c32;
+      }
+      filled |= 1 << _queue_idx;
     }
-  }
 
-  _data_buf_bit_idx = 0;
+    QUEUE_START(buf, xferLen << 4, len ? 0 : transfer, len ? nullptr : cb, user_ctx);
+  }
+  return transfer;
 }
 
 /**
@@ -596,39 +627,64 @@ void Arduino_ESP32SPIDMA::writePixels(uint16_t *data, uint32_t len)
   }
   else // 8-bit SPI
   {
-    if (_data_buf_bit_idx > 0)
+    writePixelsAsync(data, len);
+    QUEUE_END();
+  }
+}
+
+/**
+ * @brief writePixelsAsync, pixels are swapped into the two buffers, data can be reused once the call returns
+ *
+ * @param data
+ * @param len
+ * @param cb called from the SPI interrupt when the last chunk is sent
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32SPIDMA::writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if (_dc == GFX_NOT_DEFINED) // 9-bit SPI
+  {
+    return Arduino_DataBus::writePixelsAsync(data, len, cb, user_ctx);
+  }
+  if (!len)
+  {
+    return syncTransferDone(cb, user_ctx);
+  }
+
+  if (_data_buf_bit_idx > 0)
+  {
+    flush_data_buf();
+  }
+
+  // swap each chunk into one buffer while the previous chunk is sent from the other
+  gfx_transfer_t transfer = nextTransfer();
+  uint32_t l, l2;
+  uint16_t p1, p2;
+  uint32_t *buf;
+  while (len)
+  {
+    l = (len > ESP32SPIDMA_MAX_PIXELS_AT_ONCE) ? ESP32SPIDMA_MAX_PIXELS_AT_ONCE : len;
+    l2 = l >> 1;
+    QUEUE_WAIT();
+    buf = _queue_idx ? _2nd_buffer32 : _buffer32;
+    for (uint32_t i = 0; i < l2; ++i)
     {
-      flush_data_buf();
+      p1 = *data++;
+      p2 = *data++;
+      MSB_32_16_16_SET(buf[i], p1, p2);
     }
-
-    uint32_t l, l2;
-    uint16_t p1, p2;
-    while (len)
+    if (l & 1)
     {
-      l = (len > ESP32SPIDMA_MAX_PIXELS_AT_ONCE) ? ESP32SPIDMA_MAX_PIXELS_AT_ONCE : len;
-      l2 = (l + 1) >> 1;
-      for (uint32_t i = 0; i < l2; ++i)
-      {
-        p1 = *data++;
-        p2 = *data++;
-        MSB_32_16_16_SET(_buffer32[i], p1, p2);
-      }
-      if (l & 1)
-      {
-        p1 = *data++;
-        MSB_16_SET(_buffer16[l - 1], p1);
-      }
-
-      _spi_tran.tx_buffer = _buffer32;
-      _spi_tran.length = l << 4;
-      _spi_tran.flags = 0;
+      p1 = *data++;
+      MSB_16_SET(((uint16_t *)buf)[l - 1], p1);
+    }
 
-      POLL_START();
-      POLL_END();
+    len -= l;
 
-      len -= l;
-    }
+    QUEUE_START(buf, l << 4, len ? 0 : transfer, len ? nullptr : cb, user_ctx);
   }
+  return transfer;
 }
 
 /**
@@ -648,24 +704,20 @@ void Arduino_ESP32SPIDMA::writeBytes(uint8_t *data, uint32_t len)
   }
   else // 8-bit SPI
   {
-    if (esp_ptr_dma_capable(data))
+    if (_data_buf_bit_idx > 0)
     {
-      if (_data_buf_bit_idx > 0)
-      {
-        flush_data_buf();
-      }
+      flush_data_buf();
+    }
 
-      uint32_t l;
+    uint32_t l;
+    if (esp_ptr_dma_capable(data))
+    {
+      // send from the caller's buffer, the driver links DMA descriptors over it
       while (len)
       {
-        l = (len >= (ESP32SPIDMA_MAX_PIXELS_AT_ONCE << 1)) ? (ESP32SPIDMA_MAX_PIXELS_AT_ONCE << 1) : len;
-
-        _spi_tran.tx_buffer = data;
-        _spi_tran.length = l << 3;
-        _spi_tran.flags = 0;
+        l = (len > ESP32SPIDMA_MAX_DMA_BYTES) ? ESP32SPIDMA_MAX_DMA_BYTES : len;
 
-        POLL_START();
-        POLL_END();
+        QUEUE_START(data, l << 3);
 
         len -= l;
         data += l;
@@ -673,37 +725,70 @@ void Arduino_ESP32SPIDMA::writeBytes(uint8_t *data, uint32_t len)
     }
     else
     {
-      if (_data_buf_bit_idx > 0)
-      {
-        flush_data_buf();
-      }
-
-      uint32_t l, l4;
-      uint32_t *p;
+      // copy each chunk into one buffer while the previous chunk is sent from the other
+      uint8_t *buf;
       while (len)
       {
         l = (len > (ESP32SPIDMA_MAX_PIXELS_AT_ONCE << 1)) ? (ESP32SPIDMA_MAX_PIXELS_AT_ONCE << 1) : len;
-        l4 = (l + 3) >> 2;
-        p = (uint32_t *)data;
-        for (uint32_t i = 0; i < l4; ++i)
-        {
-          _buffer32[i] = *p++;
-        }
+        QUEUE_WAIT();
+        buf = _queue_idx ? _2nd_buffer : _buffer;
+        memcpy(buf, data, l);
 
-        _spi_tran.tx_buffer = _buffer32;
-        _spi_tran.length = l << 3;
-        _spi_tran.flags = 0;
-
-        POLL_START();
-        POLL_END();
+        QUEUE_START(buf, l << 3);
 
         len -= l;
         data += l;
       }
     }
+    QUEUE_END();
   }
 }
 
+/**
+ * @brief writeBytesAsync, DMA-capable data is sent in the background without copying,
+ *   cb is called from the SPI interrupt when the last byte is sent
+ *
+ * @param data
+ * @param len
+ * @param cb
+ * @param user_ctx
+ * @return handle for isTransferDone() and waitTransfer()
+ */
+gfx_transfer_t Arduino_ESP32SPIDMA::writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  if ((_dc == GFX_NOT_DEFINED) || (!len) || (!esp_ptr_dma_capable(data))) // 9-bit SPI or data to copy
+  {
+    return Arduino_DataBus::writeBytesAsync(data, len, cb, user_ctx);
+  }
+
+  if (_data_buf_bit_idx > 0)
+  {
+    flush_data_buf();
+  }
+
+  gfx_transfer_t transfer = nextTransfer();
+  uint32_t l;
+  while (len)
+  {
+    l = (len > ESP32SPIDMA_MAX_DMA_BYTES) ? ESP32SPIDMA_MAX_DMA_BYTES : len;
+    len -= l;
+
+    QUEUE_START(data, l << 3, len ? 0 : transfer, len ? nullptr : cb, user_ctx);
+
+    data += l;
+  }
+  return transfer;
+}
+
+/**
+ * @brief waitWriteDone
+ *
+ */
+void Arduino_ESP32SPIDMA::waitWriteDone()
+{
+  QUEUE_END();
+}
+
 /**
  * @brief writeIndexedPixels
  *
@@ -729,31 +814,30 @@ void Arduino_ESP32SPIDMA::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint3
 
     uint32_t l, l2;
     uint16_t p1, p2;
+    uint32_t *buf;
     while (len)
     {
       l = (len > ESP32SPIDMA_MAX_PIXELS_AT_ONCE) ? ESP32SPIDMA_MAX_PIXELS_AT_ONCE : len;
       l2 = l >> 1;
+      QUEUE_WAIT();
+      buf = _queue_idx ? _2nd_buffer32 : _buffer32;
       for (uint32_t i = 0; i < l2; ++i)
       {
         p1 = idx[*data++];
         p2 = idx[*data++];
-        MSB_32_16_16_SET(_buffer32[i], p1, p2);
+        MSB_32_16_16_SET(buf[i], p1, p2);
       }
       if (l & 1)
       {
         p1 = idx[*data++];
-        MSB_16_SET(_buffer16[l - 1], p1);
+        MSB_16_SET(((uint16_t *)buf)[l - 1], p1);
       }
 
-      _spi_tran.tx_buffer = _buffer32;
-      _spi_tran.length = l << 4;
-      _spi_tran.flags = 0;
-
-      POLL_START();
-      POLL_END();
+      QUEUE_START(buf, l << 4);
 
       len -= l;
     }
+    QUEUE_END();
   }
 }
 
@@ -789,24 +873,23 @@ void Arduino_ESP32SPIDMA::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx,
 
     uint32_t l;
     uint16_t p;
+    uint32_t *buf;
     while (len)
     {
       l = (len > (ESP32SPIDMA_MAX_PIXELS_AT_ONCE >> 1)) ? (ESP32SPIDMA_MAX_PIXELS_AT_ONCE >> 1) : len;
+      QUEUE_WAIT();
+      buf = _queue_idx ? _2nd_buffer32 : _buffer32;
       for (uint32_t i = 0; i < l; ++i)
       {
         p = idx[*data++];
-        MSB_32_16_16_SET(_buffer32[i], p, p);
+        MSB_32_16_16_SET(buf[i], p, p);
       }
 
-      _spi_tran.tx_buffer = _buffer32;
-      _spi_tran.length = l << 5;
-      _spi_tran.flags = 0;
-
-      POLL_START();
-      POLL_END();
+      QUEUE_START(buf, l << 5);
 
       len -= l;
     }
+    QUEUE_END();
   }
 }
 
@@ -818,6 +901,8 @@ void Arduino_ESP32SPIDMA::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint
   }
   else
   {
+    QUEUE_END(); // both buffers are filled below
+
     int cols = w >> 1;
     int rows = h >> 1;
     uint8_t *yData2 = yData + w;
@@ -904,6 +989,10 @@ void Arduino_ESP32SPIDMA::flush_data_buf()
  */
 GFX_INLINE void Arduino_ESP32SPIDMA::WRITE8BIT(uint8_t d)
 {
+  if (!_data_buf_bit_idx)
+  {
+    QUEUE_END(); // _buffer may still be sent by an async transfer
+  }
   uint16_t idx = _data_buf_bit_idx >> 3;
   _buffer[idx] = d;
   _data_buf_bit_idx += 8;
@@ -959,6 +1048,7 @@ GFX_INLINE void Arduino_ESP32SPIDMA::DC_HIGH(void)
  */
 GFX_INLINE void Arduino_ESP32SPIDMA::DC_LOW(void)
 {
+  QUEUE_END();
   *_dcPortClr = _dcPinMask;
 }
 
@@ -995,6 +1085,7 @@ GFX_INLINE void Arduino_ESP32SPIDMA::CS_LOW(void)
  */
 GFX_INLINE void Arduino_ESP32SPIDMA::POLL_START()
 {
+  QUEUE_END();
   spi_device_polling_start(_handle, &_spi_tran, portMAX_DELAY);
 }
 
@@ -1008,4 +1099,82 @@ GFX_INLINE void Arduino_ESP32SPIDMA::POLL_END()
   spi_device_polling_end(_handle, portMAX_DELAY);
 }
 
+/**
+ * @brief QUEUE_WAIT, wait until the next transaction and its buffer are free
+ *
+ * @return GFX_INLINE
+ */
+GFX_INLINE void Arduino_ESP32SPIDMA::QUEUE_WAIT()
+{
+  if (_queued >= ESP32SPIDMA_QUEUE_SIZE)
+  {
+    spi_transaction_t *t;
+    spi_device_get_trans_result(_handle, &t, portMAX_DELAY);
+    --_queued;
+  }
+}
+
+/**
+ * @brief QUEUE_START, queue a transaction, the driver starts it as soon as the previous one is sent
+ *
+ * @param buf
+ * @param bits
+ * @param transfer async transfer finished by this transaction, 0 for none
+ * @param cb called from the SPI interrupt when the transaction is sent
+ * @param user_ctx
+ * @return GFX_INLINE
+ */
+GFX_INLINE void Arduino_ESP32SPIDMA::QUEUE_START(const void *buf, uint32_t bits, gfx_transfer_t transfer, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  QUEUE_WAIT();
+  spi_transaction_t *t = &_queue_tran[_queue_idx];
+  t->tx_buffer = buf;
+  t->length = bits;
+  t->flags = 0;
+  t->user = this;
+  _queue_transfer[_queue_idx] = transfer;
+  _queue_cb[_queue_idx] = cb;
+  _queue_ctx[_queue_idx] = user_ctx;
+  spi_device_queue_trans(_handle, t, portMAX_DELAY);
+  ++_queued;
+  _queue_idx = (_queue_idx + 1) % ESP32SPIDMA_QUEUE_SIZE;
+}
+
+/**
+ * @brief QUEUE_END, wait until every queued transaction is sent, before polling transactions, DC or CS changes
+ *
+ * @return GFX_INLINE
+ */
+GFX_INLINE void Arduino_ESP32SPIDMA::QUEUE_END()
+{
+  spi_transaction_t *t;
+  while (_queued)
+  {
+    spi_device_get_trans_result(_handle, &t, portMAX_DELAY);
+    --_queued;
+  }
+}
+
+/**
+ * @brief queue_done_cb, post_cb of the device, polling transactions have no user
+ *
+ * @param t
+ */
+void IRAM_ATTR Arduino_ESP32SPIDMA::queue_done_cb(spi_transaction_t *t)
+{
+  Arduino_ESP32SPIDMA *bus = (Arduino_ESP32SPIDMA *)t->user;
+  if (bus)
+  {
+    uint8_t i = t - bus->_queue_tran;
+    if (bus->_queue_transfer[i])
+    {
+      bus->_transfer_done = bus->_queue_transfer[i];
+    }
+    if (bus->_queue_cb[i])
+    {
+      bus->_queue_cb[i](bus->_queue_ctx[i]);
+    }
+  }
+}
+
 #endif // #if defined(ESP32)
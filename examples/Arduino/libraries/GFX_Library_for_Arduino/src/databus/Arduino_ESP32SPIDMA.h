@@ -14,6 +14,14 @@
 #ifndef ESP32SPIDMA_DMA_CHANNEL
 #define ESP32SPIDMA_DMA_CHANNEL SPI_DMA_CH_AUTO
 #endif
+#ifndef ESP32SPIDMA_MAX_DMA_BYTES
+#if CONFIG_IDF_TARGET_ESP32
+#define ESP32SPIDMA_MAX_DMA_BYTES (240 * 320 * 2) // bytes sent from a DMA-capable buffer in one transaction
+#else
+#define ESP32SPIDMA_MAX_DMA_BYTES 32768 // 2^18 bits, the hardware limit of one transaction
+#endif
+#endif
+#define ESP32SPIDMA_QUEUE_SIZE 2 // one chunk on the wire while the next one is filled, one buffer each
 
 class Arduino_ESP32SPIDMA : public Arduino_DataBus
 {
@@ -43,6 +51,10 @@ public:
   void writePixels(uint16_t *data, uint32_t len) override;
 
   void writeBytes(uint8_t *data, uint32_t len) override;
+  gfx_transfer_t writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  void waitWriteDone() override;
 
   void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
   void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
@@ -58,6 +70,10 @@ protected:
   GFX_INLINE void CS_LOW(void);
   GFX_INLINE void POLL_START();
   GFX_INLINE void POLL_END();
+  GFX_INLINE void QUEUE_WAIT();
+  GFX_INLINE void QUEUE_START(const void *buf, uint32_t bits, gfx_transfer_t transfer = 0, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr);
+  GFX_INLINE void QUEUE_END();
+  static void queue_done_cb(spi_transaction_t *t);
 
 private:
   int8_t _dc, _cs;
@@ -75,6 +91,13 @@ private:
 
   spi_device_handle_t _handle;
   spi_transaction_t _spi_tran;
+  // queued transactions of _buffer and _2nd_buffer, sent back to back by the driver
+  spi_transaction_t _queue_tran[ESP32SPIDMA_QUEUE_SIZE];
+  uint8_t _queue_idx = 0; // next transaction and buffer to fill
+  uint8_t _queued = 0;    // transactions not finished yet
+  gfx_transfer_t _queue_transfer[ESP32SPIDMA_QUEUE_SIZE]; // async transfer finished by this transaction, 0 for none
+  gfx_write_done_cb_t _queue_cb[ESP32SPIDMA_QUEUE_SIZE];
+  void *_queue_ctx[ESP32SPIDMA_QUEUE_SIZE];
   uint8_t _bitOrder = SPI_MSBFIRST;
 
   union
@@ -0,0 +1,796 @@
+/*
+ * Recording Databus, keeps a compact trace of every bus call and counts protocol overhead.
+ * Can be used stand alone (e.g. on a host build) or in front of a real bus.
+ */
+#include "Arduino_RecordBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+static inline uint16_t read16(const uint8_t *p)
+{
+  uint16_t v;
+  memcpy(&v, p, 2);
+  return v;
+}
+
+static inline uint32_t read32(const uint8_t *p)
+{
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+Arduino_RecordBus::Arduino_RecordBus(Arduino_DataBus *output /* = nullptr */)
+    : _output(output)
+{
+  resetStats();
+}
+
+Arduino_RecordBus::~Arduino_RecordBus()
+{
+  if (_trace)
+  {
+    free(_trace);
+    _trace = nullptr;
+  }
+}
+
+bool Arduino_RecordBus::begin(int32_t speed, int8_t dataMode)
+{
+  _speed = speed;
+  _dataMode = dataMode;
+
+  if (!_trace)
+  {
+    _trace = (uint8_t *)malloc(RECORDBUS_TRACE_INITIAL_SIZE);
+    if (!_trace)
+    {
+      return false;
+    }
+    _trace_size = RECORDBUS_TRACE_INITIAL_SIZE;
+  }
+
+  if (_output)
+  {
+    return _output->begin(speed, dataMode);
+  }
+  return true;
+}
+
+void Arduino_RecordBus::beginWrite()
+{
+  ++_stats.transactions;
+  recordOp(RECORD_BEGIN_WRITE, 0);
+  if (_output)
+  {
+    _output->beginWrite();
+  }
+}
+
+void Arduino_RecordBus::endWrite()
+{
+  while (_async_pending)
+  {
+    completeTransfer();
+  }
+  recordOp(RECORD_END_WRITE, 0);
+  if (_output)
+  {
+    _output->endWrite();
+  }
+}
+
+void Arduino_RecordBus::writeCommand(uint8_t c)
+{
+  countCommand(c, 1);
+  if (recordOp(RECORD_COMMAND_8, 1))
+  {
+    record8(c);
+  }
+  if (_output)
+  {
+    _output->writeCommand(c);
+  }
+}
+
+void Arduino_RecordBus::writeCommand16(uint16_t c)
+{
+  countCommand(c, 2);
+  if (recordOp(RECORD_COMMAND_16, 2))
+  {
+    record16(c);
+  }
+  if (_output)
+  {
+    _output->writeCommand16(c);
+  }
+}
+
+void Arduino_RecordBus::writeCommandBytes(uint8_t *data, uint32_t len)
+{
+  countCommand(0, 0);
+  _stats.command_bytes += len;
+  if (recordOp(RECORD_COMMAND_BYTES, 4 + len))
+  {
+    record32(len);
+    recordData(data, len);
+  }
+  if (_output)
+  {
+    _output->writeCommandBytes(data, len);
+  }
+}
+
+void Arduino_RecordBus::write(uint8_t d)
+{
+  countData(d);
+  recordBytes(&d, 1);
+  if (_output)
+  {
+    _output->write(d);
+  }
+}
+
+void Arduino_RecordBus::write16(uint16_t d)
+{
+  countData(d >> 8);
+  countData(d & 0xff);
+  if (recordOp(RECORD_DATA_16, 2))
+  {
+    record16(d);
+  }
+  if (_output)
+  {
+    _output->write16(d);
+  }
+}
+
+void Arduino_RecordBus::writeC8D8(uint8_t c, uint8_t d)
+{
+  countCommand(c, 1);
+  countData(d);
+  if (recordOp(RECORD_C8_D8, 2))
+  {
+    record8(c);
+    record8(d);
+  }
+  if (_output)
+  {
+    _output->writeC8D8(c, d);
+  }
+}
+
+void Arduino_RecordBus::writeC16D16(uint16_t c, uint16_t d)
+{
+  countCommand(c, 2);
+  countData(d >> 8);
+  countData(d & 0xff);
+  if (recordOp(RECORD_C16_D16, 4))
+  {
+    record16(c);
+    record16(d);
+  }
+  if (_output)
+  {
+    _output->writeC16D16(c, d);
+  }
+}
+
+void Arduino_RecordBus::writeC8D16(uint8_t c, uint16_t d)
+{
+  countCommand(c, 1);
+  countData(d >> 8);
+  countData(d & 0xff);
+  if (recordOp(RECORD_C8_D16, 3))
+  {
+    record8(c);
+    record16(d);
+  }
+  if (_output)
+  {
+    _output->writeC8D16(c, d);
+  }
+}
+
+void Arduino_RecordBus::writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  countCommand(c, 1);
+  countData(d1 >> 8);
+  countData(d1 & 0xff);
+  countData(d2 >> 8);
+  countData(d2 & 0xff);
+  if (recordOp(RECORD_C8_D16_D16, 5))
+  {
+    record8(c);
+    record16(d1);
+    record16(d2);
+  }
+  if (_output)
+  {
+    _output->writeC8D16D16(c, d1, d2);
+  }
+}
+
+void Arduino_RecordBus::writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  countCommand(c, 1);
+  countData(d1 >> 8);
+  countData(d1 & 0xff);
+  countData(d2 >> 8);
+  countData(d2 & 0xff);
+  if (recordOp(RECORD_C8_D16_D16_SPLIT, 5))
+  {
+    record8(c);
+    record16(d1);
+    record16(d2);
+  }
+  if (_output)
+  {
+    _output->writeC8D16D16Split(c, d1, d2);
+  }
+}
+
+void Arduino_RecordBus::writeRepeat(uint16_t p, uint32_t len)
+{
+  recordRepeat(p, len);
+  if (_output)
+  {
+    _output->writeRepeat(p, len);
+  }
+}
+
+void Arduino_RecordBus::writeBytes(uint8_t *data, uint32_t len)
+{
+  countDataBytes(data, len);
+  recordBytes(data, len);
+  if (_output)
+  {
+    _output->writeBytes(data, len);
+  }
+}
+
+void Arduino_RecordBus::writePixels(uint16_t *data, uint32_t len)
+{
+  recordPixels(data, len);
+  // record before output, some buses swap the pixel data in place
+  if (_output)
+  {
+    _output->writePixels(data, len);
+  }
+}
+
+void Arduino_RecordBus::batchOperation(const uint8_t *operations, size_t len)
+{
+  if (recordOp(RECORD_BATCH, 4 + len))
+  {
+    record32(len);
+    recordData(operations, len);
+  }
+
+  // decode with the generic implementation for counting, operations reach the output one by one
+  bool in_batch = _in_batch;
+  _in_batch = true;
+  Arduino_DataBus::batchOperation(operations, len);
+  _in_batch = in_batch;
+}
+
+void Arduino_RecordBus::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
+{
+  _addr_cmd = 0;
+  _stats.data_bytes += len * repeat;
+  _stats.pixel_bytes += len * repeat;
+  if (recordOp(RECORD_PATTERN, 5 + len))
+  {
+    record8(len);
+    record32(repeat);
+    recordData(data, len);
+  }
+  if (_output)
+  {
+    _output->writePattern(data, len, repeat);
+  }
+}
+
+void Arduino_RecordBus::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  _addr_cmd = 0;
+  _stats.data_bytes += len * 2;
+  _stats.pixel_bytes += len * 2;
+  if (_record_payload)
+  {
+    if (recordOp(RECORD_PIXELS, 4 + (len * 2)))
+    {
+      record32(len);
+      for (uint32_t i = 0; i < len; ++i)
+      {
+        record16(idx[data[i]]);
+      }
+    }
+  }
+  else if (recordOp(RECORD_REPEAT, 6))
+  {
+    record16(0);
+    record32(len);
+  }
+  if (_output)
+  {
+    _output->writeIndexedPixels(data, idx, len);
+  }
+}
+
+void Arduino_RecordBus::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  _addr_cmd = 0;
+  _stats.data_bytes += len * 4;
+  _stats.pixel_bytes += len * 4;
+  if (_record_payload)
+  {
+    if (recordOp(RECORD_PIXELS, 4 + (len * 4)))
+    {
+      record32(len * 2);
+      for (uint32_t i = 0; i < len; ++i)
+      {
+        record16(idx[data[i]]);
+        record16(idx[data[i]]);
+      }
+    }
+  }
+  else if (recordOp(RECORD_REPEAT, 6))
+  {
+    record16(0);
+    record32(len * 2);
+  }
+  if (_output)
+  {
+    _output->writeIndexedPixelsDouble(data, idx, len);
+  }
+}
+
+gfx_transfer_t Arduino_RecordBus::writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  countDataBytes(data, len);
+  recordBytes(data, len);
+  if (_output)
+  {
+    return _output->writeBytesAsync(data, len, cb, user_ctx);
+  }
+  return queueTransfer(cb, user_ctx);
+}
+
+gfx_transfer_t Arduino_RecordBus::writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  recordPixels(data, len);
+  if (_output)
+  {
+    return _output->writePixelsAsync(data, len, cb, user_ctx);
+  }
+  return queueTransfer(cb, user_ctx);
+}
+
+gfx_transfer_t Arduino_RecordBus::writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  recordRepeat(p, len);
+  if (_output)
+  {
+    return _output->writeRepeatAsync(p, len, cb, user_ctx);
+  }
+  return queueTransfer(cb, user_ctx);
+}
+
+/**
+ * @brief isTransferDone
+ *
+ * @param transfer handle returned by an async write, of the output bus if there is one
+ */
+bool Arduino_RecordBus::isTransferDone(gfx_transfer_t transfer)
+{
+  if (_output)
+  {
+    return _output->isTransferDone(transfer);
+  }
+  return Arduino_DataBus::isTransferDone(transfer);
+}
+
+void Arduino_RecordBus::waitWriteDone()
+{
+  if (_output)
+  {
+    _output->waitWriteDone();
+  }
+  while (_async_pending)
+  {
+    completeTransfer();
+  }
+}
+
+/**
+ * @brief setAsyncDepth
+ *
+ * Stand alone only, keep up to depth async transfers pending to test code waiting for them.
+ * They are finished in order by completeTransfer(), a deeper queue, waitWriteDone() or endWrite().
+ *
+ * @param depth 0 finishes every async transfer before the call returns
+ */
+void Arduino_RecordBus::setAsyncDepth(uint8_t depth)
+{
+  _async_depth = (depth < RECORDBUS_ASYNC_QUEUE_SIZE) ? depth : (RECORDBUS_ASYNC_QUEUE_SIZE - 1);
+  while (_async_pending > _async_depth)
+  {
+    completeTransfer();
+  }
+}
+
+/**
+ * @brief completeTransfer
+ *
+ * Finish the oldest pending async transfer and call its callback.
+ */
+void Arduino_RecordBus::completeTransfer()
+{
+  if (!_async_pending)
+  {
+    return;
+  }
+  uint8_t i = _async_head;
+  _async_head = (_async_head + 1) % RECORDBUS_ASYNC_QUEUE_SIZE;
+  --_async_pending;
+  _transfer_done = _async[i].transfer;
+  if (_async[i].cb)
+  {
+    _async[i].cb(_async[i].ctx);
+  }
+}
+
+/**
+ * @brief setRecording
+ *
+ * @param enable false to only count, the trace is kept as is
+ */
+void Arduino_RecordBus::setRecording(bool enable)
+{
+  _recording = enable;
+  _bytes_len_pos = SIZE_MAX;
+}
+
+/**
+ * @brief setRecordPayload
+ *
+ * @param enable false to record pixel data as length only, replay sends black pixels instead
+ */
+void Arduino_RecordBus::setRecordPayload(bool enable)
+{
+  _record_payload = enable;
+}
+
+void Arduino_RecordBus::clearTrace()
+{
+  _trace_len = 0;
+  _bytes_len_pos = SIZE_MAX;
+  _overflow = false;
+}
+
+const uint8_t *Arduino_RecordBus::getTrace()
+{
+  return _trace;
+}
+
+size_t Arduino_RecordBus::getTraceLength()
+{
+  return _trace_len;
+}
+
+/**
+ * @brief isTraceOverflow
+ *
+ * @return true if the trace buffer failed to grow, recording stopped at that point
+ */
+bool Arduino_RecordBus::isTraceOverflow()
+{
+  return _overflow;
+}
+
+/**
+ * @brief replay
+ *
+ * Send the recorded trace to another bus.
+ * Merged write() calls are replayed as writeBytes(), pixel data is copied before sending.
+ *
+ * @param bus target bus, already begin()
+ */
+void Arduino_RecordBus::replay(Arduino_DataBus *bus)
+{
+  if ((!bus) || (bus == this) || (!_trace))
+  {
+    return;
+  }
+
+  uint16_t buf[RECORDBUS_REPLAY_BUF_PIXELS];
+  uint8_t *p = _trace;
+  uint8_t *end = _trace + _trace_len;
+  uint32_t len;
+  while (p < end)
+  {
+    switch (*p++)
+    {
+    case RECORD_BEGIN_WRITE:
+      bus->beginWrite();
+      break;
+    case RECORD_END_WRITE:
+      bus->endWrite();
+      break;
+    case RECORD_COMMAND_8:
+      bus->writeCommand(p[0]);
+      p += 1;
+      break;
+    case RECORD_COMMAND_16:
+      bus->writeCommand16(read16(p));
+      p += 2;
+      break;
+    case RECORD_COMMAND_BYTES:
+      len = read32(p);
+      bus->writeCommandBytes(p + 4, len);
+      p += 4 + len;
+      break;
+    case RECORD_DATA_16:
+      bus->write16(read16(p));
+      p += 2;
+      break;
+    case RECORD_BYTES:
+      len = read32(p);
+      if (len == 1)
+      {
+        bus->write(p[4]);
+      }
+      else
+      {
+        bus->writeBytes(p + 4, len);
+      }
+      p += 4 + len;
+      break;
+    case RECORD_C8_D8:
+      bus->writeC8D8(p[0], p[1]);
+      p += 2;
+      break;
+    case RECORD_C8_D16:
+      bus->writeC8D16(p[0], read16(p + 1));
+      p += 3;
+      break;
+    case RECORD_C16_D16:
+      bus->writeC16D16(read16(p), read16(p + 2));
+      p += 4;
+      break;
+    case RECORD_C8_D16_D16:
+      bus->writeC8D16D16(p[0], read16(p + 1), read16(p + 3));
+      p += 5;
+      break;
+    case RECORD_C8_D16_D16_SPLIT:
+      bus->writeC8D16D16Split(p[0], read16(p + 1), read16(p + 3));
+      p += 5;
+      break;
+    case RECORD_REPEAT:
+      bus->writeRepeat(read16(p), read32(p + 2));
+      p += 6;
+      break;
+    case RECORD_PIXELS:
+      len = read32(p);
+      p += 4;
+      while (len)
+      {
+        uint32_t l = (len > RECORDBUS_REPLAY_BUF_PIXELS) ? RECORDBUS_REPLAY_BUF_PIXELS : len;
+        memcpy(buf, p, l * 2);
+        bus->writePixels(buf, l);
+        p += l * 2;
+        len -= l;
+      }
+      break;
+    case RECORD_PATTERN:
+      bus->writePattern(p + 5, p[0], read32(p + 1));
+      p += 5 + p[0];
+      break;
+    case RECORD_BATCH:
+      len = read32(p);
+      bus->batchOperation(p + 4, len);
+      p += 4 + len;
+      break;
+    default:
+      // corrupted trace
+      return;
+    }
+  }
+}
+
+void Arduino_RecordBus::resetStats()
+{
+  memset(&_stats, 0, sizeof(_stats));
+  _addr_cmd = 0;
+  _last_caset_valid = false;
+  _last_raset_valid = false;
+}
+
+const record_bus_stats_t *Arduino_RecordBus::getStats()
+{
+  return &_stats;
+}
+
+void Arduino_RecordBus::countCommand(uint16_t c, uint8_t bytes)
+{
+  ++_stats.commands;
+  _stats.command_bytes += bytes;
+  if ((bytes == 1) && ((c == RECORDBUS_CASET) || (c == RECORDBUS_RASET)))
+  {
+    ++_stats.addr_windows;
+    _addr_cmd = c;
+    _addr_param_len = 0;
+  }
+  else
+  {
+    _addr_cmd = 0;
+  }
+}
+
+void Arduino_RecordBus::countData(uint8_t d)
+{
+  ++_stats.data_bytes;
+  if (_addr_cmd)
+  {
+    _addr_param[_addr_param_len++] = d;
+    if (_addr_param_len == 4)
+    {
+      uint8_t *last = (_addr_cmd == RECORDBUS_CASET) ? _last_caset : _last_raset;
+      bool *valid = (_addr_cmd == RECORDBUS_CASET) ? &_last_caset_valid : &_last_raset_valid;
+      if ((*valid) && (memcmp(last, _addr_param, 4) == 0))
+      {
+        ++_stats.redundant_addr;
+      }
+      memcpy(last, _addr_param, 4);
+      *valid = true;
+      _addr_cmd = 0;
+    }
+  }
+}
+
+void Arduino_RecordBus::countDataBytes(const uint8_t *data, uint32_t len)
+{
+  while (_addr_cmd && len)
+  {
+    countData(*data++);
+    --len;
+  }
+  _stats.data_bytes += len;
+}
+
+bool Arduino_RecordBus::reserve(size_t len)
+{
+  if (_trace_len + len > _trace_size)
+  {
+    size_t size = _trace_size ? _trace_size : RECORDBUS_TRACE_INITIAL_SIZE;
+    while (_trace_len + len > size)
+    {
+      size *= 2;
+    }
+    uint8_t *trace = (uint8_t *)realloc(_trace, size);
+    if (!trace)
+    {
+      _overflow = true;
+      return false;
+    }
+    _trace = trace;
+    _trace_size = size;
+  }
+  return true;
+}
+
+/**
+ * @brief recordOp
+ *
+ * Append an operation id and reserve space for its parameters.
+ *
+ * @return true if the parameters should be recorded
+ */
+bool Arduino_RecordBus::recordOp(uint8_t op, size_t len)
+{
+  if ((!_recording) || _in_batch || _overflow)
+  {
+    return false;
+  }
+  if (!reserve(1 + len))
+  {
+    return false;
+  }
+  _bytes_len_pos = SIZE_MAX;
+  _trace[_trace_len++] = op;
+  return true;
+}
+
+void Arduino_RecordBus::record8(uint8_t v)
+{
+  _trace[_trace_len++] = v;
+}
+
+void Arduino_RecordBus::record16(uint16_t v)
+{
+  memcpy(_trace + _trace_len, &v, 2);
+  _trace_len += 2;
+}
+
+void Arduino_RecordBus::record32(uint32_t v)
+{
+  memcpy(_trace + _trace_len, &v, 4);
+  _trace_len += 4;
+}
+
+void Arduino_RecordBus::recordData(const void *data, size_t len)
+{
+  memcpy(_trace + _trace_len, data, len);
+  _trace_len += len;
+}
+
+void Arduino_RecordBus::recordRepeat(uint16_t p, uint32_t len)
+{
+  _addr_cmd = 0;
+  _stats.data_bytes += len * 2;
+  _stats.pixel_bytes += len * 2;
+  if (recordOp(RECORD_REPEAT, 6))
+  {
+    record16(p);
+    record32(len);
+  }
+}
+
+void Arduino_RecordBus::recordPixels(const uint16_t *data, uint32_t len)
+{
+  _addr_cmd = 0;
+  _stats.data_bytes += len * 2;
+  _stats.pixel_bytes += len * 2;
+  if (_record_payload)
+  {
+    if (recordOp(RECORD_PIXELS, 4 + (len * 2)))
+    {
+      record32(len);
+      recordData(data, len * 2);
+    }
+  }
+  else if (recordOp(RECORD_REPEAT, 6))
+  {
+    record16(0);
+    record32(len);
+  }
+}
+
+gfx_transfer_t Arduino_RecordBus::queueTransfer(gfx_write_done_cb_t cb, void *user_ctx)
+{
+  gfx_transfer_t transfer = nextTransfer();
+  uint8_t i = (_async_head + _async_pending) % RECORDBUS_ASYNC_QUEUE_SIZE;
+  _async[i].transfer = transfer;
+  _async[i].cb = cb;
+  _async[i].ctx = user_ctx;
+  ++_async_pending;
+  while (_async_pending > _async_depth)
+  {
+    completeTransfer();
+  }
+  return transfer;
+}
+
+void Arduino_RecordBus::recordBytes(const uint8_t *data, uint32_t len)
+{
+  if (_bytes_len_pos != SIZE_MAX)
+  {
+    // extend the last RECORD_BYTES
+    if ((!_recording) || _in_batch || _overflow || (!reserve(len)))
+    {
+      return;
+    }
+    recordData(data, len);
+    uint32_t merged_len = _trace_len - _bytes_len_pos - 4;
+    memcpy(_trace + _bytes_len_pos, &merged_len, 4);
+  }
+  else if (recordOp(RECORD_BYTES, 4 + len))
+  {
+    _bytes_len_pos = _trace_len;
+    record32(len);
+    recordData(data, len);
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,155 @@
+/*
+ * Recording Databus, keeps a compact trace of every bus call and counts protocol overhead.
+ * Can be used stand alone (e.g. on a host build) or in front of a real bus.
+ */
+#pragma once
+
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef RECORDBUS_TRACE_INITIAL_SIZE
+#define RECORDBUS_TRACE_INITIAL_SIZE 4096
+#endif
+#ifndef RECORDBUS_REPLAY_BUF_PIXELS
+#define RECORDBUS_REPLAY_BUF_PIXELS 256
+#endif
+#ifndef RECORDBUS_ASYNC_QUEUE_SIZE
+#define RECORDBUS_ASYNC_QUEUE_SIZE 8 // async transfers kept pending by setAsyncDepth()
+#endif
+#ifndef RECORDBUS_CASET
+#define RECORDBUS_CASET 0x2A
+#endif
+#ifndef RECORDBUS_RASET
+#define RECORDBUS_RASET 0x2B
+#endif
+
+typedef enum
+{
+  RECORD_BEGIN_WRITE,
+  RECORD_END_WRITE,
+  RECORD_COMMAND_8,         // c8
+  RECORD_COMMAND_16,        // c16
+  RECORD_COMMAND_BYTES,     // len32, data[len]
+  RECORD_DATA_16,           // d16
+  RECORD_BYTES,             // len32, data[len], consecutive write() and writeBytes() are merged
+  RECORD_C8_D8,             // c8, d8
+  RECORD_C8_D16,            // c8, d16
+  RECORD_C16_D16,           // c16, d16
+  RECORD_C8_D16_D16,        // c8, d16, d16
+  RECORD_C8_D16_D16_SPLIT,  // c8, d16, d16
+  RECORD_REPEAT,            // p16, len32
+  RECORD_PIXELS,            // len32, data16[len], indexed pixels are recorded expanded
+  RECORD_PATTERN,           // len8, repeat32, data[len]
+  RECORD_BATCH,             // len32, operations[len]
+} record_bus_op_t;
+
+typedef struct
+{
+  uint32_t transactions;       // beginWrite() count
+  uint32_t commands;           // command count, including those sent by writeCxDx functions
+  uint32_t command_bytes;      // bytes sent in command phase
+  uint32_t data_bytes;         // bytes sent in data phase, pixels included
+  uint32_t pixel_bytes;        // bytes sent by writeRepeat, writePixels and the indexed / pattern variants
+  uint32_t addr_windows;       // CASET + RASET commands
+  uint32_t redundant_addr;     // CASET / RASET commands repeating the previous value of the same command
+} record_bus_stats_t;
+
+class Arduino_RecordBus : public Arduino_DataBus
+{
+public:
+  Arduino_RecordBus(Arduino_DataBus *output = nullptr); // Constructor
+  ~Arduino_RecordBus();
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = GFX_NOT_DEFINED) override;
+  void beginWrite() override;
+  void endWrite() override;
+  void writeCommand(uint8_t) override;
+  void writeCommand16(uint16_t) override;
+  void writeCommandBytes(uint8_t *data, uint32_t len) override;
+  void write(uint8_t) override;
+  void write16(uint16_t) override;
+  void writeC8D8(uint8_t c, uint8_t d) override;
+  void writeC16D16(uint16_t c, uint16_t d) override;
+  void writeC8D16(uint8_t c, uint16_t d) override;
+  void writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeRepeat(uint16_t p, uint32_t len) override;
+  void writeBytes(uint8_t *data, uint32_t len) override;
+  void writePixels(uint16_t *data, uint32_t len) override;
+
+  void batchOperation(const uint8_t *operations, size_t len) override;
+  void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override;
+  void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
+
+  gfx_transfer_t writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  bool isTransferDone(gfx_transfer_t transfer) override;
+  void waitWriteDone() override;
+  void setAsyncDepth(uint8_t depth);
+  void completeTransfer();
+
+  void setRecording(bool enable);
+  void setRecordPayload(bool enable);
+  void clearTrace();
+  const uint8_t *getTrace();
+  size_t getTraceLength();
+  bool isTraceOverflow();
+  void replay(Arduino_DataBus *bus);
+
+  void resetStats();
+  const record_bus_stats_t *getStats();
+
+protected:
+  void countCommand(uint16_t c, uint8_t bytes);
+  void countData(uint8_t d);
+  void countDataBytes(const uint8_t *data, uint32_t len);
+  bool reserve(size_t len);
+  bool recordOp(uint8_t op, size_t len);
+  void record8(uint8_t v);
+  void record16(uint16_t v);
+  void record32(uint32_t v);
+  void recordData(const void *data, size_t len);
+  void recordBytes(const uint8_t *data, uint32_t len);
+  void recordRepeat(uint16_t p, uint32_t len);
+  void recordPixels(const uint16_t *data, uint32_t len);
+  gfx_transfer_t queueTransfer(gfx_write_done_cb_t cb, void *user_ctx);
+
+  Arduino_DataBus *_output;
+  record_bus_stats_t _stats;
+
+  uint8_t *_trace = nullptr;
+  size_t _trace_len = 0;
+  size_t _trace_size = 0;
+  size_t _bytes_len_pos = SIZE_MAX; // position of the length field of the last RECORD_BYTES, if it is the last record
+  bool _recording = true;
+  bool _record_payload = true;
+  bool _overflow = false;
+  bool _in_batch = false;
+
+  // address window tracking
+  uint16_t _addr_cmd = 0;       // CASET or RASET collecting parameters, 0 when idle
+  uint8_t _addr_param_len = 0;
+  uint8_t _addr_param[4];
+  uint8_t _last_caset[4];
+  uint8_t _last_raset[4];
+  bool _last_caset_valid = false;
+  bool _last_raset_valid = false;
+
+  // async transfers of the stand alone bus, pending until finished in order
+  struct
+  {
+    gfx_transfer_t transfer;
+    gfx_write_done_cb_t cb;
+    void *ctx;
+  } _async[RECORDBUS_ASYNC_QUEUE_SIZE];
+  uint8_t _async_head = 0;
+  uint8_t _async_pending = 0;
+  uint8_t _async_depth = 0; // transfers left pending after an async call returns
+
+private:
+};
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,473 @@
+/*
+ * Shared Databus, several panels on one bus (shared MOSI/SCLK/DC) with a chip select line each.
+ * Every panel gets its own Arduino_SharedBus, a device made of two panels sends to both at once (mirror).
+ */
+#include "Arduino_SharedBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+Arduino_SharedBus::Arduino_SharedBus(Arduino_DataBus *bus, int8_t cs)
+    : _bus(bus), _group(this)
+{
+  _mask = addPanel(cs);
+}
+
+Arduino_SharedBus::Arduino_SharedBus(Arduino_SharedBus *group, int8_t cs)
+    : _bus(group->_bus), _group(group->_group)
+{
+  _mask = _group->addPanel(cs);
+}
+
+Arduino_SharedBus::Arduino_SharedBus(Arduino_SharedBus *panel1, Arduino_SharedBus *panel2)
+    : _bus(panel1->_bus), _group(panel1->_group), _mask(panel1->_mask | panel2->_mask)
+{
+}
+
+bool Arduino_SharedBus::begin(int32_t speed, int8_t dataMode)
+{
+  Arduino_SharedBus *g = _group;
+  uint8_t selected = g->_owner ? g->_owner->_mask : 0;
+  for (uint8_t i = 0; i < g->_panel_count; ++i)
+  {
+    if ((_mask & (1 << i)) && (g->_panel_cs[i] != GFX_NOT_DEFINED))
+    {
+      pinMode(g->_panel_cs[i], OUTPUT);
+      digitalWrite(g->_panel_cs[i], (selected & (1 << i)) ? LOW : HIGH); // Disable chip select
+    }
+  }
+
+  if (!g->_begun)
+  {
+    if (!_bus->begin(speed, dataMode))
+    {
+      return false;
+    }
+    g->_begun = true;
+  }
+  return true;
+}
+
+void Arduino_SharedBus::beginWrite()
+{
+  select();
+  Arduino_SharedBus *g = _group;
+  if (!g->_open)
+  {
+    _bus->beginWrite();
+    g->_open = true;
+  }
+  g->_deferred = false;
+  g->_async_last = false;
+}
+
+/**
+ * @brief endWrite
+ *
+ * Leave the bus open when the transaction ended with an async write, it is closed once the
+ * transfer is waited for or another device writes. So one panel can be drawn while the other is sent.
+ */
+void Arduino_SharedBus::endWrite()
+{
+  Arduino_SharedBus *g = _group;
+  if (!g->_open)
+  {
+    return;
+  }
+  if (g->_async_last)
+  {
+    g->_deferred = true;
+  }
+  else
+  {
+    closeBus();
+  }
+}
+
+void Arduino_SharedBus::writeCommand(uint8_t c)
+{
+  _group->_async_last = false;
+  startCommand(c);
+  _bus->writeCommand(c);
+}
+
+void Arduino_SharedBus::writeCommand16(uint16_t c)
+{
+  _group->_async_last = false;
+  _addr_cmd = -1;
+  invalidateAddr(0);
+  invalidateAddr(1);
+  _bus->writeCommand16(c);
+}
+
+void Arduino_SharedBus::writeCommandBytes(uint8_t *data, uint32_t len)
+{
+  _group->_async_last = false;
+  _addr_cmd = -1;
+  invalidateAddr(0);
+  invalidateAddr(1);
+  _bus->writeCommandBytes(data, len);
+}
+
+void Arduino_SharedBus::write(uint8_t d)
+{
+  _group->_async_last = false;
+  addrData(d);
+  _bus->write(d);
+}
+
+void Arduino_SharedBus::write16(uint16_t d)
+{
+  _group->_async_last = false;
+  addrData(d >> 8);
+  addrData(d & 0xff);
+  _bus->write16(d);
+}
+
+void Arduino_SharedBus::writeC8D8(uint8_t c, uint8_t d)
+{
+  _group->_async_last = false;
+  startCommand(c);
+  addrData(d);
+  _bus->writeC8D8(c, d);
+}
+
+void Arduino_SharedBus::writeC16D16(uint16_t c, uint16_t d)
+{
+  _group->_async_last = false;
+  _addr_cmd = -1;
+  invalidateAddr(0);
+  invalidateAddr(1);
+  _bus->writeC16D16(c, d);
+}
+
+void Arduino_SharedBus::writeC8D16(uint8_t c, uint16_t d)
+{
+  _group->_async_last = false;
+  startCommand(c);
+  addrData(d >> 8);
+  addrData(d & 0xff);
+  _bus->writeC8D16(c, d);
+}
+
+void Arduino_SharedBus::writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  _group->_async_last = false;
+  if ((c == SHAREDBUS_CASET) || (c == SHAREDBUS_RASET))
+  {
+    _addr_cmd = -1;
+    if (setAddr((c == SHAREDBUS_CASET) ? 0 : 1, d1, d2, false))
+    {
+      _bus->writeC8D16D16(c, d1, d2);
+    }
+  }
+  else
+  {
+    startCommand(c);
+    _bus->writeC8D16D16(c, d1, d2);
+  }
+}
+
+void Arduino_SharedBus::writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2)
+{
+  _group->_async_last = false;
+  if ((c == SHAREDBUS_CASET) || (c == SHAREDBUS_RASET))
+  {
+    _addr_cmd = -1;
+    if (setAddr((c == SHAREDBUS_CASET) ? 0 : 1, d1, d2, true))
+    {
+      _bus->writeC8D16D16Split(c, d1, d2);
+    }
+  }
+  else
+  {
+    startCommand(c);
+    _bus->writeC8D16D16Split(c, d1, d2);
+  }
+}
+
+void Arduino_SharedBus::writeRepeat(uint16_t p, uint32_t len)
+{
+  _group->_async_last = false;
+  _bus->writeRepeat(p, len);
+}
+
+void Arduino_SharedBus::writeBytes(uint8_t *data, uint32_t len)
+{
+  _group->_async_last = false;
+  for (uint32_t i = 0; (_addr_cmd >= 0) && (i < len); ++i)
+  {
+    addrData(data[i]);
+  }
+  _bus->writeBytes(data, len);
+}
+
+void Arduino_SharedBus::writePixels(uint16_t *data, uint32_t len)
+{
+  _group->_async_last = false;
+  _bus->writePixels(data, len);
+}
+
+void Arduino_SharedBus::write16bitBeRGBBitmapR1(uint16_t *bitmap, int16_t w, int16_t h)
+{
+  _group->_async_last = false;
+  _bus->write16bitBeRGBBitmapR1(bitmap, w, h);
+}
+
+void Arduino_SharedBus::writePattern(uint8_t *data, uint8_t len, uint32_t repeat)
+{
+  _group->_async_last = false;
+  _bus->writePattern(data, len, repeat);
+}
+
+void Arduino_SharedBus::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  _group->_async_last = false;
+  _bus->writeIndexedPixels(data, idx, len);
+}
+
+void Arduino_SharedBus::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len)
+{
+  _group->_async_last = false;
+  _bus->writeIndexedPixelsDouble(data, idx, len);
+}
+
+void Arduino_SharedBus::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_t *crData, uint16_t w, uint16_t h)
+{
+  _group->_async_last = false;
+  _bus->writeYCbCrPixels(yData, cbData, crData, w, h);
+}
+
+gfx_transfer_t Arduino_SharedBus::writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  for (uint32_t i = 0; (_addr_cmd >= 0) && (i < len); ++i)
+  {
+    addrData(data[i]);
+  }
+  gfx_transfer_t transfer = _bus->writeBytesAsync(data, len, cb, user_ctx);
+  _group->_async_last = true;
+  return transfer;
+}
+
+gfx_transfer_t Arduino_SharedBus::writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  gfx_transfer_t transfer = _bus->writePixelsAsync(data, len, cb, user_ctx);
+  _group->_async_last = true;
+  return transfer;
+}
+
+gfx_transfer_t Arduino_SharedBus::writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb, void *user_ctx)
+{
+  gfx_transfer_t transfer = _bus->writeRepeatAsync(p, len, cb, user_ctx);
+  _group->_async_last = true;
+  return transfer;
+}
+
+/**
+ * @brief isTransferDone
+ *
+ * @param transfer handle returned by an async write, handles are shared by every device of the bus
+ */
+bool Arduino_SharedBus::isTransferDone(gfx_transfer_t transfer)
+{
+  return _bus->isTransferDone(transfer);
+}
+
+void Arduino_SharedBus::waitWriteDone()
+{
+  _bus->waitWriteDone();
+  if (_group->_deferred)
+  {
+    closeBus();
+  }
+}
+
+/**
+ * @brief releaseBus
+ *
+ * Finish pending transfers and disable every chip select, e.g. before the SPI host is used by another device.
+ */
+void Arduino_SharedBus::releaseBus()
+{
+  Arduino_SharedBus *g = _group;
+  if (g->_open)
+  {
+    closeBus();
+  }
+  if (g->_owner)
+  {
+    setCS(g->_owner->_mask, HIGH);
+    g->_owner = nullptr;
+  }
+}
+
+/**
+ * @brief addPanel
+ *
+ * @param cs chip select pin, GFX_NOT_DEFINED if always selected
+ * @return mask bit of the new panel, 0 if SHAREDBUS_MAX_PANELS are used
+ */
+uint8_t Arduino_SharedBus::addPanel(int8_t cs)
+{
+  if (_panel_count >= SHAREDBUS_MAX_PANELS)
+  {
+    return 0;
+  }
+  _panel_cs[_panel_count] = cs;
+  return 1 << _panel_count++;
+}
+
+/**
+ * @brief select
+ *
+ * Make this device the owner of the bus, only chip selects that differ from the previous owner are switched.
+ */
+void Arduino_SharedBus::select()
+{
+  Arduino_SharedBus *g = _group;
+  if (g->_owner == this)
+  {
+    return;
+  }
+  if (g->_open)
+  {
+    closeBus(); // waits until the previous owner's transfers are sent
+  }
+  uint8_t selected = g->_owner ? g->_owner->_mask : 0;
+  setCS(selected & ~_mask, HIGH);
+  setCS(_mask & ~selected, LOW);
+  g->_owner = this;
+}
+
+void Arduino_SharedBus::closeBus()
+{
+  Arduino_SharedBus *g = _group;
+  _bus->endWrite();
+  g->_open = false;
+  g->_deferred = false;
+  g->_async_last = false;
+}
+
+void Arduino_SharedBus::setCS(uint8_t mask, uint8_t level)
+{
+  Arduino_SharedBus *g = _group;
+  for (uint8_t i = 0; i < g->_panel_count; ++i)
+  {
+    if ((mask & (1 << i)) && (g->_panel_cs[i] != GFX_NOT_DEFINED))
+    {
+      digitalWrite(g->_panel_cs[i], level);
+    }
+  }
+}
+
+/**
+ * @brief startCommand
+ *
+ * Track an 8-bit command: CASET/RASET parameters are collected, RAMWR gets the window this device
+ * set last (another device may have changed it) and other commands may change the window.
+ */
+void Arduino_SharedBus::startCommand(uint8_t c)
+{
+  _addr_cmd = -1;
+  if ((c == SHAREDBUS_CASET) || (c == SHAREDBUS_RASET))
+  {
+    _addr_cmd = (c == SHAREDBUS_CASET) ? 0 : 1;
+    _addr_param_len = 0;
+    invalidateAddr(_addr_cmd);
+  }
+  else if (c == SHAREDBUS_RAMWR)
+  {
+    restoreAddr();
+  }
+  else
+  {
+    invalidateAddr(0);
+    invalidateAddr(1);
+  }
+}
+
+void Arduino_SharedBus::addrData(uint8_t d)
+{
+  if (_addr_cmd < 0)
+  {
+    return;
+  }
+  _addr_param[_addr_param_len++] = d;
+  if (_addr_param_len == 4)
+  {
+    setAddr(_addr_cmd, (_addr_param[0] << 8) | _addr_param[1], (_addr_param[2] << 8) | _addr_param[3], false);
+    _addr_cmd = -1;
+  }
+}
+
+void Arduino_SharedBus::invalidateAddr(uint8_t i)
+{
+  Arduino_SharedBus *g = _group;
+  for (uint8_t p = 0; p < g->_panel_count; ++p)
+  {
+    if (_mask & (1 << p))
+    {
+      g->_panel_addr[p][i].valid = false;
+    }
+  }
+}
+
+/**
+ * @brief setAddr
+ *
+ * @param i 0 for CASET, 1 for RASET
+ * @param start
+ * @param end
+ * @param split sent by writeC8D16D16Split()
+ * @return true if any panel of this device had another window
+ */
+bool Arduino_SharedBus::setAddr(uint8_t i, uint16_t start, uint16_t end, bool split)
+{
+  Arduino_SharedBus *g = _group;
+  _addr[i].start = start;
+  _addr[i].end = end;
+  _addr[i].valid = true;
+  _addr[i].split = split;
+
+  bool changed = false;
+  for (uint8_t p = 0; p < g->_panel_count; ++p)
+  {
+    if (_mask & (1 << p))
+    {
+      shared_bus_addr_t *a = &g->_panel_addr[p][i];
+      if ((!a->valid) || (a->start != start) || (a->end != end))
+      {
+        a->start = start;
+        a->end = end;
+        a->valid = true;
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+void Arduino_SharedBus::sendAddr(uint8_t i)
+{
+  uint8_t c = i ? SHAREDBUS_RASET : SHAREDBUS_CASET;
+  if (_addr[i].split)
+  {
+    _bus->writeC8D16D16Split(c, _addr[i].start, _addr[i].end);
+  }
+  else
+  {
+    _bus->writeC8D16D16(c, _addr[i].start, _addr[i].end);
+  }
+}
+
+void Arduino_SharedBus::restoreAddr()
+{
+  for (uint8_t i = 0; i < 2; ++i)
+  {
+    if (_addr[i].valid && setAddr(i, _addr[i].start, _addr[i].end, _addr[i].split))
+    {
+      sendAddr(i);
+    }
+  }
+}
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -0,0 +1,108 @@
+/*
+ * Shared Databus, several panels on one bus (shared MOSI/SCLK/DC) with a chip select line each.
+ * Every panel gets its own Arduino_SharedBus, a device made of two panels sends to both at once (mirror).
+ * The underlying bus must be created without chip select, all devices share its clock and mode.
+ * Chip select stays asserted between transactions until another device writes or releaseBus() is called.
+ * CASET/RASET windows are tracked per panel, so 8-bit command panels skip resending an unchanged window.
+ */
+#pragma once
+
+#include "Arduino_DataBus.h"
+
+#if !defined(LITTLE_FOOT_PRINT)
+
+#ifndef SHAREDBUS_MAX_PANELS
+#define SHAREDBUS_MAX_PANELS 4
+#endif
+#ifndef SHAREDBUS_CASET
+#define SHAREDBUS_CASET 0x2A
+#endif
+#ifndef SHAREDBUS_RASET
+#define SHAREDBUS_RASET 0x2B
+#endif
+#ifndef SHAREDBUS_RAMWR
+#define SHAREDBUS_RAMWR 0x2C
+#endif
+
+typedef struct
+{
+  uint16_t start;
+  uint16_t end;
+  bool valid;
+  bool split; // sent by writeC8D16D16Split()
+} shared_bus_addr_t;
+
+class Arduino_SharedBus : public Arduino_DataBus
+{
+public:
+  Arduino_SharedBus(Arduino_DataBus *bus, int8_t cs);                     // first panel
+  Arduino_SharedBus(Arduino_SharedBus *group, int8_t cs);                 // another panel on the same bus
+  Arduino_SharedBus(Arduino_SharedBus *panel1, Arduino_SharedBus *panel2); // mirror, both chip selects asserted
+
+  bool begin(int32_t speed = GFX_NOT_DEFINED, int8_t dataMode = GFX_NOT_DEFINED) override;
+  void beginWrite() override;
+  void endWrite() override;
+  void writeCommand(uint8_t) override;
+  void writeCommand16(uint16_t) override;
+  void writeCommandBytes(uint8_t *data, uint32_t len) override;
+  void write(uint8_t) override;
+  void write16(uint16_t) override;
+  void writeC8D8(uint8_t c, uint8_t d) override;
+  void writeC16D16(uint16_t c, uint16_t d) override;
+  void writeC8D16(uint8_t c, uint16_t d) override;
+  void writeC8D16D16(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeC8D16D16Split(uint8_t c, uint16_t d1, uint16_t d2) override;
+  void writeRepeat(uint16_t p, uint32_t len) override;
+  void writeBytes(uint8_t *data, uint32_t len) override;
+  void writePixels(uint16_t *data, uint32_t len) override;
+
+  void write16bitBeRGBBitmapR1(uint16_t *bitmap, int16_t w, int16_t h) override;
+  void writePattern(uint8_t *data, uint8_t len, uint32_t repeat) override;
+  void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
+  void writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_t *crData, uint16_t w, uint16_t h) override;
+
+  gfx_transfer_t writeBytesAsync(uint8_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writePixelsAsync(uint16_t *data, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  gfx_transfer_t writeRepeatAsync(uint16_t p, uint32_t len, gfx_write_done_cb_t cb = nullptr, void *user_ctx = nullptr) override;
+  bool isTransferDone(gfx_transfer_t transfer) override;
+  void waitWriteDone() override;
+
+  void releaseBus();
+
+protected:
+  uint8_t addPanel(int8_t cs);
+  void select();
+  void closeBus();
+  void setCS(uint8_t mask, uint8_t level);
+  void startCommand(uint8_t c);
+  void addrData(uint8_t d);
+  void invalidateAddr(uint8_t i);
+  bool setAddr(uint8_t i, uint16_t start, uint16_t end, bool split);
+  void sendAddr(uint8_t i);
+  void restoreAddr();
+
+  Arduino_DataBus *_bus;
+  Arduino_SharedBus *_group; // the first panel, keeps the state shared by all devices of the bus
+  uint8_t _mask;             // panels of this device
+
+  // address window last sent by this device, CASET and RASET
+  shared_bus_addr_t _addr[2] = {};
+  int8_t _addr_cmd = -1; // CASET or RASET index collecting parameters, -1 when idle
+  uint8_t _addr_param_len = 0;
+  uint8_t _addr_param[4];
+
+  // shared state, used in _group only
+  int8_t _panel_cs[SHAREDBUS_MAX_PANELS];
+  shared_bus_addr_t _panel_addr[SHAREDBUS_MAX_PANELS][2] = {}; // address window each panel really has
+  uint8_t _panel_count = 0;
+  Arduino_SharedBus *_owner = nullptr; // device with its chip selects asserted
+  bool _begun = false;
+  bool _open = false;       // _bus is between beginWrite() and endWrite()
+  bool _deferred = false;   // _bus->endWrite() is postponed, an async transfer is still sent
+  bool _async_last = false; // the last call was async, nothing is left buffered in _bus
+
+private:
+};
+
+#endif // !defined(LITTLE_FOOT_PRINT)
@@ -26,6 +26,16 @@ Arduino_DSI_Display::Arduino_DSI_Display(
   setRotation(r);
 }
 
+Arduino_DSI_Display::~Arduino_DSI_Display()
+{
+  if (_frame_sync)
+  {
+    _dsipanel->setVSyncCallback(nullptr, nullptr);
+    delete _frame_sync;
+    _frame_sync = nullptr;
+  }
+}
+
 bool Arduino_DSI_Display::begin(int32_t speed)
 {
   if (_rst != GFX_NOT_DEFINED)
@@ -47,6 +57,11 @@ bool Arduino_DSI_Display::begin(int32_t speed)
     return false;
   }
 
+  if (_frame_sync)
+  {
+    _dsipanel->setVSyncCallback(Arduino_FrameSync::vsyncCallback, _frame_sync); // begin() again, keep counting refreshes
+  }
+
   return true;
 }
 
@@ -219,10 +234,7 @@ void Arduino_DSI_Display::writeFastHLineCore(int16_t x, int16_t y,
         uint16_t *fb = _framebuffer + ((int32_t)y * _fb_width) + x;
         uint16_t *cachePos = fb;
         int16_t writeSize = w * 2;
-        while (w--)
-        {
-          *(fb++) = color;
-        }
+        gfx_fill_16bit(fb, color, w);
         if (_auto_flush)
         {
           esp_cache_msync(cachePos, writeSize, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
@@ -264,18 +276,15 @@ void Arduino_DSI_Display::writeFillRectPreclipped(int16_t x, int16_t y,
   // log_i("adjusted writeFillRectPreclipped(x: %d, y: %d, w: %d, h: %d)", x, y, w, h);
   x += COL_OFFSET1;
   y += ROW_OFFSET1;
+  if ((_accel) && (_accel->fillRect(_framebuffer, _fb_width, _fb_height, x, y, w, h, color)))
+  {
+    return; // written to memory, no cache to write back
+  }
   uint16_t *row = _framebuffer;
   row += y * _fb_width;
   uint16_t *cachePos = row;
   row += x;
-  for (int j = 0; j < h; j++)
-  {
-    for (int i = 0; i < w; i++)
-    {
-      row[i] = color;
-    }
-    row += _fb_width;
-  }
+  gfx_fill_rect_16bit(row, _fb_width, w, h, color);
   if (_auto_flush)
   {
     esp_cache_msync(cachePos, _fb_width * h * 2, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
@@ -370,6 +379,10 @@ void Arduino_DSI_Display::draw16bitRGBBitmap(int16_t x, int16_t y,
 
   x += COL_OFFSET1;
   y += ROW_OFFSET1;
+  if ((_accel) && (_accel->drawBitmap(bitmap, w, h, _framebuffer, x, y, (_rotation & 1) ? _fb_height : _fb_width, (_rotation & 1) ? _fb_width : _fb_height, _rotation)))
+  {
+    return; // written to memory, no cache to write back
+  }
   switch (_rotation)
   {
   case 1:
@@ -414,6 +427,123 @@ void Arduino_DSI_Display::draw16bitRGBBitmap(int16_t x, int16_t y,
   }
 }
 
+// blend with the framebuffer pixels, no need to threshold transparent glyph edges
+void Arduino_DSI_Display::drawAlphaBitmap(int16_t x, int16_t y,
+                                          const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+  if ((bpp != 4) && (bpp != 8))
+  {
+    return;
+  }
+
+  x += COL_OFFSET1;
+  y += ROW_OFFSET1;
+  if (gfx_draw_alpha_bitmap_to_framebuffer(bitmap, bpp, w, h, color, bg, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x, y, w, h);
+  }
+}
+
+void Arduino_DSI_Display::writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg)
+{
+  drawAlphaBitmap(x, y, alpha, 8, w, 1, color, bg);
+}
+
+// sample straight into the framebuffer, plain scales may go to the accelerator
+void Arduino_DSI_Display::drawAffineBitmap(const gfx_affine_t *affine)
+{
+  int16_t x = COL_OFFSET1;
+  int16_t y = ROW_OFFSET1;
+  if ((affine->scaled_w) && (!affine->bilinear) && (_rotation == 0) && (_accel) &&
+      (_accel->drawScaledBitmap(affine->bitmap, affine->bitmap_w, affine->bitmap_h, _framebuffer,
+                                x + affine->scaled_x, y + affine->scaled_y, _fb_width, _fb_height, affine->scaled_w, affine->scaled_h)))
+  {
+    return; // written to memory, no cache to write back
+  }
+  if (gfx_draw_affine_bitmap_to_framebuffer(affine, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x + affine->x1, y + affine->y1, affine->x2 - affine->x1 + 1, affine->y2 - affine->y1 + 1);
+  }
+}
+
+// blend with the framebuffer pixels
+void Arduino_DSI_Display::draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h)
+{
+  x += COL_OFFSET1;
+  y += ROW_OFFSET1;
+  if (gfx_draw_rgb_alpha_bitmap_to_framebuffer(bitmap, alpha, w, h, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x, y, w, h);
+  }
+}
+
+void Arduino_DSI_Display::draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h)
+{
+  x += COL_OFFSET1;
+  y += ROW_OFFSET1;
+  if (gfx_draw_argb_bitmap_to_framebuffer(bitmap, w, h, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x, y, w, h);
+  }
+}
+
+bool Arduino_DSI_Display::setScrollArea(int16_t y, int16_t h)
+{
+  return initScrollArea(y, h);
+}
+
+// move the framebuffer rows, the panel shows them without a flush()
+void Arduino_DSI_Display::scrollTo(int16_t offset)
+{
+  int16_t dy = scrollDelta(offset);
+  if (dy)
+  {
+    int16_t y = _scroll_y + ROW_OFFSET1;
+    gfx_scroll_framebuffer_16bit(_framebuffer, _fb_width, _fb_height, _rotation, y, _scroll_h, dy);
+    if (_auto_flush)
+    {
+      writeBackRows(0, y, (_rotation & 1) ? _fb_height : _fb_width, _scroll_h);
+    }
+  }
+}
+
+// write back the cached framebuffer rows under a rectangle in rotated coordinates, offsets included
+void Arduino_DSI_Display::writeBackRows(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  int32_t row, rows;
+  switch (_rotation)
+  {
+  case 1:
+    row = x;
+    rows = w;
+    break;
+  case 2:
+    row = _fb_height - y - h;
+    rows = h;
+    break;
+  case 3:
+    row = _fb_height - x - w;
+    rows = w;
+    break;
+  default: // case 0:
+    row = y;
+    rows = h;
+  }
+  if (row < 0)
+  {
+    rows += row;
+    row = 0;
+  }
+  if ((row + rows) > _fb_height)
+  {
+    rows = _fb_height - row;
+  }
+  if (rows > 0)
+  {
+    esp_cache_msync(_framebuffer + (row * _fb_width), _fb_width * rows * 2, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+  }
+}
+
 void Arduino_DSI_Display::draw16bitBeRGBBitmap(int16_t x, int16_t y,
                                                uint16_t *bitmap, int16_t w, int16_t h)
 {
@@ -546,9 +676,31 @@ void Arduino_DSI_Display::drawYCbCrBitmap(int16_t x, int16_t y, uint8_t *yData,
   }
 }
 
+// allocated when VSync pacing is first used, so other displays take no refresh interrupt
+Arduino_FrameSync *Arduino_DSI_Display::getFrameSync()
+{
+  if ((!_frame_sync) && (!_frame_sync_failed) && _framebuffer)
+  {
+    _frame_sync = new Arduino_FrameSync();
+    if ((!_frame_sync->begin()) || (!_dsipanel->setVSyncCallback(Arduino_FrameSync::vsyncCallback, _frame_sync)))
+    {
+      delete _frame_sync;
+      _frame_sync = nullptr; // waitForVSync() returns false at once
+      _frame_sync_failed = true;
+    }
+  }
+  return _frame_sync;
+}
+
 uint16_t *Arduino_DSI_Display::getFramebuffer()
 {
   return _framebuffer;
 }
 
+// offload large fills and 16-bit bitmaps, e.g. to Arduino_ESP32PPA, nullptr to draw on the CPU only
+void Arduino_DSI_Display::setAccel(Arduino_Accel *accel)
+{
+  _accel = accel;
+}
+
 #endif // #if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32P4)
@@ -6,6 +6,7 @@
 
 #include "../Arduino_GFX.h"
 #include "../databus/Arduino_ESP32DSIPanel.h"
+#include "../Arduino_Accel.h"
 
 #include <esp_cache.h>
 
@@ -390,6 +391,8 @@ public:
       int8_t rst = GFX_NOT_DEFINED, const lcd_init_cmd_t *init_operations = NULL, size_t init_operations_len = GFX_NOT_DEFINED,
       uint8_t col_offset1 = 0, uint8_t row_offset1 = 0, uint8_t col_offset2 = 0, uint8_t row_offset2 = 0);
 
+  ~Arduino_DSI_Display();
+
   bool begin(int32_t speed = GFX_NOT_DEFINED) override;
   void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override;
   void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
@@ -400,13 +403,24 @@ public:
   void drawIndexedBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint16_t *color_index, int16_t w, int16_t h, int16_t x_skip = 0) override;
   void draw16bitRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
   void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override;
+  void drawAlphaBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg) override;
+  void writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg) override;
+  void drawAffineBitmap(const gfx_affine_t *affine) override;
+  void draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h) override;
+  void draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h) override;
+  bool setScrollArea(int16_t y, int16_t h) override;
+  void scrollTo(int16_t offset) override;
   void flush(bool force_flush = false) override;
+  Arduino_FrameSync *getFrameSync() override;
 
   void drawYCbCrBitmap(int16_t x, int16_t y, uint8_t *yData, uint8_t *cbData, uint8_t *crData, int16_t w, int16_t h);
   uint16_t *getFramebuffer();
+  void setAccel(Arduino_Accel *accel);
 
 protected:
-  uint16_t *_framebuffer;
+  void writeBackRows(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  uint16_t *_framebuffer = nullptr;
   size_t _framebuffer_size;
   Arduino_ESP32DSIPanel *_dsipanel;
   bool _auto_flush;
@@ -418,6 +432,9 @@ protected:
   uint8_t COL_OFFSET2, ROW_OFFSET2;
   uint8_t _xStart, _yStart;
   uint16_t _fb_width, _fb_height, _fb_max_x, _fb_max_y;
+  Arduino_Accel *_accel = nullptr; // fills and blits offloaded if large enough, nullptr for CPU only
+  Arduino_FrameSync *_frame_sync = nullptr; // counts refresh done events, allocated by the first getFrameSync()
+  bool _frame_sync_failed = false; // no sync signal, not retried
 
 private:
 };
@@ -7,6 +7,7 @@ Arduino_GC9A01::Arduino_GC9A01(
     uint8_t col_offset1, uint8_t row_offset1, uint8_t col_offset2, uint8_t row_offset2)
     : Arduino_TFT(bus, rst, r, ips, w, h, col_offset1, row_offset1, col_offset2, row_offset2)
 {
+  _scroll_memory_h = GC9A01_TFTHEIGHT;
 }
 
 bool Arduino_GC9A01::begin(int32_t speed)
@@ -9,6 +9,7 @@
 Arduino_ILI9341::Arduino_ILI9341(Arduino_DataBus *bus, int8_t rst, uint8_t r, bool ips)
     : Arduino_TFT(bus, rst, r, ips, ILI9341_TFTWIDTH, ILI9341_TFTHEIGHT, 0, 0, 0, 0)
 {
+  _scroll_memory_h = ILI9341_TFTHEIGHT;
 }
 
 bool Arduino_ILI9341::begin(int32_t speed)
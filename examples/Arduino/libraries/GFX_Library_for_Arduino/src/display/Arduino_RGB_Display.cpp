@@ -24,6 +24,16 @@ Arduino_RGB_Display::Arduino_RGB_Display(
   setRotation(r);
 }
 
+Arduino_RGB_Display::~Arduino_RGB_Display()
+{
+  if (_frame_sync)
+  {
+    _rgbpanel->setVSyncCallback(nullptr, nullptr);
+    delete _frame_sync;
+    _frame_sync = nullptr;
+  }
+}
+
 bool Arduino_RGB_Display::begin(int32_t speed)
 {
   if (_bus)
@@ -70,6 +80,11 @@ bool Arduino_RGB_Display::begin(int32_t speed)
     return false;
   }
 
+  if (_frame_sync)
+  {
+    _rgbpanel->setVSyncCallback(Arduino_FrameSync::vsyncCallback, _frame_sync); // begin() again, keep counting refreshes
+  }
+
   return true;
 }
 
@@ -242,10 +257,7 @@ void Arduino_RGB_Display::writeFastHLineCore(int16_t x, int16_t y,
         uint16_t *fb = _framebuffer + ((int32_t)y * _fb_width) + x;
         uint32_t cachePos = (uint32_t)fb;
         int16_t writeSize = w * 2;
-        while (w--)
-        {
-          *(fb++) = color;
-        }
+        gfx_fill_16bit(fb, color, w);
         if (_auto_flush)
         {
           Cache_WriteBack_Addr(cachePos, writeSize);
@@ -291,14 +303,7 @@ void Arduino_RGB_Display::writeFillRectPreclipped(int16_t x, int16_t y,
   row += y * _fb_width;
   uint32_t cachePos = (uint32_t)row;
   row += x;
-  for (int j = 0; j < h; j++)
-  {
-    for (int i = 0; i < w; i++)
-    {
-      row[i] = color;
-    }
-    row += _fb_width;
-  }
+  gfx_fill_rect_16bit(row, _fb_width, w, h, color);
   if (_auto_flush)
   {
     Cache_WriteBack_Addr(cachePos, _fb_width * h * 2);
@@ -437,6 +442,117 @@ void Arduino_RGB_Display::draw16bitRGBBitmap(int16_t x, int16_t y,
   }
 }
 
+// blend with the framebuffer pixels, no need to threshold transparent glyph edges
+void Arduino_RGB_Display::drawAlphaBitmap(int16_t x, int16_t y,
+                                          const uint8_t *bitmap, uint8_t bpp, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+{
+  if ((bpp != 4) && (bpp != 8))
+  {
+    return;
+  }
+
+  x += COL_OFFSET1;
+  y += ROW_OFFSET1;
+  if (gfx_draw_alpha_bitmap_to_framebuffer(bitmap, bpp, w, h, color, bg, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x, y, w, h);
+  }
+}
+
+void Arduino_RGB_Display::writeAlphaSpan(int16_t x, int16_t y, const uint8_t *alpha, int16_t w, uint16_t color, uint16_t bg)
+{
+  drawAlphaBitmap(x, y, alpha, 8, w, 1, color, bg);
+}
+
+// sample straight into the framebuffer
+void Arduino_RGB_Display::drawAffineBitmap(const gfx_affine_t *affine)
+{
+  int16_t x = COL_OFFSET1;
+  int16_t y = ROW_OFFSET1;
+  if (gfx_draw_affine_bitmap_to_framebuffer(affine, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x + affine->x1, y + affine->y1, affine->x2 - affine->x1 + 1, affine->y2 - affine->y1 + 1);
+  }
+}
+
+// blend with the framebuffer pixels
+void Arduino_RGB_Display::draw16bitRGBBitmapWithAlpha(int16_t x, int16_t y, const uint16_t *bitmap, const uint8_t *alpha, int16_t w, int16_t h)
+{
+  x += COL_OFFSET1;
+  y += ROW_OFFSET1;
+  if (gfx_draw_rgb_alpha_bitmap_to_framebuffer(bitmap, alpha, w, h, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x, y, w, h);
+  }
+}
+
+void Arduino_RGB_Display::draw32bitARGBBitmap(int16_t x, int16_t y, const uint32_t *bitmap, int16_t w, int16_t h)
+{
+  x += COL_OFFSET1;
+  y += ROW_OFFSET1;
+  if (gfx_draw_argb_bitmap_to_framebuffer(bitmap, w, h, _framebuffer, x, y, _fb_width, _fb_height, _rotation) && _auto_flush)
+  {
+    writeBackRows(x, y, w, h);
+  }
+}
+
+bool Arduino_RGB_Display::setScrollArea(int16_t y, int16_t h)
+{
+  return initScrollArea(y, h);
+}
+
+// move the framebuffer rows, the panel shows them without a flush()
+void Arduino_RGB_Display::scrollTo(int16_t offset)
+{
+  int16_t dy = scrollDelta(offset);
+  if (dy)
+  {
+    int16_t y = _scroll_y + ROW_OFFSET1;
+    gfx_scroll_framebuffer_16bit(_framebuffer, _fb_width, _fb_height, _rotation, y, _scroll_h, dy);
+    if (_auto_flush)
+    {
+      writeBackRows(0, y, (_rotation & 1) ? _fb_height : _fb_width, _scroll_h);
+    }
+  }
+}
+
+// write back the cached framebuffer rows under a rectangle in rotated coordinates, offsets included
+void Arduino_RGB_Display::writeBackRows(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  int32_t row, rows;
+  switch (_rotation)
+  {
+  case 1:
+    row = x;
+    rows = w;
+    break;
+  case 2:
+    row = _fb_height - y - h;
+    rows = h;
+    break;
+  case 3:
+    row = _fb_height - x - w;
+    rows = w;
+    break;
+  default: // case 0:
+    row = y;
+    rows = h;
+  }
+  if (row < 0)
+  {
+    rows += row;
+    row = 0;
+  }
+  if ((row + rows) > _fb_height)
+  {
+    rows = _fb_height - row;
+  }
+  if (rows > 0)
+  {
+    Cache_WriteBack_Addr((uint32_t)(_framebuffer + (row * _fb_width)), _fb_width * rows * 2);
+  }
+}
+
 void Arduino_RGB_Display::draw16bitBeRGBBitmap(int16_t x, int16_t y,
                                                uint16_t *bitmap, int16_t w, int16_t h)
 {
@@ -568,6 +684,22 @@ void Arduino_RGB_Display::flush(bool force_flush)
   }
 }
 
+// allocated when VSync pacing is first used, so other displays take no refresh interrupt
+Arduino_FrameSync *Arduino_RGB_Display::getFrameSync()
+{
+  if ((!_frame_sync) && (!_frame_sync_failed) && _framebuffer)
+  {
+    _frame_sync = new Arduino_FrameSync();
+    if ((!_frame_sync->begin()) || (!_rgbpanel->setVSyncCallback(Arduino_FrameSync::vsyncCallback, _frame_sync)))
+    {
+      delete _frame_sync;
+      _frame_sync = nullptr; // waitForVSync() returns false at once
+      _frame_sync_failed = true;
+    }
+  }
+  return _frame_sync;
+}
+
 uint16_t *Arduino_RGB_Display::getFramebuffer()
 {
   return _framebuffer;
@@ -12,6 +12,7 @@ Arduino_ST7789::Arduino_ST7789(
     uint8_t col_offset1, uint8_t row_offset1, uint8_t col_offset2, uint8_t row_offset2)
     : Arduino_TFT(bus, rst, r, ips, w, h, col_offset1, row_offset1, col_offset2, row_offset2)
 {
+  _scroll_memory_h = ST7789_TFTHEIGHT;
 }
 
 bool Arduino_ST7789::begin(int32_t speed)
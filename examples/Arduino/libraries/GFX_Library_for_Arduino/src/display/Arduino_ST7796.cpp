@@ -11,6 +11,7 @@ Arduino_ST7796::Arduino_ST7796(
     uint8_t col_offset1, uint8_t row_offset1, uint8_t col_offset2, uint8_t row_offset2)
     : Arduino_TFT(bus, rst, r, ips, w, h, col_offset1, row_offset1, col_offset2, row_offset2)
 {
+  _scroll_memory_h = ST7796_TFTHEIGHT;
 }
 
 bool Arduino_ST7796::begin(int32_t speed)
@@ -28,4 +28,17 @@ typedef struct
 	uint8_t yAdvance; ///< Newline distance (y axis)
 } GFXfont;
 
+/// Anti-aliased font, same glyph metrics as GFXfont.
+/// Each glyph row starts on a byte boundary, 4-bit pixels are high nibble first.
+/// Read without pgm_read_*(), so keep it in memory mapped flash or RAM.
+typedef struct
+{
+	uint8_t *bitmap;	///< Glyph alpha bitmaps, concatenated
+	GFXglyph *glyph;	///< Glyph array
+	uint16_t first;		///< ASCII extents (first char)
+	uint16_t last;		///< ASCII extents (last char)
+	uint8_t yAdvance; ///< Newline distance (y axis)
+	uint8_t bpp;			///< Alpha bits per pixel, 4 or 8
+} GFXalphaFont;
+
 #endif // _GFXFONT_H_